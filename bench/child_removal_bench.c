@@ -0,0 +1,130 @@
+#include "system/ui_traversal.h"
+#include "ui/ui_element.h"
+#include "ui/ui_layout_container.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Times emptying a 10k-child layout container three ways: removing children
+ * one at a time front to back (the old worst case, one full shift per call),
+ * one at a time back to front, and with a single batched call.
+ *
+ * Every removal destroys its child so the numbers include the handle release
+ * and free each real removal pays.
+ */
+
+static const size_t CHILD_COUNT = 10000U;
+static const size_t ROUND_COUNT = 5U;
+
+static void destroy_bench_element(ui_element *element) { free(element); }
+
+static const ui_element_ops BENCH_ELEMENT_OPS = {
+    .destroy = destroy_bench_element,
+};
+
+static double ticks_to_us(Uint64 ticks)
+{
+    return (double)ticks * 1000000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+static ui_layout_container *populate(ui_element **children)
+{
+    ui_layout_container *container = ui_layout_container_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, 400.0F, 400.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    if (container == NULL)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0U; i < CHILD_COUNT; ++i)
+    {
+        ui_element *child = calloc(1U, sizeof(*child));
+        if (child == NULL)
+        {
+            ui_traversal_destroy(&container->base);
+            return NULL;
+        }
+
+        child->rect = (SDL_FRect){0.0F, 0.0F, 10.0F, 10.0F};
+        child->ops = &BENCH_ELEMENT_OPS;
+        child->visible = true;
+        child->enabled = true;
+        child->align_h = UI_ALIGN_LEFT;
+        child->align_v = UI_ALIGN_TOP;
+        ui_element_reset_layout_cache(child);
+        if (!ui_layout_container_add_child(container, child))
+        {
+            free(child);
+            ui_traversal_destroy(&container->base);
+            return NULL;
+        }
+        children[i] = child;
+    }
+    return container;
+}
+
+typedef enum removal_order
+{
+    REMOVE_FRONT_TO_BACK,
+    REMOVE_BACK_TO_FRONT,
+    REMOVE_BATCH,
+} removal_order;
+
+static bool run_order(ui_element **children, removal_order order, const char *label)
+{
+    Uint64 total_ticks = 0U;
+    for (size_t round = 0U; round < ROUND_COUNT; ++round)
+    {
+        ui_layout_container *container = populate(children);
+        if (container == NULL)
+        {
+            return false;
+        }
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (order == REMOVE_BATCH)
+        {
+            (void)ui_layout_container_remove_children(container, children, CHILD_COUNT, true);
+        }
+        else
+        {
+            for (size_t i = 0U; i < CHILD_COUNT; ++i)
+            {
+                const size_t index = order == REMOVE_FRONT_TO_BACK ? i : CHILD_COUNT - 1U - i;
+                (void)ui_layout_container_remove_child(container, children[index], true);
+            }
+        }
+        total_ticks += SDL_GetPerformanceCounter() - start;
+
+        const bool emptied = container->child_count == 0U;
+        ui_traversal_destroy(&container->base);
+        if (!emptied)
+        {
+            fprintf(stderr, "%s left children behind\n", label);
+            return false;
+        }
+    }
+
+    printf("%14s %12.1f\n", label, ticks_to_us(total_ticks) / (double)ROUND_COUNT);
+    return true;
+}
+
+int main(void)
+{
+    ui_element **children = malloc(CHILD_COUNT * sizeof(*children));
+    if (children == NULL)
+    {
+        fprintf(stderr, "failed to allocate child list\n");
+        return 1;
+    }
+
+    printf("%zu children, %zu rounds\n", CHILD_COUNT, ROUND_COUNT);
+    printf("%14s %12s\n", "order", "clear us");
+    const bool ok = run_order(children, REMOVE_FRONT_TO_BACK, "front-to-back") &&
+                    run_order(children, REMOVE_BACK_TO_FRONT, "back-to-front") &&
+                    run_order(children, REMOVE_BATCH, "batch");
+
+    free(children);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,577 @@
+#include <SDL3/SDL.h>
+
+#include "pages/app_page.h"
+#include "system/ui_frame_profiler.h"
+#include "system/ui_input_coalescer.h"
+#include "system/ui_ops_profiler.h"
+#include "system/ui_render.h"
+#include "system/ui_runtime.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Headless frame benchmark over the real pages in app_pages[].
+ *
+ * Each page is booted in a window on SDL's offscreen (or dummy) video driver
+ * with the software renderer, then driven through main.c's frame phases for a
+ * fixed number of frames with a fixed delta and a scripted pointer path, so
+ * two runs on the same machine replay the same work. Results are written to
+ * stdout as JSON: frame and per-phase percentiles from ui_frame_profiler, and
+ * heap allocation counts when the build wraps malloc (see CMakeLists.txt).
+ *
+ * --max-p95-ms and --max-frame-allocations turn the run into a pass/fail
+ * check, exiting with status 1 when any page goes over budget. Any other
+ * `--name value` pair goes to the configure op of pages that have one, as in
+ * main.c (for example --stress-count 100000).
+ */
+
+static const int DEFAULT_WIDTH = 1024;
+static const int DEFAULT_HEIGHT = 768;
+static const int DEFAULT_FRAMES = 600;
+static const int DEFAULT_WARMUP_FRAMES = 30;
+static const float FRAME_DELTA_SECONDS = 1.0F / 60.0F;
+static const int CLICK_INTERVAL_FRAMES = 45;
+static const int WHEEL_INTERVAL_FRAMES = 20;
+
+#define MAX_PAGE_OPTIONS 16U
+
+typedef struct bench_options
+{
+    const char *page_id;
+    int width;
+    int height;
+    int frames;
+    int warmup_frames;
+    double max_p95_ms;
+    long long max_frame_allocations;
+    const char *page_option_names[MAX_PAGE_OPTIONS];
+    const char *page_option_values[MAX_PAGE_OPTIONS];
+    size_t page_option_count;
+} bench_options;
+
+/*
+ * Heap traffic through malloc/calloc/realloc made by code linked into this
+ * executable. The wrappers are only linked in when CUI_BENCH_COUNT_ALLOCATIONS
+ * is defined; otherwise the counters stay zero and the JSON says so.
+ */
+typedef struct allocation_counters
+{
+    Uint64 count;
+    Uint64 bytes;
+} allocation_counters;
+
+static allocation_counters allocations;
+
+#if defined(CUI_BENCH_COUNT_ALLOCATIONS)
+
+// The linker's --wrap option dictates these names.
+// NOLINTBEGIN(bugprone-reserved-identifier)
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    allocations.count++;
+    allocations.bytes += size;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    allocations.count++;
+    allocations.bytes += count * size;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocations.count++;
+    allocations.bytes += size;
+    return __real_realloc(ptr, size);
+}
+// NOLINTEND(bugprone-reserved-identifier)
+
+static const bool ALLOCATIONS_TRACKED = true;
+
+#else
+
+static const bool ALLOCATIONS_TRACKED = false;
+
+#endif
+
+typedef struct page_result
+{
+    ui_frame_timing_stats frame;
+    ui_frame_timing_stats phases[UI_FRAME_PHASE_COUNT];
+    allocation_counters startup_allocations;
+    allocation_counters frame_allocations;
+    Uint64 max_frame_allocations;
+    ui_runtime_render_stats render;
+    ui_render_call_stats render_calls;
+    ui_render_call_stats max_frame_render_calls;
+} page_result;
+
+static bool parse_non_negative_int(const char *value, int *out)
+{
+    if (value == NULL || out == NULL || value[0] == '\0')
+    {
+        return false;
+    }
+
+    errno = 0;
+    char *end = NULL;
+    const long parsed = strtol(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0' || parsed < 0L || parsed > INT_MAX)
+    {
+        return false;
+    }
+
+    *out = (int)parsed;
+    return true;
+}
+
+static void log_usage(const char *program_name)
+{
+    SDL_Log("Usage: %s [--page <id>] [-w|--width <width>] [-h|--height <height>] "
+            "[--frames <n>] [--warmup <n>] [--max-p95-ms <ms>] [--max-frame-allocations <n>] "
+            "[--<page option> <value>]",
+            program_name);
+    SDL_Log("Runs every page when --page is omitted.");
+}
+
+static bool parse_options(int argc, char **argv, bench_options *options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *option = argv[i];
+        if (i + 1 >= argc)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing value for option: %s", option);
+            return false;
+        }
+
+        const char *value = argv[++i];
+        int parsed = 0;
+        bool ok = true;
+        if (strcmp(option, "--page") == 0)
+        {
+            options->page_id = value;
+        }
+        else if (strcmp(option, "-w") == 0 || strcmp(option, "--width") == 0)
+        {
+            ok = parse_non_negative_int(value, &options->width) && options->width > 0;
+        }
+        else if (strcmp(option, "-h") == 0 || strcmp(option, "--height") == 0)
+        {
+            ok = parse_non_negative_int(value, &options->height) && options->height > 0;
+        }
+        else if (strcmp(option, "--frames") == 0)
+        {
+            ok = parse_non_negative_int(value, &options->frames) && options->frames > 0;
+        }
+        else if (strcmp(option, "--warmup") == 0)
+        {
+            ok = parse_non_negative_int(value, &options->warmup_frames);
+        }
+        else if (strcmp(option, "--max-frame-allocations") == 0)
+        {
+            ok = parse_non_negative_int(value, &parsed);
+            options->max_frame_allocations = parsed;
+        }
+        else if (strcmp(option, "--max-p95-ms") == 0)
+        {
+            char *end = NULL;
+            options->max_p95_ms = strtod(value, &end);
+            ok = end != value && *end == '\0' && options->max_p95_ms > 0.0;
+        }
+        else if (strncmp(option, "--", 2U) == 0 && options->page_option_count < MAX_PAGE_OPTIONS)
+        {
+            options->page_option_names[options->page_option_count] = option;
+            options->page_option_values[options->page_option_count] = value;
+            options->page_option_count++;
+        }
+        else
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown option: %s", option);
+            return false;
+        }
+
+        if (!ok)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid value for option %s: %s", option,
+                         value);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Scripted input for one frame: the pointer follows a fixed Lissajous path
+ * over the viewport, clicking and scrolling at fixed intervals.
+ */
+static void push_scripted_input(ui_input_coalescer *input, ui_runtime *context,
+                                SDL_WindowID window_id, const bench_options *options, int frame)
+{
+    const float t = (float)frame;
+    const float x = (float)options->width * (0.5F + 0.45F * SDL_sinf(t * 0.050F));
+    const float y = (float)options->height * (0.5F + 0.45F * SDL_sinf(t * 0.031F));
+
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    event.motion.windowID = window_id;
+    event.motion.x = x;
+    event.motion.y = y;
+    ui_input_coalescer_push(input, context, &event);
+
+    if (frame % WHEEL_INTERVAL_FRAMES == 0)
+    {
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_WHEEL;
+        event.wheel.windowID = window_id;
+        event.wheel.y = (frame / WHEEL_INTERVAL_FRAMES) % 2 == 0 ? -1.0F : 1.0F;
+        event.wheel.mouse_x = x;
+        event.wheel.mouse_y = y;
+        ui_input_coalescer_push(input, context, &event);
+    }
+
+    if (frame % CLICK_INTERVAL_FRAMES == 0)
+    {
+        SDL_zero(event);
+        event.button.windowID = window_id;
+        event.button.button = SDL_BUTTON_LEFT;
+        event.button.clicks = 1;
+        event.button.x = x;
+        event.button.y = y;
+        event.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+        event.button.down = true;
+        ui_input_coalescer_push(input, context, &event);
+        event.type = SDL_EVENT_MOUSE_BUTTON_UP;
+        event.button.down = false;
+        ui_input_coalescer_push(input, context, &event);
+    }
+}
+
+static bool configure_page(const app_page_entry *page, const bench_options *options)
+{
+    if (page->ops->configure == NULL)
+    {
+        return true;
+    }
+
+    for (size_t i = 0U; i < options->page_option_count; ++i)
+    {
+        if (!page->ops->configure(options->page_option_names[i], options->page_option_values[i]))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: unknown option or invalid value: %s %s",
+                         page->id, options->page_option_names[i], options->page_option_values[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void accumulate_render_calls(page_result *result, const ui_render_call_stats *frame)
+{
+    ui_render_call_stats *total = &result->render_calls;
+    ui_render_call_stats *peak = &result->max_frame_render_calls;
+    total->draw_calls += frame->draw_calls;
+    total->primitives += frame->primitives;
+    total->color_changes += frame->color_changes;
+    total->clip_changes += frame->clip_changes;
+    total->texture_binds += frame->texture_binds;
+    peak->draw_calls = SDL_max(peak->draw_calls, frame->draw_calls);
+    peak->primitives = SDL_max(peak->primitives, frame->primitives);
+    peak->color_changes = SDL_max(peak->color_changes, frame->color_changes);
+    peak->clip_changes = SDL_max(peak->clip_changes, frame->clip_changes);
+    peak->texture_binds = SDL_max(peak->texture_binds, frame->texture_binds);
+}
+
+static bool run_page(const app_page_entry *page, const bench_options *options,
+                     ui_frame_profiler *profiler, page_result *result)
+{
+    if (!configure_page(page, options))
+    {
+        return false;
+    }
+
+    SDL_Window *window = SDL_CreateWindow(page->id, options->width, options->height, 0);
+    if (window == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateWindow failed: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_Renderer *renderer = SDL_CreateRenderer(window, SDL_SOFTWARE_RENDERER);
+    if (renderer == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateRenderer failed: %s", SDL_GetError());
+        SDL_DestroyWindow(window);
+        return false;
+    }
+
+    const SDL_Color color_bg = {241, 241, 238, 255};
+    ui_runtime context;
+    if (!ui_runtime_init(&context))
+    {
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        return false;
+    }
+
+    const allocation_counters before_create = allocations;
+    void *page_instance = page->ops->create(window, &context, options->width, options->height);
+    if (page_instance == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create page: %s", page->id);
+        ui_runtime_destroy(&context);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        return false;
+    }
+    result->startup_allocations.count = allocations.count - before_create.count;
+    result->startup_allocations.bytes = allocations.bytes - before_create.bytes;
+
+    ui_input_coalescer input;
+    (void)ui_input_coalescer_init(&input);
+    (void)ui_frame_profiler_init(profiler);
+    ui_ops_profiler_reset();
+
+    const SDL_WindowID window_id = SDL_GetWindowID(window);
+    const int total_frames = options->warmup_frames + options->frames;
+    bool ok = true;
+    allocation_counters before_frames = allocations;
+    for (int frame = 0; frame < total_frames && ok; ++frame)
+    {
+        // Warmup frames fill caches and grow buffers; only later frames count.
+        const bool measured = frame >= options->warmup_frames;
+        if (frame == options->warmup_frames)
+        {
+            before_frames = allocations;
+        }
+        const Uint64 frame_start_count = allocations.count;
+        ui_frame_profiler_begin_frame(measured ? profiler : NULL);
+
+        push_scripted_input(&input, &context, window_id, options, frame);
+        ui_input_coalescer_flush(&input, &context);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_EVENTS);
+
+        ok = page->ops->update(page_instance);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_PAGE_UPDATE);
+
+        ui_runtime_update(&context, FRAME_DELTA_SECONDS);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_RUNTIME_UPDATE);
+
+        ui_runtime_layout(&context);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_LAYOUT);
+
+        ui_render_clear(renderer, color_bg);
+        if (!ui_runtime_render_damaged(&context, renderer, options->width, options->height,
+                                       color_bg))
+        {
+            ui_runtime_render(&context, renderer);
+        }
+        SDL_RenderPresent(renderer);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_RENDER);
+        ui_frame_profiler_end_frame(profiler);
+        ui_ops_profiler_end_frame();
+        const ui_render_call_stats frame_calls = ui_render_end_frame();
+        if (measured)
+        {
+            accumulate_render_calls(result, &frame_calls);
+        }
+
+        const Uint64 frame_allocations = allocations.count - frame_start_count;
+        if (measured && frame_allocations > result->max_frame_allocations)
+        {
+            result->max_frame_allocations = frame_allocations;
+        }
+    }
+    result->frame_allocations.count = allocations.count - before_frames.count;
+    result->frame_allocations.bytes = allocations.bytes - before_frames.bytes;
+
+    if (!ok)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to update page: %s", page->id);
+    }
+
+    result->frame = ui_frame_profiler_get_frame_stats(profiler);
+    for (int phase = 0; phase < UI_FRAME_PHASE_COUNT; ++phase)
+    {
+        result->phases[phase] = ui_frame_profiler_get_phase_stats(profiler, (ui_frame_phase)phase);
+    }
+    result->render = ui_runtime_get_render_stats(&context);
+    ui_ops_profiler_log_summary();
+
+    page->ops->destroy(page_instance);
+    ui_runtime_destroy(&context);
+    ui_input_coalescer_destroy(&input);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    return ok;
+}
+
+static void print_timing_json(const char *name, const ui_frame_timing_stats *stats)
+{
+    printf("\"%s\": {\"p50_ms\": %.4f, \"p95_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f}", name,
+           stats->p50_ms, stats->p95_ms, stats->p99_ms, stats->max_ms);
+}
+
+static void print_render_calls_json(const char *name, const ui_render_call_stats *stats,
+                                   double frames)
+{
+    printf("\"%s\": {\"draw_calls\": %.1f, \"primitives\": %.1f, \"color_changes\": %.1f, "
+           "\"clip_changes\": %.1f, \"texture_binds\": %.1f}",
+           name, (double)stats->draw_calls / frames, (double)stats->primitives / frames,
+           (double)stats->color_changes / frames, (double)stats->clip_changes / frames,
+           (double)stats->texture_binds / frames);
+}
+
+static void print_page_json(const char *page_id, const page_result *result)
+{
+    printf("    {\n      \"page\": \"%s\",\n      \"samples\": %zu,\n      ", page_id,
+           result->frame.sample_count);
+    print_timing_json("frame", &result->frame);
+    printf(",\n      \"phases\": {\n");
+    for (int phase = 0; phase < UI_FRAME_PHASE_COUNT; ++phase)
+    {
+        printf("        ");
+        print_timing_json(ui_frame_phase_name((ui_frame_phase)phase), &result->phases[phase]);
+        printf("%s\n", phase + 1 < UI_FRAME_PHASE_COUNT ? "," : "");
+    }
+    printf("      },\n");
+    if (ALLOCATIONS_TRACKED)
+    {
+        printf("      \"allocations\": {\"startup\": %llu, \"startup_bytes\": %llu, "
+               "\"frames\": %llu, \"frames_bytes\": %llu, \"max_per_frame\": %llu},\n",
+               (unsigned long long)result->startup_allocations.count,
+               (unsigned long long)result->startup_allocations.bytes,
+               (unsigned long long)result->frame_allocations.count,
+               (unsigned long long)result->frame_allocations.bytes,
+               (unsigned long long)result->max_frame_allocations);
+    }
+    else
+    {
+        printf("      \"allocations\": null,\n");
+    }
+    printf("      \"render\": {\"recorded_frames\": %llu, \"replayed_frames\": %llu, "
+           "\"partial_repaints\": %llu, \"full_repaints\": %llu},\n",
+           (unsigned long long)result->render.recorded_frames,
+           (unsigned long long)result->render.replayed_frames,
+           (unsigned long long)result->render.partial_repaint_frames,
+           (unsigned long long)result->render.full_repaint_frames);
+    // Per-frame mean and worst frame of the SDL calls issued by ui_render.
+    const double frames = result->frame.sample_count > 0U ? (double)result->frame.sample_count : 1.0;
+    printf("      \"render_calls\": {");
+    print_render_calls_json("mean", &result->render_calls, frames);
+    printf(", ");
+    print_render_calls_json("max", &result->max_frame_render_calls, 1.0);
+    printf("}\n    }");
+}
+
+static bool within_budget(const char *page_id, const page_result *result,
+                          const bench_options *options)
+{
+    bool ok = true;
+    if (options->max_p95_ms > 0.0 && result->frame.p95_ms > options->max_p95_ms)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: frame p95 %.3f ms exceeds %.3f ms",
+                     page_id, result->frame.p95_ms, options->max_p95_ms);
+        ok = false;
+    }
+    if (ALLOCATIONS_TRACKED && options->max_frame_allocations >= 0 &&
+        result->max_frame_allocations > (Uint64)options->max_frame_allocations)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %llu allocations in one frame exceed %lld",
+                     page_id, (unsigned long long)result->max_frame_allocations,
+                     options->max_frame_allocations);
+        ok = false;
+    }
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    bench_options options = {
+        .page_id = NULL,
+        .width = DEFAULT_WIDTH,
+        .height = DEFAULT_HEIGHT,
+        .frames = DEFAULT_FRAMES,
+        .warmup_frames = DEFAULT_WARMUP_FRAMES,
+        .max_p95_ms = 0.0,
+        .max_frame_allocations = -1,
+        .page_option_count = 0U,
+    };
+    if (!parse_options(argc, argv, &options))
+    {
+        log_usage(argv[0]);
+        return 1;
+    }
+
+    // An SDL_VIDEO_DRIVER environment variable wins over this hint.
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen,dummy");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init failed: %s", SDL_GetError());
+        return 1;
+    }
+
+    // Heap-allocated: the profiler's ring buffers are large.
+    ui_frame_profiler *profiler = malloc(sizeof(*profiler));
+    if (profiler == NULL)
+    {
+        SDL_Quit();
+        return 1;
+    }
+
+    printf("{\n  \"video_driver\": \"%s\",\n  \"renderer\": \"%s\",\n", SDL_GetCurrentVideoDriver(),
+           SDL_SOFTWARE_RENDERER);
+    printf("  \"width\": %d,\n  \"height\": %d,\n  \"frames\": %d,\n  \"warmup_frames\": %d,\n",
+           options.width, options.height, options.frames, options.warmup_frames);
+    printf("  \"delta_ms\": %.4f,\n  \"pages\": [\n", (double)FRAME_DELTA_SECONDS * 1000.0);
+
+    bool ok = true;
+    size_t pages_run = 0U;
+    for (size_t i = 0U; i < app_page_count; ++i)
+    {
+        const app_page_entry *page = &app_pages[i];
+        if (options.page_id != NULL && strcmp(options.page_id, page->id) != 0)
+        {
+            continue;
+        }
+
+        page_result result;
+        SDL_zero(result);
+        if (!run_page(page, &options, profiler, &result))
+        {
+            ok = false;
+            continue;
+        }
+
+        if (pages_run > 0U)
+        {
+            printf(",\n");
+        }
+        print_page_json(page->id, &result);
+        pages_run++;
+        ok = within_budget(page->id, &result, &options) && ok;
+    }
+    printf("\n  ]\n}\n");
+
+    if (pages_run == 0U && options.page_id != NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown page id: %s", options.page_id);
+        ok = false;
+    }
+
+    free(profiler);
+    SDL_Quit();
+    return ok ? 0 : 1;
+}
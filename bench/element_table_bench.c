@@ -0,0 +1,192 @@
+#include "system/ui_runtime.h"
+#include "ui/ui_element.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Compares ui_runtime's two element layouts over 100k top-level elements:
+ * "pointers" filters by dereferencing each registered element (and routes
+ * pointer events through hit_index), "table" filters on the packed element
+ * table and its vectorized point-in-rect scan.
+ *
+ * Elements are separate heap blocks padded to a typical widget size so the
+ * pointer layout pays the cache misses real widget trees do. A quarter of
+ * them are hidden and an eighth disabled so the filters have work to do.
+ *
+ * "sync us" is the one-off cost of refreshing every table row after an
+ * invalidation; the table pays it on the first pass after anything changes,
+ * where the grid pays its own rebuild on the first pointer query.
+ */
+
+static const size_t ELEMENT_COUNT = 100000U;
+static const size_t PASS_COUNT = 50U;
+static const size_t EVENT_COUNT = 2000U;
+static const size_t GRID_COLUMNS = 400U;
+static const float CELL_SIZE = 10.0F;
+
+typedef struct bench_element
+{
+    ui_element base;
+    Uint64 updates;
+    Uint64 renders;
+    Uint64 events;
+    unsigned char widget_state[160];
+} bench_element;
+
+static bool handle_bench_event(ui_element *element, const SDL_Event *event)
+{
+    (void)event;
+    ((bench_element *)element)->events++;
+    return true;
+}
+
+static void update_bench_element(ui_element *element, float delta_seconds)
+{
+    (void)delta_seconds;
+    ((bench_element *)element)->updates++;
+}
+
+static void render_bench_element(const ui_element *element, SDL_Renderer *renderer)
+{
+    (void)renderer;
+    ((bench_element *)element)->renders++;
+}
+
+static void destroy_bench_element(ui_element *element) { free(element); }
+
+static const ui_element_ops BENCH_ELEMENT_OPS = {
+    .handle_event = handle_bench_event,
+    .update = update_bench_element,
+    .render = render_bench_element,
+    .destroy = destroy_bench_element,
+};
+
+static double ticks_to_us(Uint64 ticks)
+{
+    return (double)ticks * 1000000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+static bool populate(ui_runtime *context)
+{
+    for (size_t i = 0U; i < ELEMENT_COUNT; ++i)
+    {
+        bench_element *element = calloc(1U, sizeof(*element));
+        if (element == NULL)
+        {
+            return false;
+        }
+
+        element->base.rect = (SDL_FRect){(float)(i % GRID_COLUMNS) * CELL_SIZE,
+                                         (float)(i / GRID_COLUMNS) * CELL_SIZE, CELL_SIZE - 1.0F,
+                                         CELL_SIZE - 1.0F};
+        element->base.ops = &BENCH_ELEMENT_OPS;
+        element->base.visible = (i % 4U) != 0U;
+        element->base.enabled = (i % 8U) != 1U;
+        element->base.align_h = UI_ALIGN_LEFT;
+        element->base.align_v = UI_ALIGN_TOP;
+        ui_element_reset_layout_cache(&element->base);
+        if (!ui_runtime_add(context, &element->base))
+        {
+            free(element);
+            return false;
+        }
+    }
+    return true;
+}
+
+static SDL_FPoint next_point(Uint32 *state)
+{
+    // xorshift32: deterministic pointer positions without pulling in rand().
+    *state ^= *state << 13U;
+    *state ^= *state >> 17U;
+    *state ^= *state << 5U;
+    const float width = (float)GRID_COLUMNS * CELL_SIZE;
+    const float height = (float)(ELEMENT_COUNT / GRID_COLUMNS) * CELL_SIZE;
+    const float u = (float)(*state & 0xFFFFU) / 65535.0F;
+    const float v = (float)((*state >> 16U) & 0xFFFFU) / 65535.0F;
+    return (SDL_FPoint){u * width, v * height};
+}
+
+static void run_layout(ui_runtime *context, SDL_Renderer *renderer, bool use_table)
+{
+    ui_runtime_set_element_table(context, use_table);
+
+    // Prime the table rows or the grid so the timed loops see steady state.
+    ui_element_invalidate_render(NULL);
+    const Uint64 sync_start = SDL_GetPerformanceCounter();
+    ui_runtime_update(context, 0.0F);
+    const Uint64 sync_ticks = SDL_GetPerformanceCounter() - sync_start;
+
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = SDL_EVENT_MOUSE_WHEEL;
+    ui_runtime_handle_event(context, &event);
+
+    const Uint64 update_start = SDL_GetPerformanceCounter();
+    for (size_t i = 0U; i < PASS_COUNT; ++i)
+    {
+        ui_runtime_update(context, 0.016F);
+    }
+    const Uint64 update_ticks = SDL_GetPerformanceCounter() - update_start;
+
+    const Uint64 render_start = SDL_GetPerformanceCounter();
+    for (size_t i = 0U; i < PASS_COUNT; ++i)
+    {
+        ui_runtime_render(context, renderer);
+    }
+    const Uint64 render_ticks = SDL_GetPerformanceCounter() - render_start;
+
+    // Wheel events are routed like motion but skip hover tracking, which
+    // would otherwise dominate the measurement.
+    Uint32 state = 0x9E3779B9U;
+    const Uint64 dispatch_start = SDL_GetPerformanceCounter();
+    for (size_t i = 0U; i < EVENT_COUNT; ++i)
+    {
+        const SDL_FPoint point = next_point(&state);
+        event.wheel.mouse_x = point.x;
+        event.wheel.mouse_y = point.y;
+        ui_runtime_handle_event(context, &event);
+    }
+    const Uint64 dispatch_ticks = SDL_GetPerformanceCounter() - dispatch_start;
+
+    printf("%8s %14.1f %14.1f %18.3f %10.1f\n", use_table ? "table" : "pointers",
+           ticks_to_us(update_ticks) / (double)PASS_COUNT,
+           ticks_to_us(render_ticks) / (double)PASS_COUNT,
+           ticks_to_us(dispatch_ticks) / (double)EVENT_COUNT, ticks_to_us(sync_ticks));
+}
+
+int main(void)
+{
+    SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = surface != NULL ? SDL_CreateSoftwareRenderer(surface) : NULL;
+    if (renderer == NULL)
+    {
+        fprintf(stderr, "failed to create software renderer\n");
+        SDL_DestroySurface(surface);
+        return 1;
+    }
+
+    ui_runtime context;
+    ui_runtime_init(&context);
+    // Immediate mode so every render pass walks the element list.
+    ui_runtime_set_retained_rendering(&context, false);
+    if (!populate(&context))
+    {
+        fprintf(stderr, "failed to build %zu elements\n", ELEMENT_COUNT);
+        ui_runtime_destroy(&context);
+        return 1;
+    }
+
+    printf("%zu elements, %zu update/render passes, %zu pointer events\n", ELEMENT_COUNT,
+           PASS_COUNT, EVENT_COUNT);
+    printf("%8s %14s %14s %18s %10s\n", "layout", "update us", "render us", "dispatch us/event",
+           "sync us");
+    run_layout(&context, renderer, false);
+    run_layout(&context, renderer, true);
+
+    ui_runtime_destroy(&context);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "system/ui_traversal.h"
+#include "ui/ui_button.h"
+#include "ui/ui_element.h"
+#include "ui/ui_window.h"
+
+#include <stdio.h>
+
+/*
+ * Measures mouse-motion dispatch cost through a ui_window holding a large grid
+ * of buttons, which routes pointer events through its spatial hit index.
+ *
+ * The "linear" column repeats the same lookups with the old back-to-front
+ * scan over every child for comparison: it grows with child count while the
+ * indexed column should stay roughly flat. The "rebuild" column is the one-off
+ * cost paid on the first event after an arrange invalidates the grid.
+ */
+
+static const size_t COUNTS[] = {1000U, 10000U, 50000U};
+static const size_t EVENT_COUNT = 20000U;
+static const float CELL_SIZE = 10.0F;
+static const size_t GRID_COLUMNS = 250U;
+
+static double ticks_to_us(Uint64 ticks)
+{
+    return (double)ticks * 1000000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+static ui_window *build_window(size_t count)
+{
+    const size_t rows = (count + GRID_COLUMNS - 1U) / GRID_COLUMNS;
+    ui_window *window = ui_window_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, (float)GRID_COLUMNS * CELL_SIZE, (float)rows * CELL_SIZE});
+    if (window == NULL)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0U; i < count; ++i)
+    {
+        const SDL_FRect rect = {(float)(i % GRID_COLUMNS) * CELL_SIZE,
+                                (float)(i / GRID_COLUMNS) * CELL_SIZE, CELL_SIZE - 1.0F,
+                                CELL_SIZE - 1.0F};
+        ui_button *button = ui_button_create(NULL, &rect, (SDL_Color){200, 200, 200, 255},
+                                             (SDL_Color){120, 120, 120, 255}, "", NULL, NULL, NULL);
+        if (button == NULL || !ui_window_add_child(window, &button->base))
+        {
+            ui_traversal_destroy(&window->base);
+            return NULL;
+        }
+    }
+
+    return window;
+}
+
+static SDL_FPoint next_point(Uint32 *state, const SDL_FRect *bounds)
+{
+    // xorshift32: deterministic pointer positions without pulling in rand().
+    *state ^= *state << 13U;
+    *state ^= *state >> 17U;
+    *state ^= *state << 5U;
+    const float u = (float)(*state & 0xFFFFU) / 65535.0F;
+    const float v = (float)((*state >> 16U) & 0xFFFFU) / 65535.0F;
+    return (SDL_FPoint){bounds->x + (u * bounds->w), bounds->y + (v * bounds->h)};
+}
+
+int main(void)
+{
+    size_t sink = 0U;
+
+    printf("%8s %18s %18s %14s\n", "children", "indexed us/event", "linear us/event",
+           "rebuild us");
+
+    for (size_t c = 0U; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c)
+    {
+        ui_window *window = build_window(COUNTS[c]);
+        if (window == NULL)
+        {
+            fprintf(stderr, "failed to build %zu children\n", COUNTS[c]);
+            return 1;
+        }
+
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+
+        // First dispatch after invalidation pays for the grid build.
+        ui_element_invalidate_screen_rects();
+        const Uint64 rebuild_start = SDL_GetPerformanceCounter();
+        sink += window->base.ops->handle_event(&window->base, &event) ? 1U : 0U;
+        const Uint64 rebuild_ticks = SDL_GetPerformanceCounter() - rebuild_start;
+
+        Uint32 state = 0x9E3779B9U;
+        const Uint64 indexed_start = SDL_GetPerformanceCounter();
+        for (size_t i = 0U; i < EVENT_COUNT; ++i)
+        {
+            const SDL_FPoint point = next_point(&state, &window->base.rect);
+            event.motion.x = point.x;
+            event.motion.y = point.y;
+            sink += window->base.ops->handle_event(&window->base, &event) ? 1U : 0U;
+        }
+        const Uint64 indexed_ticks = SDL_GetPerformanceCounter() - indexed_start;
+
+        state = 0x9E3779B9U;
+        const Uint64 linear_start = SDL_GetPerformanceCounter();
+        for (size_t i = 0U; i < EVENT_COUNT; ++i)
+        {
+            const SDL_FPoint point = next_point(&state, &window->base.rect);
+            for (size_t j = window->child_count; j > 0U; --j)
+            {
+                ui_element *child = window->children[j - 1U];
+                if (ui_element_hit_test(child, &point))
+                {
+                    sink += child->ops->handle_event(child, &event) ? 1U : 0U;
+                    break;
+                }
+            }
+        }
+        const Uint64 linear_ticks = SDL_GetPerformanceCounter() - linear_start;
+
+        printf("%8zu %18.3f %18.3f %14.1f\n", COUNTS[c],
+               ticks_to_us(indexed_ticks) / (double)EVENT_COUNT,
+               ticks_to_us(linear_ticks) / (double)EVENT_COUNT, ticks_to_us(rebuild_ticks));
+
+        ui_traversal_destroy(&window->base);
+    }
+
+    /* Keep the optimizer from discarding the dispatches. */
+    return sink == (size_t)-1 ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+#include "system/ui_traversal.h"
+#include "ui/ui_element.h"
+#include "ui/ui_layout_container.h"
+#include "ui/ui_pane.h"
+
+#include <stdio.h>
+
+/*
+ * Measures the per-frame cost of resolving window-space rects for every leaf
+ * of a tree whose leaves sit at the bottom of a chain of nested containers.
+ *
+ * Each simulated frame invalidates the screen-rect cache (as an arrange pass
+ * would) and then resolves all leaf rects twice (one render lookup plus one
+ * hit-test lookup). The "uncached" column repeats the same lookups with the
+ * old recursive parent walk for comparison: it grows linearly with depth while
+ * the cached column should stay flat.
+ */
+
+static const size_t LEAF_COUNT = 256U;
+static const size_t FRAME_COUNT = 400U;
+static const size_t DEPTHS[] = {1U, 2U, 4U, 8U, 16U, 32U, 64U, 128U};
+
+static SDL_FRect reference_screen_rect(const ui_element *element)
+{
+    if (element->parent == NULL)
+    {
+        return element->rect;
+    }
+
+    const SDL_FRect parent_sr = reference_screen_rect(element->parent);
+    return (SDL_FRect){parent_sr.x + element->rect.x, parent_sr.y + element->rect.y,
+                       element->rect.w, element->rect.h};
+}
+
+static ui_layout_container *build_chain(size_t depth, ui_element **leaves)
+{
+    ui_layout_container *root = ui_layout_container_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, 4096.0F, 4096.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    if (root == NULL)
+    {
+        return NULL;
+    }
+
+    ui_layout_container *tail = root;
+    for (size_t level = 1U; level < depth; ++level)
+    {
+        ui_layout_container *next = ui_layout_container_create(
+            NULL, &(SDL_FRect){0.0F, 0.0F, 4096.0F, 4096.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+        if (next == NULL || !ui_layout_container_add_child(tail, &next->base))
+        {
+            ui_traversal_destroy(&root->base);
+            return NULL;
+        }
+        tail = next;
+    }
+
+    for (size_t i = 0U; i < LEAF_COUNT; ++i)
+    {
+        ui_pane *leaf = ui_pane_create(NULL, &(SDL_FRect){0.0F, 0.0F, 8.0F, 8.0F},
+                                       (SDL_Color){0, 0, 0, 255}, NULL);
+        if (leaf == NULL || !ui_layout_container_add_child(tail, &leaf->base))
+        {
+            ui_traversal_destroy(&root->base);
+            return NULL;
+        }
+        leaves[i] = &leaf->base;
+    }
+
+    ui_element_measure(&root->base, &root->base.rect);
+    ui_element_arrange(&root->base, &root->base.rect);
+    return root;
+}
+
+static double ticks_to_us(Uint64 ticks)
+{
+    return (double)ticks * 1000000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+int main(void)
+{
+    ui_element *leaves[256];
+    float sink = 0.0F;
+
+    printf("%8s %18s %18s\n", "depth", "cached us/frame", "uncached us/frame");
+
+    for (size_t d = 0U; d < sizeof(DEPTHS) / sizeof(DEPTHS[0]); ++d)
+    {
+        ui_layout_container *root = build_chain(DEPTHS[d], leaves);
+        if (root == NULL)
+        {
+            fprintf(stderr, "failed to build depth %zu\n", DEPTHS[d]);
+            return 1;
+        }
+
+        const Uint64 cached_start = SDL_GetPerformanceCounter();
+        for (size_t frame = 0U; frame < FRAME_COUNT; ++frame)
+        {
+            ui_element_invalidate_screen_rects();
+            for (size_t pass = 0U; pass < 2U; ++pass)
+            {
+                for (size_t i = 0U; i < LEAF_COUNT; ++i)
+                {
+                    sink += ui_element_screen_rect(leaves[i]).y;
+                }
+            }
+        }
+        const Uint64 cached_ticks = SDL_GetPerformanceCounter() - cached_start;
+
+        const Uint64 uncached_start = SDL_GetPerformanceCounter();
+        for (size_t frame = 0U; frame < FRAME_COUNT; ++frame)
+        {
+            for (size_t pass = 0U; pass < 2U; ++pass)
+            {
+                for (size_t i = 0U; i < LEAF_COUNT; ++i)
+                {
+                    sink += reference_screen_rect(leaves[i]).y;
+                }
+            }
+        }
+        const Uint64 uncached_ticks = SDL_GetPerformanceCounter() - uncached_start;
+
+        printf("%8zu %18.2f %18.2f\n", DEPTHS[d], ticks_to_us(cached_ticks) / (double)FRAME_COUNT,
+               ticks_to_us(uncached_ticks) / (double)FRAME_COUNT);
+
+        ui_traversal_destroy(&root->base);
+    }
+
+    /* Keep the optimizer from discarding the lookups. */
+    return sink < 0.0F ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+#include "util/string_util.h"
+
+#include <SDL3/SDL.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Times string_util's UTF-8 scans against the per-codepoint decode loop they
+ * replace (SDL_StepUTF8, the decoder SDL_RenderDebugText uses) on 4 MiB
+ * strings: pure ASCII, mostly ASCII with an accented letter every 16 bytes,
+ * and CJK-heavy text (three-byte codepoints).
+ *
+ * "prefix" finds the byte offset of the codepoint three quarters of the way
+ * in, as text input truncation does.
+ */
+
+static const size_t TEXT_BYTES = 4U * 1024U * 1024U;
+static const size_t PASS_COUNT = 20U;
+
+typedef struct bench_corpus
+{
+    const char *name;
+    const char *pattern;
+} bench_corpus;
+
+static double ticks_to_us(Uint64 ticks)
+{
+    return (double)ticks * 1000000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+static char *fill_text(const char *pattern, size_t *out_length)
+{
+    const size_t pattern_length = strlen(pattern);
+    const size_t repeats = TEXT_BYTES / pattern_length;
+    char *text = malloc((repeats * pattern_length) + 1U);
+    if (text == NULL)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0U; i < repeats; ++i)
+    {
+        memcpy(text + (i * pattern_length), pattern, pattern_length);
+    }
+    text[repeats * pattern_length] = '\0';
+    *out_length = repeats * pattern_length;
+    return text;
+}
+
+static size_t count_step_utf8(const char *text, size_t length)
+{
+    size_t count = 0U;
+    while (length > 0U && SDL_StepUTF8(&text, &length) != 0U)
+    {
+        count++;
+    }
+    return count;
+}
+
+static void run_corpus(const bench_corpus *corpus)
+{
+    size_t length = 0U;
+    char *text = fill_text(corpus->pattern, &length);
+    if (text == NULL)
+    {
+        fprintf(stderr, "failed to allocate %zu bytes\n", TEXT_BYTES);
+        return;
+    }
+
+    // Accumulated so the compiler cannot drop the scans.
+    size_t sink = 0U;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (size_t i = 0U; i < PASS_COUNT; ++i)
+    {
+        sink += count_step_utf8(text, length);
+    }
+    const Uint64 step_ticks = SDL_GetPerformanceCounter() - start;
+
+    start = SDL_GetPerformanceCounter();
+    for (size_t i = 0U; i < PASS_COUNT; ++i)
+    {
+        sink += utf8_is_valid(text, length) ? 1U : 0U;
+    }
+    const Uint64 valid_ticks = SDL_GetPerformanceCounter() - start;
+
+    size_t codepoints = 0U;
+    start = SDL_GetPerformanceCounter();
+    for (size_t i = 0U; i < PASS_COUNT; ++i)
+    {
+        codepoints = utf8_count_codepoints(text, length);
+        sink += codepoints;
+    }
+    const Uint64 count_ticks = SDL_GetPerformanceCounter() - start;
+
+    start = SDL_GetPerformanceCounter();
+    for (size_t i = 0U; i < PASS_COUNT; ++i)
+    {
+        sink += utf8_prefix_bytes(text, length, (codepoints / 4U) * 3U);
+    }
+    const Uint64 prefix_ticks = SDL_GetPerformanceCounter() - start;
+
+    const double mib = (double)length / (1024.0 * 1024.0);
+    printf("%-8s %10zu %12.0f %12.0f %12.0f %12.0f\n", corpus->name, codepoints,
+           mib * PASS_COUNT / (ticks_to_us(step_ticks) / 1000000.0),
+           mib * PASS_COUNT / (ticks_to_us(valid_ticks) / 1000000.0),
+           mib * PASS_COUNT / (ticks_to_us(count_ticks) / 1000000.0),
+           mib * PASS_COUNT / (ticks_to_us(prefix_ticks) / 1000000.0));
+    if (sink == 0U)
+    {
+        printf("(empty)\n");
+    }
+    free(text);
+}
+
+int main(void)
+{
+    static const bench_corpus CORPORA[] = {
+        {"ascii", "Buy milk and eggs before the store closes tonight. "},
+        {"latin1", "Caf\xC3\xA9 cr\xC3\xA8me br\xC3\xBBl\xC3\xA9"
+                   "e na\xC3\xAFve r\xC3\xA9sum\xC3\xA9 "},
+        {"cjk", "\xE8\xB2\xB7\xE3\x81\x84\xE7\x89\xA9\xE3\x83\xAA\xE3\x82\xB9\xE3\x83\x88 "},
+    };
+
+    printf("utf8 backend: %s, %zu MiB x %zu passes\n", utf8_simd_backend(),
+           TEXT_BYTES / (1024U * 1024U), PASS_COUNT);
+    printf("%-8s %10s %12s %12s %12s %12s\n", "corpus", "codepoints", "step MiB/s", "valid MiB/s",
+           "count MiB/s", "prefix MiB/s");
+    for (size_t i = 0U; i < SDL_arraysize(CORPORA); ++i)
+    {
+        run_corpus(&CORPORA[i]);
+    }
+    return 0;
+}
@@ -67,6 +67,28 @@ typedef struct app_page_ops
      */
     bool (*update)(void *page_instance);
 
+    /*
+     * Optional: accept one page-specific startup option before `create`.
+     *
+     * Parameters:
+     * - `option`: option name as given on the command line (`--stress-count`).
+     * - `value`: the argument that followed it.
+     *
+     * Return value:
+     * - true when the option is known and its value valid. Startup fails
+     *   otherwise, as it does for pages without this callback.
+     */
+    bool (*configure)(const char *option, const char *value);
+
+    /*
+     * Optional: seconds until `update` next needs to run without input (for
+     * example a clock tick). NULL or UI_NO_FRAME_REQUEST means never.
+     *
+     * Parameters:
+     * - `page_instance`: page created by `create`.
+     */
+    float (*next_frame_delay)(void *page_instance);
+
     /*
      * Destroy page instance and release all owned resources.
      *
@@ -6,7 +6,8 @@
 
 #include <stddef.h>
 
-#define APP_PAGE_SHELL_MAX_REGISTERED_ELEMENTS 64U
+// Registrations tracked without allocating; more spill to a heap array.
+#define APP_PAGE_SHELL_INLINE_REGISTERED_ELEMENTS 64U
 
 /*
  * Shared page runtime shell used by concrete app pages.
@@ -19,13 +20,22 @@
  * - Every page initializes this shell once during create.
  * - The shell always owns a `ui_window` root that is registered in runtime.
  * - Additional page-owned top-level elements can be registered via this shell.
+ * - `allocator` is the page's widget allocator (NULL for malloc). Pages pass
+ *   it to every `*_create` call so the whole tree shares one memory source.
+ * - `registered_elements` points at `inline_registered` until a page registers
+ *   more than APP_PAGE_SHELL_INLINE_REGISTERED_ELEMENTS elements; it then moves
+ *   to a malloc'd array that app_page_shell_unregister_all releases. An
+ *   initialized shell must therefore not be copied or moved.
  */
 typedef struct app_page_shell
 {
     ui_runtime *context;
+    const cui_allocator *allocator;
     ui_window *window_root;
-    ui_element *registered_elements[APP_PAGE_SHELL_MAX_REGISTERED_ELEMENTS];
+    ui_element **registered_elements;
     size_t registered_count;
+    size_t registered_capacity;
+    ui_element *inline_registered[APP_PAGE_SHELL_INLINE_REGISTERED_ELEMENTS];
 } app_page_shell;
 
 /*
@@ -36,10 +46,13 @@ typedef struct app_page_shell
  * - `context`: destination runtime that owns registered elements.
  * - `viewport_width`: initial root width in logical pixels (> 0).
  * - `viewport_height`: initial root height in logical pixels (> 0).
+ * - `allocator`: widget allocator for the page (NULL for malloc). It must
+ *   outlive app_page_shell_unregister_all.
  * - `page_name`: page identifier used in fail-fast logs.
  */
 void app_page_shell_init(app_page_shell *shell, ui_runtime *context, int viewport_width,
-                         int viewport_height, const char *page_name);
+                         int viewport_height, const cui_allocator *allocator,
+                         const char *page_name);
 
 /*
  * Register one page-owned top-level element in runtime and track it.
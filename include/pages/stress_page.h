@@ -0,0 +1,111 @@
+#ifndef STRESS_PAGE_H
+#define STRESS_PAGE_H
+
+#include <SDL3/SDL.h>
+
+#include "pages/app_page.h"
+#include "system/ui_runtime.h"
+
+/*
+ * Opaque stress-page state object.
+ *
+ * The page builds a synthetic widget tree of configurable size and shape as a
+ * standard workload for profiling layout, dispatch and render scaling.
+ */
+typedef struct stress_page stress_page;
+
+/*
+ * Shape of the generated tree, set from startup options through
+ * stress_page_configure before the page is created.
+ *
+ * - element_count: widgets and containers created in total (scroll-view
+ *   leaves count together with the text they wrap).
+ * - depth: container nesting levels; level 1 holds the top-level containers,
+ *   which are registered in ui_runtime directly rather than under the window.
+ * - fanout: children per container above the deepest level; the deepest
+ *   containers take whatever leaves remain.
+ * - animated_fraction: share of animatable leaves (text, slider, checkbox,
+ *   segment group, pane) changed by every update.
+ */
+typedef struct stress_page_config
+{
+    size_t element_count;
+    size_t depth;
+    size_t fanout;
+    float animated_fraction;
+} stress_page_config;
+
+/*
+ * Apply one startup option to the configuration used by the next
+ * stress_page_create call.
+ *
+ * Options: --stress-count <n>, --stress-depth <n>, --stress-fanout <n>,
+ * --stress-animated <fraction 0..1>.
+ *
+ * Return value:
+ * - true when option is known and value is in range; the configuration is
+ *   left unchanged otherwise.
+ */
+bool stress_page_configure(const char *option, const char *value);
+
+/*
+ * Create and register the stress page in the provided UI context.
+ *
+ * Behavior/contract:
+ * - Builds the tree described by the current configuration. Registers the
+ *   window root plus one top-level container per level-1 subtree, so fanout
+ *   may exceed APP_PAGE_SHELL_INLINE_REGISTERED_ELEMENTS.
+ * - On unrecoverable internal failure (allocation/creation/registration),
+ *   the page logs a critical error and aborts the process (fail-fast policy).
+ *
+ * Parameters:
+ * - `window`: SDL window whose renderer loads image widgets; also used by
+ *   text inputs.
+ * - `context`: destination UI runtime that will own registered elements.
+ * - `viewport_width`: initial logical viewport width in pixels.
+ * - `viewport_height`: initial logical viewport height in pixels.
+ *
+ * Ownership/lifecycle:
+ * - Caller owns the returned page object and must destroy it with
+ *   `stress_page_destroy`.
+ */
+stress_page *stress_page_create(SDL_Window *window, ui_runtime *context, int viewport_width,
+                                int viewport_height);
+
+/*
+ * Spread the top-level containers over the new viewport.
+ *
+ * Return value:
+ * - true on success.
+ * - This function follows fail-fast semantics for invalid state.
+ */
+bool stress_page_resize(stress_page *page, int viewport_width, int viewport_height);
+
+/*
+ * Advance the animated leaves by one frame.
+ *
+ * Return value:
+ * - true when update succeeds.
+ * - This function follows fail-fast semantics for invalid state.
+ */
+bool stress_page_update(stress_page *page);
+
+/*
+ * Destroy a stress page and every widget it created.
+ *
+ * Ownership/lifecycle:
+ * - After this call, `page` is invalid and must not be reused.
+ */
+void stress_page_destroy(stress_page *page);
+
+/*
+ * Stress page lifecycle callbacks exported for build-generated page discovery.
+ *
+ * Behavior/contract:
+ * - Forward to `stress_page_configure`, `stress_page_create`,
+ *   `stress_page_resize`, `stress_page_update`, and `stress_page_destroy`.
+ * - Page id is derived by CMake from `stress_page.c` filename.
+ */
+extern const app_page_ops stress_page_ops;
+
+#endif
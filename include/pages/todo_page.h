@@ -14,6 +14,18 @@
  */
 typedef struct todo_page todo_page;
 
+/*
+ * Apply one startup option to the next todo_page_create call.
+ *
+ * Options: --todo-count <n> seeds n demo tasks instead of ten (0..1000000),
+ * for exercising the task list at large counts.
+ *
+ * Return value:
+ * - true when option is known and value is in range; the configuration is
+ *   left unchanged otherwise.
+ */
+bool todo_page_configure(const char *option, const char *value);
+
 /*
  * Create and register the todo page in the provided UI context.
  *
@@ -92,12 +104,36 @@ bool todo_page_resize(todo_page *page, int viewport_width, int viewport_height);
  */
 bool todo_page_update(todo_page *page);
 
+/*
+ * Return the number of tasks in the page model, whatever the active filter.
+ */
+size_t todo_page_task_count(const todo_page *page);
+
+/*
+ * Read task index (0-based, in insertion order) from the page model.
+ *
+ * Behavior/contract:
+ * - Any output pointer may be NULL. Strings stay valid until the task is
+ *   removed or the page is destroyed.
+ * - Returns false, leaving outputs untouched, when index is out of range.
+ *
+ * Together with todo_page_header_text this exposes everything a recorded
+ * session changes, so a replay can be checked against its recording.
+ */
+bool todo_page_get_task(const todo_page *page, size_t index, const char **out_title,
+                        const char **out_due_time, bool *out_is_done);
+
+/*
+ * Return the header clock text as last shown, or NULL for a NULL page.
+ */
+const char *todo_page_header_text(const todo_page *page);
+
 /*
  * Destroy a todo page and release its resources.
  *
  * Purpose:
  * - Unregister and destroy all page elements from their `ui_runtime`.
- * - Free todo model storage and callback context arrays.
+ * - Free todo model storage and task row bookkeeping.
  * - Free the page object itself.
  *
  * Parameters:
@@ -117,8 +153,8 @@ void todo_page_destroy(todo_page *page);
  *   interface used by command-line page selection.
  *
  * Behavior/contract:
- * - Lifecycle callbacks forward to `todo_page_create`, `todo_page_resize`,
- *   `todo_page_update`, and `todo_page_destroy`.
+ * - Lifecycle callbacks forward to `todo_page_configure`, `todo_page_create`,
+ *   `todo_page_resize`, `todo_page_update`, and `todo_page_destroy`.
  * - Page id is derived by CMake from `todo_page.c` filename.
  *
  * Ownership/lifecycle:
@@ -0,0 +1,56 @@
+#ifndef UI_CLOCK_H
+#define UI_CLOCK_H
+
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+
+/*
+ * Process-wide time source for page logic.
+ *
+ * Why this exists: pages that read the wall clock or seed pseudo-random state
+ * from it (todo_page's header clock and random due times) make every run
+ * different. Recorded sessions only replay bit-for-bit when those reads come
+ * from a clock that main.c drives one frame at a time.
+ *
+ * Behavior/contract:
+ * - By default the clock is real: reads forward to SDL_GetCurrentTime and
+ *   SDL_GetTicksNS.
+ * - ui_clock_use_virtual pins both readings; from then on they only move
+ *   through ui_clock_advance, which main.c calls once per frame.
+ * - Single-threaded, like the rest of the UI; not safe to call concurrently.
+ */
+
+/*
+ * Switch to a virtual clock starting at the given wall-clock time (nanoseconds
+ * since the Unix epoch) and monotonic tick count.
+ */
+void ui_clock_use_virtual(SDL_Time wall_start_ns, Uint64 ticks_start_ns);
+
+/*
+ * Return to the real clock. Virtual readings are discarded.
+ */
+void ui_clock_use_real(void);
+
+/*
+ * Return true while the virtual clock is active.
+ */
+bool ui_clock_is_virtual(void);
+
+/*
+ * Move the virtual clock forward by delta_ns. No-op on the real clock.
+ */
+void ui_clock_advance(Uint64 delta_ns);
+
+/*
+ * Return wall-clock time in nanoseconds since the Unix epoch, or 0 if the
+ * real clock cannot be read.
+ */
+SDL_Time ui_clock_wall_ns(void);
+
+/*
+ * Return monotonic time in nanoseconds.
+ */
+Uint64 ui_clock_ticks_ns(void);
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef UI_ELEMENT_TABLE_H
+#define UI_ELEMENT_TABLE_H
+
+#include "ui/ui_element.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Row flags mirrored from each element. Filtering loops compare a row's flags
+ * against a required mask instead of dereferencing the element.
+ */
+#define UI_ELEMENT_TABLE_VISIBLE 0x01U
+#define UI_ELEMENT_TABLE_ENABLED 0x02U
+#define UI_ELEMENT_TABLE_HANDLES_EVENTS 0x04U
+#define UI_ELEMENT_TABLE_UPDATES 0x08U
+#define UI_ELEMENT_TABLE_RENDERS 0x10U
+// Has children or finish_render: update/render go through ui_traversal.
+#define UI_ELEMENT_TABLE_SUBTREE 0x20U
+
+/*
+ * Struct-of-arrays copy of the per-element fields that ui_runtime's update,
+ * render and pointer loops filter on, kept parallel to one element array.
+ *
+ * Why this exists: those loops used to chase every element pointer into its
+ * widget allocation just to read visible/enabled/ops and the rect. With the
+ * fields packed into contiguous arrays, the loops only touch the elements that
+ * survive filtering, and point-in-rect rejection runs four rows per step.
+ *
+ * Behavior/contract:
+ * - Row i describes elements[i]. The owner keeps rows in step with the array
+ *   through insert/clear/truncate/rewrite, exactly as it maintains the array
+ *   itself; a NULL slot gets an empty row.
+ * - Rows are refreshed lazily by ui_element_table_sync when the render
+ *   generation has moved since the last sync. Layout, scrolling and
+ *   ui_element_set_visible all bump it; code that writes visible/enabled
+ *   directly must call ui_element_invalidate_render afterwards.
+ * - Rects are window-space (ui_element_screen_rect), stored as separate
+ *   min/max arrays; like the spatial index, a custom hit_test op must not
+ *   report hits outside the element's rect.
+ */
+typedef struct ui_element_table
+{
+    float *min_x;
+    float *min_y;
+    float *max_x;
+    float *max_y;
+    Uint8 *flags;
+    const ui_element_ops **ops;
+    size_t count;
+    size_t capacity;
+    Uint64 synced_generation;
+} ui_element_table;
+
+/*
+ * Iteration state for one point query. Yields matching row indices from the
+ * last row to the first (topmost first); callers still run the exact hit test.
+ */
+typedef struct ui_element_table_cursor
+{
+    const ui_element_table *table;
+    SDL_FPoint point;
+    Uint8 required_flags;
+    size_t block_start;
+    unsigned int pending_mask;
+} ui_element_table_cursor;
+
+/*
+ * Initialize an empty table. Safe to call on zeroed memory.
+ */
+void ui_element_table_init(ui_element_table *table);
+
+/*
+ * Release table storage. Safe to call with NULL.
+ */
+void ui_element_table_destroy(ui_element_table *table);
+
+/*
+ * Insert a row for element at index (0..count), shifting later rows up.
+ * Returns false on allocation failure, leaving the table unchanged.
+ */
+bool ui_element_table_insert(ui_element_table *table, size_t index, const ui_element *element);
+
+/*
+ * Empty the row at index after the owner cleared that slot. Out-of-range is a
+ * no-op.
+ */
+void ui_element_table_clear(ui_element_table *table, size_t index);
+
+/*
+ * Drop every row from count on. No-op when count is not below the row count.
+ */
+void ui_element_table_truncate(ui_element_table *table, size_t count);
+
+/*
+ * Rewrite every row from elements[0..count) and drop the rows past count,
+ * after the owner compacted its array. count must not exceed the row count.
+ */
+void ui_element_table_rewrite(ui_element_table *table, ui_element *const *elements, size_t count);
+
+/*
+ * Refresh every row from elements[0..count) when the render generation
+ * changed since the last sync. count must match the table's row count.
+ */
+void ui_element_table_sync(ui_element_table *table, ui_element *const *elements, size_t count);
+
+/*
+ * Return the flags of row index (0 when out of range).
+ */
+Uint8 ui_element_table_flags(const ui_element_table *table, size_t index);
+
+/*
+ * Start a point query over all rows. Only rows whose flags include every bit
+ * of required_flags and whose rect contains point are yielded.
+ */
+void ui_element_table_query(const ui_element_table *table, const SDL_FPoint *point,
+                            Uint8 required_flags, ui_element_table_cursor *cursor);
+
+/*
+ * Advance cursor. Writes the next matching row index to out_index and returns
+ * true, or returns false when rows are exhausted.
+ */
+bool ui_element_table_cursor_next(ui_element_table_cursor *cursor, size_t *out_index);
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef UI_EVENT_LOG_H
+#define UI_EVENT_LOG_H
+
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Binary log of the SDL events fed to the UI, for deterministic replay.
+ *
+ * File layout (integers little-endian):
+ * - header: magic "CUIEVLOG", u32 format version, u32 SDL major.minor,
+ *   s64 wall-clock start (ns since epoch), u64 monotonic start (ns),
+ *   s32 viewport width, s32 viewport height.
+ * - records: u32 frame index, u64 timestamp (ns since start), u16 payload
+ *   size, then the event struct bytes for the event's type. Text input and
+ *   editing records append u16 length plus the UTF-8 text.
+ * - frame records: every frame starts with one, ahead of its events. Payload
+ *   size is 0 and the u64 holds the frame's clock delta instead of a
+ *   timestamp, so a replay advances ui_clock and update deltas exactly as the
+ *   recording did, idle gaps included.
+ *
+ * Event structs are stored in host layout, so a log replays only on the same
+ * architecture with the same SDL major.minor; readers reject other versions.
+ * Only event types the UI consumes are written (pointer, keyboard, text,
+ * window, render reset, quit). Other types are counted and skipped because
+ * they carry pointers that cannot be serialized.
+ */
+
+/*
+ * Session values stored in the log header.
+ *
+ * - wall_start_ns / ticks_start_ns: ui_clock readings when recording began.
+ * - width / height: initial logical viewport size.
+ */
+typedef struct ui_event_log_header
+{
+    SDL_Time wall_start_ns;
+    Uint64 ticks_start_ns;
+    int width;
+    int height;
+} ui_event_log_header;
+
+typedef struct ui_event_log_writer
+{
+    SDL_IOStream *stream;
+    Uint64 ticks_start_ns;
+    Uint64 written_events;
+    Uint64 skipped_events;
+    bool failed;
+} ui_event_log_writer;
+
+/*
+ * Reader with one record prefix (frame index, timestamp, size) read ahead, so
+ * main.c can ask for the events due in a frame without consuming later ones.
+ */
+typedef struct ui_event_log_reader
+{
+    SDL_IOStream *stream;
+    ui_event_log_header header;
+    Uint32 pending_frame;
+    // Event timestamp, or the frame delta of a frame record (pending_size 0).
+    Uint64 pending_timestamp_ns;
+    Uint16 pending_size;
+    bool has_pending;
+    bool failed;
+    char *text;
+    size_t text_capacity;
+    Uint64 read_events;
+} ui_event_log_reader;
+
+/*
+ * Create path and write the header.
+ *
+ * Return value:
+ * - true on success; false (with SDL_GetError set) if the file cannot be
+ *   created or written, leaving writer closed.
+ */
+bool ui_event_log_writer_open(ui_event_log_writer *writer, const char *path,
+                              const ui_event_log_header *header);
+
+/*
+ * Append one event received in frame_index at monotonic time timestamp_ns.
+ *
+ * Return value:
+ * - true when the event was written or skipped as unsupported.
+ * - false after a write error; later calls are ignored and also return false.
+ */
+bool ui_event_log_write(ui_event_log_writer *writer, Uint32 frame_index, Uint64 timestamp_ns,
+                        const SDL_Event *event);
+
+/*
+ * Append the frame record for frame_index, whose clock advanced by frame_ns.
+ * Call once per frame before writing that frame's events.
+ *
+ * Return value:
+ * - true when written; false after a write error, like ui_event_log_write.
+ */
+bool ui_event_log_write_frame(ui_event_log_writer *writer, Uint32 frame_index, Uint64 frame_ns);
+
+/*
+ * Flush and close the file. Returns false if any write failed. Safe to call
+ * on a closed writer.
+ */
+bool ui_event_log_writer_close(ui_event_log_writer *writer);
+
+/*
+ * Open path, validate the header and read the first record prefix.
+ *
+ * Return value:
+ * - true on success; false (with SDL_GetError set) on I/O error, bad magic or
+ *   an incompatible version, leaving reader closed.
+ */
+bool ui_event_log_reader_open(ui_event_log_reader *reader, const char *path);
+
+/*
+ * Read the next event recorded in a frame at or before frame_index.
+ *
+ * Behavior/contract:
+ * - Returns false when the next record belongs to a later frame, is a frame
+ *   record, at end of file, or after a read error (see `failed`).
+ * - Text pointers in out_event stay valid until the next call or close.
+ * - out_timestamp_ns may be NULL.
+ */
+bool ui_event_log_read(ui_event_log_reader *reader, Uint32 frame_index, SDL_Event *out_event,
+                       Uint64 *out_timestamp_ns);
+
+/*
+ * Read the frame record of frame_index (or of an earlier frame) into
+ * out_frame_ns. Call at the start of each replayed frame, before its events.
+ *
+ * Return value:
+ * - false when the next record is an event or belongs to a later frame, at
+ *   end of file, or after a read error; nothing is consumed then.
+ */
+bool ui_event_log_read_frame(ui_event_log_reader *reader, Uint32 frame_index,
+                             Uint64 *out_frame_ns);
+
+/*
+ * Return true once every record has been read (or reading failed).
+ */
+bool ui_event_log_reader_at_end(const ui_event_log_reader *reader);
+
+/*
+ * Close the file and release text storage. Safe to call on a closed reader.
+ */
+void ui_event_log_reader_close(ui_event_log_reader *reader);
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef UI_FRAME_PROFILER_H
+#define UI_FRAME_PROFILER_H
+
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Frames kept for percentile queries; older frames are overwritten.
+#define UI_FRAME_PROFILER_CAPACITY 1024U
+
+/*
+ * Phases of one main-loop frame, in the order main.c runs them.
+ */
+typedef enum ui_frame_phase
+{
+    UI_FRAME_PHASE_EVENTS = 0,
+    UI_FRAME_PHASE_PAGE_UPDATE,
+    UI_FRAME_PHASE_RUNTIME_UPDATE,
+    UI_FRAME_PHASE_LAYOUT,
+    UI_FRAME_PHASE_RENDER,
+    UI_FRAME_PHASE_COUNT
+} ui_frame_phase;
+
+/*
+ * Tail-latency summary of one timing series over the frames in the ring.
+ * Percentiles use the nearest-rank method; all zero when no frame is stored.
+ */
+typedef struct ui_frame_timing_stats
+{
+    size_t sample_count;
+    double p50_ms;
+    double p95_ms;
+    double p99_ms;
+    double max_ms;
+} ui_frame_timing_stats;
+
+/*
+ * Per-phase frame timer backed by fixed-size ring buffers.
+ *
+ * Why this exists: ui_fps_counter only shows an average, which hides the
+ * occasional long frame that users notice as a hitch. The profiler keeps the
+ * last UI_FRAME_PROFILER_CAPACITY frames so p95/p99/max can be read at any
+ * time, per phase and for the whole frame.
+ *
+ * Behavior/contract:
+ * - Recording never allocates: timings go into arrays inside the struct.
+ * - A frame is begin_frame, one mark per finished phase, then end_frame. Time
+ *   between marks is charged to the phase being marked; phases never marked
+ *   record zero. Time spent before begin_frame (idle waits) is not counted.
+ * - Frame time is the sum of the phase times, so phases always add up.
+ */
+typedef struct ui_frame_profiler
+{
+    Uint64 phase_ticks[UI_FRAME_PHASE_COUNT][UI_FRAME_PROFILER_CAPACITY];
+    Uint64 frame_ticks[UI_FRAME_PROFILER_CAPACITY];
+    Uint64 pending_ticks[UI_FRAME_PHASE_COUNT];
+    Uint64 mark_counter;
+    Uint64 ticks_per_second;
+    Uint64 frame_count;
+    size_t next_slot;
+    bool in_frame;
+} ui_frame_profiler;
+
+/*
+ * Initialize an empty profiler. Returns false if profiler is NULL.
+ */
+bool ui_frame_profiler_init(ui_frame_profiler *profiler);
+
+/*
+ * Start timing a frame. Discards a frame that was begun but never ended.
+ */
+void ui_frame_profiler_begin_frame(ui_frame_profiler *profiler);
+
+/*
+ * Charge the time since begin_frame or the previous mark to phase. Ignored
+ * outside a frame or for an out-of-range phase.
+ */
+void ui_frame_profiler_mark(ui_frame_profiler *profiler, ui_frame_phase phase);
+
+/*
+ * Store the current frame in the ring. Ignored outside a frame.
+ */
+void ui_frame_profiler_end_frame(ui_frame_profiler *profiler);
+
+/*
+ * Store one frame from externally measured per-phase tick counts, indexed by
+ * ui_frame_phase. Used by tools that time frames themselves and by tests.
+ */
+void ui_frame_profiler_record_frame(ui_frame_profiler *profiler,
+                                    const Uint64 phase_ticks[UI_FRAME_PHASE_COUNT]);
+
+/*
+ * Return tail-latency stats of whole frames. Zeroed stats for NULL profiler.
+ */
+ui_frame_timing_stats ui_frame_profiler_get_frame_stats(const ui_frame_profiler *profiler);
+
+/*
+ * Return tail-latency stats of one phase. Zeroed stats for NULL profiler or
+ * an out-of-range phase.
+ */
+ui_frame_timing_stats ui_frame_profiler_get_phase_stats(const ui_frame_profiler *profiler,
+                                                        ui_frame_phase phase);
+
+/*
+ * Return a short lowercase name for phase, or "unknown" when out of range.
+ */
+const char *ui_frame_phase_name(ui_frame_phase phase);
+
+/*
+ * Log a percentile table of frame and phase times through SDL_Log.
+ */
+void ui_frame_profiler_log_summary(const ui_frame_profiler *profiler);
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef UI_HANDLE_H
+#define UI_HANDLE_H
+
+#include "ui/ui_element.h"
+
+/*
+ * Weak reference to an element: a slot index plus the slot's generation.
+ *
+ * Why this exists: containers and the runtime remember elements across events
+ * (the captured child), and callbacks fired during dispatch can destroy those
+ * elements or even the dispatching container (todo rows are rebuilt from
+ * inside their own checkbox and button callbacks). A raw pointer left behind
+ * is a use-after-free; a stale handle resolves to NULL instead.
+ *
+ * Behavior/contract:
+ * - An element gets a slot the first time ui_handle_acquire sees it and keeps
+ *   it until ui_traversal_destroy releases it, which bumps the slot's
+ *   generation. Released slots are reused; the generation keeps old handles
+ *   from resolving to the new occupant.
+ * - Elements must be destroyed through ui_traversal_destroy for their handles
+ *   to go stale. Every owner in the tree does.
+ * - Generation 0 is never issued, so a zeroed handle is the null handle.
+ */
+typedef struct ui_handle
+{
+    Uint32 index;
+    Uint32 generation;
+} ui_handle;
+
+#define UI_HANDLE_NULL ((ui_handle){0U, 0U})
+
+/*
+ * Return element's handle, assigning a slot on first use. Returns
+ * UI_HANDLE_NULL for NULL elements or when the slot table cannot grow.
+ */
+ui_handle ui_handle_acquire(ui_element *element);
+
+/*
+ * Return the element handle refers to, or NULL when handle is null or the
+ * element was destroyed since the handle was acquired.
+ */
+ui_element *ui_handle_resolve(ui_handle handle);
+
+/*
+ * Invalidate every handle to element and recycle its slot. No-op for NULL or
+ * for elements that never had a handle. Called by ui_traversal_destroy.
+ */
+void ui_handle_release(ui_element *element);
+
+#endif
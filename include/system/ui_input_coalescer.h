@@ -0,0 +1,100 @@
+#ifndef UI_INPUT_COALESCER_H
+#define UI_INPUT_COALESCER_H
+
+#include "system/ui_runtime.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Event counters for one coalescer.
+ *
+ * - received_events: events passed to ui_input_coalescer_push.
+ * - dispatched_events: events handed to ui_runtime_handle_event.
+ * - merged_motion_events: motion events folded into a later motion event.
+ * - merged_wheel_events: wheel events folded into a later wheel event.
+ */
+typedef struct ui_input_coalescer_stats
+{
+    Uint64 received_events;
+    Uint64 dispatched_events;
+    Uint64 merged_motion_events;
+    Uint64 merged_wheel_events;
+} ui_input_coalescer_stats;
+
+/*
+ * Input stage between the SDL event queue and ui_runtime.
+ *
+ * Why this exists: high-rate mice report motion at up to 1000 Hz, so one frame
+ * can drain dozens of motion events, each hit-testing the tree and each
+ * driving widget callbacks (slider on_change, drag handlers) whose results are
+ * overwritten before the frame is drawn.
+ *
+ * Behavior/contract:
+ * - Consecutive motion events from the same window and mouse are merged into
+ *   one event carrying the latest position and button state and the summed
+ *   xrel/yrel.
+ * - Consecutive wheel events from the same window, mouse and direction are
+ *   merged into one event carrying the summed x/y deltas and the latest
+ *   pointer position.
+ * - Any other event first dispatches pending motion/wheel in arrival order,
+ *   then itself, so button transitions and keyboard input stay ordered
+ *   relative to pointer movement.
+ * - Raw motion samples of the event currently being dispatched are available
+ *   through ui_input_coalesced_motion_samples.
+ */
+typedef struct ui_input_coalescer
+{
+    SDL_Event pending_motion;
+    SDL_Event pending_wheel;
+    bool has_pending_motion;
+    bool has_pending_wheel;
+    bool wheel_before_motion;
+    SDL_MouseMotionEvent *motion_samples;
+    size_t motion_sample_count;
+    size_t motion_sample_capacity;
+    ui_input_coalescer_stats stats;
+} ui_input_coalescer;
+
+/*
+ * Initialize an empty coalescer. Returns false if coalescer is NULL.
+ */
+bool ui_input_coalescer_init(ui_input_coalescer *coalescer);
+
+/*
+ * Release sample storage and drop pending events. Safe to call with NULL.
+ */
+void ui_input_coalescer_destroy(ui_input_coalescer *coalescer);
+
+/*
+ * Queue or dispatch one SDL event.
+ *
+ * Motion and wheel events are held for merging; every other event flushes
+ * them and is dispatched to context immediately.
+ */
+void ui_input_coalescer_push(ui_input_coalescer *coalescer, ui_runtime *context,
+                             const SDL_Event *event);
+
+/*
+ * Dispatch any held motion/wheel events. Call once after draining the SDL
+ * queue each frame, and before acting on an event outside the runtime (such as
+ * a window resize) that should observe earlier pointer input first.
+ */
+void ui_input_coalescer_flush(ui_input_coalescer *coalescer, ui_runtime *context);
+
+/*
+ * Return coalescing counters. Zeroed stats for NULL coalescer.
+ */
+ui_input_coalescer_stats ui_input_coalescer_get_stats(const ui_input_coalescer *coalescer);
+
+/*
+ * Return the raw motion samples merged into the motion event currently being
+ * dispatched by a coalescer, oldest first, and write their count.
+ *
+ * Widgets that need every sample (stroke capture, velocity estimation) call
+ * this from their handle_event op. Returns NULL with a zero count outside a
+ * coalesced motion dispatch.
+ */
+const SDL_MouseMotionEvent *ui_input_coalesced_motion_samples(size_t *out_count);
+
+#endif
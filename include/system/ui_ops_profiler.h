@@ -0,0 +1,119 @@
+#ifndef UI_OPS_PROFILER_H
+#define UI_OPS_PROFILER_H
+
+#include "ui/ui_element.h"
+
+/*
+ * Per-widget-type call counts and timings of element ops.
+ *
+ * Why this exists: the frame profiler says which phase of a frame was slow,
+ * not which widget type inside it. With CUI_OPS_PROFILING defined, every ops
+ * dispatch made by ui_element_measure/arrange, ui_traversal and the runtime,
+ * window, layout container and scroll view event loops is counted and timed
+ * against its ops table, so a page's cost can be broken down by widget type.
+ *
+ * Behavior/contract:
+ * - Inclusive time covers the whole op call; self time subtracts profiled
+ *   ops called from inside it (a container measuring its children, a window
+ *   forwarding an event).
+ * - Counters accumulate for the current frame until ui_ops_profiler_end_frame,
+ *   which keeps them as the last frame and adds them to the running totals.
+ * - Without CUI_OPS_PROFILING the scope macros expand to nothing and the frame
+ *   and summary calls are empty inline functions, so release builds carry no
+ *   trace of the profiler. Single-threaded, like the rest of the UI.
+ */
+
+typedef enum ui_ops_call
+{
+    UI_OPS_CALL_MEASURE = 0,
+    UI_OPS_CALL_ARRANGE,
+    UI_OPS_CALL_HANDLE_EVENT,
+    UI_OPS_CALL_UPDATE,
+    UI_OPS_CALL_RENDER,
+    UI_OPS_CALL_COUNT
+} ui_ops_call;
+
+#if defined(CUI_OPS_PROFILING)
+
+// Distinct ops tables tracked; calls through further tables are dropped.
+#define UI_OPS_PROFILER_MAX_TYPES 64U
+
+typedef struct ui_ops_call_stats
+{
+    Uint64 calls;
+    Uint64 inclusive_ticks;
+    Uint64 self_ticks;
+} ui_ops_call_stats;
+
+/*
+ * Counters of one ops table. current is the frame in progress, last_frame
+ * the most recently ended frame and total everything since startup.
+ */
+typedef struct ui_ops_profile_entry
+{
+    const ui_element_ops *ops;
+    ui_ops_call_stats current[UI_OPS_CALL_COUNT];
+    ui_ops_call_stats last_frame[UI_OPS_CALL_COUNT];
+    ui_ops_call_stats total[UI_OPS_CALL_COUNT];
+} ui_ops_profile_entry;
+
+/*
+ * One in-flight op call. Lives on the caller's stack between the enter and
+ * leave macros; scopes link to the enclosing one to split off self time.
+ */
+typedef struct ui_ops_profile_scope
+{
+    ui_ops_profile_entry *entry;
+    ui_ops_call call;
+    Uint64 start_counter;
+    Uint64 child_ticks;
+    struct ui_ops_profile_scope *parent;
+} ui_ops_profile_scope;
+
+void ui_ops_profiler_enter(ui_ops_profile_scope *scope, const ui_element_ops *ops,
+                           ui_ops_call call);
+void ui_ops_profiler_leave(ui_ops_profile_scope *scope);
+
+/*
+ * Bracket one ops dispatch. ENTER declares a local scope named by its first
+ * argument, so each pair needs its own block or name.
+ */
+#define UI_OPS_PROFILE_ENTER(scope, ops, call)                                                     \
+    ui_ops_profile_scope scope;                                                                    \
+    ui_ops_profiler_enter(&(scope), (ops), (call))
+#define UI_OPS_PROFILE_LEAVE(scope) ui_ops_profiler_leave(&(scope))
+
+/*
+ * Close the current frame: last_frame takes the current counters, which are
+ * added to total and reset.
+ */
+void ui_ops_profiler_end_frame(void);
+
+/*
+ * Expose the tracked ops tables in first-seen order and return their count.
+ */
+size_t ui_ops_profiler_entries(const ui_ops_profile_entry **out_entries);
+
+/*
+ * Log total calls and inclusive/self milliseconds per widget type and op
+ * through SDL_Log, most expensive type first.
+ */
+void ui_ops_profiler_log_summary(void);
+
+/*
+ * Drop every counter and tracked ops table.
+ */
+void ui_ops_profiler_reset(void);
+
+#else
+
+#define UI_OPS_PROFILE_ENTER(scope, ops, call) ((void)0)
+#define UI_OPS_PROFILE_LEAVE(scope) ((void)0)
+
+static inline void ui_ops_profiler_end_frame(void) {}
+static inline void ui_ops_profiler_log_summary(void) {}
+static inline void ui_ops_profiler_reset(void) {}
+
+#endif
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef UI_RENDER_H
+#define UI_RENDER_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define UI_RENDER_MAX_DAMAGE_RECTS 8
+
+/*
+ * Drawing primitives used by element render ops.
+ *
+ * Why this exists: routing every draw through one small API lets ui_runtime
+ * record a frame into a compact command list once and replay it on later
+ * frames while nothing is invalidated, instead of walking every element's
+ * render op again.
+ *
+ * Each call either draws immediately on `renderer` or, while a recording is
+ * active (see ui_render_begin_recording), appends one command to the active
+ * list. Render ops must not call SDL render functions directly.
+ *
+ * Every SDL call issued here (immediately or by replay) is also counted, so
+ * the cost of a frame in draw calls and state changes can be read back with
+ * ui_render_get_call_stats.
+ */
+
+/*
+ * SDL calls issued since the last ui_render_end_frame.
+ *
+ * - draw_calls: SDL_RenderClear/FillRect/Rect/Line/DebugText/Texture/Geometry
+ *   calls.
+ * - primitives: rects, lines and textured quads drawn by those calls (one per
+ *   glyph for debug text).
+ * - color_changes: SDL_SetRenderDrawColor calls.
+ * - clip_changes: SDL_SetRenderClipRect calls.
+ * - texture_binds: draws whose texture differs from the previous draw's (the
+ *   debug font and the glyph atlas count as one texture each; untextured
+ *   draws unbind).
+ */
+typedef struct ui_render_call_stats
+{
+    Uint64 draw_calls;
+    Uint64 primitives;
+    Uint64 color_changes;
+    Uint64 clip_changes;
+    Uint64 texture_binds;
+} ui_render_call_stats;
+
+/*
+ * Kinds of recorded draw commands.
+ */
+typedef enum ui_render_command_type
+{
+    UI_RENDER_COMMAND_FILL_RECT,
+    UI_RENDER_COMMAND_RECT,
+    UI_RENDER_COMMAND_LINE,
+    UI_RENDER_COMMAND_DEBUG_TEXT,
+    UI_RENDER_COMMAND_TEXTURE,
+    UI_RENDER_COMMAND_PUSH_CLIP,
+    UI_RENDER_COMMAND_POP_CLIP,
+} ui_render_command_type;
+
+/*
+ * One recorded draw command.
+ *
+ * Field use by type:
+ * - FILL_RECT/RECT: rect, color
+ * - LINE: rect.x/rect.y = start point, rect.w/rect.h = end point, color
+ * - DEBUG_TEXT: rect.x/rect.y = origin, text_offset into the list text storage, color
+ * - TEXTURE: rect = destination, texture
+ * - PUSH_CLIP: rect = clip in window coordinates
+ * - POP_CLIP: no payload
+ */
+typedef struct ui_render_command
+{
+    ui_render_command_type type;
+    SDL_Color color;
+    SDL_FRect rect;
+    size_t text_offset;
+    SDL_Texture *texture;
+} ui_render_command;
+
+/*
+ * Growable command buffer plus packed storage for text payloads.
+ *
+ * Storage is reused across recordings; ui_render_list_clear keeps capacity.
+ */
+typedef struct ui_render_list
+{
+    ui_render_command *commands;
+    size_t command_count;
+    size_t command_capacity;
+    char *text;
+    size_t text_length;
+    size_t text_capacity;
+    bool overflowed;
+} ui_render_list;
+
+/*
+ * Window-space regions whose pixels changed between two recordings.
+ *
+ * Rects are snapped outward to whole pixels. Overlapping rects are merged on
+ * insert; once the fixed capacity is exhausted everything collapses into one
+ * bounding rect, so the set only ever over-approximates the damage.
+ */
+typedef struct ui_render_damage
+{
+    SDL_FRect rects[UI_RENDER_MAX_DAMAGE_RECTS];
+    size_t count;
+} ui_render_damage;
+
+/*
+ * Initialize an empty list. Safe to call on zeroed memory.
+ */
+void ui_render_list_init(ui_render_list *list);
+
+/*
+ * Drop all recorded commands while keeping allocated capacity.
+ */
+void ui_render_list_clear(ui_render_list *list);
+
+/*
+ * Release list storage. Safe to call with NULL.
+ */
+void ui_render_list_destroy(ui_render_list *list);
+
+/*
+ * Route subsequent ui_render_* calls into list instead of drawing.
+ *
+ * Behavior:
+ * - Clears list before recording.
+ * - Only one recording can be active at a time; nested begin calls are
+ *   rejected and return false.
+ */
+bool ui_render_begin_recording(ui_render_list *list);
+
+/*
+ * Stop recording and return to immediate drawing.
+ *
+ * Returns false when a recording was not active or when an allocation failed
+ * while recording (list->overflowed); an overflowed list must not be replayed.
+ */
+bool ui_render_end_recording(void);
+
+/*
+ * Issue every command in list on renderer.
+ *
+ * Fills and 1px outlines are batched into one SDL_RenderGeometry call with
+ * per-vertex colors. A fill recorded after a line, text or texture joins the
+ * earlier batch when their bounds do not overlap, so it may be issued ahead of
+ * them; overlapping draws and clip changes keep recorded order. Consecutive
+ * deferred texts share one glyph atlas batch. Commands entirely outside the
+ * active clip are not issued. The pixels match a replay in recorded order.
+ */
+void ui_render_list_replay(const ui_render_list *list, SDL_Renderer *renderer);
+
+/*
+ * Issue the commands in list that can reach clip (window coordinates), with
+ * drawing restricted to it. Nested clips recorded in list are intersected with
+ * clip. Commands whose bounds miss the active clip, and whole clipped groups
+ * pushed outside it, are skipped, so repainting a small damage rect only costs
+ * the draws that land in it.
+ */
+void ui_render_list_replay_clipped(const ui_render_list *list, SDL_Renderer *renderer,
+                                   const SDL_FRect *clip);
+
+/*
+ * Add to damage every region whose pixels may differ between replaying
+ * previous and replaying current.
+ *
+ * Commands are compared pairwise in order. A mismatch damages the bounds of
+ * both commands; a mismatched clip push/pop or a length difference damages
+ * everything from that point on, since later commands may draw under a
+ * different clip.
+ */
+void ui_render_list_diff(const ui_render_list *previous, const ui_render_list *current,
+                         ui_render_damage *damage);
+
+/*
+ * Remove all damage rects.
+ */
+void ui_render_damage_clear(ui_render_damage *damage);
+
+/*
+ * Add rect to damage. Empty rects are ignored.
+ */
+void ui_render_damage_add(ui_render_damage *damage, const SDL_FRect *rect);
+
+/*
+ * Return counters for the frame in progress.
+ */
+ui_render_call_stats ui_render_get_call_stats(void);
+
+/*
+ * Return counters for the frame in progress and start a new frame from zero.
+ * Call once per frame after presenting.
+ */
+ui_render_call_stats ui_render_end_frame(void);
+
+/*
+ * Linearly blend from a to b by t in [0, 1], per channel including alpha.
+ * Widgets use this to derive hover shades from their idle/pressed colors.
+ */
+SDL_Color ui_render_mix_color(SDL_Color a, SDL_Color b, float t);
+
+/*
+ * Clear the whole current render target with color. Always immediate; not
+ * allowed while recording.
+ */
+void ui_render_clear(SDL_Renderer *renderer, SDL_Color color);
+
+/*
+ * Fill rect with color.
+ */
+void ui_render_fill_rect(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color);
+
+/*
+ * Draw a 1px outline of rect with color.
+ */
+void ui_render_rect(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color);
+
+/*
+ * Draw a line from (x1, y1) to (x2, y2).
+ */
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void ui_render_line(SDL_Renderer *renderer, float x1, float y1, float x2, float y2,
+                    SDL_Color color);
+
+/*
+ * Draw text with SDL's built-in 8x8 debug font.
+ *
+ * Glyphs come from ui_glyph_atlas as textured quads in one SDL_RenderGeometry
+ * call; SDL_RenderDebugText is used only when the atlas cannot be built.
+ *
+ * When recording, the text bytes are copied into the list, so callers may
+ * pass transient buffers.
+ */
+void ui_render_debug_text(SDL_Renderer *renderer, float x, float y, const char *text,
+                          SDL_Color color);
+
+/*
+ * Draw texture stretched to dst. NULL texture is ignored.
+ *
+ * Recording stores the texture pointer; the owner must keep it alive until the
+ * next invalidation.
+ */
+void ui_render_texture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *dst);
+
+/*
+ * Restrict drawing to rect (window coordinates) until the matching pop.
+ *
+ * Clips nest: the effective clip is the intersection with the enclosing clip.
+ */
+void ui_render_push_clip(SDL_Renderer *renderer, const SDL_FRect *rect);
+
+/*
+ * Restore the clip that was active before the matching push.
+ */
+void ui_render_pop_clip(SDL_Renderer *renderer);
+
+#endif
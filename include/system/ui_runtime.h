@@ -1,33 +1,96 @@
 #ifndef UI_RUNTIME_H
 #define UI_RUNTIME_H
 
+#include "system/ui_element_table.h"
+#include "system/ui_handle.h"
+#include "system/ui_render.h"
+#include "system/ui_spatial_index.h"
 #include "ui/ui_element.h"
 
 #include <stddef.h>
 
+/*
+ * Retained-rendering counters.
+ *
+ * - recorded_frames: frames whose render ops were traversed and recorded.
+ * - replayed_frames: frames drawn straight from the previous recording.
+ * - command_count: size of the current recording.
+ * - partial_repaint_frames: target-rendered frames that repainted only damage.
+ * - full_repaint_frames: target-rendered frames that repainted everything.
+ */
+typedef struct ui_runtime_render_stats
+{
+    Uint64 recorded_frames;
+    Uint64 replayed_frames;
+    size_t command_count;
+    Uint64 partial_repaint_frames;
+    Uint64 full_repaint_frames;
+} ui_runtime_render_stats;
+
 /*
  * Owns an ordered list of UI elements and drives their lifecycle.
  *
  * Why this exists: centralizing event dispatch, update, and render keeps main
  * loops simple and ensures controls are processed consistently.
+ *
+ * Hover: the last pointer position is cached and the hovered path (the
+ * topmost visible, enabled element under it, then that element's own hovered
+ * child, and so on) is re-resolved only when the pointer moves or the screen
+ * rect/render generations change, so widgets get enter/leave through the
+ * update_hover op without hit-testing motion events themselves.
+ *
+ * Element table: `element_table` mirrors visible/enabled/ops/rect for every
+ * registered element in packed arrays (see ui_element_table.h) and follows
+ * add/remove. When `use_element_table` is set, update, render and pointer
+ * routing filter on those arrays and only dereference surviving elements;
+ * pointer candidates then come from a vectorized scan instead of hit_index.
+ * Off by default: the grid wins for large lists that rarely change, the
+ * table for large lists that move or toggle every frame.
+ *
+ * Removal: each element records its slot (sibling_index), so removal clears
+ * that slot in O(1) and leaves a NULL hole; `hole_count` holes are compacted
+ * in one order-preserving pass once they make up half of `element_count`.
+ * Loops over `elements` must skip NULL slots. The captured element is held
+ * as a ui_handle so an element destroyed by its own handler is not
+ * dispatched to again.
  */
 typedef struct ui_runtime
 {
     ui_element **elements;
     size_t element_count;
     size_t element_capacity;
+    size_t hole_count;
     ui_element *focused_element;
-    ui_element *captured_element;
+    ui_handle captured_element;
+    ui_element *hovered_element;
+    bool has_pointer;
+    SDL_FPoint pointer_position;
+    Uint64 hover_screen_rect_generation;
+    Uint64 hover_render_generation;
+    ui_spatial_index hit_index;
+    ui_element_table element_table;
+    bool use_element_table;
+    bool retained_rendering;
+    bool has_recording;
+    Uint64 recorded_render_generation;
+    ui_render_list render_list;
+    ui_render_list previous_render_list;
+    ui_render_damage damage;
+    bool damage_all;
+    SDL_Texture *render_target;
+    int render_target_w;
+    int render_target_h;
+    ui_runtime_render_stats render_stats;
 } ui_runtime;
 
 /*
- * Initialize an empty context.
+ * Initialize an empty context with retained rendering enabled.
  * Returns false if context is NULL.
  */
 bool ui_runtime_init(ui_runtime *context);
 
 /*
- * Destroy all registered elements (via their destroy op) and free context storage.
+ * Destroy all registered elements with their subtrees and free context storage.
  * Safe to call with NULL.
  */
 void ui_runtime_destroy(ui_runtime *context);
@@ -44,14 +107,16 @@ bool ui_runtime_add(ui_runtime *context, ui_element *element);
  * Remove one element from the context.
  *
  * Behavior:
- * - Matches by pointer identity.
+ * - Finds the element through its recorded slot (O(1), amortized over
+ *   compaction).
  * - Preserves relative order of remaining elements.
  * - Optionally destroys the removed element.
  *
  * Parameters:
  * - context: root UI context
  * - element: element pointer previously added to this context
- * - destroy_element: when true, call element->ops->destroy before removal returns
+ * - destroy_element: when true, destroy the element and its subtree
+ *   (ui_traversal_destroy) before removal returns
  *
  * Returns:
  * - true when an element was found and removed
@@ -59,6 +124,19 @@ bool ui_runtime_add(ui_runtime *context, ui_element *element);
  */
 bool ui_runtime_remove(ui_runtime *context, ui_element *element, bool destroy_element);
 
+/*
+ * Remove several elements at once, compacting the element list a single time.
+ *
+ * Behavior:
+ * - Same per-element rules as ui_runtime_remove; entries that are NULL or
+ *   not registered are skipped.
+ * - Preserves relative order of remaining elements.
+ *
+ * Returns the number of elements removed.
+ */
+size_t ui_runtime_remove_elements(ui_runtime *context, ui_element *const *elements, size_t count,
+                                  bool destroy_elements);
+
 /*
  * Dispatch a single SDL event using centralized input routing.
  *
@@ -68,6 +146,8 @@ bool ui_runtime_remove(ui_runtime *context, ui_element *element, bool destroy_el
  *   element's hit_test op (or rect fallback).
  * - Left mouse press captures the handling element until left release.
  * - Clicking a focusable element focuses it; clicking elsewhere clears focus.
+ * - Pointer events update the hovered path before they are dispatched;
+ *   SDL_EVENT_WINDOW_MOUSE_LEAVE clears it.
  */
 void ui_runtime_handle_event(ui_runtime *context, const SDL_Event *event);
 
@@ -77,9 +157,86 @@ void ui_runtime_handle_event(ui_runtime *context, const SDL_Event *event);
  */
 void ui_runtime_update(ui_runtime *context, float delta_seconds);
 
+/*
+ * Return seconds until the earliest frame requested by any visible, enabled
+ * element (see ui_element_ops.next_frame_delay), or UI_NO_FRAME_REQUEST when
+ * nothing needs a frame until the next input event.
+ */
+float ui_runtime_next_frame_delay(const ui_runtime *context);
+
+/*
+ * Re-run measure/arrange for top-level elements that were invalidated.
+ *
+ * Behavior:
+ * - Elements whose subtree is clean are skipped entirely.
+ * - Dirty elements are measured against and arranged into their current rect,
+ *   matching how pages arrange their window root.
+ * - Intended to run once per frame after ui_runtime_update so event handlers,
+ *   page updates and widget updates can all invalidate freely.
+ * - Afterwards, re-resolves the hovered path if anything moved or changed
+ *   visually since it was last resolved (scrolling under a still pointer).
+ */
+void ui_runtime_layout(ui_runtime *context);
+
 /*
  * Call render on each visible element in insertion order.
+ *
+ * Retained mode (default):
+ * - When any element was invalidated since the last recording, render ops are
+ *   traversed once to record a command list, which is then replayed.
+ * - Otherwise the previous command list is replayed without touching element
+ *   vtables.
+ *
+ * Immediate mode draws straight through the render ops every call.
+ */
+void ui_runtime_render(ui_runtime *context, SDL_Renderer *renderer);
+
+/*
+ * Render into a persistent target texture, repainting only damaged regions,
+ * then draw the texture onto the renderer's current target.
+ *
+ * Behavior:
+ * - Damage is the set of regions where the new recording differs from the
+ *   previous one (see ui_render_list_diff). Each region is filled with
+ *   clear_color and the recording is replayed clipped to it.
+ * - Frames with no invalidation repaint nothing and only blit the texture.
+ * - The texture is (re)created at width x height; creating it, or a failed
+ *   recording, repaints the whole target.
+ * - Returns false without drawing when retained rendering is disabled or the
+ *   target texture cannot be created; callers should fall back to clearing
+ *   and calling ui_runtime_render.
+ */
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+bool ui_runtime_render_damaged(ui_runtime *context, SDL_Renderer *renderer, int width, int height,
+                               SDL_Color clear_color);
+
+/*
+ * Destroy the persistent target texture so the next ui_runtime_render_damaged
+ * recreates and fully repaints it. Call on SDL_EVENT_RENDER_TARGETS_RESET and
+ * SDL_EVENT_RENDER_DEVICE_RESET, when target contents are lost.
+ */
+void ui_runtime_discard_render_target(ui_runtime *context);
+
+/*
+ * Enable or disable retained rendering. Disabling drops the current recording.
+ */
+void ui_runtime_set_retained_rendering(ui_runtime *context, bool enabled);
+
+/*
+ * Route update, render and pointer filtering through the packed element table
+ * (true) or through the element pointers and hit_index (false, the default).
+ */
+void ui_runtime_set_element_table(ui_runtime *context, bool enabled);
+
+/*
+ * Return true when the next ui_runtime_render would replay the previous frame
+ * unchanged, so callers may skip drawing and presenting entirely.
+ */
+bool ui_runtime_can_replay(const ui_runtime *context);
+
+/*
+ * Return retained-rendering counters. Zeroed stats for NULL context.
  */
-void ui_runtime_render(const ui_runtime *context, SDL_Renderer *renderer);
+ui_runtime_render_stats ui_runtime_get_render_stats(const ui_runtime *context);
 
 #endif
@@ -0,0 +1,88 @@
+#ifndef UI_SPATIAL_INDEX_H
+#define UI_SPATIAL_INDEX_H
+
+#include "ui/ui_element.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Uniform-grid pointer hit-test accelerator over one z-ordered element array
+ * (a window's children, a layout container's children, or the runtime's
+ * top-level list).
+ *
+ * Why this exists: pointer routing used to hit-test every sibling back to
+ * front on every mouse event, including every motion event. The grid buckets
+ * siblings by their window-space rect so a query only visits the few
+ * candidates whose cell contains the pointer.
+ *
+ * Behavior/contract:
+ * - Entries are array indices; each cell lists them in ascending z order.
+ * - The grid is rebuilt lazily on the next query after any arrange/scroll
+ *   (ui_element_screen_rect_generation changes) or after the owner calls
+ *   ui_spatial_index_invalidate because its element array changed.
+ * - Candidates are bucketed by ui_element_screen_rect, so a custom hit_test
+ *   op must not report hits outside the element's rect.
+ * - Arrays with fewer than UI_SPATIAL_INDEX_MIN_ELEMENTS entries, or a failed
+ *   build, fall back to a linear back-to-front scan.
+ */
+#define UI_SPATIAL_INDEX_MIN_ELEMENTS 16U
+
+typedef struct ui_spatial_index
+{
+    SDL_FRect bounds;
+    float cell_w;
+    float cell_h;
+    int columns;
+    int rows;
+    size_t *cell_starts;
+    size_t cell_starts_capacity;
+    size_t *cell_entries;
+    size_t cell_entries_capacity;
+    size_t indexed_count;
+    Uint64 built_generation;
+    bool has_grid;
+} ui_spatial_index;
+
+/*
+ * Iteration state for one point query. Yields candidate indices from topmost
+ * to bottommost; callers still run the exact hit test on each candidate.
+ */
+typedef struct ui_spatial_cursor
+{
+    const size_t *entries;
+    size_t remaining;
+} ui_spatial_cursor;
+
+/*
+ * Initialize an empty index. Safe to call on zeroed memory.
+ */
+void ui_spatial_index_init(ui_spatial_index *index);
+
+/*
+ * Release index storage. Safe to call with NULL.
+ */
+void ui_spatial_index_destroy(ui_spatial_index *index);
+
+/*
+ * Force a rebuild on the next query. Call whenever the indexed array is
+ * reordered, grown, or shrunk.
+ */
+void ui_spatial_index_invalidate(ui_spatial_index *index);
+
+/*
+ * Start a point query over elements[0..count).
+ *
+ * Rebuilds the grid first when stale. The element array must be the one the
+ * index was last invalidated for.
+ */
+void ui_spatial_index_query(ui_spatial_index *index, ui_element *const *elements, size_t count,
+                            const SDL_FPoint *point, ui_spatial_cursor *cursor);
+
+/*
+ * Advance cursor. Writes the next candidate array index to out_index and
+ * returns true, or returns false when candidates are exhausted.
+ */
+bool ui_spatial_cursor_next(ui_spatial_cursor *cursor, size_t *out_index);
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef UI_TRAVERSAL_H
+#define UI_TRAVERSAL_H
+
+#include "ui/ui_element.h"
+
+/*
+ * Iterative whole-subtree passes over an element and its descendants.
+ *
+ * Why this exists: windows, layout containers and scroll views each used to
+ * loop over their children inside their own update/render/next_frame_delay/
+ * destroy ops, so every pass recursed through the vtables once per tree level
+ * and the same filtering was written three times. Containers now only expose
+ * their children through the child_span op; these passes walk the tree with an
+ * explicit stack, so depth is bounded by the heap instead of the C stack.
+ *
+ * Behavior/contract:
+ * - Parents are visited before their children, children in child_span order
+ *   (back to front).
+ * - Element ops run for the element alone; ops must not recurse into children.
+ * - The child span is re-read at every step, so children added during update
+ *   are safe; removing an earlier sibling mid-pass skips one element, as the
+ *   old per-container loops did.
+ * - Measure/arrange and pointer routing stay in the containers: they compute
+ *   child geometry or keep per-container focus, capture and hover state.
+ */
+
+/*
+ * Run ops->update on root and every descendant. Disabled elements are skipped
+ * together with their subtree. Each visited element's screen-rect cache is
+ * checked against its rect afterwards (see ui_element_sync_screen_rect()), so
+ * direct rect writes show up in screen rects after the next update pass.
+ */
+void ui_traversal_update(ui_element *root, float delta_seconds);
+
+/*
+ * Draw root and every descendant: ops->render before an element's children,
+ * ops->finish_render after them. Hidden elements are skipped together with
+ * their subtree.
+ */
+void ui_traversal_render(const ui_element *root, SDL_Renderer *renderer);
+
+/*
+ * Return the earliest next_frame_delay among root and its visible, enabled
+ * descendants, or UI_NO_FRAME_REQUEST when none asks for a frame.
+ */
+float ui_traversal_next_frame_delay(const ui_element *root);
+
+/*
+ * Destroy root and every descendant, children before their parent, releasing
+ * each element's handle first. Safe to call with NULL.
+ */
+void ui_traversal_destroy(ui_element *root);
+
+/*
+ * Drop the cached screen rects of root and its descendants. Stops at elements
+ * whose cache is already dropped, so repeated calls on overlapping subtrees
+ * cost only the caches they actually clear. Use
+ * ui_element_invalidate_subtree_screen_rects(), which also bumps the
+ * generations derived caches watch.
+ */
+void ui_traversal_invalidate_screen_rects(ui_element *root);
+
+#endif
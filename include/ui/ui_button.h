@@ -2,6 +2,8 @@
 #define UI_BUTTON_H
 
 #include "ui/ui_element.h"
+#include "ui/ui_text_run.h"
+#include "util/string_pool.h"
 
 /*
  * Callback invoked when a button click is committed.
@@ -11,7 +13,13 @@
 typedef void (*button_click_handler)(void *context);
 
 /*
- * Clickable rectangular control with pressed/unpressed visuals.
+ * Clickable rectangular control with idle/hovered/pressed visuals.
+ *
+ * The hovered fill is derived from up_color and down_color; hover state is
+ * driven by the parent through the update_hover op.
+ *
+ * label is borrowed, or shared from label_pool after
+ * ui_button_set_interned_label, in which case the button holds a reference.
  */
 typedef struct ui_button
 {
@@ -19,7 +27,10 @@ typedef struct ui_button
     SDL_Color up_color;
     SDL_Color down_color;
     const char *label;
+    string_pool *label_pool;
+    ui_text_run label_run;
     bool is_pressed;
+    bool is_hovered;
     button_click_handler on_click;
     void *on_click_context;
 } ui_button;
@@ -28,6 +39,7 @@ typedef struct ui_button
  * Create a button with self-contained click handling.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - rect: clickable and render bounds in window coordinates
  * - up_color/down_color: fill colors for idle and pressed states
  * - label: optional borrowed text rendered in white at button center (NULL for no text)
@@ -37,15 +49,21 @@ typedef struct ui_button
  * Returns a heap-allocated button or NULL on allocation/validation failure.
  * Ownership transfers to caller (or ui_runtime after ui_runtime_add succeeds).
  */
-ui_button *ui_button_create(const SDL_FRect *rect, SDL_Color up_color, SDL_Color down_color,
-                            const char *label, const SDL_Color *border_color,
-                            button_click_handler on_click, void *on_click_context);
+ui_button *ui_button_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                            SDL_Color up_color, SDL_Color down_color, const char *label,
+                            const SDL_Color *border_color, button_click_handler on_click,
+                            void *on_click_context);
 
 /*
  * Return whether the button is currently in pressed state.
  */
 bool ui_button_is_pressed(const ui_button *button);
 
+/*
+ * Return whether the pointer is currently over the button.
+ */
+bool ui_button_is_hovered(const ui_button *button);
+
 /*
  * Read the current borrowed label pointer.
  */
@@ -55,8 +73,18 @@ const char *ui_button_get_label(const ui_button *button);
  * Replace the button label pointer (borrowed, not copied).
  *
  * The caller owns the lifetime of label and must keep it valid while the
- * button is rendered.
+ * button is rendered. The label is measured here, so text edited in place
+ * must be set again to update the button's size.
  */
 void ui_button_set_label(ui_button *button, const char *label);
 
+/*
+ * Replace the label with an interned string from pool.
+ *
+ * The button takes its own reference to label (the caller keeps its own) and
+ * drops it when the label is replaced or the button is destroyed, so pool
+ * must outlive both. Returns false on invalid arguments.
+ */
+bool ui_button_set_interned_label(ui_button *button, string_pool *pool, const char *label);
+
 #endif
@@ -2,6 +2,8 @@
 #define UI_CHECKBOX_H
 
 #include "ui/ui_element.h"
+#include "ui/ui_text_run.h"
+#include "util/string_pool.h"
 
 /*
  * Callback invoked when the checkbox state changes.
@@ -28,6 +30,8 @@ typedef struct ui_checkbox
     bool is_checked;
     bool is_pressed;
     const char *label;
+    string_pool *label_pool;
+    ui_text_run label_run;
     checkbox_change_handler on_change;
     void *on_change_context;
 } ui_checkbox;
@@ -40,6 +44,7 @@ typedef struct ui_checkbox
  * hit-test rect spans the full width of box + gap + label text.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - x, y: top-left corner in window coordinates
  * - label: borrowed string displayed next to the box (must outlive the element)
  * - box_color: outline color for the square
@@ -52,8 +57,8 @@ typedef struct ui_checkbox
  * Returns a heap-allocated checkbox or NULL on failure.
  * Ownership transfers to caller (or ui_runtime after ui_runtime_add succeeds).
  */
-ui_checkbox *ui_checkbox_create(float x, float y, const char *label, SDL_Color box_color,
-                                SDL_Color check_color, SDL_Color label_color,
+ui_checkbox *ui_checkbox_create(const cui_allocator *allocator, float x, float y, const char *label,
+                                SDL_Color box_color, SDL_Color check_color, SDL_Color label_color,
                                 bool initially_checked, checkbox_change_handler on_change,
                                 void *on_change_context, const SDL_Color *border_color);
 
@@ -72,4 +77,13 @@ bool ui_checkbox_is_checked(const ui_checkbox *checkbox);
  */
 void ui_checkbox_set_checked(ui_checkbox *checkbox, bool checked, bool notify);
 
+/*
+ * Replace the label with an interned string from pool.
+ *
+ * The checkbox takes its own reference to label (the caller keeps its own)
+ * and drops it when the label is replaced or the checkbox is destroyed, so
+ * pool must outlive both. Returns false on invalid arguments.
+ */
+bool ui_checkbox_set_interned_label(ui_checkbox *checkbox, string_pool *pool, const char *label);
+
 #endif
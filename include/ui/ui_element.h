@@ -1,8 +1,16 @@
 #ifndef UI_ELEMENT_H
 #define UI_ELEMENT_H
 
+#include "util/cui_allocator.h"
+
 #include <SDL3/SDL.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * next_frame_delay result meaning "no frame needed until the next input".
+ */
+#define UI_NO_FRAME_REQUEST (-1.0F)
 
 /*
  * Forward declaration for the shared UI base type.
@@ -50,6 +58,12 @@ typedef enum ui_align_v
  */
 typedef struct ui_element_ops
 {
+    /*
+     * Short widget type name for diagnostics such as the ops profiler.
+     * May be NULL; such tables are reported by address.
+     */
+    const char *type_name;
+
     /*
      * Compute this element's desired local size for a given available rect.
      *
@@ -102,21 +116,62 @@ typedef struct ui_element_ops
      */
     void (*set_focus)(ui_element *element, bool focused);
 
+    /*
+     * Notify the element that the pointer is over it at point (window
+     * coordinates), or has left it when point is NULL.
+     *
+     * Called by the parent along the hovered path: the first non-NULL call
+     * after a NULL one is an enter, every NULL call is a leave. Containers
+     * forward to their own hovered child (see ui_element_set_hovered_child).
+     * When NULL, the element has no hover state.
+     */
+    void (*update_hover)(ui_element *element, const SDL_FPoint *point);
+
+    /*
+     * Expose this element's children in back-to-front order.
+     *
+     * Contract:
+     * - Writes the child array to *out_children and returns its length.
+     * - The array may move between calls (children added or removed);
+     *   ui_traversal re-reads it at every step.
+     *
+     * When NULL, the element is a leaf. See system/ui_traversal.h.
+     */
+    size_t (*child_span)(const ui_element *element, ui_element *const **out_children);
+
     /*
      * Advance element state by delta_seconds.
-     * Called once per frame when enabled.
+     * Called once per frame when enabled; children are updated afterwards by
+     * ui_traversal, so implementations only touch the element itself.
      */
     void (*update)(ui_element *element, float delta_seconds);
 
+    /*
+     * Optional: seconds from now until this element next needs an
+     * update/render pass without any input (caret blink, periodic refresh).
+     * Return UI_NO_FRAME_REQUEST when nothing is pending. Only the element's
+     * own request; ui_traversal_next_frame_delay combines its children's.
+     * When NULL, the element never asks for frames on its own.
+     */
+    float (*next_frame_delay)(const ui_element *element);
+
     /*
      * Draw this element.
-     * Called once per frame when visible.
+     * Called once per frame when visible, before its children are drawn.
      */
     void (*render)(const ui_element *element, SDL_Renderer *renderer);
 
+    /*
+     * Optional: draw after this element's children (borders drawn on top,
+     * popping a clip pushed by render).
+     */
+    void (*finish_render)(const ui_element *element, SDL_Renderer *renderer);
+
     /*
      * Release resources owned by the element.
-     * Implementations generally free the concrete struct itself.
+     * Implementations generally free the concrete struct itself through
+     * element->allocator. Children are destroyed first by
+     * ui_traversal_destroy; implementations must not destroy them.
      */
     void (*destroy)(ui_element *element);
 } ui_element_ops;
@@ -129,8 +184,25 @@ typedef struct ui_element_ops
  * - parent: owning element for relative positioning (NULL = top-level).
  * - align_h/align_v: anchor point on the parent that rect offsets from.
  * - ops: behavior implementation (must be non-NULL for valid elements)
+ * - allocator: allocator the element (and any memory it owns) came from; the
+ *   destroy op releases through it. NULL means malloc/free.
  * - visible: participates in render pass when true
  * - enabled: participates in event/update passes when true
+ * - screen_rect_cache/screen_rect_source/screen_rect_generation: memoized
+ *   window-space rect, the rect it was computed from and its epoch, owned by
+ *   ui_element_screen_rect() and the screen-rect invalidation APIs;
+ *   constructors reset them through ui_element_reset_layout_cache() and
+ *   nothing else should write them.
+ * - needs_measure/needs_arrange: dirty flags set by the invalidate APIs below
+ *   and cleared by ui_element_measure()/ui_element_arrange().
+ * - measure_available_w/h, measured_w/h: memo key and result of the last
+ *   measure pass.
+ * - arrange_final_rect/arranged_rect: input and result of the last arrange
+ *   pass, used to skip re-arranging clean subtrees.
+ * - sibling_index: position in the owner's child array (window, layout
+ *   container or runtime list), written by the owner on add and compaction so
+ *   removal finds the slot without a search.
+ * - handle_index: slot in the ui_handle table (0 = no handle yet).
  */
 struct ui_element
 {
@@ -139,13 +211,188 @@ struct ui_element
     ui_align_h align_h;
     ui_align_v align_v;
     const ui_element_ops *ops;
+    const cui_allocator *allocator;
     bool visible;
     bool enabled;
     bool has_border;
     SDL_Color border_color;
     float border_width;
+    SDL_FRect screen_rect_cache;
+    SDL_FRect screen_rect_source;
+    Uint64 screen_rect_generation;
+    bool needs_measure;
+    bool needs_arrange;
+    float measure_available_w;
+    float measure_available_h;
+    float measured_w;
+    float measured_h;
+    SDL_FRect arrange_final_rect;
+    SDL_FRect arranged_rect;
+    size_t sibling_index;
+    Uint32 handle_index;
 };
 
+/*
+ * Reset cached layout state stored on the element base.
+ *
+ * Every *_create function calls this once after filling in the base fields so
+ * the cache starts out stale instead of holding uninitialized heap memory.
+ * New elements start with measure and arrange marked dirty, with no handle
+ * and no sibling slot.
+ */
+void ui_element_reset_layout_cache(ui_element *element);
+
+/*
+ * Find element's slot in its owner's child array in O(1).
+ *
+ * Returns true and writes the slot to out_index when
+ * siblings[element->sibling_index] is element; false when element is not in
+ * this array.
+ */
+bool ui_element_find_sibling(ui_element *const *siblings, size_t count, const ui_element *element,
+                             size_t *out_index);
+
+/*
+ * Return true once removals have left enough NULL slots in a child array that
+ * compacting it now keeps removal amortized O(1).
+ */
+bool ui_element_should_compact_siblings(size_t hole_count, size_t count);
+
+/*
+ * Drop the NULL slots removal left in a child array, in one pass.
+ *
+ * Behavior:
+ * - Keeps the relative (z) order of the remaining elements and rewrites their
+ *   sibling_index.
+ * - NULLs the vacated tail so stale indices read NULL rather than an old
+ *   pointer.
+ * - Returns the new element count.
+ */
+size_t ui_element_compact_siblings(ui_element **siblings, size_t count);
+
+/*
+ * Mark an element's measured size as stale.
+ *
+ * Behavior:
+ * - Sets needs_measure and needs_arrange on element and every ancestor, since
+ *   a size change can move siblings and resize containers up the chain.
+ * - Call after changing state that affects intrinsic size (text content,
+ *   children list, labels).
+ */
+void ui_element_invalidate_measure(ui_element *element);
+
+/*
+ * Mark an element's arrangement as stale without invalidating its size.
+ *
+ * Behavior:
+ * - Sets needs_arrange on element and every ancestor so the next layout pass
+ *   reaches it.
+ */
+void ui_element_invalidate_arrange(ui_element *element);
+
+/*
+ * Return true when element or one of its descendants is waiting for a layout
+ * pass.
+ */
+bool ui_element_needs_layout(const ui_element *element);
+
+/*
+ * Return the element's own next_frame_delay, or UI_NO_FRAME_REQUEST when
+ * element is NULL, hidden, disabled, or has no next_frame_delay op. Use
+ * ui_traversal_next_frame_delay to include descendants.
+ */
+float ui_element_next_frame_delay(const ui_element *element);
+
+/*
+ * Combine two next_frame_delay results, returning the earlier request.
+ */
+float ui_element_earliest_frame_delay(float a, float b);
+
+/*
+ * Forward a hover update to element's update_hover op.
+ * No-op for NULL elements or elements without the op.
+ */
+void ui_element_update_hover(ui_element *element, const SDL_FPoint *point);
+
+/*
+ * Move a container's hovered-child slot to next and forward point to it.
+ *
+ * Behavior:
+ * - When next differs from *hovered_child, the previous child gets a leave
+ *   (NULL point) before the slot changes.
+ * - next (which may be the unchanged child) then receives point.
+ * - Passing next == NULL with point == NULL clears the slot after a leave.
+ */
+void ui_element_set_hovered_child(ui_element **hovered_child, ui_element *next,
+                                  const SDL_FPoint *point);
+
+/*
+ * Show or hide an element.
+ *
+ * Hidden elements are skipped by render and layout passes. Showing an element
+ * again invalidates its measure so the next layout pass brings it up to date.
+ * Either transition invalidates rendering.
+ */
+void ui_element_set_visible(ui_element *element, bool visible);
+
+/*
+ * Mark every cached window-space rect as stale.
+ *
+ * Behavior:
+ * - O(1): bumps a global epoch; each element recomputes its cached rect lazily
+ *   on the next ui_element_screen_rect() call.
+ * - Prefer ui_element_invalidate_subtree_screen_rects() when the moved element
+ *   is known; this is for changes that cannot be pinned to one subtree.
+ */
+void ui_element_invalidate_screen_rects(void);
+
+/*
+ * Mark the cached window-space rects of element and its descendants as stale.
+ *
+ * Behavior:
+ * - Other subtrees keep their caches. The walk stops at elements whose cache
+ *   was already dropped, so it only costs the caches it clears.
+ * - Bumps the screen-rect and render generations like the global variant.
+ * - ui_element_arrange(), scroll offset changes, window resizes and
+ *   reparenting call this for the element they move.
+ * - Direct rect writes are picked up by ui_element_sync_screen_rect() on the
+ *   next ui_traversal_update(); align changes, and code that needs
+ *   screen-space results before that, must call this itself.
+ */
+void ui_element_invalidate_subtree_screen_rects(ui_element *element);
+
+/*
+ * Invalidate element's subtree when its rect no longer matches the rect its
+ * cached screen rect was computed from. O(1) when nothing moved or nothing is
+ * cached; run by ui_element_arrange() and for every element by
+ * ui_traversal_update().
+ */
+void ui_element_sync_screen_rect(ui_element *element);
+
+/*
+ * Return the current screen-rect generation. Caches derived from screen rects
+ * (for example hit-test grids) are stale once this value changes.
+ */
+Uint64 ui_element_screen_rect_generation(void);
+
+/*
+ * Request a repaint after an element's visual state changed.
+ *
+ * Behavior:
+ * - Bumps a global render generation that retained rendering in ui_runtime
+ *   compares against; any bump forces the next frame to be re-recorded.
+ * - Layout and screen-rect invalidation imply a render invalidation, so
+ *   widgets only need this for purely visual state (pressed, checked, caret,
+ *   colors, labels that do not change size).
+ */
+void ui_element_invalidate_render(const ui_element *element);
+
+/*
+ * Return the current render generation. Unchanged values between two frames
+ * mean no element requested a repaint in between.
+ */
+Uint64 ui_element_render_generation(void);
+
 /*
  * Configure an optional border for an element.
  *
@@ -173,9 +420,17 @@ void ui_element_render_inner_border(SDL_Renderer *renderer, const SDL_FRect *rec
 /*
  * Compute the absolute (window-space) rectangle for an element.
  *
- * Walks the parent chain, applying each ancestor's alignment and offset to
- * convert the element's parent-relative rect into absolute window coordinates.
- * When parent is NULL the rect is returned as-is (already absolute).
+ * Applies each ancestor's alignment and offset to convert the element's
+ * parent-relative rect into absolute window coordinates. When parent is NULL
+ * the rect is returned as-is (already absolute).
+ *
+ * Results are cached per element together with the rect they were computed
+ * from, and reused until the element's subtree or the whole tree is
+ * invalidated or its own rect no longer matches. A stale element only
+ * recomputes from its parent's cached rect, so each element is resolved at most
+ * once per invalidation and render/hit-test lookups stay O(1) regardless of
+ * tree depth. A direct write to an ancestor's rect reaches descendants on the
+ * next ui_traversal_update() or subtree invalidation.
  *
  * Returns: SDL_FRect with absolute x, y and the element's own w, h.
  */
@@ -196,8 +451,13 @@ bool ui_element_hit_test(const ui_element *element, const SDL_FPoint *point);
  * Run one element's measure pass.
  *
  * Behavior:
- * - Dispatches to ops->measure when provided.
- * - Otherwise keeps current rect size (fixed-size default).
+ * - Skipped for hidden elements (visible == false).
+ * - Memoized: when the element is clean, available_rect has the same size as
+ *   last time and rect size still matches the last result, the previous
+ *   result is reused without calling ops->measure (so clean container
+ *   subtrees are not visited).
+ * - Otherwise dispatches to ops->measure when provided, or keeps current rect
+ *   size (fixed-size default).
  */
 void ui_element_measure(ui_element *element, const SDL_FRect *available_rect);
 
@@ -205,8 +465,11 @@ void ui_element_measure(ui_element *element, const SDL_FRect *available_rect);
  * Run one element's arrange pass.
  *
  * Behavior:
- * - Dispatches to ops->arrange when provided.
- * - Otherwise copies final_rect into element->rect.
+ * - Skipped for hidden elements (visible == false).
+ * - Skipped when the element is clean, final_rect matches the previous pass
+ *   and rect was not modified since; clean subtrees are not visited.
+ * - Otherwise dispatches to ops->arrange when provided, or copies final_rect
+ *   into element->rect, then invalidates cached screen rects.
  */
 void ui_element_arrange(ui_element *element, const SDL_FRect *final_rect);
 
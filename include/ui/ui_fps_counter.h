@@ -2,6 +2,7 @@
 #define UI_FPS_COUNTER_H
 
 #include "ui/ui_element.h"
+#include "ui/ui_text_run.h"
 
 /*
  * Live FPS label element anchored near the viewport's bottom-right corner.
@@ -21,12 +22,14 @@ typedef struct ui_fps_counter
     float displayed_fps;
     float padding;
     char label[32];
+    ui_text_run label_run;
 } ui_fps_counter;
 
 /*
  * Create a bottom-right FPS counter element.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - viewport_width/viewport_height: dimensions used for anchoring
  * - padding: inset from right/bottom edges in pixels
  * - color: text color
@@ -39,9 +42,12 @@ typedef struct ui_fps_counter
  *   with `align_h=UI_ALIGN_RIGHT` and `align_v=UI_ALIGN_BOTTOM`.
  *
  * Update requirement: ui_runtime_update must be called each frame with a real
- * delta_seconds value, otherwise FPS output will not be meaningful.
+ * delta_seconds value, otherwise FPS output will not be meaningful. The
+ * counter requests a frame every refresh interval, so in event-driven idle
+ * mode it reports the rate frames are actually produced.
  */
-ui_fps_counter *ui_fps_counter_create(int viewport_width, int viewport_height, float padding,
-                                      SDL_Color color, const SDL_Color *border_color);
+ui_fps_counter *ui_fps_counter_create(const cui_allocator *allocator, int viewport_width,
+                                      int viewport_height, float padding, SDL_Color color,
+                                      const SDL_Color *border_color);
 
 #endif
@@ -0,0 +1,43 @@
+#ifndef UI_GLYPH_ATLAS_H
+#define UI_GLYPH_ATLAS_H
+
+#include <SDL3/SDL.h>
+
+// Cell size and advance of the default face, matching SDL's 8x8 debug font.
+#define UI_GLYPH_ATLAS_CELL_SIZE 8
+
+/*
+ * Glyph atlas for the default text face.
+ *
+ * Why this exists: SDL_RenderDebugText rebuilds glyph geometry on every call
+ * and binds its own font texture, so a text-heavy frame costs one draw call
+ * per label. Rasterizing the face once into a texture lets ui_render emit a
+ * whole frame's text as a few SDL_RenderGeometry quad batches.
+ *
+ * Behavior/contract:
+ * - The atlas is built lazily on first use per renderer by drawing every
+ *   codepoint U+0000-U+00FF (plus U+FFFD for everything above) with
+ *   SDL_RenderDebugText into a target texture. The pixels are then read back
+ *   into a static texture, so glyphs are identical to the debug font and
+ *   survive render target resets.
+ * - Glyphs are white with alpha coverage; vertex colors tint them.
+ * - The texture is owned by the renderer (stored in its properties) and goes
+ *   away with it.
+ */
+
+/*
+ * Return the atlas texture for renderer, building it on first use.
+ *
+ * Return value:
+ * - NULL when renderer is NULL or the atlas cannot be built (no render target
+ *   support); callers fall back to SDL_RenderDebugText. A failed build is not
+ *   retried for the same renderer.
+ */
+SDL_Texture *ui_glyph_atlas_get(SDL_Renderer *renderer);
+
+/*
+ * Return the normalized texture coordinates of codepoint's cell.
+ */
+SDL_FRect ui_glyph_atlas_uv(Uint32 codepoint);
+
+#endif
@@ -33,6 +33,7 @@ typedef struct ui_hrule
  *   wide, centered horizontally within the element's rect.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - thickness: vertical height of the rule in pixels (becomes rect.h)
  * - color: fill color of the line
  * - inset_fraction: fraction of rect.w to leave as padding on each side
@@ -46,6 +47,7 @@ typedef struct ui_hrule
  * - Caller owns the returned pointer until transferred to a layout container
  *   or ui_runtime.
  */
-ui_hrule *ui_hrule_create(float thickness, SDL_Color color, float inset_fraction);
+ui_hrule *ui_hrule_create(const cui_allocator *allocator, float thickness, SDL_Color color,
+                          float inset_fraction);
 
 #endif
@@ -29,6 +29,7 @@ typedef struct ui_image
  * aspect-ratio preservation is performed.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - renderer:  active SDL renderer used to create the texture
  * - x, y:     top-left position in window coordinates
  * - w, h:     display width and height in window coordinates
@@ -40,7 +41,7 @@ typedef struct ui_image
  * Ownership transfers to caller (or ui_runtime after ui_runtime_add
  * succeeds).
  */
-ui_image *ui_image_create(SDL_Renderer *renderer, float x, float y, float w, float h,
-                          const char *file_path, const SDL_Color *border_color);
+ui_image *ui_image_create(const cui_allocator *allocator, SDL_Renderer *renderer, float x, float y,
+                          float w, float h, const char *file_path, const SDL_Color *border_color);
 
 #endif
@@ -1,6 +1,8 @@
 #ifndef UI_LAYOUT_CONTAINER_H
 #define UI_LAYOUT_CONTAINER_H
 
+#include "system/ui_handle.h"
+#include "system/ui_spatial_index.h"
 #include "ui/ui_element.h"
 
 #include <stddef.h>
@@ -25,6 +27,15 @@ typedef enum ui_layout_axis
  *
  * This is intentional for v1 to keep the API and implementation small in this
  * learning-oriented project.
+ *
+ * Pointer events are routed like ui_window: the child that handles a left
+ * press captures motion/release, and other pointer events only reach children
+ * under the pointer, found through hit_index. hovered_child follows the
+ * update_hover op the same way as ui_window.
+ *
+ * Removal leaves NULL holes in `children` and compacts them the same way as
+ * ui_window, and captured_child is likewise a ui_handle: rows are routinely
+ * destroyed by callbacks fired from inside their own event dispatch.
  */
 typedef struct ui_layout_container
 {
@@ -33,7 +44,11 @@ typedef struct ui_layout_container
     ui_element **children;
     size_t child_count;
     size_t child_capacity;
+    size_t hole_count;
     ui_element *focused_child;
+    ui_handle captured_child;
+    ui_element *hovered_child;
+    ui_spatial_index hit_index;
 } ui_layout_container;
 
 /*
@@ -54,6 +69,7 @@ typedef struct ui_layout_container
  *   performed in this version.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - rect: container bounds in window coordinates (must be non-NULL)
  * - axis: layout direction for child placement
  * - border_color: optional border color around container bounds (NULL disables)
@@ -66,16 +82,19 @@ typedef struct ui_layout_container
  * - Caller owns the returned pointer until transferred to ui_runtime via
  *   ui_runtime_add.
  * - The container owns every child added through ui_layout_container_add_child.
- * - Destroying the container destroys all registered children.
+ * - Destroying the container with ui_traversal_destroy destroys all registered
+ *   children.
  */
-ui_layout_container *ui_layout_container_create(const SDL_FRect *rect, ui_layout_axis axis,
+ui_layout_container *ui_layout_container_create(const cui_allocator *allocator,
+                                                const SDL_FRect *rect, ui_layout_axis axis,
                                                 const SDL_Color *border_color);
 
 /*
  * Add one child element to a layout container.
  *
  * Purpose:
- * - Register a child for automatic layout and event/update/render forwarding.
+ * - Register a child for automatic layout, event forwarding and ui_traversal
+ *   update/render passes.
  *
  * Behavior/Contract:
  * - Children are processed in insertion order.
@@ -106,7 +125,7 @@ bool ui_layout_container_add_child(ui_layout_container *container, ui_element *c
  * Parameters:
  * - container: source layout container
  * - child: child pointer previously added to this container
- * - destroy_child: when true, call child->ops->destroy before returning
+ * - destroy_child: when true, destroy the child and its subtree before returning
  *
  * Returns:
  * - true when a child was found and removed
@@ -115,6 +134,20 @@ bool ui_layout_container_add_child(ui_layout_container *container, ui_element *c
 bool ui_layout_container_remove_child(ui_layout_container *container, ui_element *child,
                                       bool destroy_child);
 
+/*
+ * Remove several children at once, compacting the child array a single time.
+ *
+ * Behavior:
+ * - Same per-child rules as ui_layout_container_remove_child; entries that
+ *   are NULL or not children of container are skipped.
+ * - Preserves relative order of remaining children.
+ *
+ * Returns the number of children removed.
+ */
+size_t ui_layout_container_remove_children(ui_layout_container *container,
+                                           ui_element *const *children, size_t count,
+                                           bool destroy_children);
+
 /*
  * Remove all children from a layout container.
  *
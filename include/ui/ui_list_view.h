@@ -0,0 +1,152 @@
+#ifndef UI_LIST_VIEW_H
+#define UI_LIST_VIEW_H
+
+#include "system/ui_handle.h"
+#include "ui/ui_element.h"
+
+#include <stddef.h>
+
+/*
+ * How ui_list_view interprets its row height.
+ * - FIXED: every row is exactly row_height tall; positions are computed, so
+ *   the list keeps no per-row state at all.
+ * - ESTIMATED: row_height is a first guess for rows never shown; a row's
+ *   measured height replaces the guess once it is bound. Costs one double per
+ *   row and O(log n) position lookups.
+ */
+typedef enum ui_list_view_height_mode
+{
+    UI_LIST_VIEW_FIXED_HEIGHT,
+    UI_LIST_VIEW_ESTIMATED_HEIGHT,
+} ui_list_view_height_mode;
+
+/*
+ * Callbacks connecting a list view to the data it displays.
+ *
+ * - create_row: build one unbound row widget (required). Called only when no
+ *   recycled row is available, so roughly once per visible row.
+ * - bind_row: make row display item index (required).
+ * - unbind_row: row stops displaying index, either because it scrolled out
+ *   and is kept for reuse or because it is about to be bound again after the
+ *   data changed (optional). Not called when the list is destroyed; rows are
+ *   destroyed with it.
+ * - context: passed back to every callback.
+ */
+typedef struct ui_list_view_adapter
+{
+    ui_element *(*create_row)(void *context);
+    void (*bind_row)(void *context, ui_element *row, size_t index);
+    void (*unbind_row)(void *context, ui_element *row, size_t index);
+    void *context;
+} ui_list_view_adapter;
+
+/*
+ * Virtualized vertical list: a scrollable viewport over row_count items that
+ * only instantiates the rows it shows.
+ *
+ * Why this exists: a list built from one container row per item costs time
+ * and memory in the item count, while only the rows inside the viewport can
+ * be seen. The list view keeps widgets for the rows intersecting the viewport
+ * plus overscan rows on each side, and when scrolling moves a row out it is
+ * unbound and reused for the row scrolling in.
+ *
+ * Behavior/contract:
+ * - Rows are stacked top to bottom at padding from the edges, spacing apart,
+ *   stretched to the inner width. Row positions are kept relative to the
+ *   viewport and the scroll offset is a double, so lists of millions of rows
+ *   place rows exactly.
+ * - Bound rows are the list's children (child_span), so update, render and
+ *   destroy reach them through ui_traversal; recycled rows are hidden from
+ *   every pass until bound again.
+ * - Pointer events are routed to the row under the cursor inside the viewport,
+ *   with press capture as in ui_layout_container; the mouse wheel scrolls.
+ *   Rows do not take keyboard focus.
+ * - Callbacks may change the list (for example a row's delete button calling
+ *   ui_list_view_set_row_count); rows are only recycled, never destroyed,
+ *   while the list lives.
+ */
+typedef struct ui_list_view
+{
+    ui_element base;
+    ui_list_view_adapter adapter;
+    size_t row_count;
+    ui_list_view_height_mode height_mode;
+    float row_height;
+    // ESTIMATED only: Fenwick tree of per-row pitch (height + spacing).
+    double *pitch_tree;
+    size_t overscan;
+    float padding;
+    float spacing;
+    double scroll_offset;
+    float scroll_step;
+    // rows[i] displays item first_index + i.
+    ui_element **rows;
+    size_t first_index;
+    size_t bound_count;
+    size_t row_capacity;
+    ui_element **spare_rows;
+    size_t spare_count;
+    size_t spare_capacity;
+    ui_element *hovered_row;
+    ui_handle captured_row;
+} ui_list_view;
+
+/*
+ * Create a list view.
+ *
+ * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc). Rows come
+ *   from adapter->create_row and are destroyed with the list.
+ * - rect: viewport bounds in parent coordinates.
+ * - row_count: number of items.
+ * - height_mode/row_height: fixed row height or first estimate (> 0).
+ * - overscan: rows kept bound above and below the viewport.
+ * - adapter: row callbacks (copied).
+ * - border_color: optional border around the viewport (NULL disables).
+ *
+ * Returns NULL on invalid arguments or allocation failure.
+ * Ownership transfers to caller (or to ui_runtime after ui_runtime_add).
+ */
+ui_list_view *ui_list_view_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                                  size_t row_count, ui_list_view_height_mode height_mode,
+                                  float row_height, size_t overscan,
+                                  const ui_list_view_adapter *adapter,
+                                  const SDL_Color *border_color);
+
+/*
+ * Set the gap between the viewport edges and the rows (padding) and between
+ * consecutive rows (spacing). Both default to 0.
+ */
+void ui_list_view_set_spacing(ui_list_view *list, float padding, float spacing);
+
+/*
+ * Change the number of items and rebind every bound row, since items may have
+ * moved. The scroll offset is kept, clamped to the new content height.
+ *
+ * In ESTIMATED mode heights are kept per index: rows below both counts keep
+ * their measured height and added rows start at the estimate, so the cost is
+ * O(rows added + log n). Bound rows are measured again after rebinding.
+ *
+ * Returns false on invalid arguments or allocation failure. If the rows for
+ * the new count could not be created, the new count is kept but no rows are
+ * bound until a later call succeeds.
+ */
+bool ui_list_view_set_row_count(ui_list_view *list, size_t row_count);
+
+/*
+ * Rebind every bound row after item contents changed in place.
+ */
+void ui_list_view_refresh(ui_list_view *list);
+
+/*
+ * Scroll so that row index starts at the top of the viewport, or as close as
+ * the content height allows.
+ */
+void ui_list_view_scroll_to_row(ui_list_view *list, size_t index);
+
+/*
+ * Return the total content height in pixels (rows, spacing and padding).
+ */
+double ui_list_view_content_height(const ui_list_view *list);
+
+#endif
@@ -17,7 +17,9 @@ typedef struct ui_pane
  *
  * Why this exists: it provides a reusable container-like visual primitive
  * without requiring ad-hoc draw calls in main render code.
+ * allocator supplies the element's memory; pass NULL for malloc.
  */
-ui_pane *ui_pane_create(const SDL_FRect *rect, SDL_Color fill_color, const SDL_Color *border_color);
+ui_pane *ui_pane_create(const cui_allocator *allocator, const SDL_FRect *rect, SDL_Color fill_color,
+                        const SDL_Color *border_color);
 
 #endif
@@ -17,8 +17,8 @@
  *   the scroll view base element).
  * - Rendering is clipped to the viewport rect.
  *
- * Mouse events are only forwarded to the child when the cursor is inside
- * the viewport. Non-positional events (keyboard, text input) are always
+ * Mouse events and hover are only forwarded to the child when the cursor is
+ * inside the viewport. Non-positional events (keyboard, text input) are always
  * forwarded.
  */
 typedef struct ui_scroll_view
@@ -33,6 +33,7 @@ typedef struct ui_scroll_view
  * Create a scroll view wrapping a single child element.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - rect: viewport bounds in window coordinates. This is the visible area.
  * - child: the element to scroll. Its rect.h is read as the content height.
  *   Ownership transfers to the scroll view on success. child must be unparented
@@ -43,7 +44,8 @@ typedef struct ui_scroll_view
  * Returns a heap-allocated scroll view or NULL on failure.
  * Ownership transfers to caller (or to ui_runtime after ui_runtime_add).
  */
-ui_scroll_view *ui_scroll_view_create(const SDL_FRect *rect, ui_element *child, float scroll_step,
+ui_scroll_view *ui_scroll_view_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                                      ui_element *child, float scroll_step,
                                       const SDL_Color *border_color);
 
 #endif
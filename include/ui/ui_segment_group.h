@@ -2,6 +2,7 @@
 #define UI_SEGMENT_GROUP_H
 
 #include "ui/ui_element.h"
+#include "ui/ui_text_run.h"
 
 #include <stddef.h>
 
@@ -24,16 +25,21 @@ typedef void (*segment_group_change_handler)(size_t selected_index, const char *
  * The element rect defines the full clickable/rendered area. The control
  * renders equal-width segments and keeps exactly one active selection.
  *
- * Labels are borrowed pointers and are not copied by the widget.
+ * Labels are borrowed pointers and are not copied by the widget; label_runs
+ * (one per segment, owned) hold their metrics, measured at creation.
  */
 struct ui_segment_group
 {
     ui_element base;
     const char **labels;
+    ui_text_run *label_runs;
+    float max_label_width;
     size_t segment_count;
     size_t selected_index;
     bool has_pressed_segment;
     size_t pressed_index;
+    bool has_hovered_segment;
+    size_t hovered_index;
     SDL_Color base_color;
     SDL_Color selected_color;
     SDL_Color pressed_color;
@@ -50,8 +56,11 @@ struct ui_segment_group
  * - Left mouse press inside stores a pressed segment.
  * - Left mouse release inside commits selection to the segment under cursor.
  * - When the selected segment changes, on_change is invoked if non-NULL.
+ * - The unselected segment under the pointer is drawn halfway between
+ *   base_color and pressed_color while hovered.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - rect: full control bounds in window coordinates
  * - labels: array of borrowed C strings with segment_count entries
  * - segment_count: number of selectable segments (must be >= 1)
@@ -72,12 +81,14 @@ struct ui_segment_group
  * - Caller owns the returned pointer until transferring ownership to ui_runtime
  *   via ui_runtime_add, after which ui_runtime_destroy releases it.
  */
-ui_segment_group *
-ui_segment_group_create(const SDL_FRect *rect, const char **labels, size_t segment_count,
-                        size_t initial_selected_index, SDL_Color base_color,
-                        SDL_Color selected_color, SDL_Color pressed_color, SDL_Color text_color,
-                        SDL_Color selected_text_color, const SDL_Color *border_color,
-                        segment_group_change_handler on_change, void *on_change_context);
+ui_segment_group *ui_segment_group_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                                          const char **labels, size_t segment_count,
+                                          size_t initial_selected_index, SDL_Color base_color,
+                                          SDL_Color selected_color, SDL_Color pressed_color,
+                                          SDL_Color text_color, SDL_Color selected_text_color,
+                                          const SDL_Color *border_color,
+                                          segment_group_change_handler on_change,
+                                          void *on_change_context);
 
 /*
  * Read the current selected segment index.
@@ -29,6 +29,7 @@ typedef struct ui_slider
     SDL_Color thumb_color;
     SDL_Color active_thumb_color;
     bool is_dragging;
+    bool is_thumb_hovered;
     slider_change_handler on_change;
     void *on_change_context;
 } ui_slider;
@@ -40,8 +41,11 @@ typedef struct ui_slider
  * - Left mouse press inside slider starts drag and updates value immediately.
  * - While dragging, horizontal mouse motion updates value continuously.
  * - Left mouse release ends dragging.
+ * - The thumb is drawn halfway to active_thumb_color while the pointer is
+ *   over it.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - rect: slider bounds in window coordinates
  * - min_value/max_value: inclusive numeric range (must satisfy min_value < max_value)
  * - initial_value: initial slider value (clamped to range)
@@ -59,9 +63,10 @@ typedef struct ui_slider
  * - Caller owns the returned pointer until transferring ownership to ui_runtime
  *   via ui_runtime_add, after which ui_runtime_destroy releases it.
  */
-ui_slider *ui_slider_create(const SDL_FRect *rect, float min_value, float max_value,
-                            float initial_value, SDL_Color track_color, SDL_Color thumb_color,
-                            SDL_Color active_thumb_color, const SDL_Color *border_color,
-                            slider_change_handler on_change, void *on_change_context);
+ui_slider *ui_slider_create(const cui_allocator *allocator, const SDL_FRect *rect, float min_value,
+                            float max_value, float initial_value, SDL_Color track_color,
+                            SDL_Color thumb_color, SDL_Color active_thumb_color,
+                            const SDL_Color *border_color, slider_change_handler on_change,
+                            void *on_change_context);
 
 #endif
@@ -2,6 +2,11 @@
 #define UI_TEXT_H
 
 #include "ui/ui_element.h"
+#include "ui/ui_text_run.h"
+#include "util/string_pool.h"
+
+// Content up to this many bytes (terminator included) is stored in the element.
+#define UI_TEXT_INLINE_CAPACITY 32
 
 /*
  * Lightweight text element rendered with SDL_RenderDebugText.
@@ -11,39 +16,90 @@
  * - Rendering is vertically centered when rect.h is larger than glyph height.
  * This allows ui_text to align cleanly inside layout rows that stretch child
  * heights while preserving legacy behavior for fixed-height labels.
+ *
+ * run points at content and holds its metrics, refreshed only when the
+ * content changes.
+ *
+ * Storage: storage is inline_storage for short strings and an allocator-owned
+ * buffer of capacity bytes otherwise. Updates write in place and only
+ * allocate when the new content outgrows capacity, which then doubles; the
+ * buffer never shrinks, so a live-updating label stops allocating after its
+ * first few updates.
+ *
+ * content points at storage, or at a string shared from shared_pool after
+ * ui_text_set_interned; the element then holds one reference to it, dropped
+ * when the content is replaced or the element is destroyed. storage is kept
+ * meanwhile so switching back does not allocate.
  */
 typedef struct ui_text
 {
     ui_element base;
     SDL_Color color;
-    char *content;
+    const char *content;
+    char *storage;
+    size_t capacity;
+    string_pool *shared_pool;
+    ui_text_run run;
+    char inline_storage[UI_TEXT_INLINE_CAPACITY];
 } ui_text;
 
 /*
  * Create a text element at fixed coordinates.
  *
  * Content ownership: the input content string is copied into element-owned
- * storage, so the caller retains ownership of the input pointer.
+ * storage (taken from allocator, or malloc when NULL), so the caller retains
+ * ownership of the input pointer.
  * border_color is optional; pass NULL for no border.
  */
-ui_text *ui_text_create(float x, float y, const char *content, SDL_Color color,
-                        const SDL_Color *border_color);
+ui_text *ui_text_create(const cui_allocator *allocator, float x, float y, const char *content,
+                        SDL_Color color, const SDL_Color *border_color);
 
 /*
  * Replace the text element content.
  *
  * Behavior:
- * - Copies the provided string into element-owned storage.
- * - Updates the element width to fit the new content using debug glyph metrics.
+ * - Copies the provided string into element-owned storage, reusing the
+ *   current buffer when it is large enough (content may point into it).
+ * - Setting the current content again is a no-op and does not invalidate.
+ * - Re-measures the content once and resizes the element to fit it.
  *
- * Returns false on invalid arguments or allocation failure.
+ * Returns false on invalid arguments or allocation failure (the previous
+ * content is kept).
  */
 bool ui_text_set_content(ui_text *text, const char *content);
 
+/*
+ * Replace the content with printf-style formatted text.
+ *
+ * Formats straight into the element's buffer; only output longer than the
+ * current capacity grows it (and formats a second time). Arguments must not
+ * point into the element's own content. Otherwise behaves like
+ * ui_text_set_content, except that unchanged output still invalidates.
+ *
+ * Returns false on invalid arguments, a formatting error or allocation
+ * failure; the content is then left empty.
+ */
+bool ui_text_set_format(ui_text *text, SDL_PRINTF_FORMAT_STRING const char *format, ...)
+    SDL_PRINTF_VARARG_FUNC(2);
+
+/*
+ * Display an interned string without copying it.
+ *
+ * Behavior:
+ * - interned must come from string_pool_intern on pool; the element takes its
+ *   own reference, so the caller keeps (and must still release) its own.
+ * - pool must outlive the element or its next content change.
+ * - Content equal to the current text keeps the metrics and does not
+ *   invalidate, so rebinding an unchanged row is a pointer swap.
+ *
+ * Returns false on invalid arguments (the previous content is kept).
+ */
+bool ui_text_set_interned(ui_text *text, string_pool *pool, const char *interned);
+
 /*
  * Read the current text content.
  *
- * Returns a pointer to element-owned storage valid for the element lifetime.
+ * Returns a pointer valid until the content next changes.
  */
 const char *ui_text_get_content(const ui_text *text);
 
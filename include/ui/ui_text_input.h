@@ -2,11 +2,13 @@
 #define UI_TEXT_INPUT_H
 
 #include "ui/ui_element.h"
+#include "ui/ui_text_run.h"
 
 /*
- * Maximum buffer size for text input content (including null terminator).
- * The actual usable character count may be smaller depending on the element
- * width, since characters beyond the visible area are not accepted.
+ * Maximum buffer size in bytes for text input content (including null
+ * terminator). The actual usable character count may be smaller depending on
+ * the element width, since characters beyond the visible area are not
+ * accepted.
  */
 #define UI_TEXT_INPUT_BUFFER_SIZE 256
 
@@ -28,7 +30,9 @@ typedef void (*text_input_submit_handler)(const char *value, void *context);
  * When focused, a blinking caret is drawn at the end of the text.
  *
  * Editing: append-only. Characters are inserted at the end of the buffer.
- * Backspace deletes the last character. No cursor movement or selection.
+ * Backspace deletes the last character (a whole UTF-8 codepoint). No cursor
+ * movement or selection. length counts bytes; max_length and the visible
+ * limit count characters.
  *
  * The text input always renders a border; the border color changes to
  * indicate focus state.
@@ -38,6 +42,8 @@ typedef struct ui_text_input
     ui_element base;
     char buffer[UI_TEXT_INPUT_BUFFER_SIZE];
     char *placeholder;
+    ui_text_run text_run;
+    ui_text_run placeholder_run;
     size_t length;
     size_t max_length;
     bool is_focused;
@@ -56,6 +62,7 @@ typedef struct ui_text_input
  * Create a single-line text input field.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - rect: position and size in window coordinates. Width determines the
  *   initial maximum number of visible (and typeable) characters.
  * - text_color: color used for rendered text and the caret.
@@ -73,11 +80,12 @@ typedef struct ui_text_input
  * failure. Ownership transfers to caller (or to ui_runtime after a
  * successful ui_runtime_add call).
  */
-ui_text_input *ui_text_input_create(const SDL_FRect *rect, SDL_Color text_color,
-                                    SDL_Color background_color, SDL_Color border_color,
-                                    SDL_Color focused_border_color, const char *placeholder,
-                                    SDL_Color placeholder_color, SDL_Window *window,
-                                    text_input_submit_handler on_submit, void *on_submit_context);
+ui_text_input *ui_text_input_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                                    SDL_Color text_color, SDL_Color background_color,
+                                    SDL_Color border_color, SDL_Color focused_border_color,
+                                    const char *placeholder, SDL_Color placeholder_color,
+                                    SDL_Window *window, text_input_submit_handler on_submit,
+                                    void *on_submit_context);
 
 /*
  * Get the current text content of the input field.
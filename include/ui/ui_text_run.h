@@ -0,0 +1,64 @@
+#ifndef UI_TEXT_RUN_H
+#define UI_TEXT_RUN_H
+
+#include <SDL3/SDL.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Advance and line height of the default face (SDL's 8x8 debug font).
+#define UI_TEXT_GLYPH_WIDTH 8.0F
+#define UI_TEXT_GLYPH_HEIGHT 8.0F
+
+/*
+ * A string plus its measured metrics, shared by every text-bearing widget.
+ *
+ * Why this exists: widgets used to rescan their strings with strlen in
+ * measure and render, some of them every frame. A run is measured once when
+ * its content changes and then read for free; the measurement lives in one
+ * place so a proportional face only has to change ui_text_run_set.
+ *
+ * Behavior/contract:
+ * - text is borrowed: the owner (widget copy, caller literal, fixed buffer)
+ *   must keep it alive and unchanged until the next ui_text_run_set*. A NULL
+ *   string is stored as "".
+ * - byte_length excludes the terminator; glyph_count is the number of glyphs
+ *   drawn, one per UTF-8 codepoint (malformed sequences draw replacement
+ *   glyphs, as in SDL_RenderDebugText); width/height are the pixel
+ *   extents of one line of the default face (height is the glyph height even
+ *   for an empty run).
+ * - A zero-initialized run is not valid; call ui_text_run_set first.
+ */
+typedef struct ui_text_run
+{
+    const char *text;
+    size_t byte_length;
+    size_t glyph_count;
+    float width;
+    float height;
+} ui_text_run;
+
+/*
+ * Point run at text and measure it.
+ */
+void ui_text_run_set(ui_text_run *run, const char *text);
+
+/*
+ * Point run at the first byte_length bytes of text and measure them, for
+ * owners that already know the length (fixed buffers edited in place).
+ * text[byte_length] must be the terminator.
+ */
+void ui_text_run_set_length(ui_text_run *run, const char *text, size_t byte_length);
+
+/*
+ * Return true when run draws no glyphs.
+ */
+bool ui_text_run_is_empty(const ui_text_run *run);
+
+/*
+ * Return how many glyphs of the default face fit in width pixels (0 when
+ * width is not positive).
+ */
+size_t ui_text_run_glyphs_in_width(float width);
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef UI_WINDOW_H
 #define UI_WINDOW_H
 
+#include "system/ui_handle.h"
+#include "system/ui_spatial_index.h"
 #include "ui/ui_element.h"
 
 #include <stddef.h>
@@ -8,8 +10,17 @@
 /*
  * Root window element used as the page's top-level UI tree node.
  *
- * The window owns child elements and forwards measure/arrange/event/update/render
- * traversal to them.
+ * The window owns child elements, forwards measure/arrange/event handling to
+ * them and exposes them to ui_traversal's update/render passes. Pointer events
+ * are routed through hit_index, a grid over the children's screen rects, so
+ * only children under the pointer are tested.
+ * hovered_child is the topmost visible, enabled child under the pointer; it
+ * is maintained through the update_hover op rather than by event dispatch.
+ *
+ * Removal clears the child's slot in O(1) and leaves a NULL hole in
+ * `children`; `hole_count` holes are compacted in one order-preserving pass
+ * once they make up half the array. captured_child is a ui_handle because a
+ * child's handler may destroy it, or the whole window, mid-dispatch.
  */
 typedef struct ui_window
 {
@@ -17,14 +28,18 @@ typedef struct ui_window
     ui_element **children;
     size_t child_count;
     size_t child_capacity;
+    size_t hole_count;
     ui_element *focused_child;
-    ui_element *captured_child;
+    ui_handle captured_child;
+    ui_element *hovered_child;
+    ui_spatial_index hit_index;
 } ui_window;
 
 /*
  * Create a window-root element with the provided bounds.
  *
  * Parameters:
+ * - allocator: source of the element's memory (NULL for malloc)
  * - rect: root bounds in window coordinates (must be non-NULL with positive
  *   width and height).
  *
@@ -34,10 +49,10 @@ typedef struct ui_window
  *
  * Ownership/Lifecycle:
  * - Caller owns the returned pointer until transferred to ui_runtime.
- * - Destroying the window also destroys every child added through
- *   ui_window_add_child.
+ * - Destroying the window with ui_traversal_destroy also destroys every child
+ *   added through ui_window_add_child.
  */
-ui_window *ui_window_create(const SDL_FRect *rect);
+ui_window *ui_window_create(const cui_allocator *allocator, const SDL_FRect *rect);
 
 /*
  * Update the window-root bounds.
@@ -67,6 +82,16 @@ bool ui_window_add_child(ui_window *window, ui_element *child);
  */
 bool ui_window_remove_child(ui_window *window, ui_element *child, bool destroy_child);
 
+/*
+ * Remove several children at once, compacting the child array a single time.
+ *
+ * Entries that are NULL or not children of window are skipped. When
+ * destroy_children is true, each removed child is destroyed. Returns the number
+ * of children removed.
+ */
+size_t ui_window_remove_children(ui_window *window, ui_element *const *children, size_t count,
+                                 bool destroy_children);
+
 /*
  * Remove all children from the window root.
  *
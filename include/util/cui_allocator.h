@@ -0,0 +1,103 @@
+#ifndef CUI_ALLOCATOR_H
+#define CUI_ALLOCATOR_H
+
+#include <stddef.h>
+
+/*
+ * Pluggable allocator used by widget create functions, container child arrays
+ * and widget-owned strings.
+ *
+ * Purpose:
+ * - Let a page build its whole widget tree from one arena (or any other
+ *   strategy) instead of one malloc per widget and per string.
+ *
+ * Behavior/contract:
+ * - Every function taking `const cui_allocator *` treats NULL as the default
+ *   malloc/realloc/free allocator, so existing call sites keep heap semantics.
+ * - Callers pass the original allocation size back on reallocate/release so
+ *   size-class pools can be implemented without per-block headers.
+ * - Memory must stay valid until released or the allocator is torn down; the
+ *   allocator must outlive every element created with it.
+ */
+typedef struct cui_allocator
+{
+    void *(*allocate)(void *user_data, size_t size);
+    void *(*reallocate)(void *user_data, void *ptr, size_t old_size, size_t new_size);
+    void (*release)(void *user_data, void *ptr, size_t size);
+    void *user_data;
+} cui_allocator;
+
+/*
+ * Allocate size bytes. Returns NULL on failure or when size is 0.
+ */
+void *cui_alloc(const cui_allocator *allocator, size_t size);
+
+/*
+ * Resize an allocation made by the same allocator. ptr may be NULL (acts as
+ * cui_alloc). On failure returns NULL and leaves ptr untouched.
+ */
+void *cui_realloc(const cui_allocator *allocator, void *ptr, size_t old_size, size_t new_size);
+
+/*
+ * Release an allocation made by the same allocator. NULL ptr is ignored.
+ */
+void cui_free(const cui_allocator *allocator, void *ptr, size_t size);
+
+/*
+ * Copy a NUL-terminated string into allocator-owned storage.
+ * Release with cui_free_string. Returns NULL when source is NULL or on
+ * allocation failure.
+ */
+char *cui_strdup(const cui_allocator *allocator, const char *source);
+
+/*
+ * Release a string returned by cui_strdup. NULL string is ignored.
+ */
+void cui_free_string(const cui_allocator *allocator, char *string);
+
+typedef struct cui_arena_block cui_arena_block;
+
+/*
+ * Bump allocator that releases everything at once.
+ *
+ * Why this exists: a page that builds thousands of widgets and tears them all
+ * down together gains nothing from per-object free; an arena turns creation
+ * into pointer bumps and teardown into freeing a handful of blocks.
+ *
+ * Behavior/contract:
+ * - Allocations are carved from blocks of at least block_size bytes. Requests
+ *   larger than block_size get a block of their own, and small requests keep
+ *   filling the current block.
+ * - release only reclaims the most recent allocation; other frees are no-ops,
+ *   so memory from replaced strings or grown arrays is held until
+ *   cui_arena_destroy. Arenas suit trees that are built once per page.
+ * - Not thread-safe. The allocator interface points back at the arena, so an
+ *   initialized arena must not be moved or copied.
+ */
+typedef struct cui_arena
+{
+    cui_arena_block *blocks;
+    size_t block_size;
+    size_t bytes_reserved;
+    size_t bytes_used;
+    cui_allocator allocator;
+} cui_arena;
+
+/*
+ * Initialize an empty arena. block_size 0 selects a default (64 KiB).
+ */
+void cui_arena_init(cui_arena *arena, size_t block_size);
+
+/*
+ * Return the allocator interface backed by arena. The pointer stays valid for
+ * the arena's lifetime.
+ */
+const cui_allocator *cui_arena_allocator(cui_arena *arena);
+
+/*
+ * Free every block at once. All memory handed out by the arena becomes
+ * invalid. Safe to call with NULL; the arena may be re-initialized afterwards.
+ */
+void cui_arena_destroy(cui_arena *arena);
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include "util/cui_allocator.h"
+
+#include <stddef.h>
+
+// Power-of-two entry size classes recycled through per-class free lists.
+#define STRING_POOL_SIZE_CLASSES 24
+
+typedef struct string_pool_entry string_pool_entry;
+
+/*
+ * Memory and traffic counters for one pool, read with string_pool_get_stats.
+ *
+ * - live_strings/references: distinct strings held and references to them.
+ * - string_bytes: bytes of live strings, terminators included.
+ * - entry_bytes: size-class bytes backing live strings (headers included).
+ * - free_bytes: size-class bytes of released entries kept for reuse.
+ * - arena_bytes: bytes reserved from the heap by the backing arena.
+ * - table_bytes: bytes of the bucket array.
+ * - intern_calls/intern_hits: string_pool_intern calls and how many of them
+ *   found an existing copy.
+ */
+typedef struct string_pool_stats
+{
+    size_t live_strings;
+    size_t references;
+    size_t string_bytes;
+    size_t entry_bytes;
+    size_t free_bytes;
+    size_t arena_bytes;
+    size_t table_bytes;
+    size_t intern_calls;
+    size_t intern_hits;
+} string_pool_stats;
+
+/*
+ * Reference-counted pool of immutable interned strings.
+ *
+ * Why this exists: pages copied the same strings into their model and again
+ * into every widget that displays them, and rebuilt those copies on each
+ * rebuild. Interning keeps one canonical copy per distinct string; sharing it
+ * is a pointer copy plus a reference count bump.
+ *
+ * Behavior/contract:
+ * - Equal strings intern to the same pointer, so interned strings from one
+ *   pool can be compared by address.
+ * - Every string_pool_intern or string_pool_retain must be paired with one
+ *   string_pool_release. The last release unlinks the string and recycles
+ *   its entry for later strings of the same size class.
+ * - Entries are carved from an internal cui_arena; the hash table is a
+ *   separately allocated bucket array that doubles past a 3/4 load factor.
+ * - Interned strings must not be modified and stay valid until their last
+ *   release or string_pool_destroy.
+ * - Not thread-safe. The pool owns an arena, so an initialized pool must not
+ *   be moved or copied.
+ */
+typedef struct string_pool
+{
+    cui_arena arena;
+    string_pool_entry **buckets;
+    size_t bucket_count;
+    string_pool_entry *free_lists[STRING_POOL_SIZE_CLASSES];
+    string_pool_stats stats;
+} string_pool;
+
+/*
+ * Initialize an empty pool. Nothing is allocated until the first intern.
+ */
+void string_pool_init(string_pool *pool);
+
+/*
+ * Release every string and the table at once. Outstanding interned pointers
+ * become invalid. Safe to call with NULL; the pool may be re-initialized.
+ */
+void string_pool_destroy(string_pool *pool);
+
+/*
+ * Return the canonical copy of text, adding one reference to it.
+ *
+ * Returns NULL when pool or text is NULL or on allocation failure.
+ */
+const char *string_pool_intern(string_pool *pool, const char *text);
+
+/*
+ * Add a reference to a string returned by string_pool_intern on this pool and
+ * return it. NULL interned is ignored.
+ */
+const char *string_pool_retain(string_pool *pool, const char *interned);
+
+/*
+ * Drop one reference to a string interned in this pool. NULL interned is
+ * ignored.
+ */
+void string_pool_release(string_pool *pool, const char *interned);
+
+/*
+ * Return the byte length (terminator excluded) of an interned string in O(1).
+ */
+size_t string_pool_length(const char *interned);
+
+/*
+ * Copy the pool's current memory and traffic counters into out_stats.
+ */
+void string_pool_get_stats(const string_pool *pool, string_pool_stats *out_stats);
+
+#endif
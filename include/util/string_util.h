@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 
 /*
@@ -10,3 +11,51 @@
  * - Caller owns the returned pointer and must free() it.
  */
 char *duplicate_string(const char *source);
+
+/*
+ * UTF-8 scanning for text measurement and editing.
+ *
+ * Why this exists: widths are measured per codepoint, and a scalar decode
+ * loop on every measure is far slower than strlen. These scans process 16
+ * (SSE2, NEON) or 32 (AVX2) bytes per step, selected at compile time, with a
+ * scalar path for other targets and for the tail of each string.
+ *
+ * All functions take an explicit byte length and never read past it; text
+ * need not be NUL-terminated.
+ */
+
+/*
+ * Return true when the first length bytes of text are well-formed UTF-8
+ * (no overlong forms, surrogates, or codepoints above U+10FFFF, and no
+ * sequence cut off at the end). Pure ASCII blocks are skipped vectorized.
+ */
+bool utf8_is_valid(const char *text, size_t length);
+
+/*
+ * Return the number of codepoints in the first length bytes of text.
+ *
+ * Counts bytes that are not continuation bytes (10xxxxxx), which equals the
+ * codepoint count for valid UTF-8. Check utf8_is_valid first when the input
+ * is untrusted and an exact decode count matters.
+ */
+size_t utf8_count_codepoints(const char *text, size_t length);
+
+/*
+ * Return the byte length of the first codepoints codepoints of text, or
+ * length when text holds fewer. The result is always a codepoint boundary.
+ */
+size_t utf8_prefix_bytes(const char *text, size_t length, size_t codepoints);
+
+/*
+ * Return the last codepoint boundary at or before offset: offset itself when
+ * it starts a codepoint, otherwise the start of the codepoint containing it.
+ * Offsets at or past length return length.
+ *
+ * Backspace is utf8_floor_boundary(text, length, length - 1).
+ */
+size_t utf8_floor_boundary(const char *text, size_t length, size_t offset);
+
+/*
+ * Name of the vector path compiled in: "avx2", "sse2", "neon" or "scalar".
+ */
+const char *utf8_simd_backend(void);
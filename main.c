@@ -1,6 +1,12 @@
 #include <SDL3/SDL.h>
 
 #include "pages/app_page.h"
+#include "system/ui_clock.h"
+#include "system/ui_event_log.h"
+#include "system/ui_frame_profiler.h"
+#include "system/ui_input_coalescer.h"
+#include "system/ui_ops_profiler.h"
+#include "system/ui_render.h"
 #include "system/ui_runtime.h"
 #include "util/fail_fast.h"
 
@@ -15,6 +21,13 @@ static const int DEFAULT_WINDOW_HEIGHT = 768;
 static const int MIN_WINDOW_WIDTH = 640;
 static const int MIN_WINDOW_HEIGHT = 480;
 static const char *DEFAULT_PAGE_ID = "todo";
+static const Uint32 IDLE_FRAME_DELAY_MS = 16U;
+static const Sint32 MAX_IDLE_WAIT_MS = 60000;
+// Replay delta for a frame the log has no frame record for (a truncated log).
+static const Uint64 REPLAY_FRAME_NS = (Uint64)SDL_NS_PER_SECOND / 60U;
+
+// Page-specific `--name value` pairs kept for the selected page's configure op.
+#define MAX_PAGE_OPTIONS 16U
 
 typedef struct window_size
 {
@@ -26,6 +39,16 @@ typedef struct startup_options
 {
     window_size size;
     const char *page_id;
+    bool skip_idle_present;
+    bool full_redraw;
+    bool continuous;
+    bool profile;
+    bool render_stats;
+    const char *record_path;
+    const char *replay_path;
+    const char *page_option_names[MAX_PAGE_OPTIONS];
+    const char *page_option_values[MAX_PAGE_OPTIONS];
+    size_t page_option_count;
 } startup_options;
 
 static bool parse_positive_int(const char *value, int *out)
@@ -53,7 +76,9 @@ static bool parse_positive_int(const char *value, int *out)
 
 static void log_usage(const char *program_name)
 {
-    SDL_Log("Usage: %s [--page <id>] [-w|--width <width>] [-h|--height <height>] [--help]",
+    SDL_Log("Usage: %s [--page <id>] [-w|--width <width>] [-h|--height <height>] "
+            "[--skip-idle-present] [--full-redraw] [--continuous] [--profile] [--render-stats] "
+            "[--record <file> | --replay <file>] [--<page option> <value>] [--help]",
             program_name);
 }
 
@@ -83,6 +108,15 @@ static void log_help(const char *program_name)
     SDL_Log("      --page <id>        Select page to load (default: %s).", DEFAULT_PAGE_ID);
     SDL_Log("  -w, --width <width>    Set startup window width in pixels.");
     SDL_Log("  -h, --height <height>  Set startup window height in pixels.");
+    SDL_Log("      --skip-idle-present Skip drawing and presenting unchanged frames.");
+    SDL_Log("      --full-redraw      Repaint the whole window every frame.");
+    SDL_Log("      --continuous       Run frames back to back instead of idling between events.");
+    SDL_Log("      --profile          Log per-phase frame time percentiles on exit.");
+    SDL_Log("      --render-stats     Overlay each frame's draw call and state change counts.");
+    SDL_Log("      --record <file>    Write every frame's clock delta and input events to file.");
+    SDL_Log("      --replay <file>    Replay a recorded session with its recorded frame clock, "
+            "without vsync or idle waits, then exit.");
+    SDL_Log("      --<name> <value>   Pass a page-specific option (for example --stress-count).");
     SDL_Log("      --help             Show this help message.");
     log_available_pages();
 }
@@ -140,6 +174,57 @@ static parse_result parse_startup_options(int argc, char **argv, startup_options
             continue;
         }
 
+        const char **path = NULL;
+        if (strcmp(option, "--record") == 0)
+        {
+            path = &options->record_path;
+        }
+        else if (strcmp(option, "--replay") == 0)
+        {
+            path = &options->replay_path;
+        }
+        if (path != NULL)
+        {
+            if (i + 1 >= argc)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing value for option: %s", option);
+                log_usage(argv[0]);
+                return PARSE_RESULT_ERROR;
+            }
+            *path = argv[++i];
+            continue;
+        }
+
+        if (strcmp(option, "--skip-idle-present") == 0)
+        {
+            options->skip_idle_present = true;
+            continue;
+        }
+
+        if (strcmp(option, "--full-redraw") == 0)
+        {
+            options->full_redraw = true;
+            continue;
+        }
+
+        if (strcmp(option, "--continuous") == 0)
+        {
+            options->continuous = true;
+            continue;
+        }
+
+        if (strcmp(option, "--profile") == 0)
+        {
+            options->profile = true;
+            continue;
+        }
+
+        if (strcmp(option, "--render-stats") == 0)
+        {
+            options->render_stats = true;
+            continue;
+        }
+
         if (strcmp(option, "-w") == 0 || strcmp(option, "--width") == 0)
         {
             target = &options->size.width;
@@ -153,6 +238,15 @@ static parse_result parse_startup_options(int argc, char **argv, startup_options
             log_help(argv[0]);
             return PARSE_RESULT_HELP;
         }
+        else if (strncmp(option, "--", 2U) == 0 && i + 1 < argc &&
+                 options->page_option_count < MAX_PAGE_OPTIONS)
+        {
+            // Validated by the selected page once it is known.
+            options->page_option_names[options->page_option_count] = option;
+            options->page_option_values[options->page_option_count] = argv[++i];
+            options->page_option_count++;
+            continue;
+        }
         else
         {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown option: %s", option);
@@ -177,9 +271,83 @@ static parse_result parse_startup_options(int argc, char **argv, startup_options
         }
     }
 
+    if (options->record_path != NULL && options->replay_path != NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--record and --replay cannot be combined");
+        log_usage(argv[0]);
+        return PARSE_RESULT_ERROR;
+    }
+
     return PARSE_RESULT_OK;
 }
 
+/*
+ * Convert the earliest frame requested by widgets or the page into an
+ * SDL_WaitEventTimeout timeout. Returns -1 (wait for input) when nothing is
+ * scheduled.
+ */
+static Sint32 next_frame_timeout_ms(const ui_runtime *context, const app_page_entry *page,
+                                    void *page_instance)
+{
+    float delay = ui_runtime_next_frame_delay(context);
+    if (page->ops->next_frame_delay != NULL)
+    {
+        delay = ui_element_earliest_frame_delay(delay, page->ops->next_frame_delay(page_instance));
+    }
+    if (delay < 0.0F)
+    {
+        return -1;
+    }
+
+    const float timeout_ms = SDL_ceilf(delay * 1000.0F);
+    return timeout_ms < (float)MAX_IDLE_WAIT_MS ? (Sint32)timeout_ms : MAX_IDLE_WAIT_MS;
+}
+
+/*
+ * Draw the frame's render call counters in the top-left corner.
+ *
+ * Uses SDL directly rather than ui_render so the overlay does not count
+ * itself.
+ */
+static void render_call_stats_overlay(SDL_Renderer *renderer, const ui_render_call_stats *stats)
+{
+    char line[128];
+    SDL_snprintf(line, sizeof(line), "draws %llu  prims %llu  colors %llu  clips %llu  binds %llu",
+                 (unsigned long long)stats->draw_calls, (unsigned long long)stats->primitives,
+                 (unsigned long long)stats->color_changes,
+                 (unsigned long long)stats->clip_changes,
+                 (unsigned long long)stats->texture_binds);
+
+    const SDL_FRect background = {0.0F, 0.0F, ((float)SDL_strlen(line) * 8.0F) + 8.0F, 16.0F};
+    SDL_SetRenderClipRect(renderer, NULL);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    SDL_RenderFillRect(renderer, &background);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+    SDL_RenderDebugText(renderer, 4.0F, 4.0F, line);
+}
+
+static void add_render_call_stats(ui_render_call_stats *total, const ui_render_call_stats *frame)
+{
+    total->draw_calls += frame->draw_calls;
+    total->primitives += frame->primitives;
+    total->color_changes += frame->color_changes;
+    total->clip_changes += frame->clip_changes;
+    total->texture_binds += frame->texture_binds;
+}
+
+/*
+ * Fetch the next event for the current frame: from the replay log when
+ * replaying, otherwise from the SDL queue.
+ */
+static bool poll_frame_event(ui_event_log_reader *replay, Uint32 frame_index, SDL_Event *event)
+{
+    if (replay != NULL)
+    {
+        return ui_event_log_read(replay, frame_index, event, NULL);
+    }
+    return SDL_PollEvent(event);
+}
+
 /*
  * Application entry point.
  *
@@ -193,6 +361,14 @@ int main(int argc, char **argv)
     startup_options options = {
         .size = {DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT},
         .page_id = DEFAULT_PAGE_ID,
+        .skip_idle_present = false,
+        .full_redraw = false,
+        .continuous = false,
+        .profile = false,
+        .render_stats = false,
+        .record_path = NULL,
+        .replay_path = NULL,
+        .page_option_count = 0U,
     };
 
     const parse_result parse_args_result = parse_startup_options(argc, argv, &options);
@@ -217,6 +393,37 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    for (size_t i = 0U; i < options.page_option_count; ++i)
+    {
+        if (selected_page->ops->configure == NULL ||
+            !selected_page->ops->configure(options.page_option_names[i],
+                                           options.page_option_values[i]))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown option or invalid value: %s %s",
+                         options.page_option_names[i], options.page_option_values[i]);
+            log_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // A replay restores the recorded viewport and clock before anything reads them.
+    static ui_event_log_reader replay_log;
+    ui_event_log_reader *replay = NULL;
+    if (options.replay_path != NULL)
+    {
+        if (!ui_event_log_reader_open(&replay_log, options.replay_path))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open replay: %s", SDL_GetError());
+            return 1;
+        }
+        replay = &replay_log;
+        if (replay->header.width > 0 && replay->header.height > 0)
+        {
+            options.size = (window_size){replay->header.width, replay->header.height};
+        }
+        ui_clock_use_virtual(replay->header.wall_start_ns, replay->header.ticks_start_ns);
+    }
+
     // Initialize SDL video before creating any window or renderer objects.
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
@@ -248,7 +455,8 @@ int main(int argc, char **argv)
         return 1;
     }
 
-    SDL_SetRenderVSync(renderer, 1);
+    // Replays measure work per frame, so they run unthrottled.
+    SDL_SetRenderVSync(renderer, replay != NULL ? 0 : 1);
 
     // Map the render coordinate space to the logical window size so layout
     // code works in points (not physical pixels) on high-DPI displays.
@@ -268,12 +476,41 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    // Recording pins the page-visible clock to frame starts, so pseudo-random
+    // seeds and clock reads match what the replay will see.
+    static ui_event_log_writer record_log;
+    ui_event_log_writer *recorder = NULL;
+    if (options.record_path != NULL)
+    {
+        SDL_Time wall_start_ns = 0;
+        (void)SDL_GetCurrentTime(&wall_start_ns);
+        const ui_event_log_header header = {
+            .wall_start_ns = wall_start_ns,
+            .ticks_start_ns = SDL_GetTicksNS(),
+            .width = options.size.width,
+            .height = options.size.height,
+        };
+        if (!ui_event_log_writer_open(&record_log, options.record_path, &header))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open recording: %s",
+                         SDL_GetError());
+            ui_runtime_destroy(&context);
+            SDL_DestroyRenderer(renderer);
+            SDL_DestroyWindow(window);
+            SDL_Quit();
+            return 1;
+        }
+        recorder = &record_log;
+        ui_clock_use_virtual(header.wall_start_ns, header.ticks_start_ns);
+    }
+
     // Build and register the selected page.
     void *page_instance =
         selected_page->ops->create(window, &context, options.size.width, options.size.height);
     if (page_instance == NULL)
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create page: %s", selected_page->id);
+        (void)ui_event_log_writer_close(recorder);
         ui_runtime_destroy(&context);
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
@@ -281,29 +518,104 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    // Merges each frame's motion/wheel bursts before they reach the runtime.
+    ui_input_coalescer input;
+    (void)ui_input_coalescer_init(&input);
+
+    // Ring-buffered phase timings; every profiler call is a no-op on NULL, so
+    // frames cost nothing extra without --profile.
+    static ui_frame_profiler frame_profiler;
+    ui_frame_profiler *profiler = NULL;
+    if (options.profile && ui_frame_profiler_init(&frame_profiler))
+    {
+        profiler = &frame_profiler;
+    }
+
     bool running = true;
+    bool force_present = true;
+    window_size viewport = options.size;
     Uint64 previous_ns = SDL_GetTicksNS();
+    Uint32 frame_index = 0U;
+    ui_render_call_stats render_calls_total = {0};
+    Uint64 drawn_frames = 0U;
 
     while (running)
     {
-        // Compute frame delta once and pass it to the update phase.
+        // Phase 0: unless --continuous, sleep until input arrives or a widget/page
+        // frame request is due. Never sleep while an invalidated frame is undrawn.
+        // A replay never sleeps; live input only gets to close the window.
+        SDL_Event event;
+        bool has_event = false;
+        Uint64 replay_frame_ns = REPLAY_FRAME_NS;
+        if (replay != NULL)
+        {
+            while (SDL_PollEvent(&event))
+            {
+                if (event.type == SDL_EVENT_QUIT)
+                {
+                    running = false;
+                }
+            }
+            (void)ui_event_log_read_frame(replay, frame_index, &replay_frame_ns);
+            has_event = poll_frame_event(replay, frame_index, &event);
+        }
+        else if (options.continuous || force_present || !ui_runtime_can_replay(&context))
+        {
+            has_event = SDL_PollEvent(&event);
+        }
+        else
+        {
+            has_event = SDL_WaitEventTimeout(
+                &event, next_frame_timeout_ms(&context, selected_page, page_instance));
+        }
+
+        // Compute frame delta once and pass it to the update phase; a pinned
+        // clock advances by the same amount. Recording logs the delta, idle
+        // waits included, so the replay reproduces every clock read.
         const Uint64 current_ns = SDL_GetTicksNS();
-        const float delta_seconds = (float)(current_ns - previous_ns) / (float)SDL_NS_PER_SECOND;
+        const Uint64 frame_ns = replay != NULL ? replay_frame_ns : current_ns - previous_ns;
+        const float delta_seconds = (float)frame_ns / (float)SDL_NS_PER_SECOND;
         previous_ns = current_ns;
+        ui_clock_advance(frame_ns);
+        if (recorder != NULL)
+        {
+            (void)ui_event_log_write_frame(recorder, frame_index, frame_ns);
+        }
+        ui_frame_profiler_begin_frame(profiler);
 
-        // Phase 1: collect and dispatch SDL events.
-        SDL_Event event;
-        while (SDL_PollEvent(&event))
+        // Phase 1: collect SDL events; motion and wheel are merged per frame and
+        // dispatched in order with everything else.
+        for (; has_event; has_event = poll_frame_event(replay, frame_index, &event))
         {
+            if (recorder != NULL)
+            {
+                (void)ui_event_log_write(recorder, frame_index, ui_clock_ticks_ns(), &event);
+            }
             if (event.type == SDL_EVENT_QUIT)
             {
                 running = false;
                 continue;
             }
+            if (event.type == SDL_EVENT_WINDOW_EXPOSED)
+            {
+                // The compositor may have discarded our back buffer contents.
+                force_present = true;
+            }
+            if (event.type == SDL_EVENT_RENDER_TARGETS_RESET ||
+                event.type == SDL_EVENT_RENDER_DEVICE_RESET)
+            {
+                // Target texture contents (or the texture itself) were lost.
+                ui_runtime_discard_render_target(&context);
+                force_present = true;
+            }
             if (event.type == SDL_EVENT_WINDOW_RESIZED)
             {
+                // Pointer input that arrived before the resize targets the old layout.
+                ui_input_coalescer_flush(&input, &context);
+                force_present = true;
                 const int new_w = event.window.data1;
                 const int new_h = event.window.data2;
+                viewport = (window_size){new_w, new_h};
                 SDL_SetRenderLogicalPresentation(renderer, new_w, new_h,
                                                  SDL_LOGICAL_PRESENTATION_LETTERBOX);
                 if (!selected_page->ops->resize(page_instance, new_w, new_h))
@@ -313,7 +625,15 @@ int main(int argc, char **argv)
                     running = false;
                 }
             }
-            ui_runtime_handle_event(&context, &event);
+            ui_input_coalescer_push(&input, &context, &event);
+        }
+        ui_input_coalescer_flush(&input, &context);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_EVENTS);
+        frame_index++;
+        if (replay != NULL && ui_event_log_reader_at_end(replay))
+        {
+            // The frame holding the last recorded event still runs to completion.
+            running = false;
         }
 
         // Phase 2: page-specific per-frame logic (outside widget vtables).
@@ -323,20 +643,115 @@ int main(int argc, char **argv)
                          selected_page->id);
             running = false;
         }
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_PAGE_UPDATE);
 
         // Phase 3: widget updates via ui_runtime.
         ui_runtime_update(&context, delta_seconds);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_RUNTIME_UPDATE);
+
+        // Phase 3b: reflow only the subtrees invalidated by phases 1-3.
+        ui_runtime_layout(&context);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_LAYOUT);
 
-        // Phase 4: draw frame.
-        SDL_SetRenderDrawColor(renderer, color_bg.r, color_bg.g, color_bg.b, color_bg.a);
-        SDL_RenderClear(renderer);
-        ui_runtime_render(&context, renderer);
+        // Phase 4: draw frame. With --skip-idle-present, an unchanged frame is not
+        // redrawn; in continuous mode the delay stands in for the vsync wait that
+        // present provides.
+        if (options.skip_idle_present && !force_present && ui_runtime_can_replay(&context))
+        {
+            // Skipped frames still count, with a zero render phase.
+            ui_frame_profiler_end_frame(profiler);
+            ui_ops_profiler_end_frame();
+            (void)ui_render_end_frame();
+            if (options.continuous && replay == NULL)
+            {
+                SDL_Delay(IDLE_FRAME_DELAY_MS);
+            }
+            continue;
+        }
+        force_present = false;
+
+        // The UI is kept in a persistent target texture where only damaged regions
+        // are repainted; it falls back to a full repaint if the target is unavailable.
+        ui_render_clear(renderer, color_bg);
+        if (options.full_redraw || !ui_runtime_render_damaged(&context, renderer, viewport.width,
+                                                              viewport.height, color_bg))
+        {
+            ui_runtime_render(&context, renderer);
+        }
+        if (options.render_stats)
+        {
+            const ui_render_call_stats frame_calls = ui_render_get_call_stats();
+            render_call_stats_overlay(renderer, &frame_calls);
+        }
         SDL_RenderPresent(renderer);
+        ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_RENDER);
+        ui_frame_profiler_end_frame(profiler);
+        ui_ops_profiler_end_frame();
+        const ui_render_call_stats frame_calls = ui_render_end_frame();
+        add_render_call_stats(&render_calls_total, &frame_calls);
+        drawn_frames++;
+    }
+
+    const ui_runtime_render_stats render_stats = ui_runtime_get_render_stats(&context);
+    SDL_Log("Rendered frames: %llu recorded, %llu replayed (%zu commands in last recording)",
+            (unsigned long long)render_stats.recorded_frames,
+            (unsigned long long)render_stats.replayed_frames, render_stats.command_count);
+    SDL_Log("Target repaints: %llu partial, %llu full",
+            (unsigned long long)render_stats.partial_repaint_frames,
+            (unsigned long long)render_stats.full_repaint_frames);
+
+    if (drawn_frames > 0U)
+    {
+        const double frames = (double)drawn_frames;
+        SDL_Log("Render calls per drawn frame: %.1f draws, %.1f primitives, %.1f color, "
+                "%.1f clip, %.1f texture changes",
+                (double)render_calls_total.draw_calls / frames,
+                (double)render_calls_total.primitives / frames,
+                (double)render_calls_total.color_changes / frames,
+                (double)render_calls_total.clip_changes / frames,
+                (double)render_calls_total.texture_binds / frames);
+    }
+
+    const ui_input_coalescer_stats input_stats = ui_input_coalescer_get_stats(&input);
+    SDL_Log("Input events: %llu received, %llu dispatched (%llu motion, %llu wheel merged)",
+            (unsigned long long)input_stats.received_events,
+            (unsigned long long)input_stats.dispatched_events,
+            (unsigned long long)input_stats.merged_motion_events,
+            (unsigned long long)input_stats.merged_wheel_events);
+
+    if (recorder != NULL)
+    {
+        SDL_Log("Recorded %llu events over %u frames (%llu unsupported events skipped)",
+                (unsigned long long)recorder->written_events, (unsigned)frame_index,
+                (unsigned long long)recorder->skipped_events);
+        if (!ui_event_log_writer_close(recorder))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write recording: %s",
+                         options.record_path);
+        }
+    }
+    if (replay != NULL)
+    {
+        SDL_Log("Replayed %llu events over %u frames",
+                (unsigned long long)replay->read_events, (unsigned)frame_index);
+        if (replay->failed)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Replay log is truncated or corrupt: %s",
+                         options.replay_path);
+        }
+        ui_event_log_reader_close(replay);
+    }
+
+    if (profiler != NULL)
+    {
+        ui_frame_profiler_log_summary(profiler);
+        ui_ops_profiler_log_summary();
     }
 
     // Teardown order: page -> context -> renderer/window -> SDL runtime.
     selected_page->ops->destroy(page_instance);
     ui_runtime_destroy(&context);
+    ui_input_coalescer_destroy(&input);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
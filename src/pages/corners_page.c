@@ -57,7 +57,8 @@ static const anchored_button_spec BUTTON_SPECS[CORNER_BUTTON_COUNT] = {
 
 static void handle_corner_button_click(void *context) { (void)context; }
 
-static ui_button *create_anchored_button(const anchored_button_spec *spec)
+static ui_button *create_anchored_button(const cui_allocator *allocator,
+                                        const anchored_button_spec *spec)
 {
     if (spec == NULL)
     {
@@ -68,8 +69,8 @@ static ui_button *create_anchored_button(const anchored_button_spec *spec)
     const SDL_Color color_down = {76, 80, 92, 255};
     const SDL_Color border_color = {214, 214, 214, 255};
     ui_button *button = ui_button_create(
-        &(SDL_FRect){spec->offset_x, spec->offset_y, BUTTON_WIDTH, BUTTON_HEIGHT}, color_up,
-        color_down, spec->label, &border_color, handle_corner_button_click, NULL);
+        allocator, &(SDL_FRect){spec->offset_x, spec->offset_y, BUTTON_WIDTH, BUTTON_HEIGHT},
+        color_up, color_down, spec->label, &border_color, handle_corner_button_click, NULL);
     if (button == NULL)
     {
         fail_fast("corners_page: failed to create anchored button");
@@ -117,13 +118,14 @@ corners_page *corners_page_create(SDL_Window *window, ui_runtime *context, int v
         fail_fast("corners_page: failed to allocate page object");
     }
 
-    app_page_shell_init(&page->shell, context, viewport_width, viewport_height, "corners_page");
+    app_page_shell_init(&page->shell, context, viewport_width, viewport_height, NULL,
+                        "corners_page");
     page->viewport_width = viewport_width;
     page->viewport_height = viewport_height;
 
     for (size_t i = 0U; i < SDL_arraysize(page->buttons); ++i)
     {
-        page->buttons[i] = create_anchored_button(&BUTTON_SPECS[i]);
+        page->buttons[i] = create_anchored_button(page->shell.allocator, &BUTTON_SPECS[i]);
         if (page->buttons[i] == NULL)
         {
             fail_fast("corners_page: failed to create anchored button %zu", i);
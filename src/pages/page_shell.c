@@ -2,6 +2,7 @@
 
 #include "util/fail_fast.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 static void validate_page_name(const char *page_name)
@@ -17,6 +18,26 @@ static void fail_invalid_shell(const char *page_name, const char *action)
     fail_fast("%s: invalid page shell in %s", page_name, action);
 }
 
+static void grow_registrations(app_page_shell *shell, const char *page_name)
+{
+    const size_t new_capacity = shell->registered_capacity * 2U;
+    const bool is_inline = shell->registered_elements == shell->inline_registered;
+    ui_element **resized = (ui_element **)realloc(
+        is_inline ? NULL : (void *)shell->registered_elements, new_capacity * sizeof(*resized));
+    if (resized == NULL)
+    {
+        fail_fast("%s: failed to grow page shell registrations", page_name);
+    }
+
+    if (is_inline)
+    {
+        memcpy((void *)resized, (const void *)shell->inline_registered,
+               shell->registered_count * sizeof(*resized));
+    }
+    shell->registered_elements = resized;
+    shell->registered_capacity = new_capacity;
+}
+
 void app_page_shell_register_element(app_page_shell *shell, ui_element *element,
                                      const char *page_name)
 {
@@ -31,16 +52,16 @@ void app_page_shell_register_element(app_page_shell *shell, ui_element *element,
         fail_fast("%s: ui_runtime_add failed", page_name);
     }
 
-    if (shell->registered_count >= SDL_arraysize(shell->registered_elements))
+    if (shell->registered_count == shell->registered_capacity)
     {
-        fail_fast("%s: page shell registration capacity exceeded", page_name);
+        grow_registrations(shell, page_name);
     }
 
     shell->registered_elements[shell->registered_count++] = element;
 }
 
 void app_page_shell_init(app_page_shell *shell, ui_runtime *context, int viewport_width,
-                         int viewport_height, const char *page_name)
+                         int viewport_height, const cui_allocator *allocator, const char *page_name)
 {
     validate_page_name(page_name);
     if (shell == NULL || context == NULL || viewport_width <= 0 || viewport_height <= 0)
@@ -50,9 +71,12 @@ void app_page_shell_init(app_page_shell *shell, ui_runtime *context, int viewpor
 
     memset(shell, 0, sizeof(*shell));
     shell->context = context;
+    shell->allocator = allocator;
+    shell->registered_elements = shell->inline_registered;
+    shell->registered_capacity = SDL_arraysize(shell->inline_registered);
 
-    shell->window_root =
-        ui_window_create(&(SDL_FRect){0.0F, 0.0F, (float)viewport_width, (float)viewport_height});
+    shell->window_root = ui_window_create(
+        allocator, &(SDL_FRect){0.0F, 0.0F, (float)viewport_width, (float)viewport_height});
     if (shell->window_root == NULL)
     {
         fail_fast("%s: failed to create window root", page_name);
@@ -119,6 +143,10 @@ void app_page_shell_arrange_root(app_page_shell *shell, int viewport_width, int
         fail_invalid_shell(page_name, "app_page_shell_arrange_root");
     }
 
+    // Pages position window children by writing their rects directly, so the
+    // window pass must run; children whose rect did not change are skipped.
+    ui_element_invalidate_arrange((ui_element *)shell->window_root);
+
     const SDL_FRect window_root_rect = {0.0F, 0.0F, (float)viewport_width, (float)viewport_height};
     measure_and_arrange_element((ui_element *)shell->window_root, &window_root_rect, page_name);
 }
@@ -137,6 +165,12 @@ void app_page_shell_unregister_all(app_page_shell *shell, const char *page_name)
         (void)ui_runtime_remove(shell->context, element, true);
     }
 
+    if (shell->registered_elements != shell->inline_registered)
+    {
+        free((void *)shell->registered_elements);
+    }
+    shell->registered_elements = shell->inline_registered;
+    shell->registered_capacity = SDL_arraysize(shell->inline_registered);
     shell->registered_count = 0U;
     shell->window_root = NULL;
 }
@@ -19,6 +19,9 @@
 
 struct showcase_page
 {
+    // The widget tree is built once and torn down with the page, so every
+    // widget and widget string comes from this arena.
+    cui_arena arena;
     app_page_shell shell;
 
     int viewport_width;
@@ -125,9 +128,10 @@ static void handle_slider_change(float value, void *context)
         fail_fast("showcase_page: slider callback state is invalid");
     }
 
-    char slider_label[64];
-    SDL_snprintf(slider_label, sizeof(slider_label), "SLIDER VALUE: %.1f", value);
-    set_text_content(page->slider_value_text, slider_label);
+    if (!ui_text_set_format(page->slider_value_text, "SLIDER VALUE: %.1f", value))
+    {
+        fail_fast("showcase_page: failed to update slider value text");
+    }
 }
 
 static void handle_segment_change(size_t selected_index, const char *selected_label, void *context)
@@ -138,10 +142,11 @@ static void handle_segment_change(size_t selected_index, const char *selected_la
         fail_fast("showcase_page: segment callback state is invalid");
     }
 
-    char segment_label[80];
-    SDL_snprintf(segment_label, sizeof(segment_label), "SEGMENT %zu: %s", selected_index + 1U,
-                 selected_label);
-    set_text_content(page->segment_value_text, segment_label);
+    if (!ui_text_set_format(page->segment_value_text, "SEGMENT %zu: %s", selected_index + 1U,
+                            selected_label))
+    {
+        fail_fast("showcase_page: failed to update segment value text");
+    }
 }
 
 static void handle_text_input_submit(const char *value, void *context)
@@ -152,22 +157,17 @@ static void handle_text_input_submit(const char *value, void *context)
         fail_fast("showcase_page: text-input callback state is invalid");
     }
 
-    char submitted[160];
-    if (value[0] == '\0')
+    if (!ui_text_set_format(page->status_text, "INPUT SUBMIT: %s",
+                            value[0] == '\0' ? "(EMPTY)" : value))
     {
-        SDL_snprintf(submitted, sizeof(submitted), "INPUT SUBMIT: (EMPTY)");
+        fail_fast("showcase_page: failed to update input submit text");
     }
-    else
-    {
-        SDL_snprintf(submitted, sizeof(submitted), "INPUT SUBMIT: %s", value);
-    }
-
-    set_text_content(page->status_text, submitted);
 }
 
-static ui_text *create_text_label_or_fail(const char *content, SDL_Color color)
+static ui_text *create_text_label_or_fail(const cui_allocator *allocator, const char *content,
+                                          SDL_Color color)
 {
-    ui_text *label = ui_text_create(0.0F, 0.0F, content, color, NULL);
+    ui_text *label = ui_text_create(allocator, 0.0F, 0.0F, content, color, NULL);
     if (label == NULL)
     {
         fail_fast("showcase_page: failed to create text label");
@@ -176,9 +176,10 @@ static ui_text *create_text_label_or_fail(const char *content, SDL_Color color)
     return label;
 }
 
-static void add_text_label(ui_layout_container *content, const char *label, SDL_Color color)
+static void add_text_label(const cui_allocator *allocator, ui_layout_container *content,
+                           const char *label, SDL_Color color)
 {
-    ui_text *text = create_text_label_or_fail(label, color);
+    ui_text *text = create_text_label_or_fail(allocator, label, color);
     add_child_or_fail(content, (ui_element *)text);
 }
 
@@ -190,6 +191,7 @@ static ui_layout_container *create_showcase_content(showcase_page *page, SDL_Win
         fail_fast("showcase_page: invalid create_showcase_content input");
     }
 
+    const cui_allocator *allocator = page->shell.allocator;
     const SDL_Color color_ink = {31, 34, 44, 255};
     const SDL_Color color_muted = {92, 95, 110, 255};
     const SDL_Color color_line = {184, 186, 194, 255};
@@ -207,59 +209,61 @@ static ui_layout_container *create_showcase_content(showcase_page *page, SDL_Win
     const SDL_Color color_slider_thumb_active = {38, 46, 66, 255};
 
     ui_layout_container *content = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 720.0F, 1200.0F}, UI_LAYOUT_AXIS_VERTICAL, &color_border);
+        allocator, &(SDL_FRect){0.0F, 0.0F, 720.0F, 1200.0F}, UI_LAYOUT_AXIS_VERTICAL,
+        &color_border);
     if (content == NULL)
     {
         fail_fast("showcase_page: failed to create content container");
     }
 
-    add_text_label(content, "UI SHOWCASE PAGE", color_ink);
-    add_text_label(content, "Every built-in widget on one page", color_muted);
+    add_text_label(allocator, content, "UI SHOWCASE PAGE", color_ink);
+    add_text_label(allocator, content, "Every built-in widget on one page", color_muted);
 
-    ui_hrule *top_rule = ui_hrule_create(8.0F, color_line, 0.0F);
+    ui_hrule *top_rule = ui_hrule_create(allocator, 8.0F, color_line, 0.0F);
     if (top_rule == NULL)
     {
         fail_fast("showcase_page: failed to create top rule");
     }
     add_child_or_fail(content, (ui_element *)top_rule);
 
-    add_text_label(content, "UI_PANE", color_ink);
+    add_text_label(allocator, content, "UI_PANE", color_ink);
 
-    ui_pane *pane =
-        ui_pane_create(&(SDL_FRect){0.0F, 0.0F, 100.0F, 56.0F}, color_pane_fill, &color_border);
+    ui_pane *pane = ui_pane_create(allocator, &(SDL_FRect){0.0F, 0.0F, 100.0F, 56.0F},
+                                   color_pane_fill, &color_border);
     if (pane == NULL)
     {
         fail_fast("showcase_page: failed to create demo pane");
     }
     add_child_or_fail(content, (ui_element *)pane);
 
-    ui_hrule *controls_rule = ui_hrule_create(8.0F, color_line, 0.0F);
+    ui_hrule *controls_rule = ui_hrule_create(allocator, 8.0F, color_line, 0.0F);
     if (controls_rule == NULL)
     {
         fail_fast("showcase_page: failed to create controls rule");
     }
     add_child_or_fail(content, (ui_element *)controls_rule);
 
-    add_text_label(content, "UI_BUTTON + UI_CHECKBOX", color_ink);
+    add_text_label(allocator, content, "UI_BUTTON + UI_CHECKBOX", color_ink);
 
     ui_layout_container *controls_row = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 100.0F, 44.0F}, UI_LAYOUT_AXIS_HORIZONTAL, NULL);
+        allocator, &(SDL_FRect){0.0F, 0.0F, 100.0F, 44.0F}, UI_LAYOUT_AXIS_HORIZONTAL, NULL);
     if (controls_row == NULL)
     {
         fail_fast("showcase_page: failed to create controls row");
     }
 
-    ui_button *button = ui_button_create(&(SDL_FRect){0.0F, 0.0F, 160.0F, 32.0F}, color_button_up,
-                                         color_button_down, "CLICK BUTTON", &color_border,
-                                         handle_demo_button_click, page);
+    ui_button *button = ui_button_create(allocator, &(SDL_FRect){0.0F, 0.0F, 160.0F, 32.0F},
+                                         color_button_up, color_button_down, "CLICK BUTTON",
+                                         &color_border, handle_demo_button_click, page);
     if (button == NULL)
     {
         fail_fast("showcase_page: failed to create demo button");
     }
     add_child_or_fail(controls_row, (ui_element *)button);
 
-    page->checkbox = ui_checkbox_create(0.0F, 0.0F, "TOGGLE CHECKBOX", color_ink, color_ink,
-                                        color_ink, false, handle_checkbox_change, page, NULL);
+    page->checkbox = ui_checkbox_create(allocator, 0.0F, 0.0F, "TOGGLE CHECKBOX", color_ink,
+                                        color_ink, color_ink, false, handle_checkbox_change, page,
+                                        NULL);
     if (page->checkbox == NULL)
     {
         fail_fast("showcase_page: failed to create checkbox");
@@ -268,42 +272,43 @@ static ui_layout_container *create_showcase_content(showcase_page *page, SDL_Win
 
     add_child_or_fail(content, (ui_element *)controls_row);
 
-    page->checkbox_state_text = create_text_label_or_fail("CHECKBOX: OFF", color_muted);
+    page->checkbox_state_text = create_text_label_or_fail(allocator, "CHECKBOX: OFF", color_muted);
     add_child_or_fail(content, (ui_element *)page->checkbox_state_text);
 
-    ui_hrule *input_rule = ui_hrule_create(8.0F, color_line, 0.0F);
+    ui_hrule *input_rule = ui_hrule_create(allocator, 8.0F, color_line, 0.0F);
     if (input_rule == NULL)
     {
         fail_fast("showcase_page: failed to create input rule");
     }
     add_child_or_fail(content, (ui_element *)input_rule);
 
-    add_text_label(content, "UI_TEXT_INPUT", color_ink);
+    add_text_label(allocator, content, "UI_TEXT_INPUT", color_ink);
 
-    ui_text_input *text_input =
-        ui_text_input_create(&(SDL_FRect){0.0F, 0.0F, 520.0F, 36.0F}, color_ink, color_input_bg,
-                             color_border, color_focus_border, "Type and press Enter", color_muted,
-                             window, handle_text_input_submit, page);
+    ui_text_input *text_input = ui_text_input_create(
+        allocator, &(SDL_FRect){0.0F, 0.0F, 520.0F, 36.0F}, color_ink, color_input_bg, color_border,
+        color_focus_border, "Type and press Enter", color_muted, window, handle_text_input_submit,
+        page);
     if (text_input == NULL)
     {
         fail_fast("showcase_page: failed to create text input");
     }
     add_child_or_fail(content, (ui_element *)text_input);
 
-    page->status_text = create_text_label_or_fail("BUTTON/INPUT STATUS: READY", color_muted);
+    page->status_text = create_text_label_or_fail(allocator, "BUTTON/INPUT STATUS: READY",
+                                                  color_muted);
     add_child_or_fail(content, (ui_element *)page->status_text);
 
-    ui_hrule *segment_rule = ui_hrule_create(8.0F, color_line, 0.0F);
+    ui_hrule *segment_rule = ui_hrule_create(allocator, 8.0F, color_line, 0.0F);
     if (segment_rule == NULL)
     {
         fail_fast("showcase_page: failed to create segment rule");
     }
     add_child_or_fail(content, (ui_element *)segment_rule);
 
-    add_text_label(content, "UI_SEGMENT_GROUP", color_ink);
+    add_text_label(allocator, content, "UI_SEGMENT_GROUP", color_ink);
 
     page->segment_group = ui_segment_group_create(
-        &(SDL_FRect){0.0F, 0.0F, 420.0F, 36.0F}, SHOWCASE_SEGMENTS,
+        allocator, &(SDL_FRect){0.0F, 0.0F, 420.0F, 36.0F}, SHOWCASE_SEGMENTS,
         SDL_arraysize(SHOWCASE_SEGMENTS), 0U, color_segment_bg, color_segment_selected,
         color_segment_pressed, color_ink, (SDL_Color){244, 246, 255, 255}, &color_border,
         handle_segment_change, page);
@@ -313,55 +318,58 @@ static ui_layout_container *create_showcase_content(showcase_page *page, SDL_Win
     }
     add_child_or_fail(content, (ui_element *)page->segment_group);
 
-    page->segment_value_text = create_text_label_or_fail("SEGMENT 1: FIRST", color_muted);
+    page->segment_value_text = create_text_label_or_fail(allocator, "SEGMENT 1: FIRST",
+                                                         color_muted);
     add_child_or_fail(content, (ui_element *)page->segment_value_text);
 
-    ui_hrule *slider_rule = ui_hrule_create(8.0F, color_line, 0.0F);
+    ui_hrule *slider_rule = ui_hrule_create(allocator, 8.0F, color_line, 0.0F);
     if (slider_rule == NULL)
     {
         fail_fast("showcase_page: failed to create slider rule");
     }
     add_child_or_fail(content, (ui_element *)slider_rule);
 
-    add_text_label(content, "UI_SLIDER", color_ink);
+    add_text_label(allocator, content, "UI_SLIDER", color_ink);
 
-    page->slider = ui_slider_create(
-        &(SDL_FRect){0.0F, 0.0F, 420.0F, 30.0F}, 0.0F, 100.0F, 35.0F, color_slider_track,
-        color_slider_thumb, color_slider_thumb_active, &color_border, handle_slider_change, page);
+    page->slider = ui_slider_create(allocator, &(SDL_FRect){0.0F, 0.0F, 420.0F, 30.0F}, 0.0F,
+                                    100.0F, 35.0F, color_slider_track, color_slider_thumb,
+                                    color_slider_thumb_active, &color_border, handle_slider_change,
+                                    page);
     if (page->slider == NULL)
     {
         fail_fast("showcase_page: failed to create slider");
     }
     add_child_or_fail(content, (ui_element *)page->slider);
 
-    page->slider_value_text = create_text_label_or_fail("SLIDER VALUE: 35.0", color_muted);
+    page->slider_value_text = create_text_label_or_fail(allocator, "SLIDER VALUE: 35.0",
+                                                        color_muted);
     add_child_or_fail(content, (ui_element *)page->slider_value_text);
 
-    ui_hrule *image_rule = ui_hrule_create(8.0F, color_line, 0.0F);
+    ui_hrule *image_rule = ui_hrule_create(allocator, 8.0F, color_line, 0.0F);
     if (image_rule == NULL)
     {
         fail_fast("showcase_page: failed to create image rule");
     }
     add_child_or_fail(content, (ui_element *)image_rule);
 
-    add_text_label(content, "UI_IMAGE", color_ink);
+    add_text_label(allocator, content, "UI_IMAGE", color_ink);
 
-    ui_image *image =
-        ui_image_create(renderer, 0.0F, 0.0F, 120.0F, 120.0F, "assets/icon.png", &color_border);
+    ui_image *image = ui_image_create(allocator, renderer, 0.0F, 0.0F, 120.0F, 120.0F,
+                                      "assets/icon.png", &color_border);
     if (image == NULL)
     {
         fail_fast("showcase_page: failed to create image widget");
     }
     add_child_or_fail(content, (ui_element *)image);
 
-    ui_hrule *end_rule = ui_hrule_create(8.0F, color_line, 0.0F);
+    ui_hrule *end_rule = ui_hrule_create(allocator, 8.0F, color_line, 0.0F);
     if (end_rule == NULL)
     {
         fail_fast("showcase_page: failed to create end rule");
     }
     add_child_or_fail(content, (ui_element *)end_rule);
 
-    add_text_label(content, "END OF SHOWCASE", color_muted);
+    add_text_label(allocator, content, "END OF SHOWCASE", color_muted);
 
     handle_checkbox_change(ui_checkbox_is_checked(page->checkbox), page);
     handle_slider_change(page->slider->value, page);
@@ -432,11 +440,15 @@ showcase_page *showcase_page_create(SDL_Window *window, ui_runtime *context, int
 
     page->viewport_width = viewport_width;
     page->viewport_height = viewport_height;
-    app_page_shell_init(&page->shell, context, viewport_width, viewport_height, "showcase_page");
+    cui_arena_init(&page->arena, 0U);
+    const cui_allocator *allocator = cui_arena_allocator(&page->arena);
+    app_page_shell_init(&page->shell, context, viewport_width, viewport_height, allocator,
+                        "showcase_page");
 
     const SDL_Color color_bg = {243, 245, 250, 255};
     page->background = ui_pane_create(
-        &(SDL_FRect){0.0F, 0.0F, (float)viewport_width, (float)viewport_height}, color_bg, NULL);
+        allocator, &(SDL_FRect){0.0F, 0.0F, (float)viewport_width, (float)viewport_height},
+        color_bg, NULL);
     if (page->background == NULL)
     {
         fail_fast("showcase_page: failed to create background pane");
@@ -447,6 +459,7 @@ showcase_page *showcase_page_create(SDL_Window *window, ui_runtime *context, int
 
     const SDL_Color color_scroll_border = {206, 209, 217, 255};
     page->scroll_view = ui_scroll_view_create(
+        allocator,
         &(SDL_FRect){PAGE_MARGIN, PAGE_MARGIN, (float)viewport_width - (2.0F * PAGE_MARGIN),
                      (float)viewport_height - (2.0F * PAGE_MARGIN) - FOOTER_RESERVE},
         (ui_element *)content, MAIN_SCROLL_STEP, &color_scroll_border);
@@ -457,8 +470,8 @@ showcase_page *showcase_page_create(SDL_Window *window, ui_runtime *context, int
     add_window_child_or_fail(page, (ui_element *)page->scroll_view);
 
     const SDL_Color color_fps = {56, 61, 76, 255};
-    page->fps_counter =
-        ui_fps_counter_create(viewport_width, viewport_height, 16.0F, color_fps, NULL);
+    page->fps_counter = ui_fps_counter_create(allocator, viewport_width, viewport_height, 16.0F,
+                                              color_fps, NULL);
     if (page->fps_counter == NULL)
     {
         fail_fast("showcase_page: failed to create fps counter");
@@ -492,8 +505,7 @@ bool showcase_page_update(showcase_page *page)
         fail_fast("showcase_page_update called with NULL page");
     }
 
-    const showcase_page_layout layout = compute_page_geometry(page);
-    arrange_page_layout(page, &layout);
+    // Widget setters invalidate layout; ui_runtime_layout reflows after updates.
     return true;
 }
 
@@ -505,6 +517,9 @@ void showcase_page_destroy(showcase_page *page)
     }
 
     unregister_elements(page);
+    // Destroy ops ran above (textures, text input state); the widget memory
+    // itself goes back in one step.
+    cui_arena_destroy(&page->arena);
     free(page);
 }
 
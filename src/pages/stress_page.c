@@ -0,0 +1,585 @@
+#include "pages/stress_page.h"
+
+#include "pages/page_shell.h"
+#include "system/ui_traversal.h"
+#include "ui/ui_button.h"
+#include "ui/ui_checkbox.h"
+#include "ui/ui_fps_counter.h"
+#include "ui/ui_hrule.h"
+#include "ui/ui_image.h"
+#include "ui/ui_layout_container.h"
+#include "ui/ui_pane.h"
+#include "ui/ui_scroll_view.h"
+#include "ui/ui_segment_group.h"
+#include "ui/ui_slider.h"
+#include "ui/ui_text.h"
+#include "ui/ui_text_input.h"
+#include "util/fail_fast.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum stress_leaf_kind
+{
+    STRESS_LEAF_TEXT = 0,
+    STRESS_LEAF_BUTTON,
+    STRESS_LEAF_CHECKBOX,
+    STRESS_LEAF_PANE,
+    STRESS_LEAF_SLIDER,
+    STRESS_LEAF_SEGMENT_GROUP,
+    STRESS_LEAF_HRULE,
+    STRESS_LEAF_TEXT_INPUT,
+    STRESS_LEAF_SCROLL_VIEW,
+    STRESS_LEAF_IMAGE,
+    STRESS_LEAF_KIND_COUNT
+} stress_leaf_kind;
+
+typedef struct stress_animated_leaf
+{
+    stress_leaf_kind kind;
+    ui_element *element;
+} stress_animated_leaf;
+
+struct stress_page
+{
+    // Animated text replaces its content every frame, which an arena would
+    // only reclaim at teardown, so this page stays on malloc.
+    app_page_shell shell;
+    SDL_Window *window;
+    SDL_Renderer *renderer;
+    stress_page_config config;
+
+    int viewport_width;
+    int viewport_height;
+
+    ui_pane *background;
+    ui_fps_counter *fps_counter;
+
+    ui_layout_container **roots;
+    size_t root_count;
+
+    stress_animated_leaf *animated;
+    size_t animated_count;
+    size_t animated_capacity;
+    // Running share of animatable leaves owed to the animated list.
+    float animated_credit;
+
+    size_t leaf_count;
+    size_t container_count;
+    size_t image_count;
+    Uint64 frame;
+};
+
+static const size_t MAX_ELEMENT_COUNT = 1000000U;
+static const size_t MAX_DEPTH = 32U;
+static const size_t MAX_FANOUT = 100000U;
+// Each image owns a texture; beyond this, image slots become panes.
+static const size_t MAX_IMAGE_COUNT = 32U;
+static const float LEAF_WIDTH = 96.0F;
+static const float LEAF_HEIGHT = 22.0F;
+static const float ROOT_GAP = 4.0F;
+static const float SCROLL_STEP = 12.0F;
+static const Uint64 TOGGLE_INTERVAL_FRAMES = 30U;
+static const char *STRESS_SEGMENTS[] = {"A", "B", "C"};
+
+static stress_page_config page_config = {
+    .element_count = 5000U,
+    .depth = 4U,
+    .fanout = 8U,
+    .animated_fraction = 0.1F,
+};
+
+static bool parse_size(const char *value, size_t min_value, size_t max_value, size_t *out)
+{
+    if (value == NULL || value[0] == '\0')
+    {
+        return false;
+    }
+
+    errno = 0;
+    char *end = NULL;
+    const unsigned long long parsed = strtoull(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0' || parsed < min_value || parsed > max_value)
+    {
+        return false;
+    }
+
+    *out = (size_t)parsed;
+    return true;
+}
+
+bool stress_page_configure(const char *option, const char *value)
+{
+    if (option == NULL || value == NULL)
+    {
+        return false;
+    }
+
+    if (strcmp(option, "--stress-count") == 0)
+    {
+        return parse_size(value, 1U, MAX_ELEMENT_COUNT, &page_config.element_count);
+    }
+    if (strcmp(option, "--stress-depth") == 0)
+    {
+        return parse_size(value, 1U, MAX_DEPTH, &page_config.depth);
+    }
+    if (strcmp(option, "--stress-fanout") == 0)
+    {
+        return parse_size(value, 1U, MAX_FANOUT, &page_config.fanout);
+    }
+    if (strcmp(option, "--stress-animated") == 0)
+    {
+        char *end = NULL;
+        const float fraction = strtof(value, &end);
+        if (end == value || *end != '\0' || !(fraction >= 0.0F && fraction <= 1.0F))
+        {
+            return false;
+        }
+        page_config.animated_fraction = fraction;
+        return true;
+    }
+    return false;
+}
+
+static void add_child_or_fail(ui_layout_container *container, ui_element *child)
+{
+    if (container == NULL || child == NULL)
+    {
+        fail_fast("stress_page: invalid add_child_or_fail input");
+    }
+
+    if (!ui_layout_container_add_child(container, child))
+    {
+        fail_fast("stress_page: failed to add child to layout container");
+    }
+}
+
+static bool is_animatable(stress_leaf_kind kind)
+{
+    return kind == STRESS_LEAF_TEXT || kind == STRESS_LEAF_SLIDER ||
+           kind == STRESS_LEAF_CHECKBOX || kind == STRESS_LEAF_SEGMENT_GROUP ||
+           kind == STRESS_LEAF_PANE;
+}
+
+static void track_animated_leaf(stress_page *page, stress_leaf_kind kind, ui_element *element)
+{
+    if (!is_animatable(kind))
+    {
+        return;
+    }
+
+    page->animated_credit += page->config.animated_fraction;
+    if (page->animated_credit < 1.0F)
+    {
+        return;
+    }
+    page->animated_credit -= 1.0F;
+
+    if (page->animated_count == page->animated_capacity)
+    {
+        const size_t new_capacity =
+            page->animated_capacity == 0U ? 64U : page->animated_capacity * 2U;
+        stress_animated_leaf *resized =
+            realloc((void *)page->animated, new_capacity * sizeof(*resized));
+        if (resized == NULL)
+        {
+            fail_fast("stress_page: failed to grow animated leaf list");
+        }
+        page->animated = resized;
+        page->animated_capacity = new_capacity;
+    }
+
+    page->animated[page->animated_count++] = (stress_animated_leaf){kind, element};
+}
+
+static ui_element *create_text_leaf(const cui_allocator *allocator, const char *prefix,
+                                    size_t index)
+{
+    const SDL_Color color_ink = {31, 34, 44, 255};
+    char content[32];
+    SDL_snprintf(content, sizeof(content), "%s %zu", prefix, index);
+    ui_text *text = ui_text_create(allocator, 0.0F, 0.0F, content, color_ink, NULL);
+    if (text == NULL)
+    {
+        fail_fast("stress_page: failed to create text leaf");
+    }
+    return (ui_element *)text;
+}
+
+static ui_element *create_leaf(stress_page *page, stress_leaf_kind kind, size_t index)
+{
+    const SDL_Color color_ink = {31, 34, 44, 255};
+    const SDL_Color color_muted = {92, 95, 110, 255};
+    const SDL_Color color_border = {210, 212, 218, 255};
+    const SDL_Color color_focus_border = {62, 130, 255, 255};
+    const SDL_Color color_fill = {230, 232, 239, 255};
+    const SDL_Color color_button_up = {49, 74, 122, 255};
+    const SDL_Color color_button_down = {34, 52, 84, 255};
+    const SDL_Color color_selected = {64, 95, 150, 255};
+    const SDL_Color color_selected_text = {244, 246, 255, 255};
+    const SDL_FRect leaf_rect = {0.0F, 0.0F, LEAF_WIDTH, LEAF_HEIGHT};
+    const cui_allocator *allocator = page->shell.allocator;
+
+    if (kind == STRESS_LEAF_IMAGE && page->image_count >= MAX_IMAGE_COUNT)
+    {
+        kind = STRESS_LEAF_PANE;
+    }
+
+    ui_element *leaf = NULL;
+    switch (kind)
+    {
+    case STRESS_LEAF_TEXT:
+        leaf = create_text_leaf(allocator, "ITEM", index);
+        break;
+    case STRESS_LEAF_BUTTON:
+        leaf = (ui_element *)ui_button_create(allocator, &leaf_rect, color_button_up,
+                                              color_button_down, "BUTTON", &color_border, NULL,
+                                              NULL);
+        break;
+    case STRESS_LEAF_CHECKBOX:
+        leaf = (ui_element *)ui_checkbox_create(allocator, 0.0F, 0.0F, "CHECK", color_ink,
+                                                color_ink, color_ink, (index % 2U) == 0U, NULL,
+                                                NULL, NULL);
+        break;
+    case STRESS_LEAF_PANE:
+        leaf = (ui_element *)ui_pane_create(allocator, &leaf_rect, color_fill, &color_border);
+        break;
+    case STRESS_LEAF_SLIDER:
+        leaf = (ui_element *)ui_slider_create(allocator, &leaf_rect, 0.0F, 100.0F, 50.0F,
+                                              color_fill, color_ink, color_muted, &color_border,
+                                              NULL, NULL);
+        break;
+    case STRESS_LEAF_SEGMENT_GROUP:
+        leaf = (ui_element *)ui_segment_group_create(
+            allocator, &leaf_rect, STRESS_SEGMENTS, SDL_arraysize(STRESS_SEGMENTS), 0U,
+            color_fill, color_selected, color_button_down, color_ink, color_selected_text,
+            &color_border, NULL, NULL);
+        break;
+    case STRESS_LEAF_HRULE:
+        leaf = (ui_element *)ui_hrule_create(allocator, 4.0F, color_border, 0.0F);
+        break;
+    case STRESS_LEAF_TEXT_INPUT:
+        leaf = (ui_element *)ui_text_input_create(
+            allocator, &leaf_rect, color_ink, (SDL_Color){252, 252, 252, 255}, color_border,
+            color_focus_border, "TYPE", color_muted, page->window, NULL, NULL);
+        break;
+    case STRESS_LEAF_SCROLL_VIEW:
+    {
+        ui_element *content = create_text_leaf(allocator, "SCROLLED", index);
+        leaf = (ui_element *)ui_scroll_view_create(allocator, &leaf_rect, content, SCROLL_STEP,
+                                                   &color_border);
+        if (leaf == NULL)
+        {
+            ui_traversal_destroy(content);
+        }
+        break;
+    }
+    case STRESS_LEAF_IMAGE:
+        leaf = (ui_element *)ui_image_create(allocator, page->renderer, 0.0F, 0.0F, LEAF_HEIGHT,
+                                             LEAF_HEIGHT, "assets/icon.png", NULL);
+        page->image_count++;
+        break;
+    case STRESS_LEAF_KIND_COUNT:
+        break;
+    }
+
+    if (leaf == NULL)
+    {
+        fail_fast("stress_page: failed to create leaf of kind %d", (int)kind);
+    }
+
+    track_animated_leaf(page, kind, leaf);
+    page->leaf_count++;
+    return leaf;
+}
+
+static ui_layout_container *create_container(stress_page *page, size_t level)
+{
+    const SDL_Color color_border = {206, 209, 217, 255};
+    // Alternate axes so rows of columns of rows exercise both layout paths.
+    const ui_layout_axis axis =
+        (level % 2U) == 1U ? UI_LAYOUT_AXIS_VERTICAL : UI_LAYOUT_AXIS_HORIZONTAL;
+    ui_layout_container *container = ui_layout_container_create(
+        page->shell.allocator, &(SDL_FRect){0.0F, 0.0F, LEAF_WIDTH, LEAF_HEIGHT}, axis,
+        &color_border);
+    if (container == NULL)
+    {
+        fail_fast("stress_page: failed to create container at level %zu", level);
+    }
+
+    page->container_count++;
+    return container;
+}
+
+/*
+ * Create budget elements under container, which sits at level. Above the
+ * deepest level, up to fanout child containers split the budget evenly; the
+ * deepest containers (or any with budget <= fanout) take it all as leaves.
+ */
+static void build_subtree(stress_page *page, ui_layout_container *container, size_t level,
+                          size_t budget)
+{
+    if (level >= page->config.depth || budget <= page->config.fanout)
+    {
+        for (size_t i = 0U; i < budget; ++i)
+        {
+            const stress_leaf_kind kind =
+                (stress_leaf_kind)(page->leaf_count % STRESS_LEAF_KIND_COUNT);
+            add_child_or_fail(container, create_leaf(page, kind, page->leaf_count));
+        }
+        return;
+    }
+
+    const size_t child_count = page->config.fanout;
+    const size_t remaining = budget - child_count;
+    for (size_t i = 0U; i < child_count; ++i)
+    {
+        const size_t share =
+            (remaining / child_count) + (i < (remaining % child_count) ? 1U : 0U);
+        ui_layout_container *child = create_container(page, level + 1U);
+        add_child_or_fail(container, (ui_element *)child);
+        build_subtree(page, child, level + 1U, share);
+    }
+}
+
+static void build_roots(stress_page *page)
+{
+    const size_t count = page->config.element_count;
+    page->root_count = count < page->config.fanout ? count : page->config.fanout;
+    page->roots = calloc(page->root_count, sizeof(*page->roots));
+    if (page->roots == NULL)
+    {
+        fail_fast("stress_page: failed to allocate %zu top-level containers", page->root_count);
+    }
+
+    const size_t remaining = count - page->root_count;
+    for (size_t i = 0U; i < page->root_count; ++i)
+    {
+        const size_t share =
+            (remaining / page->root_count) + (i < (remaining % page->root_count) ? 1U : 0U);
+        page->roots[i] = create_container(page, 1U);
+        build_subtree(page, page->roots[i], 1U, share);
+        app_page_shell_register_element(&page->shell, (ui_element *)page->roots[i], "stress_page");
+    }
+}
+
+static void arrange_page_layout(stress_page *page)
+{
+    if (page == NULL || page->viewport_width <= 0 || page->viewport_height <= 0)
+    {
+        fail_fast("stress_page: invalid arrange_page_layout state");
+    }
+
+    page->background->base.rect =
+        (SDL_FRect){0.0F, 0.0F, (float)page->viewport_width, (float)page->viewport_height};
+    app_page_shell_arrange_root(&page->shell, page->viewport_width, page->viewport_height,
+                                "stress_page");
+
+    // Top-level containers tile the viewport in a near-square grid; their
+    // content may overflow the cell. ui_runtime_layout reflows them.
+    size_t columns = 1U;
+    while (columns * columns < page->root_count)
+    {
+        columns++;
+    }
+    const size_t rows = (page->root_count + columns - 1U) / columns;
+    const float cell_w = (float)page->viewport_width / (float)columns;
+    const float cell_h = (float)page->viewport_height / (float)(rows > 0U ? rows : 1U);
+    for (size_t i = 0U; i < page->root_count; ++i)
+    {
+        ui_element *root = (ui_element *)page->roots[i];
+        root->rect = (SDL_FRect){(float)(i % columns) * cell_w + ROOT_GAP,
+                                 (float)(i / columns) * cell_h + ROOT_GAP,
+                                 SDL_max(cell_w - (2.0F * ROOT_GAP), 1.0F),
+                                 SDL_max(cell_h - (2.0F * ROOT_GAP), 1.0F)};
+        ui_element_invalidate_measure(root);
+    }
+}
+
+stress_page *stress_page_create(SDL_Window *window, ui_runtime *context, int viewport_width,
+                                int viewport_height)
+{
+    if (window == NULL || context == NULL || viewport_width <= 0 || viewport_height <= 0)
+    {
+        fail_fast("stress_page_create called with invalid arguments");
+    }
+
+    SDL_Renderer *renderer = SDL_GetRenderer(window);
+    if (renderer == NULL)
+    {
+        fail_fast("stress_page_create requires window renderer: %s", SDL_GetError());
+    }
+
+    stress_page *page = calloc(1U, sizeof(*page));
+    if (page == NULL)
+    {
+        fail_fast("stress_page: failed to allocate page object");
+    }
+
+    page->window = window;
+    page->renderer = renderer;
+    page->config = page_config;
+    page->viewport_width = viewport_width;
+    page->viewport_height = viewport_height;
+    app_page_shell_init(&page->shell, context, viewport_width, viewport_height, NULL,
+                        "stress_page");
+
+    const SDL_Color color_bg = {243, 245, 250, 255};
+    page->background = ui_pane_create(
+        page->shell.allocator,
+        &(SDL_FRect){0.0F, 0.0F, (float)viewport_width, (float)viewport_height}, color_bg, NULL);
+    if (page->background == NULL)
+    {
+        fail_fast("stress_page: failed to create background pane");
+    }
+    app_page_shell_add_window_child(&page->shell, (ui_element *)page->background, "stress_page");
+
+    build_roots(page);
+
+    // Registered last so it draws over the generated tree.
+    const SDL_Color color_fps = {56, 61, 76, 255};
+    page->fps_counter = ui_fps_counter_create(page->shell.allocator, viewport_width,
+                                              viewport_height, 16.0F, color_fps, NULL);
+    if (page->fps_counter == NULL)
+    {
+        fail_fast("stress_page: failed to create fps counter");
+    }
+    app_page_shell_register_element(&page->shell, (ui_element *)page->fps_counter, "stress_page");
+
+    arrange_page_layout(page);
+    SDL_Log("stress_page: %zu elements (%zu containers, %zu leaves, %zu animated), depth %zu, "
+            "fanout %zu",
+            page->container_count + page->leaf_count, page->container_count, page->leaf_count,
+            page->animated_count, page->config.depth, page->config.fanout);
+    return page;
+}
+
+bool stress_page_resize(stress_page *page, int viewport_width, int viewport_height)
+{
+    if (page == NULL || viewport_width <= 0 || viewport_height <= 0)
+    {
+        fail_fast("stress_page_resize called with invalid arguments");
+    }
+
+    page->viewport_width = viewport_width;
+    page->viewport_height = viewport_height;
+    arrange_page_layout(page);
+    return true;
+}
+
+static void animate_leaf(const stress_animated_leaf *leaf, size_t index, Uint64 frame)
+{
+    const Uint64 phase = frame + index;
+    switch (leaf->kind)
+    {
+    case STRESS_LEAF_TEXT:
+    {
+        if (!ui_text_set_format((ui_text *)leaf->element, "TICK %llu",
+                                (unsigned long long)(phase % 1000U)))
+        {
+            fail_fast("stress_page: failed to update animated text");
+        }
+        break;
+    }
+    case STRESS_LEAF_SLIDER:
+    {
+        ui_slider *slider = (ui_slider *)leaf->element;
+        slider->value = (float)(phase % 101U);
+        ui_element_invalidate_render(leaf->element);
+        break;
+    }
+    case STRESS_LEAF_CHECKBOX:
+        if (phase % TOGGLE_INTERVAL_FRAMES == 0U)
+        {
+            ui_checkbox *checkbox = (ui_checkbox *)leaf->element;
+            ui_checkbox_set_checked(checkbox, !ui_checkbox_is_checked(checkbox), false);
+        }
+        break;
+    case STRESS_LEAF_SEGMENT_GROUP:
+        if (phase % TOGGLE_INTERVAL_FRAMES == 0U)
+        {
+            ui_segment_group *group = (ui_segment_group *)leaf->element;
+            const size_t next = (ui_segment_group_get_selected_index(group) + 1U) %
+                                SDL_arraysize(STRESS_SEGMENTS);
+            (void)ui_segment_group_set_selected_index(group, next, false);
+        }
+        break;
+    case STRESS_LEAF_PANE:
+    {
+        ui_pane *pane = (ui_pane *)leaf->element;
+        pane->fill_color.b = (Uint8)(160U + (phase % 96U));
+        ui_element_invalidate_render(leaf->element);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+bool stress_page_update(stress_page *page)
+{
+    if (page == NULL)
+    {
+        fail_fast("stress_page_update called with NULL page");
+    }
+
+    for (size_t i = 0U; i < page->animated_count; ++i)
+    {
+        animate_leaf(&page->animated[i], i, page->frame);
+    }
+    page->frame++;
+    return true;
+}
+
+void stress_page_destroy(stress_page *page)
+{
+    if (page == NULL)
+    {
+        fail_fast("stress_page_destroy called with NULL page");
+    }
+
+    app_page_shell_unregister_all(&page->shell, "stress_page");
+    free((void *)page->roots);
+    free((void *)page->animated);
+    free(page);
+}
+
+static void *create_stress_page_instance(SDL_Window *window, ui_runtime *context,
+                                         int viewport_width, int viewport_height)
+{
+    return (void *)stress_page_create(window, context, viewport_width, viewport_height);
+}
+
+static bool resize_stress_page_instance(void *page_instance, int viewport_width,
+                                        int viewport_height)
+{
+    return stress_page_resize((stress_page *)page_instance, viewport_width, viewport_height);
+}
+
+static bool update_stress_page_instance(void *page_instance)
+{
+    return stress_page_update((stress_page *)page_instance);
+}
+
+static float next_stress_page_frame_delay(void *page_instance)
+{
+    const stress_page *page = (const stress_page *)page_instance;
+
+    // Animated leaves change every frame, so keep frames coming while any exist.
+    return page->animated_count > 0U ? 0.0F : UI_NO_FRAME_REQUEST;
+}
+
+static void destroy_stress_page_instance(void *page_instance)
+{
+    stress_page_destroy((stress_page *)page_instance);
+}
+
+const app_page_ops stress_page_ops = {
+    .configure = stress_page_configure,
+    .create = create_stress_page_instance,
+    .resize = resize_stress_page_instance,
+    .update = update_stress_page_instance,
+    .next_frame_delay = next_stress_page_frame_delay,
+    .destroy = destroy_stress_page_instance,
+};
@@ -1,49 +1,75 @@
 #include "pages/todo_page.h"
 
 #include "pages/page_shell.h"
+#include "system/ui_clock.h"
 #include "ui/ui_button.h"
 #include "ui/ui_checkbox.h"
 #include "ui/ui_fps_counter.h"
 #include "ui/ui_hrule.h"
 #include "ui/ui_layout_container.h"
+#include "ui/ui_list_view.h"
 #include "ui/ui_pane.h"
-#include "ui/ui_scroll_view.h"
 #include "ui/ui_segment_group.h"
 #include "ui/ui_text.h"
 #include "ui/ui_text_input.h"
 #include "util/fail_fast.h"
-#include "util/string_util.h"
+#include "util/string_pool.h"
 
 #include <ctype.h>
+#include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+/*
+ * Task model entry. title and due_time are interned in the page's string pool
+ * and shared with the row widgets that display them; the row number is
+ * formatted from id when a row is bound.
+ */
 typedef struct todo_task
 {
     uint64_t id;
-    char *title;
-    char due_time[6];
+    const char *title;
+    const char *due_time;
     bool is_done;
 } todo_task;
 
-typedef struct task_row_context
+/*
+ * Widgets of one recycled list row and the task it currently shows. Row
+ * callbacks receive this as context, so it is heap-allocated once per row
+ * and outlives every rebind.
+ */
+typedef struct task_row
 {
     struct todo_page *page;
+    ui_element *element;
+    ui_text *number;
+    ui_checkbox *check;
+    ui_text *title;
+    ui_text *due_time;
+    // SIZE_MAX while the row is not bound to a task.
     size_t task_index;
-} task_row_context;
+} task_row;
 
 struct todo_page
 {
     app_page_shell shell;
 
+    // Canonical copies of task strings; rows hold references, not copies.
+    string_pool strings;
     todo_task *tasks;
     size_t task_count;
     size_t task_capacity;
     uint64_t next_task_id;
-    task_row_context *row_contexts;
-    size_t row_context_capacity;
+    size_t done_count;
+    // Task indices matching the filter; unused while the filter shows all.
+    size_t *visible_tasks;
+    size_t visible_count;
+    size_t visible_capacity;
+    task_row **task_rows;
+    size_t task_row_count;
+    size_t task_row_capacity;
 
     // Current viewport dimensions for responsive layout.
     int viewport_width;
@@ -60,8 +86,7 @@ struct todo_page
     ui_hrule *top_rule;
     ui_hrule *bottom_rule;
     ui_pane *list_frame;
-    ui_scroll_view *scroll_view;
-    ui_layout_container *rows_container;
+    ui_list_view *task_list;
     ui_button *clear_done;
     ui_fps_counter *fps_counter;
     ui_text *stats_text;
@@ -71,6 +96,8 @@ struct todo_page
 
     size_t selected_filter_index;
     time_t last_header_time;
+    // xorshift state for random due times, seeded on first use.
+    uint64_t random_state;
 
     SDL_Color color_ink;
     SDL_Color color_muted;
@@ -84,10 +111,15 @@ static const float INPUT_ROW_HEIGHT = 64.0F;
 static const float STATS_ROW_Y = 244.0F;
 static const float LIST_TOP_Y = 306.0F;
 static const float ROW_HEIGHT = 32.0F;
+static const float ROW_GAP = 8.0F;
+// Rows kept bound beyond each viewport edge so short scrolls rebind nothing.
+static const size_t ROW_OVERSCAN = 4U;
 static const float SCROLL_STEP = 24.0F;
+static const size_t MAX_TASK_COUNT = 1000000U;
 // Matches legacy footer geometry at 1024x768 (list height 304, footer y 650).
 static const float FOOTER_RESERVE = 158.0F;
 static const float FOOTER_GAP = 22.0F;
+static const float HEADER_CLOCK_WAKE_SLACK_SECONDS = 0.005F;
 
 static const float COL_NUMBER_W = 56.0F;
 static const float COL_CHECK_W = 32.0F;
@@ -118,6 +150,9 @@ static const float REMAINING_LABEL_RIGHT_INSET = 168.0F;
 static const float REMAINING_LABEL_Y_OFFSET = 18.0F;
 static const char *TODO_FILTER_LABELS[] = {"ALL", "ACTIVE", "DONE"};
 
+// Tasks seeded by the next todo_page_create; set through todo_page_configure.
+static size_t initial_task_count = 10U;
+
 /*
  * Viewport-derived layout values used by the page arrange pass.
  */
@@ -182,34 +217,19 @@ static void update_task_summary(todo_page *page)
         fail_fast("todo_page: summary update called with invalid state");
     }
 
-    size_t done_count = 0U;
-    for (size_t i = 0; i < page->task_count; ++i)
-    {
-        if (page->tasks[i].is_done)
-        {
-            done_count++;
-        }
-    }
-
+    const size_t done_count = page->done_count;
     const size_t active_count = page->task_count - done_count;
-    char stats_buffer[64];
-    char remaining_buffer[32];
-
-    SDL_snprintf(stats_buffer, sizeof(stats_buffer), "%zu ACTIVE - %zu DONE", active_count,
-                 done_count);
-    SDL_snprintf(remaining_buffer, sizeof(remaining_buffer), "%zu REMAINING", active_count);
-
-    if (!ui_text_set_content(page->stats_text, stats_buffer))
+    if (!ui_text_set_format(page->stats_text, "%zu ACTIVE - %zu DONE", active_count, done_count))
     {
         fail_fast("todo_page: failed to update stats summary text");
     }
-    if (!ui_text_set_content(page->remaining_text, remaining_buffer))
+    if (!ui_text_set_format(page->remaining_text, "%zu REMAINING", active_count))
     {
         fail_fast("todo_page: failed to update remaining summary text");
     }
 }
 
-static void rebuild_task_rows(todo_page *page);
+static void refresh_task_list(todo_page *page);
 static todo_page_layout compute_page_geometry(const todo_page *page);
 static void arrange_page_layout(todo_page *page, const todo_page_layout *layout);
 static void arrange_header_section(todo_page *page, const todo_page_layout *layout);
@@ -249,43 +269,18 @@ static bool does_task_match_filter(const todo_page *page, const todo_task *task)
 }
 
 /*
- * Ensure per-row callback context storage can index every task entry.
+ * Drop the model's references to a task's interned strings.
  */
-static void ensure_row_context_capacity(todo_page *page)
+static void release_task_strings(todo_page *page, todo_task *task)
 {
-    if (page == NULL)
-    {
-        fail_fast("todo_page: NULL page in ensure_row_context_capacity");
-    }
-
-    if (page->task_count == 0U)
-    {
-        free(page->row_contexts);
-        page->row_contexts = NULL;
-        page->row_context_capacity = 0U;
-        return;
-    }
-
-    if (page->row_context_capacity >= page->task_count)
-    {
-        return;
-    }
-
-    // Context slots are indexed by task index, so capacity follows task_count.
-    const size_t new_capacity = page->task_count;
-    task_row_context *new_contexts =
-        realloc((void *)page->row_contexts, new_capacity * sizeof(task_row_context));
-    if (new_contexts == NULL)
-    {
-        fail_fast("todo_page: failed to grow row contexts");
-    }
-
-    page->row_contexts = new_contexts;
-    page->row_context_capacity = new_capacity;
+    string_pool_release(&page->strings, task->title);
+    string_pool_release(&page->strings, task->due_time);
+    task->title = NULL;
+    task->due_time = NULL;
 }
 
 /*
- * Delete a task by index and rebuild visible rows afterward.
+ * Delete a task by index and refresh the list afterward.
  */
 static void delete_task_at_index(todo_page *page, size_t index)
 {
@@ -294,117 +289,169 @@ static void delete_task_at_index(todo_page *page, size_t index)
         fail_fast("todo_page: invalid delete index");
     }
 
-    free(page->tasks[index].title);
-    page->tasks[index].title = NULL;
-
-    for (size_t i = index; i + 1U < page->task_count; ++i)
+    if (page->tasks[index].is_done)
     {
-        page->tasks[i] = page->tasks[i + 1U];
+        page->done_count--;
     }
+    release_task_strings(page, &page->tasks[index]);
+
+    memmove((void *)&page->tasks[index], (const void *)&page->tasks[index + 1U],
+            (page->task_count - index - 1U) * sizeof(todo_task));
     page->task_count--;
 
-    rebuild_task_rows(page);
+    refresh_task_list(page);
 }
 
 /*
- * Button callback that deletes the row's bound task.
+ * Return the task a row callback acts on, failing fast when the row is not
+ * bound to a live task.
  */
-static void handle_delete_button_click(void *context)
+static size_t bound_task_index(const task_row *row, const char *callback)
 {
-    task_row_context *row_ctx = (task_row_context *)context;
-    if (row_ctx == NULL || row_ctx->page == NULL)
+    if (row == NULL || row->page == NULL || row->task_index >= row->page->task_count)
     {
-        fail_fast("todo_page: delete callback context is invalid");
+        fail_fast("todo_page: %s callback context is invalid", callback);
     }
 
-    delete_task_at_index(row_ctx->page, row_ctx->task_index);
+    return row->task_index;
 }
 
 /*
- * Checkbox callback that toggles task completion and refreshes row projection.
+ * Button callback that deletes the row's bound task.
+ */
+static void handle_delete_button_click(void *context)
+{
+    task_row *row = (task_row *)context;
+    const size_t task_index = bound_task_index(row, "delete");
+    delete_task_at_index(row->page, task_index);
+}
+
+/*
+ * Checkbox callback that toggles task completion and refreshes the list,
+ * since the task may no longer match the filter.
  */
 static void handle_task_checkbox_change(bool checked, void *context)
 {
-    task_row_context *row_ctx = (task_row_context *)context;
-    if (row_ctx == NULL || row_ctx->page == NULL)
+    task_row *row = (task_row *)context;
+    const size_t task_index = bound_task_index(row, "checkbox");
+    todo_page *page = row->page;
+    todo_task *task = &page->tasks[task_index];
+
+    if (task->is_done != checked)
     {
-        fail_fast("todo_page: checkbox callback context is invalid");
+        task->is_done = checked;
+        if (checked)
+        {
+            page->done_count++;
+        }
+        else
+        {
+            page->done_count--;
+        }
     }
+    refresh_task_list(page);
+}
 
-    todo_page *page = row_ctx->page;
-    if (row_ctx->task_index >= page->task_count)
+/*
+ * Return the bookkeeping for a row element created by create_task_row. The
+ * list view only creates enough rows to fill the viewport, so this stays a
+ * short scan.
+ */
+static task_row *find_task_row(const todo_page *page, const ui_element *element)
+{
+    for (size_t i = 0U; i < page->task_row_count; ++i)
     {
-        fail_fast("todo_page: checkbox callback received out-of-range task index");
+        if (page->task_rows[i]->element == element)
+        {
+            return page->task_rows[i];
+        }
     }
 
-    page->tasks[row_ctx->task_index].is_done = checked;
-    rebuild_task_rows(page);
+    fail_fast("todo_page: list view passed an unknown row");
 }
 
 /*
- * Build one horizontal UI row for the task at the provided model index.
+ * Create an empty row text element of the given column width.
  */
-static void add_task_row(todo_page *page, size_t index)
+static ui_text *create_row_text(todo_page *page, SDL_Color color, float width)
 {
-    if (page == NULL || page->rows_container == NULL || index >= page->task_count)
+    ui_text *text = ui_text_create(page->shell.allocator, 0.0F, 0.0F, "", color, NULL);
+    if (text == NULL)
     {
-        fail_fast("todo_page: invalid add_task_row input");
+        fail_fast("todo_page: failed to create task row text");
     }
+    text->base.rect.w = width;
+    return text;
+}
 
-    const todo_task *task = &page->tasks[index];
-    char row_number[20];
-    SDL_snprintf(row_number, sizeof(row_number), "%llu", (unsigned long long)task->id);
-
-    ui_layout_container *row = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 0.0F, ROW_HEIGHT}, UI_LAYOUT_AXIS_HORIZONTAL, &page->color_ink);
-    if (row == NULL)
+/*
+ * List view callback: build one unbound horizontal task row. Rows are
+ * recycled as the list scrolls, so this runs about once per visible row.
+ */
+static ui_element *create_task_row(void *context)
+{
+    todo_page *page = (todo_page *)context;
+    if (page == NULL)
     {
-        fail_fast("todo_page: failed to create task row container");
+        fail_fast("todo_page: invalid create_task_row context");
     }
 
-    task_row_context *row_ctx = &page->row_contexts[index];
-    row_ctx->page = page;
-    row_ctx->task_index = index;
-
-    ui_text *number = ui_text_create(0.0F, 0.0F, row_number, page->color_muted, NULL);
-    if (number == NULL)
+    if (page->task_row_count == page->task_row_capacity)
     {
-        fail_fast("todo_page: failed to create task number text");
+        const size_t new_capacity =
+            page->task_row_capacity == 0U ? 16U : page->task_row_capacity * 2U;
+        task_row **new_rows = realloc((void *)page->task_rows, new_capacity * sizeof(task_row *));
+        if (new_rows == NULL)
+        {
+            fail_fast("todo_page: failed to grow task row storage");
+        }
+        page->task_rows = new_rows;
+        page->task_row_capacity = new_capacity;
     }
-    number->base.rect.w = COL_NUMBER_W;
-    add_child_or_fail(row, (ui_element *)number);
 
-    ui_checkbox *check =
-        ui_checkbox_create(0.0F, 0.0F, "", page->color_ink, page->color_ink, page->color_ink,
-                           task->is_done, handle_task_checkbox_change, row_ctx, NULL);
-    if (check == NULL)
+    task_row *view = calloc(1U, sizeof(task_row));
+    if (view == NULL)
     {
-        fail_fast("todo_page: failed to create task checkbox");
+        fail_fast("todo_page: failed to allocate task row");
     }
-    check->base.rect.w = COL_CHECK_W;
-    add_child_or_fail(row, (ui_element *)check);
+    view->page = page;
+    view->task_index = SIZE_MAX;
+    page->task_rows[page->task_row_count++] = view;
 
-    ui_text *task_text = ui_text_create(0.0F, 0.0F, task->title, page->color_ink, NULL);
-    if (task_text == NULL)
+    const cui_allocator *allocator = page->shell.allocator;
+    ui_layout_container *row = ui_layout_container_create(
+        allocator, &(SDL_FRect){0.0F, 0.0F, 0.0F, ROW_HEIGHT}, UI_LAYOUT_AXIS_HORIZONTAL,
+        &page->color_ink);
+    if (row == NULL)
     {
-        fail_fast("todo_page: failed to create task title text");
+        fail_fast("todo_page: failed to create task row container");
     }
-    task_text->base.rect.w = COL_TITLE_W;
-    add_child_or_fail(row, (ui_element *)task_text);
+    view->element = &row->base;
+
+    view->number = create_row_text(page, page->color_muted, COL_NUMBER_W);
+    add_child_or_fail(row, (ui_element *)view->number);
 
-    ui_text *time_text = ui_text_create(0.0F, 0.0F, task->due_time, page->color_muted, NULL);
-    if (time_text == NULL)
+    view->check = ui_checkbox_create(allocator, 0.0F, 0.0F, "", page->color_ink, page->color_ink,
+                                     page->color_ink, false, handle_task_checkbox_change, view,
+                                     NULL);
+    if (view->check == NULL)
     {
-        fail_fast("todo_page: failed to create task due-time text");
+        fail_fast("todo_page: failed to create task checkbox");
     }
-    time_text->base.rect.w = COL_TIME_W;
-    time_text->base.align_h = UI_ALIGN_RIGHT;
-    time_text->base.rect.x = COL_TIME_RIGHT_OFFSET;
-    add_child_or_fail(row, (ui_element *)time_text);
+    view->check->base.rect.w = COL_CHECK_W;
+    add_child_or_fail(row, (ui_element *)view->check);
 
-    ui_button *remove = ui_button_create(&(SDL_FRect){0.0F, 0.0F, COL_DELETE_W, COL_DELETE_H},
-                                         page->color_ink, page->color_button_down, "DELETE",
-                                         &page->color_ink, handle_delete_button_click, row_ctx);
+    view->title = create_row_text(page, page->color_ink, COL_TITLE_W);
+    add_child_or_fail(row, (ui_element *)view->title);
+
+    view->due_time = create_row_text(page, page->color_muted, COL_TIME_W);
+    view->due_time->base.align_h = UI_ALIGN_RIGHT;
+    view->due_time->base.rect.x = COL_TIME_RIGHT_OFFSET;
+    add_child_or_fail(row, (ui_element *)view->due_time);
+
+    ui_button *remove = ui_button_create(
+        allocator, &(SDL_FRect){0.0F, 0.0F, COL_DELETE_W, COL_DELETE_H}, page->color_ink,
+        page->color_button_down, "DELETE", &page->color_ink, handle_delete_button_click, view);
     if (remove == NULL)
     {
         fail_fast("todo_page: failed to create delete button");
@@ -412,36 +459,105 @@ static void add_task_row(todo_page *page, size_t index)
     remove->base.align_h = UI_ALIGN_RIGHT;
     remove->base.rect.x = COL_DELETE_RIGHT_OFFSET;
     add_child_or_fail(row, (ui_element *)remove);
-    add_child_or_fail(page->rows_container, (ui_element *)row);
+
+    return &row->base;
+}
+
+/*
+ * List view callback: show the task at list position index in a row. Title
+ * and due time share the pool's copies; only the number is formatted.
+ */
+static void bind_task_row(void *context, ui_element *element, size_t index)
+{
+    todo_page *page = (todo_page *)context;
+    if (page == NULL || index >= page->visible_count)
+    {
+        fail_fast("todo_page: invalid bind_task_row input");
+    }
+
+    task_row *row = find_task_row(page, element);
+    const size_t task_index =
+        page->selected_filter_index == 0U ? index : page->visible_tasks[index];
+    const todo_task *task = &page->tasks[task_index];
+    row->task_index = task_index;
+
+    if (!ui_text_set_format(row->number, "%llu", (unsigned long long)task->id) ||
+        !ui_text_set_interned(row->title, &page->strings, task->title) ||
+        !ui_text_set_interned(row->due_time, &page->strings, task->due_time))
+    {
+        fail_fast("todo_page: failed to bind task row text");
+    }
+    ui_checkbox_set_checked(row->check, task->is_done, false);
 }
 
 /*
- * Rebuild the entire task-row container from current model/filter state.
+ * List view callback: a row stops showing its task. Its pool references are
+ * dropped so strings of deleted tasks are reclaimed while the row waits.
  */
-static void rebuild_task_rows(todo_page *page)
+static void unbind_task_row(void *context, ui_element *element, size_t index)
 {
-    if (page == NULL || page->rows_container == NULL)
+    (void)index;
+
+    task_row *row = find_task_row((const todo_page *)context, element);
+    row->task_index = SIZE_MAX;
+    if (!ui_text_set_content(row->title, "") || !ui_text_set_content(row->due_time, ""))
     {
-        fail_fast("todo_page: invalid state in rebuild_task_rows");
+        fail_fast("todo_page: failed to unbind task row text");
     }
-    ensure_row_context_capacity(page);
+}
 
-    // Rows are a projection of model state; rebuild from scratch after changes.
-    ui_layout_container_clear_children(page->rows_container, true);
+/*
+ * Rebuild the list position -> task index mapping for the current filter.
+ * The ALL filter maps positions to tasks directly and needs no storage.
+ */
+static void rebuild_visible_tasks(todo_page *page)
+{
+    if (page->selected_filter_index == 0U)
+    {
+        page->visible_count = page->task_count;
+        return;
+    }
+
+    if (page->visible_capacity < page->task_count)
+    {
+        size_t *new_visible =
+            realloc((void *)page->visible_tasks, page->task_count * sizeof(size_t));
+        if (new_visible == NULL)
+        {
+            fail_fast("todo_page: failed to grow visible task storage");
+        }
+        page->visible_tasks = new_visible;
+        page->visible_capacity = page->task_count;
+    }
 
+    size_t count = 0U;
     for (size_t i = 0; i < page->task_count; ++i)
     {
-        if (!does_task_match_filter(page, &page->tasks[i]))
+        if (does_task_match_filter(page, &page->tasks[i]))
         {
-            continue;
+            page->visible_tasks[count++] = i;
         }
+    }
+    page->visible_count = count;
+}
 
-        add_task_row(page, i);
+/*
+ * Point the task list at current model/filter state. Only the rows in view
+ * are rebound, so the cost does not grow with the task count.
+ */
+static void refresh_task_list(todo_page *page)
+{
+    if (page == NULL || page->task_list == NULL)
+    {
+        fail_fast("todo_page: invalid state in refresh_task_list");
     }
 
+    rebuild_visible_tasks(page);
+    if (!ui_list_view_set_row_count(page->task_list, page->visible_count))
+    {
+        fail_fast("todo_page: failed to update task list rows");
+    }
     update_task_summary(page);
-    const todo_page_layout layout = compute_page_geometry(page);
-    arrange_page_layout(page, &layout);
 }
 
 /*
@@ -466,27 +582,37 @@ static void append_task(todo_page *page, const char *title, const char *due_time
         page->task_capacity = new_capacity;
     }
 
-    char *task_title = duplicate_string(title);
-    if (task_title == NULL)
-    {
-        fail_fast("todo_page: failed to duplicate task title");
-    }
-
     if (page->next_task_id == UINT64_MAX)
     {
-        free(task_title);
         fail_fast("todo_page: task id counter overflow");
     }
 
     todo_task *task = &page->tasks[page->task_count];
     task->id = page->next_task_id;
+    task->title = string_pool_intern(&page->strings, title);
+    task->due_time = string_pool_intern(&page->strings, due_time);
+    if (task->title == NULL || task->due_time == NULL)
+    {
+        fail_fast("todo_page: failed to intern task strings");
+    }
     page->next_task_id++;
-    task->title = task_title;
-    SDL_snprintf(task->due_time, sizeof(task->due_time), "%s", due_time);
     task->is_done = is_done;
+    if (is_done)
+    {
+        page->done_count++;
+    }
     page->task_count++;
 }
 
+/*
+ * Return the current wall-clock second. Read through ui_clock so recorded
+ * sessions replay with the recorded time.
+ */
+static time_t current_wall_time(void)
+{
+    return (time_t)(ui_clock_wall_ns() / (SDL_Time)SDL_NS_PER_SECOND);
+}
+
 /*
  * Format the header clock string as uppercased local date/time text.
  */
@@ -497,7 +623,7 @@ static void format_header_datetime(char *buffer, size_t buffer_size)
         return;
     }
 
-    const time_t now = time(NULL);
+    const time_t now = current_wall_time();
     struct tm local_tm;
 #if defined(_WIN32)
     localtime_s(&local_tm, &now);
@@ -527,7 +653,7 @@ static void fill_current_time(char *buffer, size_t buffer_size)
         return;
     }
 
-    const time_t now = time(NULL);
+    const time_t now = current_wall_time();
     struct tm local_tm;
 #if defined(_WIN32)
     localtime_s(&local_tm, &now);
@@ -542,16 +668,16 @@ static void fill_current_time(char *buffer, size_t buffer_size)
 }
 
 /*
- * Generate a simple pseudo-random 32-bit value from an internal xorshift state.
+ * Generate a simple pseudo-random 32-bit value from the page's xorshift state.
  */
-static uint32_t next_pseudo_random_u32(void)
+static uint32_t next_pseudo_random_u32(todo_page *page)
 {
-    static uint64_t state = 0U;
-
+    uint64_t state = page->random_state;
     if (state == 0U)
     {
-        // Lazy one-time seed using wall clock + SDL monotonic ticks.
-        state = ((uint64_t)time(NULL) << 32U) ^ SDL_GetTicksNS();
+        // Lazy per-page seed using wall clock + monotonic ticks; both are pinned
+        // while recording or replaying, so due times replay exactly.
+        state = ((uint64_t)current_wall_time() << 32U) ^ ui_clock_ticks_ns();
         if (state == 0U)
         {
             state = 0x9e3779b97f4a7c15ULL;
@@ -561,21 +687,22 @@ static uint32_t next_pseudo_random_u32(void)
     state ^= state << 13U;
     state ^= state >> 7U;
     state ^= state << 17U;
+    page->random_state = state;
     return (uint32_t)(state >> 32U);
 }
 
 /*
  * Fill buffer with a pseudo-random HH:MM value.
  */
-static void fill_random_time(char *buffer, size_t buffer_size)
+static void fill_random_time(todo_page *page, char *buffer, size_t buffer_size)
 {
     if (buffer == NULL || buffer_size < 6U)
     {
         return;
     }
 
-    const int hour = (int)(next_pseudo_random_u32() % 24U);
-    const int minute = (int)(next_pseudo_random_u32() % 60U);
+    const int hour = (int)(next_pseudo_random_u32(page) % 24U);
+    const int minute = (int)(next_pseudo_random_u32(page) % 60U);
     SDL_snprintf(buffer, buffer_size, "%02d:%02d", hour, minute);
 }
 
@@ -601,7 +728,7 @@ static void add_task_from_input(todo_page *page)
     append_task(page, input_value, due_time, false);
 
     ui_text_input_clear(page->task_input);
-    rebuild_task_rows(page);
+    refresh_task_list(page);
 }
 
 /*
@@ -619,8 +746,7 @@ static void clear_done_tasks(todo_page *page)
     {
         if (page->tasks[read].is_done)
         {
-            free(page->tasks[read].title);
-            page->tasks[read].title = NULL;
+            release_task_strings(page, &page->tasks[read]);
         }
         else
         {
@@ -632,12 +758,15 @@ static void clear_done_tasks(todo_page *page)
         }
     }
     page->task_count = write;
+    page->done_count = 0U;
 
-    (void)rebuild_task_rows(page);
+    refresh_task_list(page);
 }
 
 /*
- * Release all heap allocations owned by task model storage.
+ * Release all heap allocations and string references owned by task model
+ * storage and row bookkeeping, then the string pool itself. Row widgets must
+ * already be gone.
  */
 static void destroy_task_storage(todo_page *page)
 {
@@ -648,18 +777,29 @@ static void destroy_task_storage(todo_page *page)
 
     for (size_t i = 0; i < page->task_count; ++i)
     {
-        free(page->tasks[i].title);
-        page->tasks[i].title = NULL;
+        release_task_strings(page, &page->tasks[i]);
     }
+    string_pool_destroy(&page->strings);
 
     free(page->tasks);
     page->tasks = NULL;
     page->task_count = 0U;
     page->task_capacity = 0U;
+    page->done_count = 0U;
 
-    free(page->row_contexts);
-    page->row_contexts = NULL;
-    page->row_context_capacity = 0U;
+    free(page->visible_tasks);
+    page->visible_tasks = NULL;
+    page->visible_count = 0U;
+    page->visible_capacity = 0U;
+
+    for (size_t i = 0; i < page->task_row_count; ++i)
+    {
+        free(page->task_rows[i]);
+    }
+    free((void *)page->task_rows);
+    page->task_rows = NULL;
+    page->task_row_count = 0U;
+    page->task_row_capacity = 0U;
 }
 
 /*
@@ -704,7 +844,7 @@ static void handle_filter_change(size_t selected_index, const char *selected_lab
     }
 
     page->selected_filter_index = selected_index;
-    rebuild_task_rows(page);
+    refresh_task_list(page);
 }
 
 /*
@@ -778,7 +918,7 @@ static void arrange_list_section(todo_page *page, const todo_page_layout *layout
         (SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y + TOP_RULE_Y_OFFSET, layout->content_width, 1.0F};
     page->list_frame->base.rect =
         (SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, layout->content_width, layout->task_list_height};
-    page->scroll_view->base.rect =
+    page->task_list->base.rect =
         (SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, layout->content_width, layout->task_list_height};
 }
 
@@ -828,6 +968,26 @@ bool todo_page_resize(todo_page *page, int viewport_width, int viewport_height)
     return true;
 }
 
+bool todo_page_configure(const char *option, const char *value)
+{
+    if (option == NULL || value == NULL || strcmp(option, "--todo-count") != 0 ||
+        value[0] == '\0')
+    {
+        return false;
+    }
+
+    errno = 0;
+    char *end = NULL;
+    const unsigned long long parsed = strtoull(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0' || parsed > MAX_TASK_COUNT)
+    {
+        return false;
+    }
+
+    initial_task_count = (size_t)parsed;
+    return true;
+}
+
 todo_page *todo_page_create(SDL_Window *window, ui_runtime *context, int viewport_width,
                             int viewport_height)
 {
@@ -847,6 +1007,12 @@ todo_page *todo_page_create(SDL_Window *window, ui_runtime *context, int viewpor
     page->next_task_id = 1U;
     page->selected_filter_index = 0U;
     page->last_header_time = 0;
+    string_pool_init(&page->strings);
+
+    // Recycled row texts regrow their buffers as rows are rebound, and an
+    // arena only reclaims memory at teardown, so this page stays on malloc.
+    app_page_shell_init(&page->shell, context, viewport_width, viewport_height, NULL, "todo_page");
+    const cui_allocator *allocator = page->shell.allocator;
 
     const SDL_Color color_panel = {245, 245, 242, 255};
     page->color_ink = (SDL_Color){36, 36, 36, 255};
@@ -855,22 +1021,22 @@ todo_page *todo_page_create(SDL_Window *window, ui_runtime *context, int viewpor
     page->color_button_down = (SDL_Color){86, 86, 94, 255};
     const SDL_Color color_accent = {211, 92, 52, 255};
 
-    page->header_left =
-        ui_pane_create(&(SDL_FRect){LAYOUT_MARGIN, LAYOUT_MARGIN, 1.0F, HEADER_HEIGHT}, color_panel,
-                       &page->color_ink);
+    page->header_left = ui_pane_create(
+        allocator, &(SDL_FRect){LAYOUT_MARGIN, LAYOUT_MARGIN, 1.0F, HEADER_HEIGHT}, color_panel,
+        &page->color_ink);
     if (page->header_left == NULL)
     {
         fail_fast("todo_page: failed to create header_left pane");
     }
-    page->header_right =
-        ui_pane_create(&(SDL_FRect){LAYOUT_MARGIN, LAYOUT_MARGIN, HEADER_RIGHT_W, HEADER_HEIGHT},
-                       color_panel, &page->color_ink);
+    page->header_right = ui_pane_create(
+        allocator, &(SDL_FRect){LAYOUT_MARGIN, LAYOUT_MARGIN, HEADER_RIGHT_W, HEADER_HEIGHT},
+        color_panel, &page->color_ink);
     if (page->header_right == NULL)
     {
         fail_fast("todo_page: failed to create header_right pane");
     }
 
-    page->title_text = ui_text_create(TITLE_TEXT_X, TITLE_TEXT_Y,
+    page->title_text = ui_text_create(allocator, TITLE_TEXT_X, TITLE_TEXT_Y,
                                       "TODO TASK MANAGEMENT SYSTEM V0.1", page->color_ink, NULL);
     if (page->title_text == NULL)
     {
@@ -879,27 +1045,29 @@ todo_page *todo_page_create(SDL_Window *window, ui_runtime *context, int viewpor
 
     char header_datetime[40];
     format_header_datetime(header_datetime, sizeof(header_datetime));
-    page->datetime_text =
-        ui_text_create(DATETIME_TEXT_X, DATETIME_TEXT_Y, header_datetime, page->color_muted, NULL);
+    page->datetime_text = ui_text_create(allocator, DATETIME_TEXT_X, DATETIME_TEXT_Y,
+                                         header_datetime, page->color_muted, NULL);
     if (page->datetime_text == NULL)
     {
         fail_fast("todo_page: failed to create datetime text");
     }
 
-    page->icon_cell =
-        ui_pane_create(&(SDL_FRect){LAYOUT_MARGIN, INPUT_ROW_Y, ICON_CELL_W, INPUT_ROW_HEIGHT},
-                       color_panel, &page->color_ink);
+    page->icon_cell = ui_pane_create(
+        allocator, &(SDL_FRect){LAYOUT_MARGIN, INPUT_ROW_Y, ICON_CELL_W, INPUT_ROW_HEIGHT},
+        color_panel, &page->color_ink);
     if (page->icon_cell == NULL)
     {
         fail_fast("todo_page: failed to create icon cell pane");
     }
-    page->icon_arrow = ui_text_create(ICON_ARROW_X, ICON_ARROW_Y, ">", color_accent, NULL);
+    page->icon_arrow = ui_text_create(allocator, ICON_ARROW_X, ICON_ARROW_Y, ">", color_accent,
+                                      NULL);
     if (page->icon_arrow == NULL)
     {
         fail_fast("todo_page: failed to create icon arrow text");
     }
 
     page->task_input = ui_text_input_create(
+        allocator,
         &(SDL_FRect){LAYOUT_MARGIN + ICON_CELL_W, INPUT_ROW_Y, INPUT_FIELD_W, INPUT_ROW_HEIGHT},
         page->color_muted, color_panel, page->color_ink, page->color_ink, "enter task...",
         page->color_muted, window, handle_task_input_submit, page);
@@ -909,22 +1077,23 @@ todo_page *todo_page_create(SDL_Window *window, ui_runtime *context, int viewpor
     }
 
     page->add_button = ui_button_create(
-        &(SDL_FRect){LAYOUT_MARGIN, INPUT_ROW_Y, ADD_BUTTON_W, INPUT_ROW_HEIGHT}, color_button_dark,
-        page->color_button_down, "ADD", &page->color_ink, handle_add_button_click, page);
+        allocator, &(SDL_FRect){LAYOUT_MARGIN, INPUT_ROW_Y, ADD_BUTTON_W, INPUT_ROW_HEIGHT},
+        color_button_dark, page->color_button_down, "ADD", &page->color_ink,
+        handle_add_button_click, page);
     if (page->add_button == NULL)
     {
         fail_fast("todo_page: failed to create add button");
     }
 
-    page->stats_text =
-        ui_text_create(LAYOUT_MARGIN, STATS_ROW_Y, "0 ACTIVE - 0 DONE", page->color_ink, NULL);
+    page->stats_text = ui_text_create(allocator, LAYOUT_MARGIN, STATS_ROW_Y, "0 ACTIVE - 0 DONE",
+                                      page->color_ink, NULL);
     if (page->stats_text == NULL)
     {
         fail_fast("todo_page: failed to create stats text");
     }
 
     page->filter_group = ui_segment_group_create(
-        &(SDL_FRect){LAYOUT_MARGIN, STATS_ROW_Y, FILTER_W, FILTER_H}, TODO_FILTER_LABELS,
+        allocator, &(SDL_FRect){LAYOUT_MARGIN, STATS_ROW_Y, FILTER_W, FILTER_H}, TODO_FILTER_LABELS,
         SDL_arraysize(TODO_FILTER_LABELS), 0U, color_panel, color_button_dark,
         page->color_button_down, page->color_muted, color_panel, &page->color_ink,
         handle_filter_change, page);
@@ -933,65 +1102,67 @@ todo_page *todo_page_create(SDL_Window *window, ui_runtime *context, int viewpor
         fail_fast("todo_page: failed to create filter group");
     }
 
-    page->top_rule = ui_hrule_create(1.0F, page->color_ink, 0.0F);
+    page->top_rule = ui_hrule_create(allocator, 1.0F, page->color_ink, 0.0F);
     if (page->top_rule == NULL)
     {
         fail_fast("todo_page: failed to create top rule");
     }
 
-    page->list_frame = ui_pane_create(&(SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, 1.0F, 1.0F},
+    page->list_frame = ui_pane_create(allocator,
+                                      &(SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, 1.0F, 1.0F},
                                       color_panel, &page->color_ink);
     if (page->list_frame == NULL)
     {
         fail_fast("todo_page: failed to create list frame");
     }
 
-    page->rows_container = ui_layout_container_create(
-        &(SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, 1.0F, 1.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
-    if (page->rows_container == NULL)
-    {
-        fail_fast("todo_page: failed to create rows container");
-    }
-
-    // Scroll view takes ownership of rows_container on success.
-    page->scroll_view =
-        ui_scroll_view_create(&(SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, 1.0F, 1.0F},
-                              (ui_element *)page->rows_container, SCROLL_STEP, NULL);
-    if (page->scroll_view == NULL)
+    // Rows are created on demand and recycled, so only the rows in view exist
+    // however many tasks there are.
+    const ui_list_view_adapter task_adapter = {
+        .create_row = create_task_row,
+        .bind_row = bind_task_row,
+        .unbind_row = unbind_task_row,
+        .context = page,
+    };
+    page->task_list = ui_list_view_create(
+        allocator, &(SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, 1.0F, 1.0F}, 0U,
+        UI_LIST_VIEW_FIXED_HEIGHT, ROW_HEIGHT, ROW_OVERSCAN, &task_adapter, NULL);
+    if (page->task_list == NULL)
     {
-        fail_fast("todo_page: failed to create scroll view");
+        fail_fast("todo_page: failed to create task list");
     }
+    ui_list_view_set_spacing(page->task_list, ROW_GAP, ROW_GAP);
+    page->task_list->scroll_step = SCROLL_STEP;
 
-    page->bottom_rule = ui_hrule_create(1.0F, page->color_ink, 0.0F);
+    page->bottom_rule = ui_hrule_create(allocator, 1.0F, page->color_ink, 0.0F);
     if (page->bottom_rule == NULL)
     {
         fail_fast("todo_page: failed to create bottom rule");
     }
 
     page->clear_done = ui_button_create(
-        &(SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, CLEAR_BUTTON_W, CLEAR_BUTTON_H}, color_button_dark,
-        page->color_button_down, "CLEAR DONE", &page->color_ink, handle_clear_button_click, page);
+        allocator, &(SDL_FRect){LAYOUT_MARGIN, LIST_TOP_Y, CLEAR_BUTTON_W, CLEAR_BUTTON_H},
+        color_button_dark, page->color_button_down, "CLEAR DONE", &page->color_ink,
+        handle_clear_button_click, page);
     if (page->clear_done == NULL)
     {
         fail_fast("todo_page: failed to create clear-done button");
     }
 
-    page->remaining_text =
-        ui_text_create(LAYOUT_MARGIN, LIST_TOP_Y, "0 REMAINING", page->color_muted, NULL);
+    page->remaining_text = ui_text_create(allocator, LAYOUT_MARGIN, LIST_TOP_Y, "0 REMAINING",
+                                          page->color_muted, NULL);
     if (page->remaining_text == NULL)
     {
         fail_fast("todo_page: failed to create remaining text");
     }
 
-    page->fps_counter =
-        ui_fps_counter_create(viewport_width, viewport_height, 12.0F, page->color_ink, NULL);
+    page->fps_counter = ui_fps_counter_create(allocator, viewport_width, viewport_height, 12.0F,
+                                              page->color_ink, NULL);
     if (page->fps_counter == NULL)
     {
         fail_fast("todo_page: failed to create fps counter");
     }
 
-    app_page_shell_init(&page->shell, context, viewport_width, viewport_height, "todo_page");
-
     add_window_child_or_fail(page, (ui_element *)page->header_left);
     add_window_child_or_fail(page, (ui_element *)page->header_right);
     add_window_child_or_fail(page, (ui_element *)page->title_text);
@@ -1004,7 +1175,7 @@ todo_page *todo_page_create(SDL_Window *window, ui_runtime *context, int viewpor
     add_window_child_or_fail(page, (ui_element *)page->filter_group);
     add_window_child_or_fail(page, (ui_element *)page->top_rule);
     add_window_child_or_fail(page, (ui_element *)page->list_frame);
-    add_window_child_or_fail(page, (ui_element *)page->scroll_view);
+    add_window_child_or_fail(page, (ui_element *)page->task_list);
     add_window_child_or_fail(page, (ui_element *)page->bottom_rule);
     add_window_child_or_fail(page, (ui_element *)page->clear_done);
     add_window_child_or_fail(page, (ui_element *)page->remaining_text);
@@ -1025,14 +1196,16 @@ todo_page *todo_page_create(SDL_Window *window, ui_runtime *context, int viewpor
         "red", "orange", "yellow", "green", "blue", "indigo", "violet", "cyan", "magenta", "amber",
     };
 
+    // Seeded titles repeat past the first few, so large lists share strings.
     char initial_due_time[6];
-    for (size_t i = 0U; i < SDL_arraysize(initial_task_titles); ++i)
+    for (size_t i = 0U; i < initial_task_count; ++i)
     {
-        fill_random_time(initial_due_time, sizeof(initial_due_time));
-        append_task(page, initial_task_titles[i], initial_due_time, false);
+        fill_random_time(page, initial_due_time, sizeof(initial_due_time));
+        append_task(page, initial_task_titles[i % SDL_arraysize(initial_task_titles)],
+                    initial_due_time, false);
     }
 
-    rebuild_task_rows(page);
+    refresh_task_list(page);
 
     return page;
 }
@@ -1044,7 +1217,7 @@ bool todo_page_update(todo_page *page)
         fail_fast("todo_page_update called with NULL page");
     }
 
-    const time_t now = time(NULL);
+    const time_t now = current_wall_time();
     if (now != page->last_header_time)
     {
         page->last_header_time = now;
@@ -1056,11 +1229,44 @@ bool todo_page_update(todo_page *page)
         }
     }
 
-    const todo_page_layout layout = compute_page_geometry(page);
-    arrange_page_layout(page, &layout);
+    // The clock label invalidates its own measure; ui_runtime_layout reflows it.
     return true;
 }
 
+size_t todo_page_task_count(const todo_page *page)
+{
+    return page != NULL ? page->task_count : 0U;
+}
+
+bool todo_page_get_task(const todo_page *page, size_t index, const char **out_title,
+                        const char **out_due_time, bool *out_is_done)
+{
+    if (page == NULL || index >= page->task_count)
+    {
+        return false;
+    }
+
+    const todo_task *task = &page->tasks[index];
+    if (out_title != NULL)
+    {
+        *out_title = task->title;
+    }
+    if (out_due_time != NULL)
+    {
+        *out_due_time = task->due_time;
+    }
+    if (out_is_done != NULL)
+    {
+        *out_is_done = task->is_done;
+    }
+    return true;
+}
+
+const char *todo_page_header_text(const todo_page *page)
+{
+    return page != NULL ? ui_text_get_content(page->datetime_text) : NULL;
+}
+
 static void *create_todo_page_instance(SDL_Window *window, ui_runtime *context, int viewport_width,
                                        int viewport_height)
 {
@@ -1077,15 +1283,33 @@ static bool update_todo_page_instance(void *page_instance)
     return todo_page_update((todo_page *)page_instance);
 }
 
+static float next_todo_page_frame_delay(void *page_instance)
+{
+    (void)page_instance;
+
+    // The header clock only changes on wall-clock second boundaries. Wake just
+    // past the boundary so the wall-clock second has already ticked over.
+    const SDL_Time now_ns = ui_clock_wall_ns();
+    if (now_ns == 0)
+    {
+        return 1.0F;
+    }
+    const Sint64 into_second_ns = now_ns % (Sint64)SDL_NS_PER_SECOND;
+    const Sint64 remaining_ns = (Sint64)SDL_NS_PER_SECOND - into_second_ns;
+    return ((float)remaining_ns / (float)SDL_NS_PER_SECOND) + HEADER_CLOCK_WAKE_SLACK_SECONDS;
+}
+
 static void destroy_todo_page_instance(void *page_instance)
 {
     todo_page_destroy((todo_page *)page_instance);
 }
 
 const app_page_ops todo_page_ops = {
+    .configure = todo_page_configure,
     .create = create_todo_page_instance,
     .resize = resize_todo_page_instance,
     .update = update_todo_page_instance,
+    .next_frame_delay = next_todo_page_frame_delay,
     .destroy = destroy_todo_page_instance,
 };
 
@@ -1096,7 +1320,8 @@ void todo_page_destroy(todo_page *page)
         fail_fast("todo_page_destroy called with NULL page");
     }
 
-    destroy_task_storage(page);
+    // Widgets first: rows hold references into the task string pool.
     unregister_elements(page);
+    destroy_task_storage(page);
     free(page);
 }
@@ -0,0 +1,55 @@
+#include "system/ui_clock.h"
+
+static bool is_virtual = false;
+static SDL_Time virtual_wall_ns = 0;
+static Uint64 virtual_ticks_ns = 0U;
+
+void ui_clock_use_virtual(SDL_Time wall_start_ns, Uint64 ticks_start_ns)
+{
+    is_virtual = true;
+    virtual_wall_ns = wall_start_ns;
+    virtual_ticks_ns = ticks_start_ns;
+}
+
+void ui_clock_use_real(void)
+{
+    is_virtual = false;
+    virtual_wall_ns = 0;
+    virtual_ticks_ns = 0U;
+}
+
+bool ui_clock_is_virtual(void)
+{
+    return is_virtual;
+}
+
+void ui_clock_advance(Uint64 delta_ns)
+{
+    if (!is_virtual)
+    {
+        return;
+    }
+
+    virtual_wall_ns += (SDL_Time)delta_ns;
+    virtual_ticks_ns += delta_ns;
+}
+
+SDL_Time ui_clock_wall_ns(void)
+{
+    if (is_virtual)
+    {
+        return virtual_wall_ns;
+    }
+
+    SDL_Time now_ns = 0;
+    if (!SDL_GetCurrentTime(&now_ns))
+    {
+        return 0;
+    }
+    return now_ns;
+}
+
+Uint64 ui_clock_ticks_ns(void)
+{
+    return is_virtual ? virtual_ticks_ns : SDL_GetTicksNS();
+}
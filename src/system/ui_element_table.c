@@ -0,0 +1,318 @@
+#include "system/ui_element_table.h"
+
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_ELEMENT_TABLE_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UI_ELEMENT_TABLE_NEON 1
+#endif
+
+// Rows are processed four at a time; capacity is always a multiple of this.
+#define TABLE_LANES 4U
+
+static void pad_rows(ui_element_table *table, size_t first, size_t last)
+{
+    // Inverted rects never contain a point, so padded lanes drop out of the
+    // kernel's mask without a bounds check.
+    for (size_t i = first; i < last; ++i)
+    {
+        table->min_x[i] = FLT_MAX;
+        table->min_y[i] = FLT_MAX;
+        table->max_x[i] = -FLT_MAX;
+        table->max_y[i] = -FLT_MAX;
+        table->flags[i] = 0U;
+        table->ops[i] = NULL;
+    }
+}
+
+static bool resize_array(void **storage, size_t element_size, size_t capacity)
+{
+    void *resized = realloc(*storage, capacity * element_size);
+    if (resized == NULL)
+    {
+        return false;
+    }
+    *storage = resized;
+    return true;
+}
+
+static bool reserve_rows(ui_element_table *table, size_t needed)
+{
+    if (needed <= table->capacity)
+    {
+        return true;
+    }
+
+    size_t new_capacity = table->capacity == 0U ? 8U * TABLE_LANES : table->capacity * 2U;
+    while (new_capacity < needed)
+    {
+        new_capacity *= 2U;
+    }
+
+    // Arrays that grew before a later failure simply keep the extra room.
+    if (!resize_array((void **)&table->min_x, sizeof(float), new_capacity) ||
+        !resize_array((void **)&table->min_y, sizeof(float), new_capacity) ||
+        !resize_array((void **)&table->max_x, sizeof(float), new_capacity) ||
+        !resize_array((void **)&table->max_y, sizeof(float), new_capacity) ||
+        !resize_array((void **)&table->flags, sizeof(Uint8), new_capacity) ||
+        !resize_array((void **)(void *)&table->ops, sizeof(*table->ops), new_capacity))
+    {
+        return false;
+    }
+
+    pad_rows(table, table->capacity, new_capacity);
+    table->capacity = new_capacity;
+    return true;
+}
+
+static Uint8 element_flags(const ui_element *element)
+{
+    if (element == NULL || element->ops == NULL)
+    {
+        return 0U;
+    }
+
+    const ui_element_ops *ops = element->ops;
+    const bool subtree = ops->child_span != NULL || ops->finish_render != NULL;
+    unsigned int flags = 0U;
+    flags |= element->visible ? UI_ELEMENT_TABLE_VISIBLE : 0U;
+    flags |= element->enabled ? UI_ELEMENT_TABLE_ENABLED : 0U;
+    flags |= ops->handle_event != NULL ? UI_ELEMENT_TABLE_HANDLES_EVENTS : 0U;
+    flags |= subtree || ops->update != NULL ? UI_ELEMENT_TABLE_UPDATES : 0U;
+    flags |= subtree || ops->render != NULL ? UI_ELEMENT_TABLE_RENDERS : 0U;
+    flags |= subtree ? UI_ELEMENT_TABLE_SUBTREE : 0U;
+    return (Uint8)flags;
+}
+
+static void write_row(ui_element_table *table, size_t index, const ui_element *element)
+{
+    table->flags[index] = element_flags(element);
+    table->ops[index] = element != NULL ? element->ops : NULL;
+    if (table->flags[index] == 0U)
+    {
+        pad_rows(table, index, index + 1U);
+        return;
+    }
+
+    const SDL_FRect sr = ui_element_screen_rect(element);
+    table->min_x[index] = sr.x;
+    table->min_y[index] = sr.y;
+    table->max_x[index] = sr.x + sr.w;
+    table->max_y[index] = sr.y + sr.h;
+}
+
+static void move_rows(ui_element_table *table, size_t to, size_t from, size_t count)
+{
+    memmove(table->min_x + to, table->min_x + from, count * sizeof(float));
+    memmove(table->min_y + to, table->min_y + from, count * sizeof(float));
+    memmove(table->max_x + to, table->max_x + from, count * sizeof(float));
+    memmove(table->max_y + to, table->max_y + from, count * sizeof(float));
+    memmove(table->flags + to, table->flags + from, count * sizeof(Uint8));
+    memmove((void *)(table->ops + to), (const void *)(table->ops + from),
+            count * sizeof(*table->ops));
+}
+
+/*
+ * Bit k of the result is set when row start + k contains point, with the same
+ * inclusive edges as SDL_PointInRectFloat.
+ */
+static unsigned int point_in_rect_mask(const ui_element_table *table, size_t start,
+                                       const SDL_FPoint *point)
+{
+#if defined(UI_ELEMENT_TABLE_SSE2)
+    const __m128 px = _mm_set1_ps(point->x);
+    const __m128 py = _mm_set1_ps(point->y);
+    __m128 inside = _mm_cmple_ps(_mm_loadu_ps(table->min_x + start), px);
+    inside = _mm_and_ps(inside, _mm_cmple_ps(px, _mm_loadu_ps(table->max_x + start)));
+    inside = _mm_and_ps(inside, _mm_cmple_ps(_mm_loadu_ps(table->min_y + start), py));
+    inside = _mm_and_ps(inside, _mm_cmple_ps(py, _mm_loadu_ps(table->max_y + start)));
+    return (unsigned int)_mm_movemask_ps(inside);
+#elif defined(UI_ELEMENT_TABLE_NEON)
+    const float32x4_t px = vdupq_n_f32(point->x);
+    const float32x4_t py = vdupq_n_f32(point->y);
+    uint32x4_t inside = vcleq_f32(vld1q_f32(table->min_x + start), px);
+    inside = vandq_u32(inside, vcleq_f32(px, vld1q_f32(table->max_x + start)));
+    inside = vandq_u32(inside, vcleq_f32(vld1q_f32(table->min_y + start), py));
+    inside = vandq_u32(inside, vcleq_f32(py, vld1q_f32(table->max_y + start)));
+    const uint32_t lane_bits[TABLE_LANES] = {1U, 2U, 4U, 8U};
+    return (unsigned int)vaddvq_u32(vandq_u32(inside, vld1q_u32(lane_bits)));
+#else
+    unsigned int mask = 0U;
+    for (size_t lane = 0U; lane < TABLE_LANES; ++lane)
+    {
+        const size_t i = start + lane;
+        if (table->min_x[i] <= point->x && point->x <= table->max_x[i] &&
+            table->min_y[i] <= point->y && point->y <= table->max_y[i])
+        {
+            mask |= 1U << lane;
+        }
+    }
+    return mask;
+#endif
+}
+
+void ui_element_table_init(ui_element_table *table)
+{
+    if (table == NULL)
+    {
+        return;
+    }
+
+    memset(table, 0, sizeof(*table));
+}
+
+void ui_element_table_destroy(ui_element_table *table)
+{
+    if (table == NULL)
+    {
+        return;
+    }
+
+    free(table->min_x);
+    free(table->min_y);
+    free(table->max_x);
+    free(table->max_y);
+    free(table->flags);
+    free((void *)table->ops);
+    ui_element_table_init(table);
+}
+
+bool ui_element_table_insert(ui_element_table *table, size_t index, const ui_element *element)
+{
+    if (table == NULL || index > table->count || !reserve_rows(table, table->count + 1U))
+    {
+        return false;
+    }
+
+    move_rows(table, index + 1U, index, table->count - index);
+    write_row(table, index, element);
+    table->count++;
+    return true;
+}
+
+void ui_element_table_clear(ui_element_table *table, size_t index)
+{
+    if (table == NULL || index >= table->count)
+    {
+        return;
+    }
+
+    write_row(table, index, NULL);
+}
+
+void ui_element_table_truncate(ui_element_table *table, size_t count)
+{
+    if (table == NULL || count >= table->count)
+    {
+        return;
+    }
+
+    pad_rows(table, count, table->count);
+    table->count = count;
+}
+
+void ui_element_table_rewrite(ui_element_table *table, ui_element *const *elements, size_t count)
+{
+    if (table == NULL || count > table->count)
+    {
+        return;
+    }
+
+    for (size_t i = 0U; i < count; ++i)
+    {
+        write_row(table, i, elements[i]);
+    }
+    ui_element_table_truncate(table, count);
+}
+
+void ui_element_table_sync(ui_element_table *table, ui_element *const *elements, size_t count)
+{
+    if (table == NULL || count != table->count)
+    {
+        return;
+    }
+
+    const Uint64 generation = ui_element_render_generation();
+    if (table->synced_generation == generation)
+    {
+        return;
+    }
+
+    for (size_t i = 0U; i < count; ++i)
+    {
+        write_row(table, i, elements[i]);
+    }
+    table->synced_generation = generation;
+}
+
+Uint8 ui_element_table_flags(const ui_element_table *table, size_t index)
+{
+    if (table == NULL || index >= table->count)
+    {
+        return 0U;
+    }
+    return table->flags[index];
+}
+
+void ui_element_table_query(const ui_element_table *table, const SDL_FPoint *point,
+                            Uint8 required_flags, ui_element_table_cursor *cursor)
+{
+    if (cursor == NULL)
+    {
+        return;
+    }
+
+    cursor->table = table;
+    cursor->point = point != NULL ? *point : (SDL_FPoint){0.0F, 0.0F};
+    cursor->required_flags = required_flags;
+    cursor->pending_mask = 0U;
+    cursor->block_start = 0U;
+    if (table != NULL && point != NULL)
+    {
+        // Start past the last (padded) block; blocks are consumed downwards.
+        cursor->block_start = (table->count + TABLE_LANES - 1U) / TABLE_LANES * TABLE_LANES;
+    }
+}
+
+bool ui_element_table_cursor_next(ui_element_table_cursor *cursor, size_t *out_index)
+{
+    if (cursor == NULL || out_index == NULL)
+    {
+        return false;
+    }
+
+    const ui_element_table *table = cursor->table;
+    while (cursor->pending_mask == 0U)
+    {
+        if (cursor->block_start == 0U)
+        {
+            return false;
+        }
+
+        cursor->block_start -= TABLE_LANES;
+        unsigned int mask = point_in_rect_mask(table, cursor->block_start, &cursor->point);
+        for (size_t lane = 0U; lane < TABLE_LANES; ++lane)
+        {
+            const Uint8 flags = table->flags[cursor->block_start + lane];
+            if ((flags & cursor->required_flags) != cursor->required_flags)
+            {
+                mask &= ~(1U << lane);
+            }
+        }
+        cursor->pending_mask = mask;
+    }
+
+    size_t lane = TABLE_LANES - 1U;
+    while ((cursor->pending_mask & (1U << lane)) == 0U)
+    {
+        --lane;
+    }
+    cursor->pending_mask &= ~(1U << lane);
+    *out_index = cursor->block_start + lane;
+    return true;
+}
@@ -0,0 +1,337 @@
+#include "system/ui_event_log.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char LOG_MAGIC[8] = {'C', 'U', 'I', 'E', 'V', 'L', 'O', 'G'};
+static const Uint32 LOG_VERSION = 2U;
+// Major.minor only: patch releases keep the event struct layout.
+static const Uint32 LOG_SDL_VERSION = (Uint32)(SDL_VERSION / 1000);
+static const size_t MAX_TEXT_LENGTH = 0xFFFFU;
+
+/*
+ * Bytes of SDL_Event stored for type, or 0 for types the log does not carry.
+ */
+static size_t event_payload_size(Uint32 type)
+{
+    switch (type)
+    {
+    case SDL_EVENT_MOUSE_MOTION:
+        return sizeof(SDL_MouseMotionEvent);
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+        return sizeof(SDL_MouseButtonEvent);
+    case SDL_EVENT_MOUSE_WHEEL:
+        return sizeof(SDL_MouseWheelEvent);
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+        return sizeof(SDL_KeyboardEvent);
+    case SDL_EVENT_TEXT_INPUT:
+        return sizeof(SDL_TextInputEvent);
+    case SDL_EVENT_TEXT_EDITING:
+        return sizeof(SDL_TextEditingEvent);
+    case SDL_EVENT_RENDER_TARGETS_RESET:
+    case SDL_EVENT_RENDER_DEVICE_RESET:
+        return sizeof(SDL_RenderEvent);
+    case SDL_EVENT_QUIT:
+        return sizeof(SDL_QuitEvent);
+    default:
+        break;
+    }
+
+    if (type >= SDL_EVENT_WINDOW_FIRST && type <= SDL_EVENT_WINDOW_LAST)
+    {
+        return sizeof(SDL_WindowEvent);
+    }
+    return 0U;
+}
+
+static const char **event_text_field(SDL_Event *event)
+{
+    if (event->type == SDL_EVENT_TEXT_INPUT)
+    {
+        return &event->text.text;
+    }
+    if (event->type == SDL_EVENT_TEXT_EDITING)
+    {
+        return &event->edit.text;
+    }
+    return NULL;
+}
+
+bool ui_event_log_writer_open(ui_event_log_writer *writer, const char *path,
+                              const ui_event_log_header *header)
+{
+    if (writer == NULL || path == NULL || header == NULL)
+    {
+        return SDL_InvalidParamError("writer");
+    }
+
+    memset(writer, 0, sizeof(*writer));
+    SDL_IOStream *stream = SDL_IOFromFile(path, "wb");
+    if (stream == NULL)
+    {
+        return false;
+    }
+
+    const bool ok = SDL_WriteIO(stream, LOG_MAGIC, sizeof(LOG_MAGIC)) == sizeof(LOG_MAGIC) &&
+                    SDL_WriteU32LE(stream, LOG_VERSION) &&
+                    SDL_WriteU32LE(stream, LOG_SDL_VERSION) &&
+                    SDL_WriteS64LE(stream, header->wall_start_ns) &&
+                    SDL_WriteU64LE(stream, header->ticks_start_ns) &&
+                    SDL_WriteS32LE(stream, header->width) && SDL_WriteS32LE(stream, header->height);
+    if (!ok)
+    {
+        SDL_CloseIO(stream);
+        return false;
+    }
+
+    writer->stream = stream;
+    writer->ticks_start_ns = header->ticks_start_ns;
+    return true;
+}
+
+bool ui_event_log_write(ui_event_log_writer *writer, Uint32 frame_index, Uint64 timestamp_ns,
+                        const SDL_Event *event)
+{
+    if (writer == NULL || writer->stream == NULL || writer->failed || event == NULL)
+    {
+        return false;
+    }
+
+    const size_t size = event_payload_size(event->type);
+    if (size == 0U)
+    {
+        writer->skipped_events++;
+        return true;
+    }
+
+    const Uint64 relative_ns =
+        timestamp_ns > writer->ticks_start_ns ? timestamp_ns - writer->ticks_start_ns : 0U;
+    bool ok = SDL_WriteU32LE(writer->stream, frame_index) &&
+              SDL_WriteU64LE(writer->stream, relative_ns) &&
+              SDL_WriteU16LE(writer->stream, (Uint16)size) &&
+              SDL_WriteIO(writer->stream, event, size) == size;
+
+    SDL_Event copy = *event;
+    const char **text = event_text_field(&copy);
+    if (ok && text != NULL)
+    {
+        size_t length = *text != NULL ? strlen(*text) : 0U;
+        if (length > MAX_TEXT_LENGTH)
+        {
+            length = MAX_TEXT_LENGTH;
+        }
+        ok = SDL_WriteU16LE(writer->stream, (Uint16)length) &&
+             (length == 0U || SDL_WriteIO(writer->stream, *text, length) == length);
+    }
+
+    if (!ok)
+    {
+        writer->failed = true;
+        return false;
+    }
+    writer->written_events++;
+    return true;
+}
+
+bool ui_event_log_write_frame(ui_event_log_writer *writer, Uint32 frame_index, Uint64 frame_ns)
+{
+    if (writer == NULL || writer->stream == NULL || writer->failed)
+    {
+        return false;
+    }
+
+    // Same prefix as an event record; the zero payload size marks it.
+    const bool ok = SDL_WriteU32LE(writer->stream, frame_index) &&
+                    SDL_WriteU64LE(writer->stream, frame_ns) &&
+                    SDL_WriteU16LE(writer->stream, 0U);
+    if (!ok)
+    {
+        writer->failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool ui_event_log_writer_close(ui_event_log_writer *writer)
+{
+    if (writer == NULL || writer->stream == NULL)
+    {
+        return writer != NULL && !writer->failed;
+    }
+
+    const bool closed = SDL_CloseIO(writer->stream);
+    writer->stream = NULL;
+    if (!closed)
+    {
+        writer->failed = true;
+    }
+    return !writer->failed;
+}
+
+static void read_next_prefix(ui_event_log_reader *reader)
+{
+    reader->has_pending = false;
+
+    Uint32 frame_index = 0U;
+    if (!SDL_ReadU32LE(reader->stream, &frame_index))
+    {
+        // A clean end of file lands exactly on a record boundary.
+        reader->failed = SDL_GetIOStatus(reader->stream) != SDL_IO_STATUS_EOF;
+        return;
+    }
+
+    Uint64 timestamp_ns = 0U;
+    Uint16 size = 0U;
+    if (!SDL_ReadU64LE(reader->stream, &timestamp_ns) || !SDL_ReadU16LE(reader->stream, &size))
+    {
+        reader->failed = true;
+        return;
+    }
+
+    reader->pending_frame = frame_index;
+    reader->pending_timestamp_ns = timestamp_ns;
+    reader->pending_size = size;
+    reader->has_pending = true;
+}
+
+static bool read_text(ui_event_log_reader *reader, const char **out_text)
+{
+    Uint16 length = 0U;
+    if (!SDL_ReadU16LE(reader->stream, &length))
+    {
+        return false;
+    }
+
+    if ((size_t)length + 1U > reader->text_capacity)
+    {
+        char *resized = realloc(reader->text, (size_t)length + 1U);
+        if (resized == NULL)
+        {
+            return false;
+        }
+        reader->text = resized;
+        reader->text_capacity = (size_t)length + 1U;
+    }
+
+    if (length > 0U && SDL_ReadIO(reader->stream, reader->text, length) != length)
+    {
+        return false;
+    }
+    reader->text[length] = '\0';
+    *out_text = reader->text;
+    return true;
+}
+
+bool ui_event_log_reader_open(ui_event_log_reader *reader, const char *path)
+{
+    if (reader == NULL || path == NULL)
+    {
+        return SDL_InvalidParamError("reader");
+    }
+
+    memset(reader, 0, sizeof(*reader));
+    SDL_IOStream *stream = SDL_IOFromFile(path, "rb");
+    if (stream == NULL)
+    {
+        return false;
+    }
+
+    char magic[sizeof(LOG_MAGIC)];
+    Uint32 version = 0U;
+    Uint32 sdl_version = 0U;
+    Sint32 width = 0;
+    Sint32 height = 0;
+    const bool read = SDL_ReadIO(stream, magic, sizeof(magic)) == sizeof(magic) &&
+                      SDL_ReadU32LE(stream, &version) && SDL_ReadU32LE(stream, &sdl_version) &&
+                      SDL_ReadS64LE(stream, &reader->header.wall_start_ns) &&
+                      SDL_ReadU64LE(stream, &reader->header.ticks_start_ns) &&
+                      SDL_ReadS32LE(stream, &width) && SDL_ReadS32LE(stream, &height);
+    if (!read || memcmp(magic, LOG_MAGIC, sizeof(magic)) != 0)
+    {
+        SDL_CloseIO(stream);
+        return SDL_SetError("%s is not an event log", path);
+    }
+    if (version != LOG_VERSION || sdl_version != LOG_SDL_VERSION)
+    {
+        SDL_CloseIO(stream);
+        return SDL_SetError("%s: unsupported event log version %u (SDL %u)", path,
+                            (unsigned)version, (unsigned)sdl_version);
+    }
+
+    reader->header.width = width;
+    reader->header.height = height;
+    reader->stream = stream;
+    read_next_prefix(reader);
+    return true;
+}
+
+bool ui_event_log_read(ui_event_log_reader *reader, Uint32 frame_index, SDL_Event *out_event,
+                       Uint64 *out_timestamp_ns)
+{
+    if (reader == NULL || out_event == NULL || !reader->has_pending ||
+        reader->pending_frame > frame_index || reader->pending_size == 0U)
+    {
+        return false;
+    }
+
+    reader->has_pending = false;
+    const Uint16 size = reader->pending_size;
+    memset(out_event, 0, sizeof(*out_event));
+    if (size > sizeof(*out_event) || SDL_ReadIO(reader->stream, out_event, size) != size ||
+        event_payload_size(out_event->type) != size)
+    {
+        reader->failed = true;
+        return false;
+    }
+
+    const char **text = event_text_field(out_event);
+    if (text != NULL && !read_text(reader, text))
+    {
+        reader->failed = true;
+        return false;
+    }
+
+    if (out_timestamp_ns != NULL)
+    {
+        *out_timestamp_ns = reader->pending_timestamp_ns;
+    }
+    reader->read_events++;
+    read_next_prefix(reader);
+    return true;
+}
+
+bool ui_event_log_read_frame(ui_event_log_reader *reader, Uint32 frame_index,
+                             Uint64 *out_frame_ns)
+{
+    if (reader == NULL || out_frame_ns == NULL || !reader->has_pending ||
+        reader->pending_frame > frame_index || reader->pending_size != 0U)
+    {
+        return false;
+    }
+
+    *out_frame_ns = reader->pending_timestamp_ns;
+    read_next_prefix(reader);
+    return true;
+}
+
+bool ui_event_log_reader_at_end(const ui_event_log_reader *reader)
+{
+    return reader == NULL || !reader->has_pending;
+}
+
+void ui_event_log_reader_close(ui_event_log_reader *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+
+    if (reader->stream != NULL)
+    {
+        SDL_CloseIO(reader->stream);
+    }
+    free(reader->text);
+    memset(reader, 0, sizeof(*reader));
+}
@@ -0,0 +1,189 @@
+#include "system/ui_frame_profiler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const PHASE_NAMES[UI_FRAME_PHASE_COUNT] = {
+    "events", "page update", "runtime update", "layout", "render",
+};
+
+static bool is_valid_phase(ui_frame_phase phase)
+{
+    return (int)phase >= 0 && phase < UI_FRAME_PHASE_COUNT;
+}
+
+static size_t stored_frame_count(const ui_frame_profiler *profiler)
+{
+    return profiler->frame_count < UI_FRAME_PROFILER_CAPACITY ? (size_t)profiler->frame_count
+                                                              : UI_FRAME_PROFILER_CAPACITY;
+}
+
+bool ui_frame_profiler_init(ui_frame_profiler *profiler)
+{
+    if (profiler == NULL)
+    {
+        return false;
+    }
+
+    memset(profiler, 0, sizeof(*profiler));
+    profiler->ticks_per_second = SDL_GetPerformanceFrequency();
+    if (profiler->ticks_per_second == 0U)
+    {
+        profiler->ticks_per_second = 1U;
+    }
+    return true;
+}
+
+void ui_frame_profiler_begin_frame(ui_frame_profiler *profiler)
+{
+    if (profiler == NULL)
+    {
+        return;
+    }
+
+    memset(profiler->pending_ticks, 0, sizeof(profiler->pending_ticks));
+    profiler->in_frame = true;
+    profiler->mark_counter = SDL_GetPerformanceCounter();
+}
+
+void ui_frame_profiler_mark(ui_frame_profiler *profiler, ui_frame_phase phase)
+{
+    if (profiler == NULL || !profiler->in_frame || !is_valid_phase(phase))
+    {
+        return;
+    }
+
+    const Uint64 now = SDL_GetPerformanceCounter();
+    profiler->pending_ticks[phase] += now - profiler->mark_counter;
+    profiler->mark_counter = now;
+}
+
+void ui_frame_profiler_record_frame(ui_frame_profiler *profiler,
+                                    const Uint64 phase_ticks[UI_FRAME_PHASE_COUNT])
+{
+    if (profiler == NULL || phase_ticks == NULL)
+    {
+        return;
+    }
+
+    const size_t slot = profiler->next_slot;
+    Uint64 frame_ticks = 0U;
+    for (size_t phase = 0U; phase < UI_FRAME_PHASE_COUNT; ++phase)
+    {
+        profiler->phase_ticks[phase][slot] = phase_ticks[phase];
+        frame_ticks += phase_ticks[phase];
+    }
+    profiler->frame_ticks[slot] = frame_ticks;
+    profiler->next_slot = (slot + 1U) % UI_FRAME_PROFILER_CAPACITY;
+    profiler->frame_count++;
+}
+
+void ui_frame_profiler_end_frame(ui_frame_profiler *profiler)
+{
+    if (profiler == NULL || !profiler->in_frame)
+    {
+        return;
+    }
+
+    profiler->in_frame = false;
+    ui_frame_profiler_record_frame(profiler, profiler->pending_ticks);
+}
+
+static int compare_ticks(const void *lhs, const void *rhs)
+{
+    const Uint64 a = *(const Uint64 *)lhs;
+    const Uint64 b = *(const Uint64 *)rhs;
+    return (a > b) - (a < b);
+}
+
+static double ticks_to_ms(const ui_frame_profiler *profiler, Uint64 ticks)
+{
+    return (double)ticks * 1000.0 / (double)profiler->ticks_per_second;
+}
+
+// Nearest rank: the smallest sample with at least percent% of samples at or below it.
+static Uint64 percentile(const Uint64 *sorted, size_t count, size_t percent)
+{
+    const size_t rank = (percent * count + 99U) / 100U;
+    return sorted[rank > 0U ? rank - 1U : 0U];
+}
+
+static ui_frame_timing_stats summarize(const ui_frame_profiler *profiler, const Uint64 *series)
+{
+    ui_frame_timing_stats stats;
+    SDL_zero(stats);
+
+    const size_t count = stored_frame_count(profiler);
+    if (count == 0U)
+    {
+        return stats;
+    }
+
+    // Sorted on a stack copy so queries neither allocate nor disturb the ring.
+    Uint64 sorted[UI_FRAME_PROFILER_CAPACITY];
+    memcpy(sorted, series, count * sizeof(sorted[0]));
+    qsort(sorted, count, sizeof(sorted[0]), compare_ticks);
+
+    stats.sample_count = count;
+    stats.p50_ms = ticks_to_ms(profiler, percentile(sorted, count, 50U));
+    stats.p95_ms = ticks_to_ms(profiler, percentile(sorted, count, 95U));
+    stats.p99_ms = ticks_to_ms(profiler, percentile(sorted, count, 99U));
+    stats.max_ms = ticks_to_ms(profiler, sorted[count - 1U]);
+    return stats;
+}
+
+ui_frame_timing_stats ui_frame_profiler_get_frame_stats(const ui_frame_profiler *profiler)
+{
+    if (profiler == NULL)
+    {
+        ui_frame_timing_stats empty;
+        SDL_zero(empty);
+        return empty;
+    }
+
+    return summarize(profiler, profiler->frame_ticks);
+}
+
+ui_frame_timing_stats ui_frame_profiler_get_phase_stats(const ui_frame_profiler *profiler,
+                                                        ui_frame_phase phase)
+{
+    if (profiler == NULL || !is_valid_phase(phase))
+    {
+        ui_frame_timing_stats empty;
+        SDL_zero(empty);
+        return empty;
+    }
+
+    return summarize(profiler, profiler->phase_ticks[phase]);
+}
+
+const char *ui_frame_phase_name(ui_frame_phase phase)
+{
+    return is_valid_phase(phase) ? PHASE_NAMES[phase] : "unknown";
+}
+
+static void log_stats_row(const char *label, const ui_frame_timing_stats *stats)
+{
+    SDL_Log("  %-15s %9.3f %9.3f %9.3f %9.3f", label, stats->p50_ms, stats->p95_ms,
+            stats->p99_ms, stats->max_ms);
+}
+
+void ui_frame_profiler_log_summary(const ui_frame_profiler *profiler)
+{
+    if (profiler == NULL)
+    {
+        return;
+    }
+
+    const ui_frame_timing_stats frame = ui_frame_profiler_get_frame_stats(profiler);
+    SDL_Log("Frame profile: last %zu of %llu frames (ms)", frame.sample_count,
+            (unsigned long long)profiler->frame_count);
+    SDL_Log("  %-15s %9s %9s %9s %9s", "phase", "p50", "p95", "p99", "max");
+    log_stats_row("frame", &frame);
+    for (int phase = 0; phase < UI_FRAME_PHASE_COUNT; ++phase)
+    {
+        const ui_frame_timing_stats stats =
+            ui_frame_profiler_get_phase_stats(profiler, (ui_frame_phase)phase);
+        log_stats_row(ui_frame_phase_name((ui_frame_phase)phase), &stats);
+    }
+}
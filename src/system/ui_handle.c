@@ -0,0 +1,111 @@
+#include "system/ui_handle.h"
+
+#include <stdlib.h>
+
+/*
+ * Slot 0 is reserved so element->handle_index == 0 can mean "no slot" and
+ * next_free == 0 can terminate the free list.
+ */
+typedef struct handle_slot
+{
+    ui_element *element;
+    Uint32 generation;
+    Uint32 next_free;
+} handle_slot;
+
+static handle_slot *slots = NULL;
+static Uint32 slot_count = 0U;
+static Uint32 slot_capacity = 0U;
+static Uint32 free_head = 0U;
+
+static bool reserve_slot(void)
+{
+    if (slot_count < slot_capacity)
+    {
+        return true;
+    }
+
+    const Uint32 new_capacity = slot_capacity == 0U ? 64U : slot_capacity * 2U;
+    if (new_capacity <= slot_capacity)
+    {
+        return false;
+    }
+
+    handle_slot *resized = realloc(slots, (size_t)new_capacity * sizeof(*resized));
+    if (resized == NULL)
+    {
+        return false;
+    }
+
+    slots = resized;
+    slot_capacity = new_capacity;
+    if (slot_count == 0U)
+    {
+        slots[0] = (handle_slot){NULL, 0U, 0U};
+        slot_count = 1U;
+    }
+    return true;
+}
+
+ui_handle ui_handle_acquire(ui_element *element)
+{
+    if (element == NULL)
+    {
+        return UI_HANDLE_NULL;
+    }
+
+    if (element->handle_index != 0U)
+    {
+        return (ui_handle){element->handle_index, slots[element->handle_index].generation};
+    }
+
+    Uint32 index = free_head;
+    if (index != 0U)
+    {
+        free_head = slots[index].next_free;
+    }
+    else
+    {
+        if (!reserve_slot())
+        {
+            return UI_HANDLE_NULL;
+        }
+        index = slot_count++;
+        slots[index].generation = 1U;
+    }
+
+    slots[index].element = element;
+    slots[index].next_free = 0U;
+    element->handle_index = index;
+    return (ui_handle){index, slots[index].generation};
+}
+
+ui_element *ui_handle_resolve(ui_handle handle)
+{
+    if (handle.generation == 0U || handle.index == 0U || handle.index >= slot_count)
+    {
+        return NULL;
+    }
+
+    const handle_slot *slot = &slots[handle.index];
+    return slot->generation == handle.generation ? slot->element : NULL;
+}
+
+void ui_handle_release(ui_element *element)
+{
+    if (element == NULL || element->handle_index == 0U)
+    {
+        return;
+    }
+
+    handle_slot *slot = &slots[element->handle_index];
+    slot->element = NULL;
+    slot->generation++;
+    if (slot->generation == 0U)
+    {
+        slot->generation = 1U;
+    }
+    slot->next_free = free_head;
+    free_head = element->handle_index;
+    element->handle_index = 0U;
+}
@@ -0,0 +1,199 @@
+#include "system/ui_input_coalescer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const size_t INITIAL_SAMPLE_CAPACITY = 32U;
+
+// Samples exposed to widgets while a merged motion event is being dispatched.
+static const SDL_MouseMotionEvent *active_motion_samples = NULL;
+static size_t active_motion_sample_count = 0U;
+
+static void append_motion_sample(ui_input_coalescer *coalescer, const SDL_MouseMotionEvent *motion)
+{
+    if (coalescer->motion_sample_count == coalescer->motion_sample_capacity)
+    {
+        const size_t new_capacity = coalescer->motion_sample_capacity == 0U
+                                        ? INITIAL_SAMPLE_CAPACITY
+                                        : coalescer->motion_sample_capacity * 2U;
+        SDL_MouseMotionEvent *resized =
+            realloc(coalescer->motion_samples, new_capacity * sizeof(SDL_MouseMotionEvent));
+        if (resized == NULL)
+        {
+            // Samples are best-effort; the merged event itself is still exact.
+            return;
+        }
+        coalescer->motion_samples = resized;
+        coalescer->motion_sample_capacity = new_capacity;
+    }
+
+    coalescer->motion_samples[coalescer->motion_sample_count++] = *motion;
+}
+
+static void dispatch(ui_input_coalescer *coalescer, ui_runtime *context, const SDL_Event *event)
+{
+    coalescer->stats.dispatched_events++;
+    ui_runtime_handle_event(context, event);
+}
+
+static void dispatch_pending_motion(ui_input_coalescer *coalescer, ui_runtime *context)
+{
+    if (!coalescer->has_pending_motion)
+    {
+        return;
+    }
+
+    coalescer->has_pending_motion = false;
+    active_motion_samples = coalescer->motion_samples;
+    active_motion_sample_count = coalescer->motion_sample_count;
+    dispatch(coalescer, context, &coalescer->pending_motion);
+    active_motion_samples = NULL;
+    active_motion_sample_count = 0U;
+    coalescer->motion_sample_count = 0U;
+}
+
+static void dispatch_pending_wheel(ui_input_coalescer *coalescer, ui_runtime *context)
+{
+    if (!coalescer->has_pending_wheel)
+    {
+        return;
+    }
+
+    coalescer->has_pending_wheel = false;
+    dispatch(coalescer, context, &coalescer->pending_wheel);
+}
+
+static void push_motion(ui_input_coalescer *coalescer, ui_runtime *context,
+                        const SDL_MouseMotionEvent *motion)
+{
+    SDL_MouseMotionEvent *pending = &coalescer->pending_motion.motion;
+    if (coalescer->has_pending_motion &&
+        (pending->windowID != motion->windowID || pending->which != motion->which))
+    {
+        ui_input_coalescer_flush(coalescer, context);
+    }
+
+    append_motion_sample(coalescer, motion);
+    if (!coalescer->has_pending_motion)
+    {
+        coalescer->pending_motion.motion = *motion;
+        coalescer->has_pending_motion = true;
+        coalescer->wheel_before_motion = coalescer->has_pending_wheel;
+        return;
+    }
+
+    const float xrel = pending->xrel + motion->xrel;
+    const float yrel = pending->yrel + motion->yrel;
+    *pending = *motion;
+    pending->xrel = xrel;
+    pending->yrel = yrel;
+    coalescer->stats.merged_motion_events++;
+}
+
+static void push_wheel(ui_input_coalescer *coalescer, ui_runtime *context,
+                       const SDL_MouseWheelEvent *wheel)
+{
+    SDL_MouseWheelEvent *pending = &coalescer->pending_wheel.wheel;
+    if (coalescer->has_pending_wheel &&
+        (pending->windowID != wheel->windowID || pending->which != wheel->which ||
+         pending->direction != wheel->direction))
+    {
+        ui_input_coalescer_flush(coalescer, context);
+    }
+
+    if (!coalescer->has_pending_wheel)
+    {
+        coalescer->pending_wheel.wheel = *wheel;
+        coalescer->has_pending_wheel = true;
+        return;
+    }
+
+    const float x = pending->x + wheel->x;
+    const float y = pending->y + wheel->y;
+    *pending = *wheel;
+    pending->x = x;
+    pending->y = y;
+    coalescer->stats.merged_wheel_events++;
+}
+
+bool ui_input_coalescer_init(ui_input_coalescer *coalescer)
+{
+    if (coalescer == NULL)
+    {
+        return false;
+    }
+
+    memset(coalescer, 0, sizeof(*coalescer));
+    return true;
+}
+
+void ui_input_coalescer_destroy(ui_input_coalescer *coalescer)
+{
+    if (coalescer == NULL)
+    {
+        return;
+    }
+
+    free(coalescer->motion_samples);
+    memset(coalescer, 0, sizeof(*coalescer));
+}
+
+void ui_input_coalescer_push(ui_input_coalescer *coalescer, ui_runtime *context,
+                             const SDL_Event *event)
+{
+    if (coalescer == NULL || event == NULL)
+    {
+        return;
+    }
+
+    coalescer->stats.received_events++;
+    if (event->type == SDL_EVENT_MOUSE_MOTION)
+    {
+        push_motion(coalescer, context, &event->motion);
+        return;
+    }
+    if (event->type == SDL_EVENT_MOUSE_WHEEL)
+    {
+        push_wheel(coalescer, context, &event->wheel);
+        return;
+    }
+
+    ui_input_coalescer_flush(coalescer, context);
+    dispatch(coalescer, context, event);
+}
+
+void ui_input_coalescer_flush(ui_input_coalescer *coalescer, ui_runtime *context)
+{
+    if (coalescer == NULL)
+    {
+        return;
+    }
+
+    // Motion and wheel commute closely enough to merge across each other, but
+    // the one that started first is still delivered first.
+    if (coalescer->wheel_before_motion)
+    {
+        dispatch_pending_wheel(coalescer, context);
+    }
+    dispatch_pending_motion(coalescer, context);
+    dispatch_pending_wheel(coalescer, context);
+    coalescer->wheel_before_motion = false;
+}
+
+ui_input_coalescer_stats ui_input_coalescer_get_stats(const ui_input_coalescer *coalescer)
+{
+    if (coalescer == NULL)
+    {
+        return (ui_input_coalescer_stats){0};
+    }
+    return coalescer->stats;
+}
+
+const SDL_MouseMotionEvent *ui_input_coalesced_motion_samples(size_t *out_count)
+{
+    if (out_count != NULL)
+    {
+        *out_count = active_motion_sample_count;
+    }
+    return active_motion_samples;
+}
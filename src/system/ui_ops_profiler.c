@@ -0,0 +1,170 @@
+#include "system/ui_ops_profiler.h"
+
+#if defined(CUI_OPS_PROFILING)
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const CALL_NAMES[UI_OPS_CALL_COUNT] = {
+    "measure", "arrange", "handle_event", "update", "render",
+};
+
+static ui_ops_profile_entry entries[UI_OPS_PROFILER_MAX_TYPES];
+static size_t entry_count = 0U;
+static ui_ops_profile_scope *active_scope = NULL;
+
+static ui_ops_profile_entry *find_or_add_entry(const ui_element_ops *ops)
+{
+    if (ops == NULL)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0U; i < entry_count; ++i)
+    {
+        if (entries[i].ops == ops)
+        {
+            return &entries[i];
+        }
+    }
+
+    if (entry_count == UI_OPS_PROFILER_MAX_TYPES)
+    {
+        return NULL;
+    }
+
+    ui_ops_profile_entry *entry = &entries[entry_count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->ops = ops;
+    return entry;
+}
+
+void ui_ops_profiler_enter(ui_ops_profile_scope *scope, const ui_element_ops *ops,
+                           ui_ops_call call)
+{
+    const bool valid_call = (int)call >= 0 && call < UI_OPS_CALL_COUNT;
+    scope->entry = valid_call ? find_or_add_entry(ops) : NULL;
+    scope->call = call;
+    scope->child_ticks = 0U;
+    scope->parent = active_scope;
+    active_scope = scope;
+    scope->start_counter = SDL_GetPerformanceCounter();
+}
+
+void ui_ops_profiler_leave(ui_ops_profile_scope *scope)
+{
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - scope->start_counter;
+    active_scope = scope->parent;
+
+    // Dropped scopes (untracked type) still count as children, so the
+    // caller's self time excludes them either way.
+    if (scope->parent != NULL)
+    {
+        scope->parent->child_ticks += elapsed;
+    }
+
+    if (scope->entry == NULL)
+    {
+        return;
+    }
+
+    ui_ops_call_stats *stats = &scope->entry->current[scope->call];
+    stats->calls++;
+    stats->inclusive_ticks += elapsed;
+    stats->self_ticks += elapsed > scope->child_ticks ? elapsed - scope->child_ticks : 0U;
+}
+
+void ui_ops_profiler_end_frame(void)
+{
+    for (size_t i = 0U; i < entry_count; ++i)
+    {
+        ui_ops_profile_entry *entry = &entries[i];
+        for (size_t call = 0U; call < UI_OPS_CALL_COUNT; ++call)
+        {
+            entry->last_frame[call] = entry->current[call];
+            entry->total[call].calls += entry->current[call].calls;
+            entry->total[call].inclusive_ticks += entry->current[call].inclusive_ticks;
+            entry->total[call].self_ticks += entry->current[call].self_ticks;
+        }
+        memset(entry->current, 0, sizeof(entry->current));
+    }
+}
+
+size_t ui_ops_profiler_entries(const ui_ops_profile_entry **out_entries)
+{
+    if (out_entries != NULL)
+    {
+        *out_entries = entries;
+    }
+    return entry_count;
+}
+
+typedef struct ranked_entry
+{
+    const ui_ops_profile_entry *entry;
+    Uint64 self_ticks;
+} ranked_entry;
+
+static int compare_ranked_entries(const void *lhs, const void *rhs)
+{
+    const Uint64 a = ((const ranked_entry *)lhs)->self_ticks;
+    const Uint64 b = ((const ranked_entry *)rhs)->self_ticks;
+    return (a < b) - (a > b);
+}
+
+void ui_ops_profiler_log_summary(void)
+{
+    ranked_entry ranked[UI_OPS_PROFILER_MAX_TYPES];
+    for (size_t i = 0U; i < entry_count; ++i)
+    {
+        ranked[i].entry = &entries[i];
+        ranked[i].self_ticks = 0U;
+        for (size_t call = 0U; call < UI_OPS_CALL_COUNT; ++call)
+        {
+            ranked[i].self_ticks += entries[i].total[call].self_ticks;
+        }
+    }
+    qsort(ranked, entry_count, sizeof(ranked[0]), compare_ranked_entries);
+
+    Uint64 ticks_per_second = SDL_GetPerformanceFrequency();
+    if (ticks_per_second == 0U)
+    {
+        ticks_per_second = 1U;
+    }
+    const double ms_per_tick = 1000.0 / (double)ticks_per_second;
+
+    SDL_Log("Ops profile: %zu widget types (total ms)", entry_count);
+    SDL_Log("  %-18s %-13s %10s %11s %11s", "type", "op", "calls", "inclusive", "self");
+    for (size_t i = 0U; i < entry_count; ++i)
+    {
+        const ui_ops_profile_entry *entry = ranked[i].entry;
+        char fallback_name[32];
+        const char *type_name = entry->ops->type_name;
+        if (type_name == NULL)
+        {
+            SDL_snprintf(fallback_name, sizeof(fallback_name), "%p", (const void *)entry->ops);
+            type_name = fallback_name;
+        }
+
+        for (size_t call = 0U; call < UI_OPS_CALL_COUNT; ++call)
+        {
+            const ui_ops_call_stats *stats = &entry->total[call];
+            if (stats->calls == 0U)
+            {
+                continue;
+            }
+            SDL_Log("  %-18s %-13s %10llu %11.3f %11.3f", type_name, CALL_NAMES[call],
+                    (unsigned long long)stats->calls, (double)stats->inclusive_ticks * ms_per_tick,
+                    (double)stats->self_ticks * ms_per_tick);
+        }
+    }
+}
+
+void ui_ops_profiler_reset(void)
+{
+    memset(entries, 0, sizeof(entries));
+    entry_count = 0U;
+    active_scope = NULL;
+}
+
+#endif
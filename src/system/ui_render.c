@@ -0,0 +1,931 @@
+#include "system/ui_render.h"
+
+#include "ui/ui_glyph_atlas.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define UI_RENDER_MAX_CLIP_DEPTH 32
+#define UI_RENDER_MAX_BATCH_QUADS 256
+#define UI_RENDER_MAX_BATCH_GLYPHS 1024
+#define UI_RENDER_MAX_DEFERRED_COMMANDS 256
+
+// Text uses the glyph atlas's default face: fixed 8x8 cells, like SDL_RenderDebugText.
+static const float DEBUG_GLYPH_SIZE = (float)UI_GLYPH_ATLAS_CELL_SIZE;
+
+static ui_render_list *active_list = NULL;
+
+static ui_render_call_stats call_stats;
+// Texture used by the previous draw; NULL after untextured draws.
+static const void *bound_texture = NULL;
+// Stand-in for SDL's internal debug font texture, which is not exposed.
+static const char DEBUG_FONT_TEXTURE = 0;
+
+/*
+ * Clip stack shared by immediate drawing and replay. Only one of them runs at
+ * a time, and both leave the stack balanced when render ops pair push/pop.
+ */
+static SDL_Rect clip_stack[UI_RENDER_MAX_CLIP_DEPTH];
+static size_t clip_depth = 0U;
+
+/*
+ * Quads waiting for one SDL_RenderGeometry call with a single texture (NULL
+ * for solid fills). Fixed capacity; a full batch is simply flushed early.
+ */
+typedef struct quad_batch
+{
+    SDL_Vertex *vertices;
+    int *indices;
+    size_t capacity;
+    size_t count;
+    SDL_Texture *texture;
+} quad_batch;
+
+static SDL_Vertex solid_vertices[UI_RENDER_MAX_BATCH_QUADS * 4];
+static int solid_indices[UI_RENDER_MAX_BATCH_QUADS * 6];
+static quad_batch solid_batch = {solid_vertices, solid_indices, UI_RENDER_MAX_BATCH_QUADS, 0U,
+                                 NULL};
+
+static SDL_Vertex glyph_vertices[UI_RENDER_MAX_BATCH_GLYPHS * 4];
+static int glyph_indices[UI_RENDER_MAX_BATCH_GLYPHS * 6];
+static quad_batch glyph_batch = {glyph_vertices, glyph_indices, UI_RENDER_MAX_BATCH_GLYPHS, 0U,
+                                 NULL};
+
+// Replay scratch: non-solid commands recorded after the first queued solid quad.
+static const ui_render_command *deferred_commands[UI_RENDER_MAX_DEFERRED_COMMANDS];
+static size_t deferred_count = 0U;
+
+static bool reserve_commands(ui_render_list *list, size_t needed)
+{
+    if (needed <= list->command_capacity)
+    {
+        return true;
+    }
+
+    size_t new_capacity = list->command_capacity == 0U ? 64U : list->command_capacity * 2U;
+    while (new_capacity < needed)
+    {
+        new_capacity *= 2U;
+    }
+
+    ui_render_command *new_commands =
+        realloc(list->commands, new_capacity * sizeof(ui_render_command));
+    if (new_commands == NULL)
+    {
+        return false;
+    }
+
+    list->commands = new_commands;
+    list->command_capacity = new_capacity;
+    return true;
+}
+
+static bool reserve_text(ui_render_list *list, size_t needed)
+{
+    if (needed <= list->text_capacity)
+    {
+        return true;
+    }
+
+    size_t new_capacity = list->text_capacity == 0U ? 1024U : list->text_capacity * 2U;
+    while (new_capacity < needed)
+    {
+        new_capacity *= 2U;
+    }
+
+    char *new_text = realloc(list->text, new_capacity);
+    if (new_text == NULL)
+    {
+        return false;
+    }
+
+    list->text = new_text;
+    list->text_capacity = new_capacity;
+    return true;
+}
+
+static ui_render_command *append_command(ui_render_command_type type)
+{
+    ui_render_list *list = active_list;
+    if (list->overflowed || !reserve_commands(list, list->command_count + 1U))
+    {
+        list->overflowed = true;
+        return NULL;
+    }
+
+    ui_render_command *command = &list->commands[list->command_count++];
+    memset(command, 0, sizeof(*command));
+    command->type = type;
+    return command;
+}
+
+static void set_draw_color(SDL_Renderer *renderer, SDL_Color color)
+{
+    call_stats.color_changes++;
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+}
+
+static void set_clip_rect(SDL_Renderer *renderer, const SDL_Rect *clip)
+{
+    call_stats.clip_changes++;
+    SDL_SetRenderClipRect(renderer, clip);
+}
+
+static void count_draw(const void *texture, Uint64 primitives)
+{
+    call_stats.draw_calls++;
+    call_stats.primitives += primitives;
+    if (texture != NULL && texture != bound_texture)
+    {
+        call_stats.texture_binds++;
+    }
+    bound_texture = texture;
+}
+
+static SDL_Rect to_clip_rect(const SDL_FRect *rect)
+{
+    return (SDL_Rect){(int)rect->x, (int)rect->y, (int)rect->w, (int)rect->h};
+}
+
+static void apply_push_clip(SDL_Renderer *renderer, const SDL_FRect *rect)
+{
+    SDL_Rect clip = to_clip_rect(rect);
+    if (clip_depth > 0U)
+    {
+        SDL_Rect intersection;
+        if (!SDL_GetRectIntersection(&clip, &clip_stack[clip_depth - 1U], &intersection))
+        {
+            intersection = (SDL_Rect){clip.x, clip.y, 0, 0};
+        }
+        clip = intersection;
+    }
+
+    if (clip_depth < UI_RENDER_MAX_CLIP_DEPTH)
+    {
+        clip_stack[clip_depth] = clip;
+    }
+    clip_depth++;
+    set_clip_rect(renderer, &clip);
+}
+
+static void apply_pop_clip(SDL_Renderer *renderer)
+{
+    if (clip_depth == 0U)
+    {
+        return;
+    }
+
+    clip_depth--;
+    if (clip_depth == 0U)
+    {
+        set_clip_rect(renderer, NULL);
+        return;
+    }
+
+    const size_t top = clip_depth <= UI_RENDER_MAX_CLIP_DEPTH ? clip_depth - 1U
+                                                              : UI_RENDER_MAX_CLIP_DEPTH - 1U;
+    set_clip_rect(renderer, &clip_stack[top]);
+}
+
+static SDL_FColor to_fcolor(SDL_Color color)
+{
+    return (SDL_FColor){(float)color.r / 255.0F, (float)color.g / 255.0F, (float)color.b / 255.0F,
+                        (float)color.a / 255.0F};
+}
+
+static void batch_append(quad_batch *batch, const SDL_FRect *rect, SDL_FColor color,
+                         const SDL_FRect *uv)
+{
+    const float x0 = rect->x;
+    const float y0 = rect->y;
+    const float x1 = rect->x + rect->w;
+    const float y1 = rect->y + rect->h;
+    const float u0 = uv->x;
+    const float v0 = uv->y;
+    const float u1 = uv->x + uv->w;
+    const float v1 = uv->y + uv->h;
+
+    SDL_Vertex *vertex = &batch->vertices[batch->count * 4U];
+    vertex[0] = (SDL_Vertex){{x0, y0}, color, {u0, v0}};
+    vertex[1] = (SDL_Vertex){{x1, y0}, color, {u1, v0}};
+    vertex[2] = (SDL_Vertex){{x1, y1}, color, {u1, v1}};
+    vertex[3] = (SDL_Vertex){{x0, y1}, color, {u0, v1}};
+
+    const int base = (int)(batch->count * 4U);
+    int *index = &batch->indices[batch->count * 6U];
+    index[0] = base;
+    index[1] = base + 1;
+    index[2] = base + 2;
+    index[3] = base;
+    index[4] = base + 2;
+    index[5] = base + 3;
+    batch->count++;
+}
+
+static void batch_flush(SDL_Renderer *renderer, quad_batch *batch)
+{
+    if (batch->count == 0U)
+    {
+        return;
+    }
+
+    // Per-vertex colors replace SDL_SetRenderDrawColor between quads.
+    count_draw(batch->texture, batch->count);
+    SDL_RenderGeometry(renderer, batch->texture, batch->vertices, (int)(batch->count * 4U),
+                       batch->indices, (int)(batch->count * 6U));
+    batch->count = 0U;
+}
+
+/*
+ * Append text to glyph_batch as atlas quads, one per non-space codepoint.
+ * Returns false when the renderer has no atlas and text must go through
+ * SDL_RenderDebugText.
+ */
+static bool queue_text_glyphs(SDL_Renderer *renderer, float x, float y, const char *text,
+                              SDL_Color color)
+{
+    SDL_Texture *atlas = ui_glyph_atlas_get(renderer);
+    if (atlas == NULL)
+    {
+        return false;
+    }
+    if (glyph_batch.texture != atlas)
+    {
+        batch_flush(renderer, &glyph_batch);
+        glyph_batch.texture = atlas;
+    }
+
+    const SDL_FColor fcolor = to_fcolor(color);
+    size_t remaining = strlen(text);
+    float pen_x = x;
+    while (remaining > 0U)
+    {
+        // Same decoding as SDL_RenderDebugText, so glyph counts and advances match.
+        const Uint32 codepoint = SDL_StepUTF8(&text, &remaining);
+        if (codepoint == 0U)
+        {
+            break;
+        }
+        if (codepoint != ' ')
+        {
+            if (glyph_batch.count == glyph_batch.capacity)
+            {
+                batch_flush(renderer, &glyph_batch);
+            }
+            const SDL_FRect glyph = {pen_x, y, DEBUG_GLYPH_SIZE, DEBUG_GLYPH_SIZE};
+            const SDL_FRect uv = ui_glyph_atlas_uv(codepoint);
+            batch_append(&glyph_batch, &glyph, fcolor, &uv);
+        }
+        pen_x += DEBUG_GLYPH_SIZE;
+    }
+    return true;
+}
+
+static void draw_text(SDL_Renderer *renderer, float x, float y, const char *text,
+                      SDL_Color color)
+{
+    if (queue_text_glyphs(renderer, x, y, text, color))
+    {
+        batch_flush(renderer, &glyph_batch);
+        return;
+    }
+
+    set_draw_color(renderer, color);
+    count_draw(&DEBUG_FONT_TEXTURE, strlen(text));
+    SDL_RenderDebugText(renderer, x, y, text);
+}
+
+static void draw_command(SDL_Renderer *renderer, const ui_render_list *list,
+                         const ui_render_command *command)
+{
+    const SDL_Color color = command->color;
+    switch (command->type)
+    {
+    case UI_RENDER_COMMAND_FILL_RECT:
+        set_draw_color(renderer, color);
+        count_draw(NULL, 1U);
+        SDL_RenderFillRect(renderer, &command->rect);
+        break;
+    case UI_RENDER_COMMAND_RECT:
+        set_draw_color(renderer, color);
+        count_draw(NULL, 1U);
+        SDL_RenderRect(renderer, &command->rect);
+        break;
+    case UI_RENDER_COMMAND_LINE:
+        set_draw_color(renderer, color);
+        count_draw(NULL, 1U);
+        SDL_RenderLine(renderer, command->rect.x, command->rect.y, command->rect.w,
+                       command->rect.h);
+        break;
+    case UI_RENDER_COMMAND_DEBUG_TEXT:
+        draw_text(renderer, command->rect.x, command->rect.y, list->text + command->text_offset,
+                  color);
+        break;
+    case UI_RENDER_COMMAND_TEXTURE:
+        count_draw(command->texture, 1U);
+        SDL_RenderTexture(renderer, command->texture, NULL, &command->rect);
+        break;
+    case UI_RENDER_COMMAND_PUSH_CLIP:
+        apply_push_clip(renderer, &command->rect);
+        break;
+    case UI_RENDER_COMMAND_POP_CLIP:
+        apply_pop_clip(renderer);
+        break;
+    }
+}
+
+void ui_render_list_init(ui_render_list *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+
+    memset(list, 0, sizeof(*list));
+}
+
+void ui_render_list_clear(ui_render_list *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+
+    list->command_count = 0U;
+    list->text_length = 0U;
+    list->overflowed = false;
+}
+
+void ui_render_list_destroy(ui_render_list *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+
+    if (active_list == list)
+    {
+        active_list = NULL;
+    }
+
+    free(list->commands);
+    free(list->text);
+    memset(list, 0, sizeof(*list));
+}
+
+bool ui_render_begin_recording(ui_render_list *list)
+{
+    if (list == NULL || active_list != NULL)
+    {
+        return false;
+    }
+
+    ui_render_list_clear(list);
+    active_list = list;
+    return true;
+}
+
+bool ui_render_end_recording(void)
+{
+    if (active_list == NULL)
+    {
+        return false;
+    }
+
+    const bool ok = !active_list->overflowed;
+    active_list = NULL;
+    return ok;
+}
+
+static bool are_colors_equal(SDL_Color a, SDL_Color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static bool are_commands_equal(const ui_render_list *list_a, const ui_render_command *a,
+                               const ui_render_list *list_b, const ui_render_command *b)
+{
+    if (a->type != b->type || !are_colors_equal(a->color, b->color) || a->texture != b->texture ||
+        a->rect.x != b->rect.x || a->rect.y != b->rect.y || a->rect.w != b->rect.w ||
+        a->rect.h != b->rect.h)
+    {
+        return false;
+    }
+
+    if (a->type == UI_RENDER_COMMAND_DEBUG_TEXT)
+    {
+        return strcmp(list_a->text + a->text_offset, list_b->text + b->text_offset) == 0;
+    }
+    return true;
+}
+
+static SDL_FRect command_bounds(const ui_render_list *list, const ui_render_command *command)
+{
+    switch (command->type)
+    {
+    case UI_RENDER_COMMAND_LINE:
+    {
+        // Pad by a pixel: line rasterization may touch pixels just past the endpoints.
+        const float min_x = SDL_min(command->rect.x, command->rect.w);
+        const float min_y = SDL_min(command->rect.y, command->rect.h);
+        const float max_x = SDL_max(command->rect.x, command->rect.w);
+        const float max_y = SDL_max(command->rect.y, command->rect.h);
+        return (SDL_FRect){min_x - 1.0F, min_y - 1.0F, (max_x - min_x) + 2.0F,
+                           (max_y - min_y) + 2.0F};
+    }
+    case UI_RENDER_COMMAND_DEBUG_TEXT:
+    {
+        const float width = (float)strlen(list->text + command->text_offset) * DEBUG_GLYPH_SIZE;
+        return (SDL_FRect){command->rect.x, command->rect.y, width, DEBUG_GLYPH_SIZE};
+    }
+    case UI_RENDER_COMMAND_POP_CLIP:
+        return (SDL_FRect){0.0F, 0.0F, 0.0F, 0.0F};
+    case UI_RENDER_COMMAND_FILL_RECT:
+    case UI_RENDER_COMMAND_RECT:
+    case UI_RENDER_COMMAND_TEXTURE:
+    case UI_RENDER_COMMAND_PUSH_CLIP:
+        break;
+    }
+    return command->rect;
+}
+
+static bool is_clip_command(const ui_render_command *command)
+{
+    return command->type == UI_RENDER_COMMAND_PUSH_CLIP ||
+           command->type == UI_RENDER_COMMAND_POP_CLIP;
+}
+
+static void add_command_range(const ui_render_list *list, size_t first, ui_render_damage *damage)
+{
+    for (size_t i = first; i < list->command_count; ++i)
+    {
+        const SDL_FRect bounds = command_bounds(list, &list->commands[i]);
+        ui_render_damage_add(damage, &bounds);
+    }
+}
+
+static void flush_batches(SDL_Renderer *renderer, const ui_render_list *list)
+{
+    batch_flush(renderer, &solid_batch);
+    for (size_t i = 0U; i < deferred_count; ++i)
+    {
+        // Consecutive text shares one glyph batch; anything else ends it.
+        const ui_render_command *command = deferred_commands[i];
+        if (command->type == UI_RENDER_COMMAND_DEBUG_TEXT &&
+            queue_text_glyphs(renderer, command->rect.x, command->rect.y,
+                              list->text + command->text_offset, command->color))
+        {
+            continue;
+        }
+        batch_flush(renderer, &glyph_batch);
+        draw_command(renderer, list, command);
+    }
+    batch_flush(renderer, &glyph_batch);
+    deferred_count = 0U;
+}
+
+static bool overlaps_deferred(const ui_render_list *list, const SDL_FRect *bounds)
+{
+    for (size_t i = 0U; i < deferred_count; ++i)
+    {
+        const SDL_FRect deferred_bounds = command_bounds(list, deferred_commands[i]);
+        if (SDL_HasRectIntersectionFloat(bounds, &deferred_bounds))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Queue a fill or 1px outline (as four edge quads) into the solid batch.
+ *
+ * The quads are drawn before any deferred command, so they may only join the
+ * batch when they do not overlap one; otherwise everything queued is drawn
+ * first to keep z-order.
+ */
+static void queue_solid_command(SDL_Renderer *renderer, const ui_render_list *list,
+                                const ui_render_command *command)
+{
+    const SDL_FRect *rect = &command->rect;
+    if (overlaps_deferred(list, rect))
+    {
+        flush_batches(renderer, list);
+    }
+    if (solid_batch.count + 4U > solid_batch.capacity)
+    {
+        // Deferred commands stay queued: they do not overlap anything queued later.
+        batch_flush(renderer, &solid_batch);
+    }
+
+    const SDL_FColor color = to_fcolor(command->color);
+    const SDL_FRect no_uv = {0.0F, 0.0F, 0.0F, 0.0F};
+    if (command->type == UI_RENDER_COMMAND_FILL_RECT || rect->w <= 2.0F || rect->h <= 2.0F)
+    {
+        batch_append(&solid_batch, rect, color, &no_uv);
+        return;
+    }
+
+    const SDL_FRect top = {rect->x, rect->y, rect->w, 1.0F};
+    const SDL_FRect bottom = {rect->x, rect->y + rect->h - 1.0F, rect->w, 1.0F};
+    const SDL_FRect left = {rect->x, rect->y + 1.0F, 1.0F, rect->h - 2.0F};
+    const SDL_FRect right = {rect->x + rect->w - 1.0F, rect->y + 1.0F, 1.0F, rect->h - 2.0F};
+    batch_append(&solid_batch, &top, color, &no_uv);
+    batch_append(&solid_batch, &bottom, color, &no_uv);
+    batch_append(&solid_batch, &left, color, &no_uv);
+    batch_append(&solid_batch, &right, color, &no_uv);
+}
+
+/*
+ * True when command cannot touch a pixel inside the active clip. Clips pushed
+ * past UI_RENDER_MAX_CLIP_DEPTH are not kept, so the kept top only ever culls
+ * less than the real clip would.
+ */
+static bool is_outside_active_clip(const ui_render_list *list, const ui_render_command *command)
+{
+    if (clip_depth == 0U || command->type == UI_RENDER_COMMAND_POP_CLIP)
+    {
+        return false;
+    }
+
+    const size_t top = SDL_min(clip_depth, (size_t)UI_RENDER_MAX_CLIP_DEPTH) - 1U;
+    const SDL_Rect *clip = &clip_stack[top];
+    const SDL_FRect clip_bounds = {(float)clip->x, (float)clip->y, (float)clip->w,
+                                   (float)clip->h};
+    const SDL_FRect bounds = command_bounds(list, command);
+    return !SDL_HasRectIntersectionFloat(&bounds, &clip_bounds);
+}
+
+void ui_render_list_replay(const ui_render_list *list, SDL_Renderer *renderer)
+{
+    if (list == NULL || renderer == NULL)
+    {
+        return;
+    }
+
+    solid_batch.count = 0U;
+    glyph_batch.count = 0U;
+    deferred_count = 0U;
+    // Clips pushed outside the active clip, still waiting for their pop;
+    // everything recorded inside them is invisible and skipped.
+    size_t culled_clip_depth = 0U;
+    for (size_t i = 0; i < list->command_count; ++i)
+    {
+        const ui_render_command *command = &list->commands[i];
+        if (culled_clip_depth > 0U)
+        {
+            if (command->type == UI_RENDER_COMMAND_PUSH_CLIP)
+            {
+                culled_clip_depth++;
+            }
+            else if (command->type == UI_RENDER_COMMAND_POP_CLIP)
+            {
+                culled_clip_depth--;
+            }
+            continue;
+        }
+        if (is_outside_active_clip(list, command))
+        {
+            culled_clip_depth = command->type == UI_RENDER_COMMAND_PUSH_CLIP ? 1U : 0U;
+            continue;
+        }
+
+        switch (command->type)
+        {
+        case UI_RENDER_COMMAND_FILL_RECT:
+        case UI_RENDER_COMMAND_RECT:
+            queue_solid_command(renderer, list, command);
+            break;
+        case UI_RENDER_COMMAND_LINE:
+        case UI_RENDER_COMMAND_DEBUG_TEXT:
+        case UI_RENDER_COMMAND_TEXTURE:
+            if (deferred_count == UI_RENDER_MAX_DEFERRED_COMMANDS)
+            {
+                flush_batches(renderer, list);
+            }
+            deferred_commands[deferred_count++] = command;
+            break;
+        case UI_RENDER_COMMAND_PUSH_CLIP:
+        case UI_RENDER_COMMAND_POP_CLIP:
+            // Batches never span a clip change.
+            flush_batches(renderer, list);
+            draw_command(renderer, list, command);
+            break;
+        }
+    }
+    flush_batches(renderer, list);
+}
+
+void ui_render_list_replay_clipped(const ui_render_list *list, SDL_Renderer *renderer,
+                                   const SDL_FRect *clip)
+{
+    if (list == NULL || renderer == NULL || clip == NULL)
+    {
+        return;
+    }
+
+    apply_push_clip(renderer, clip);
+    ui_render_list_replay(list, renderer);
+    apply_pop_clip(renderer);
+}
+
+void ui_render_list_diff(const ui_render_list *previous, const ui_render_list *current,
+                         ui_render_damage *damage)
+{
+    if (previous == NULL || current == NULL || damage == NULL)
+    {
+        return;
+    }
+
+    const size_t shared_count = SDL_min(previous->command_count, current->command_count);
+    for (size_t i = 0; i < shared_count; ++i)
+    {
+        const ui_render_command *old_command = &previous->commands[i];
+        const ui_render_command *new_command = &current->commands[i];
+        if (are_commands_equal(previous, old_command, current, new_command))
+        {
+            continue;
+        }
+
+        if (is_clip_command(old_command) || is_clip_command(new_command))
+        {
+            add_command_range(previous, i, damage);
+            add_command_range(current, i, damage);
+            return;
+        }
+
+        const SDL_FRect old_bounds = command_bounds(previous, old_command);
+        const SDL_FRect new_bounds = command_bounds(current, new_command);
+        ui_render_damage_add(damage, &old_bounds);
+        ui_render_damage_add(damage, &new_bounds);
+    }
+
+    add_command_range(previous, shared_count, damage);
+    add_command_range(current, shared_count, damage);
+}
+
+void ui_render_damage_clear(ui_render_damage *damage)
+{
+    if (damage == NULL)
+    {
+        return;
+    }
+
+    damage->count = 0U;
+}
+
+static bool merge_into_overlapping(ui_render_damage *damage, const SDL_FRect *rect)
+{
+    for (size_t i = 0; i < damage->count; ++i)
+    {
+        if (SDL_HasRectIntersectionFloat(&damage->rects[i], rect))
+        {
+            SDL_FRect merged;
+            SDL_GetRectUnionFloat(&damage->rects[i], rect, &merged);
+            // The grown rect may now overlap others; re-insert it from scratch.
+            damage->rects[i] = damage->rects[--damage->count];
+            ui_render_damage_add(damage, &merged);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ui_render_damage_add(ui_render_damage *damage, const SDL_FRect *rect)
+{
+    if (damage == NULL || rect == NULL || rect->w <= 0.0F || rect->h <= 0.0F)
+    {
+        return;
+    }
+
+    // Snap outward so the integer clip rect used for repainting covers every touched pixel.
+    const float left = SDL_floorf(rect->x);
+    const float top = SDL_floorf(rect->y);
+    const SDL_FRect snapped = {left, top, SDL_ceilf(rect->x + rect->w) - left,
+                               SDL_ceilf(rect->y + rect->h) - top};
+
+    if (merge_into_overlapping(damage, &snapped))
+    {
+        return;
+    }
+
+    if (damage->count < UI_RENDER_MAX_DAMAGE_RECTS)
+    {
+        damage->rects[damage->count++] = snapped;
+        return;
+    }
+
+    SDL_FRect bounds = snapped;
+    for (size_t i = 0; i < damage->count; ++i)
+    {
+        SDL_GetRectUnionFloat(&bounds, &damage->rects[i], &bounds);
+    }
+    damage->rects[0] = bounds;
+    damage->count = 1U;
+}
+
+ui_render_call_stats ui_render_get_call_stats(void)
+{
+    return call_stats;
+}
+
+ui_render_call_stats ui_render_end_frame(void)
+{
+    const ui_render_call_stats frame = call_stats;
+    call_stats = (ui_render_call_stats){0};
+    bound_texture = NULL;
+    return frame;
+}
+
+static Uint8 mix_channel(Uint8 a, Uint8 b, float t)
+{
+    return (Uint8)((float)a + (((float)b - (float)a) * t) + 0.5F);
+}
+
+SDL_Color ui_render_mix_color(SDL_Color a, SDL_Color b, float t)
+{
+    if (t <= 0.0F)
+    {
+        return a;
+    }
+    if (t >= 1.0F)
+    {
+        return b;
+    }
+
+    return (SDL_Color){mix_channel(a.r, b.r, t), mix_channel(a.g, b.g, t),
+                       mix_channel(a.b, b.b, t), mix_channel(a.a, b.a, t)};
+}
+
+void ui_render_clear(SDL_Renderer *renderer, SDL_Color color)
+{
+    if (renderer == NULL || active_list != NULL)
+    {
+        return;
+    }
+
+    set_draw_color(renderer, color);
+    count_draw(NULL, 1U);
+    SDL_RenderClear(renderer);
+}
+
+void ui_render_fill_rect(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color)
+{
+    if (renderer == NULL || rect == NULL)
+    {
+        return;
+    }
+
+    const ui_render_command command = {
+        .type = UI_RENDER_COMMAND_FILL_RECT, .color = color, .rect = *rect};
+    if (active_list == NULL)
+    {
+        draw_command(renderer, NULL, &command);
+        return;
+    }
+
+    ui_render_command *recorded = append_command(command.type);
+    if (recorded != NULL)
+    {
+        *recorded = command;
+    }
+}
+
+void ui_render_rect(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color)
+{
+    if (renderer == NULL || rect == NULL)
+    {
+        return;
+    }
+
+    const ui_render_command command = {
+        .type = UI_RENDER_COMMAND_RECT, .color = color, .rect = *rect};
+    if (active_list == NULL)
+    {
+        draw_command(renderer, NULL, &command);
+        return;
+    }
+
+    ui_render_command *recorded = append_command(command.type);
+    if (recorded != NULL)
+    {
+        *recorded = command;
+    }
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void ui_render_line(SDL_Renderer *renderer, float x1, float y1, float x2, float y2,
+                    SDL_Color color)
+{
+    if (renderer == NULL)
+    {
+        return;
+    }
+
+    const ui_render_command command = {
+        .type = UI_RENDER_COMMAND_LINE, .color = color, .rect = {x1, y1, x2, y2}};
+    if (active_list == NULL)
+    {
+        draw_command(renderer, NULL, &command);
+        return;
+    }
+
+    ui_render_command *recorded = append_command(command.type);
+    if (recorded != NULL)
+    {
+        *recorded = command;
+    }
+}
+
+void ui_render_debug_text(SDL_Renderer *renderer, float x, float y, const char *text,
+                          SDL_Color color)
+{
+    if (renderer == NULL || text == NULL || text[0] == '\0')
+    {
+        return;
+    }
+
+    if (active_list == NULL)
+    {
+        draw_text(renderer, x, y, text, color);
+        return;
+    }
+
+    ui_render_list *list = active_list;
+    const size_t text_size = strlen(text) + 1U;
+    if (list->overflowed || !reserve_text(list, list->text_length + text_size))
+    {
+        list->overflowed = true;
+        return;
+    }
+
+    ui_render_command *recorded = append_command(UI_RENDER_COMMAND_DEBUG_TEXT);
+    if (recorded == NULL)
+    {
+        return;
+    }
+
+    memcpy(list->text + list->text_length, text, text_size);
+    recorded->color = color;
+    recorded->rect = (SDL_FRect){x, y, 0.0F, 0.0F};
+    recorded->text_offset = list->text_length;
+    list->text_length += text_size;
+}
+
+void ui_render_texture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *dst)
+{
+    if (renderer == NULL || texture == NULL || dst == NULL)
+    {
+        return;
+    }
+
+    const ui_render_command command = {
+        .type = UI_RENDER_COMMAND_TEXTURE, .rect = *dst, .texture = texture};
+    if (active_list == NULL)
+    {
+        draw_command(renderer, NULL, &command);
+        return;
+    }
+
+    ui_render_command *recorded = append_command(command.type);
+    if (recorded != NULL)
+    {
+        *recorded = command;
+    }
+}
+
+void ui_render_push_clip(SDL_Renderer *renderer, const SDL_FRect *rect)
+{
+    if (renderer == NULL || rect == NULL)
+    {
+        return;
+    }
+
+    if (active_list == NULL)
+    {
+        apply_push_clip(renderer, rect);
+        return;
+    }
+
+    ui_render_command *recorded = append_command(UI_RENDER_COMMAND_PUSH_CLIP);
+    if (recorded != NULL)
+    {
+        recorded->rect = *rect;
+    }
+}
+
+void ui_render_pop_clip(SDL_Renderer *renderer)
+{
+    if (renderer == NULL)
+    {
+        return;
+    }
+
+    if (active_list == NULL)
+    {
+        apply_pop_clip(renderer);
+        return;
+    }
+
+    (void)append_command(UI_RENDER_COMMAND_POP_CLIP);
+}
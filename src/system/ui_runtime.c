@@ -1,5 +1,8 @@
 #include "system/ui_runtime.h"
 
+#include "system/ui_ops_profiler.h"
+#include "system/ui_traversal.h"
+
 #include <stdlib.h>
 
 static bool is_valid_element(const ui_element *element)
@@ -71,6 +74,44 @@ static bool hit_test_element(const ui_element *element, const SDL_FPoint *point)
     return ui_element_hit_test(element, point);
 }
 
+/*
+ * Candidate source for one pointer query: the packed element table when the
+ * runtime uses it, otherwise the spatial hit index. Both yield indices from
+ * topmost to bottommost; the table also pre-filters by required_flags.
+ */
+typedef struct pointer_query
+{
+    bool use_table;
+    ui_element_table_cursor table_cursor;
+    ui_spatial_cursor spatial_cursor;
+} pointer_query;
+
+static void begin_pointer_query(ui_runtime *context, const SDL_FPoint *point, Uint8 required_flags,
+                                pointer_query *query)
+{
+    query->use_table = context->use_element_table;
+    if (query->use_table)
+    {
+        ui_element_table_sync(&context->element_table, context->elements,
+                              context->element_count);
+        ui_element_table_query(&context->element_table, point, required_flags,
+                               &query->table_cursor);
+        return;
+    }
+
+    ui_spatial_index_query(&context->hit_index, context->elements, context->element_count, point,
+                           &query->spatial_cursor);
+}
+
+static bool next_pointer_candidate(pointer_query *query, size_t *out_index)
+{
+    if (query->use_table)
+    {
+        return ui_element_table_cursor_next(&query->table_cursor, out_index);
+    }
+    return ui_spatial_cursor_next(&query->spatial_cursor, out_index);
+}
+
 static void set_focused_element(ui_runtime *context, ui_element *next_focus)
 {
     if (context == NULL || context->focused_element == next_focus)
@@ -96,16 +137,20 @@ static void set_focused_element(ui_runtime *context, ui_element *next_focus)
     }
 }
 
-static ui_element *find_top_focusable_at(const ui_runtime *context, const SDL_FPoint *point)
+static ui_element *find_top_focusable_at(ui_runtime *context, const SDL_FPoint *point)
 {
     if (context == NULL || point == NULL)
     {
         return NULL;
     }
 
-    for (size_t i = context->element_count; i > 0U; --i)
+    pointer_query query;
+    begin_pointer_query(context, point, UI_ELEMENT_TABLE_VISIBLE | UI_ELEMENT_TABLE_ENABLED,
+                        &query);
+    size_t i = 0U;
+    while (next_pointer_candidate(&query, &i))
     {
-        ui_element *element = context->elements[i - 1U];
+        ui_element *element = context->elements[i];
         if (!is_focusable(element) || !hit_test_element(element, point))
         {
             continue;
@@ -116,17 +161,79 @@ static ui_element *find_top_focusable_at(const ui_runtime *context, const SDL_FP
     return NULL;
 }
 
-static ui_element *dispatch_pointer_event(ui_runtime *context, const SDL_Event *event,
-                                          const SDL_FPoint *point)
+static ui_element *find_top_hoverable_at(ui_runtime *context, const SDL_FPoint *point)
+{
+    pointer_query query;
+    begin_pointer_query(context, point, UI_ELEMENT_TABLE_VISIBLE | UI_ELEMENT_TABLE_ENABLED,
+                        &query);
+    size_t i = 0U;
+    while (next_pointer_candidate(&query, &i))
+    {
+        ui_element *element = context->elements[i];
+        if (is_valid_element(element) && element->enabled && hit_test_element(element, point))
+        {
+            return element;
+        }
+    }
+
+    return NULL;
+}
+
+static void refresh_hover(ui_runtime *context)
+{
+    const SDL_FPoint *point = context->has_pointer ? &context->pointer_position : NULL;
+    ui_element *next = point != NULL ? find_top_hoverable_at(context, point) : NULL;
+    ui_element_set_hovered_child(&context->hovered_element, next, point);
+
+    // Sampled after the walk: hover visuals invalidate rendering themselves.
+    context->hover_screen_rect_generation = ui_element_screen_rect_generation();
+    context->hover_render_generation = ui_element_render_generation();
+}
+
+static bool is_hover_stale(const ui_runtime *context)
+{
+    return context->hover_screen_rect_generation != ui_element_screen_rect_generation() ||
+           context->hover_render_generation != ui_element_render_generation();
+}
+
+static void track_pointer(ui_runtime *context, const SDL_FPoint *point)
+{
+    // Button and wheel events at the last motion position over an unchanged
+    // tree cannot change what is hovered.
+    if (context->has_pointer && context->pointer_position.x == point->x &&
+        context->pointer_position.y == point->y && !is_hover_stale(context))
+    {
+        return;
+    }
+
+    context->has_pointer = true;
+    context->pointer_position = *point;
+    refresh_hover(context);
+}
+
+/*
+ * Offer a pointer event to the topmost elements under point until one handles
+ * it. The handler's handle is taken before dispatch so a handler that
+ * destroys its own element leaves a stale handle rather than a dangling
+ * pointer.
+ */
+static bool dispatch_pointer_event(ui_runtime *context, const SDL_Event *event,
+                                   const SDL_FPoint *point, ui_handle *out_handled)
 {
     if (context == NULL || event == NULL || point == NULL)
     {
-        return NULL;
+        return false;
     }
 
-    for (size_t i = context->element_count; i > 0U; --i)
+    pointer_query query;
+    begin_pointer_query(context, point,
+                        UI_ELEMENT_TABLE_VISIBLE | UI_ELEMENT_TABLE_ENABLED |
+                            UI_ELEMENT_TABLE_HANDLES_EVENTS,
+                        &query);
+    size_t i = 0U;
+    while (next_pointer_candidate(&query, &i))
     {
-        ui_element *element = context->elements[i - 1U];
+        ui_element *element = context->elements[i];
         if (!is_valid_element(element) || !element->enabled || element->ops->handle_event == NULL)
         {
             continue;
@@ -137,13 +244,21 @@ static ui_element *dispatch_pointer_event(ui_runtime *context, const SDL_Event *
             continue;
         }
 
-        if (element->ops->handle_event(element, event))
+        const ui_handle handle = ui_handle_acquire(element);
+        UI_OPS_PROFILE_ENTER(scope, element->ops, UI_OPS_CALL_HANDLE_EVENT);
+        const bool handled = element->ops->handle_event(element, event);
+        UI_OPS_PROFILE_LEAVE(scope);
+        if (handled)
         {
-            return element;
+            if (out_handled != NULL)
+            {
+                *out_handled = handle;
+            }
+            return true;
         }
     }
 
-    return NULL;
+    return false;
 }
 
 static bool dispatch_to_element(ui_element *element, const SDL_Event *event)
@@ -153,7 +268,10 @@ static bool dispatch_to_element(ui_element *element, const SDL_Event *event)
         return false;
     }
 
-    return element->ops->handle_event(element, event);
+    UI_OPS_PROFILE_ENTER(scope, element->ops, UI_OPS_CALL_HANDLE_EVENT);
+    const bool handled = element->ops->handle_event(element, event);
+    UI_OPS_PROFILE_LEAVE(scope);
+    return handled;
 }
 
 bool ui_runtime_init(ui_runtime *context)
@@ -166,8 +284,28 @@ bool ui_runtime_init(ui_runtime *context)
     context->elements = NULL;
     context->element_count = 0;
     context->element_capacity = 0;
+    context->hole_count = 0;
     context->focused_element = NULL;
-    context->captured_element = NULL;
+    context->captured_element = UI_HANDLE_NULL;
+    context->hovered_element = NULL;
+    context->has_pointer = false;
+    context->pointer_position = (SDL_FPoint){0.0F, 0.0F};
+    context->hover_screen_rect_generation = 0U;
+    context->hover_render_generation = 0U;
+    ui_spatial_index_init(&context->hit_index);
+    ui_element_table_init(&context->element_table);
+    context->use_element_table = false;
+    context->retained_rendering = true;
+    context->has_recording = false;
+    context->recorded_render_generation = 0U;
+    ui_render_list_init(&context->render_list);
+    ui_render_list_init(&context->previous_render_list);
+    ui_render_damage_clear(&context->damage);
+    context->damage_all = true;
+    context->render_target = NULL;
+    context->render_target_w = 0;
+    context->render_target_h = 0;
+    context->render_stats = (ui_runtime_render_stats){0};
     return true;
 }
 
@@ -179,23 +317,28 @@ void ui_runtime_destroy(ui_runtime *context)
     }
 
     set_focused_element(context, NULL);
-    context->captured_element = NULL;
+    context->captured_element = UI_HANDLE_NULL;
+    ui_element_set_hovered_child(&context->hovered_element, NULL, NULL);
+    context->has_pointer = false;
 
     for (size_t i = 0; i < context->element_count; ++i)
     {
-        ui_element *element = context->elements[i];
-        if (is_valid_element(element) && element->ops->destroy != NULL)
-        {
-            element->ops->destroy(element);
-        }
+        ui_traversal_destroy(context->elements[i]);
     }
 
     free((void *)context->elements);
     context->elements = NULL;
     context->element_count = 0;
     context->element_capacity = 0;
+    context->hole_count = 0;
     context->focused_element = NULL;
-    context->captured_element = NULL;
+    context->captured_element = UI_HANDLE_NULL;
+    ui_spatial_index_destroy(&context->hit_index);
+    ui_element_table_destroy(&context->element_table);
+    ui_render_list_destroy(&context->render_list);
+    ui_render_list_destroy(&context->previous_render_list);
+    context->has_recording = false;
+    ui_runtime_discard_render_target(context);
 }
 
 bool ui_runtime_add(ui_runtime *context, ui_element *element)
@@ -218,47 +361,117 @@ bool ui_runtime_add(ui_runtime *context, ui_element *element)
         context->element_capacity = new_capacity;
     }
 
+    if (!ui_element_table_insert(&context->element_table, context->element_count, element))
+    {
+        return false;
+    }
+
+    element->sibling_index = context->element_count;
     context->elements[context->element_count++] = element;
+    ui_spatial_index_invalidate(&context->hit_index);
+    ui_element_invalidate_render(element);
     return true;
 }
 
-bool ui_runtime_remove(ui_runtime *context, ui_element *element, bool destroy_element)
+/*
+ * Unregister the element in slot index, leaving a NULL hole behind.
+ */
+static void detach_element(ui_runtime *context, size_t index, bool destroy_element)
 {
-    if (context == NULL || !is_valid_element(element))
+    ui_element *element = context->elements[index];
+    if (context->focused_element == element)
     {
-        return false;
+        set_focused_element(context, NULL);
+    }
+    if (ui_handle_resolve(context->captured_element) == element)
+    {
+        context->captured_element = UI_HANDLE_NULL;
+    }
+    if (context->hovered_element == element)
+    {
+        ui_element_set_hovered_child(&context->hovered_element, NULL, NULL);
     }
 
-    for (size_t i = 0; i < context->element_count; ++i)
+    if (destroy_element)
     {
-        if (context->elements[i] != element)
-        {
-            continue;
-        }
+        ui_traversal_destroy(element);
+    }
 
-        if (context->focused_element == element)
-        {
-            set_focused_element(context, NULL);
-        }
-        if (context->captured_element == element)
-        {
-            context->captured_element = NULL;
-        }
+    context->elements[index] = NULL;
+    context->hole_count++;
+    ui_element_table_clear(&context->element_table, index);
+}
 
-        if (destroy_element && element->ops->destroy != NULL)
-        {
-            element->ops->destroy(element);
-        }
+/*
+ * Trim trailing holes, compact once holes dominate, and invalidate the
+ * structures indexed by slot.
+ */
+static void finish_removal(ui_runtime *context)
+{
+    while (context->element_count > 0U && context->elements[context->element_count - 1U] == NULL)
+    {
+        context->element_count--;
+        context->hole_count--;
+    }
+
+    if (ui_element_should_compact_siblings(context->hole_count, context->element_count))
+    {
+        context->element_count =
+            ui_element_compact_siblings(context->elements, context->element_count);
+        context->hole_count = 0;
+        ui_element_table_rewrite(&context->element_table, context->elements,
+                                 context->element_count);
+    }
+    else
+    {
+        ui_element_table_truncate(&context->element_table, context->element_count);
+    }
+
+    ui_spatial_index_invalidate(&context->hit_index);
+    ui_element_invalidate_render(NULL);
+}
+
+bool ui_runtime_remove(ui_runtime *context, ui_element *element, bool destroy_element)
+{
+    size_t index = 0U;
+    if (context == NULL || !is_valid_element(element) ||
+        !ui_element_find_sibling(context->elements, context->element_count, element, &index))
+    {
+        return false;
+    }
+
+    detach_element(context, index, destroy_element);
+    finish_removal(context);
+    return true;
+}
+
+size_t ui_runtime_remove_elements(ui_runtime *context, ui_element *const *elements, size_t count,
+                                  bool destroy_elements)
+{
+    if (context == NULL || elements == NULL)
+    {
+        return 0U;
+    }
 
-        for (size_t j = i; j + 1U < context->element_count; ++j)
+    size_t removed = 0U;
+    for (size_t i = 0U; i < count; ++i)
+    {
+        size_t index = 0U;
+        if (!is_valid_element(elements[i]) ||
+            !ui_element_find_sibling(context->elements, context->element_count, elements[i],
+                                     &index))
         {
-            context->elements[j] = context->elements[j + 1U];
+            continue;
         }
-        context->element_count--;
-        return true;
+        detach_element(context, index, destroy_elements);
+        removed++;
     }
 
-    return false;
+    if (removed > 0U)
+    {
+        finish_removal(context);
+    }
+    return removed;
 }
 
 void ui_runtime_handle_event(ui_runtime *context, const SDL_Event *event)
@@ -281,41 +494,48 @@ void ui_runtime_handle_event(ui_runtime *context, const SDL_Event *event)
         {
             return;
         }
+        track_pointer(context, &point);
 
         if (event->type == SDL_EVENT_MOUSE_BUTTON_DOWN && event->button.button == SDL_BUTTON_LEFT)
         {
             set_focused_element(context, find_top_focusable_at(context, &point));
-            ui_element *handled_element = dispatch_pointer_event(context, event, &point);
-            context->captured_element = handled_element;
+            context->captured_element = UI_HANDLE_NULL;
+            (void)dispatch_pointer_event(context, event, &point, &context->captured_element);
             return;
         }
 
         if (event->type == SDL_EVENT_MOUSE_MOTION)
         {
-            if (dispatch_to_element(context->captured_element, event))
+            if (dispatch_to_element(ui_handle_resolve(context->captured_element), event))
             {
                 return;
             }
-            (void)dispatch_pointer_event(context, event, &point);
+            (void)dispatch_pointer_event(context, event, &point, NULL);
             return;
         }
 
         if (event->type == SDL_EVENT_MOUSE_BUTTON_UP && event->button.button == SDL_BUTTON_LEFT)
         {
-            if (dispatch_to_element(context->captured_element, event))
+            ui_element *captured = ui_handle_resolve(context->captured_element);
+            context->captured_element = UI_HANDLE_NULL;
+            if (dispatch_to_element(captured, event))
             {
-                context->captured_element = NULL;
                 return;
             }
-            context->captured_element = NULL;
-            (void)dispatch_pointer_event(context, event, &point);
+            (void)dispatch_pointer_event(context, event, &point, NULL);
             return;
         }
 
-        (void)dispatch_pointer_event(context, event, &point);
+        (void)dispatch_pointer_event(context, event, &point, NULL);
         return;
     }
 
+    if (event->type == SDL_EVENT_WINDOW_MOUSE_LEAVE)
+    {
+        context->has_pointer = false;
+        refresh_hover(context);
+    }
+
     for (size_t i = context->element_count; i > 0U; --i)
     {
         ui_element *element = context->elements[i - 1U];
@@ -333,31 +553,320 @@ void ui_runtime_update(ui_runtime *context, float delta_seconds)
         return;
     }
 
+    if (context->use_element_table)
+    {
+        const ui_element_table *table = &context->element_table;
+        const Uint8 required = UI_ELEMENT_TABLE_ENABLED | UI_ELEMENT_TABLE_UPDATES;
+        ui_element_table_sync(&context->element_table, context->elements,
+                              context->element_count);
+        for (size_t i = 0; i < context->element_count; ++i)
+        {
+            const Uint8 flags = table->flags[i];
+            if ((flags & required) != required)
+            {
+                continue;
+            }
+            if ((flags & UI_ELEMENT_TABLE_SUBTREE) != 0U)
+            {
+                ui_traversal_update(context->elements[i], delta_seconds);
+                continue;
+            }
+            UI_OPS_PROFILE_ENTER(scope, table->ops[i], UI_OPS_CALL_UPDATE);
+            table->ops[i]->update(context->elements[i], delta_seconds);
+            UI_OPS_PROFILE_LEAVE(scope);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < context->element_count; ++i)
+    {
+        ui_traversal_update(context->elements[i], delta_seconds);
+    }
+}
+
+float ui_runtime_next_frame_delay(const ui_runtime *context)
+{
+    if (context == NULL)
+    {
+        return UI_NO_FRAME_REQUEST;
+    }
+
+    float delay = UI_NO_FRAME_REQUEST;
+    for (size_t i = 0; i < context->element_count; ++i)
+    {
+        delay = ui_element_earliest_frame_delay(
+            delay, ui_traversal_next_frame_delay(context->elements[i]));
+    }
+    return delay;
+}
+
+void ui_runtime_layout(ui_runtime *context)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+
     for (size_t i = 0; i < context->element_count; ++i)
     {
         ui_element *element = context->elements[i];
-        if (!is_valid_element(element) || !element->enabled || element->ops->update == NULL)
+        if (!is_valid_element(element) || !ui_element_needs_layout(element))
         {
             continue;
         }
-        element->ops->update(element, delta_seconds);
+
+        const SDL_FRect available = element->rect;
+        ui_element_measure(element, &available);
+        SDL_FRect final_rect = available;
+        if (element->ops->measure != NULL)
+        {
+            final_rect.w = element->rect.w;
+            final_rect.h = element->rect.h;
+        }
+        ui_element_arrange(element, &final_rect);
+    }
+
+    if (context->has_pointer && is_hover_stale(context))
+    {
+        refresh_hover(context);
     }
 }
 
-void ui_runtime_render(const ui_runtime *context, SDL_Renderer *renderer)
+static void render_elements(ui_runtime *context, SDL_Renderer *renderer)
 {
-    if (context == NULL || renderer == NULL)
+    if (context->use_element_table)
     {
+        const ui_element_table *table = &context->element_table;
+        const Uint8 required = UI_ELEMENT_TABLE_VISIBLE | UI_ELEMENT_TABLE_RENDERS;
+        ui_element_table_sync(&context->element_table, context->elements,
+                              context->element_count);
+        for (size_t i = 0; i < context->element_count; ++i)
+        {
+            const Uint8 flags = table->flags[i];
+            if ((flags & required) != required)
+            {
+                continue;
+            }
+            if ((flags & UI_ELEMENT_TABLE_SUBTREE) != 0U)
+            {
+                ui_traversal_render(context->elements[i], renderer);
+                continue;
+            }
+            UI_OPS_PROFILE_ENTER(scope, table->ops[i], UI_OPS_CALL_RENDER);
+            table->ops[i]->render(context->elements[i], renderer);
+            UI_OPS_PROFILE_LEAVE(scope);
+        }
         return;
     }
 
     for (size_t i = 0; i < context->element_count; ++i)
     {
-        const ui_element *element = context->elements[i];
-        if (!is_valid_element(element) || !element->visible || element->ops->render == NULL)
+        ui_traversal_render(context->elements[i], renderer);
+    }
+}
+
+/*
+ * Re-record the frame when anything was invalidated, accumulating the regions
+ * that changed into context->damage. Returns false when no valid recording is
+ * available and callers must draw immediately.
+ */
+static bool ensure_recording(ui_runtime *context, SDL_Renderer *renderer)
+{
+    if (ui_runtime_can_replay(context))
+    {
+        context->render_stats.replayed_frames++;
+        return true;
+    }
+
+    // Keep the last recording around so the new one can be diffed against it.
+    const bool had_recording = context->has_recording;
+    const ui_render_list previous = context->previous_render_list;
+    context->previous_render_list = context->render_list;
+    context->render_list = previous;
+
+    const Uint64 generation = ui_element_render_generation();
+    context->has_recording = false;
+    if (!ui_render_begin_recording(&context->render_list))
+    {
+        context->damage_all = true;
+        return false;
+    }
+    render_elements(context, renderer);
+    context->has_recording = ui_render_end_recording();
+    context->recorded_render_generation = generation;
+    context->render_stats.recorded_frames++;
+    context->render_stats.command_count = context->render_list.command_count;
+
+    if (!context->has_recording)
+    {
+        // Recording ran out of memory; the caller draws this frame directly.
+        context->damage_all = true;
+        return false;
+    }
+
+    if (had_recording)
+    {
+        ui_render_list_diff(&context->previous_render_list, &context->render_list,
+                            &context->damage);
+    }
+    else
+    {
+        context->damage_all = true;
+    }
+    return true;
+}
+
+void ui_runtime_render(ui_runtime *context, SDL_Renderer *renderer)
+{
+    if (context == NULL || renderer == NULL)
+    {
+        return;
+    }
+
+    if (!context->retained_rendering || !ensure_recording(context, renderer))
+    {
+        render_elements(context, renderer);
+        return;
+    }
+
+    ui_render_list_replay(&context->render_list, renderer);
+}
+
+static bool ensure_render_target(ui_runtime *context, SDL_Renderer *renderer, int width,
+                                 int height)
+{
+    if (context->render_target != NULL && context->render_target_w == width &&
+        context->render_target_h == height)
+    {
+        return true;
+    }
+
+    ui_runtime_discard_render_target(context);
+    context->render_target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                               SDL_TEXTUREACCESS_TARGET, width, height);
+    if (context->render_target == NULL)
+    {
+        return false;
+    }
+
+    // Every pixel is painted opaque, so skip per-pixel blending when presenting.
+    SDL_SetTextureBlendMode(context->render_target, SDL_BLENDMODE_NONE);
+    context->render_target_w = width;
+    context->render_target_h = height;
+    context->damage_all = true;
+    return true;
+}
+
+static void repaint_region(const ui_runtime *context, SDL_Renderer *renderer,
+                           const SDL_FRect *region, SDL_Color clear_color)
+{
+    ui_render_fill_rect(renderer, region, clear_color);
+    ui_render_list_replay_clipped(&context->render_list, renderer, region);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+bool ui_runtime_render_damaged(ui_runtime *context, SDL_Renderer *renderer, int width, int height,
+                               SDL_Color clear_color)
+{
+    if (context == NULL || renderer == NULL || width <= 0 || height <= 0 ||
+        !context->retained_rendering)
+    {
+        return false;
+    }
+
+    if (!ensure_render_target(context, renderer, width, height))
+    {
+        return false;
+    }
+
+    SDL_Texture *previous_target = SDL_GetRenderTarget(renderer);
+    if (!SDL_SetRenderTarget(renderer, context->render_target))
+    {
+        return false;
+    }
+
+    const SDL_FRect full_rect = {0.0F, 0.0F, (float)width, (float)height};
+    if (!ensure_recording(context, renderer))
+    {
+        ui_render_fill_rect(renderer, &full_rect, clear_color);
+        render_elements(context, renderer);
+        context->render_stats.full_repaint_frames++;
+    }
+    else if (context->damage_all)
+    {
+        repaint_region(context, renderer, &full_rect, clear_color);
+        context->render_stats.full_repaint_frames++;
+        context->damage_all = false;
+    }
+    else if (context->damage.count > 0U)
+    {
+        for (size_t i = 0; i < context->damage.count; ++i)
         {
-            continue;
+            repaint_region(context, renderer, &context->damage.rects[i], clear_color);
         }
-        element->ops->render(element, renderer);
+        context->render_stats.partial_repaint_frames++;
+    }
+    ui_render_damage_clear(&context->damage);
+
+    SDL_SetRenderTarget(renderer, previous_target);
+    ui_render_texture(renderer, context->render_target, &full_rect);
+    return true;
+}
+
+void ui_runtime_discard_render_target(ui_runtime *context)
+{
+    if (context == NULL)
+    {
+        return;
     }
+
+    if (context->render_target != NULL)
+    {
+        SDL_DestroyTexture(context->render_target);
+    }
+    context->render_target = NULL;
+    context->render_target_w = 0;
+    context->render_target_h = 0;
+    context->damage_all = true;
+}
+
+void ui_runtime_set_retained_rendering(ui_runtime *context, bool enabled)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+
+    context->retained_rendering = enabled;
+    context->has_recording = false;
+    context->damage_all = true;
+    ui_render_list_clear(&context->render_list);
+}
+
+void ui_runtime_set_element_table(ui_runtime *context, bool enabled)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+
+    context->use_element_table = enabled;
+    // Rows may have gone stale while unused; force a full refresh.
+    context->element_table.synced_generation = 0U;
+}
+
+bool ui_runtime_can_replay(const ui_runtime *context)
+{
+    return context != NULL && context->retained_rendering && context->has_recording &&
+           context->recorded_render_generation == ui_element_render_generation();
+}
+
+ui_runtime_render_stats ui_runtime_get_render_stats(const ui_runtime *context)
+{
+    if (context == NULL)
+    {
+        return (ui_runtime_render_stats){0};
+    }
+
+    return context->render_stats;
 }
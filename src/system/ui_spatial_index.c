@@ -0,0 +1,271 @@
+#include "system/ui_spatial_index.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Average number of elements per grid cell the grid is sized for.
+static const float TARGET_ELEMENTS_PER_CELL = 2.0F;
+static const int MAX_GRID_DIMENSION = 1024;
+
+static bool reserve_sizes(size_t **storage, size_t *capacity, size_t needed)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+
+    size_t new_capacity = *capacity == 0U ? 64U : *capacity;
+    while (new_capacity < needed)
+    {
+        new_capacity *= 2U;
+    }
+
+    size_t *resized = realloc(*storage, new_capacity * sizeof(size_t));
+    if (resized == NULL)
+    {
+        return false;
+    }
+
+    *storage = resized;
+    *capacity = new_capacity;
+    return true;
+}
+
+static int clamp_dimension(float value)
+{
+    if (value < 1.0F)
+    {
+        return 1;
+    }
+    if (value > (float)MAX_GRID_DIMENSION)
+    {
+        return MAX_GRID_DIMENSION;
+    }
+    return (int)value;
+}
+
+static int cell_coordinate(float offset, float cell_size, int cell_count)
+{
+    if (offset <= 0.0F || cell_size <= 0.0F)
+    {
+        return 0;
+    }
+
+    const float cell = offset / cell_size;
+    if (cell >= (float)(cell_count - 1))
+    {
+        return cell_count - 1;
+    }
+    return (int)cell;
+}
+
+static void size_grid(ui_spatial_index *index, size_t count)
+{
+    const float width = index->bounds.w > 0.0F ? index->bounds.w : 1.0F;
+    const float height = index->bounds.h > 0.0F ? index->bounds.h : 1.0F;
+    const float target_cells = (float)count / TARGET_ELEMENTS_PER_CELL;
+
+    // Pick columns/rows so cells are roughly square over the occupied bounds.
+    index->columns = clamp_dimension(SDL_ceilf(SDL_sqrtf(target_cells * (width / height))));
+    index->rows = clamp_dimension(SDL_ceilf(target_cells / (float)index->columns));
+    index->cell_w = width / (float)index->columns;
+    index->cell_h = height / (float)index->rows;
+}
+
+static void get_cell_span(const ui_spatial_index *index, const SDL_FRect *rect, int *col0,
+                          int *row0, int *col1, int *row1)
+{
+    *col0 = cell_coordinate(rect->x - index->bounds.x, index->cell_w, index->columns);
+    *row0 = cell_coordinate(rect->y - index->bounds.y, index->cell_h, index->rows);
+    *col1 = cell_coordinate((rect->x + rect->w) - index->bounds.x, index->cell_w, index->columns);
+    *row1 = cell_coordinate((rect->y + rect->h) - index->bounds.y, index->cell_h, index->rows);
+}
+
+static bool build_grid(ui_spatial_index *index, ui_element *const *elements, size_t count)
+{
+    bool has_bounds = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (elements[i] == NULL)
+        {
+            continue;
+        }
+
+        const SDL_FRect rect = ui_element_screen_rect(elements[i]);
+        if (!has_bounds)
+        {
+            index->bounds = rect;
+            has_bounds = true;
+            continue;
+        }
+        SDL_GetRectUnionFloat(&index->bounds, &rect, &index->bounds);
+    }
+    if (!has_bounds)
+    {
+        index->bounds = (SDL_FRect){0.0F, 0.0F, 0.0F, 0.0F};
+    }
+
+    size_grid(index, count);
+    const size_t cell_count = (size_t)index->columns * (size_t)index->rows;
+    if (!reserve_sizes(&index->cell_starts, &index->cell_starts_capacity, cell_count + 1U))
+    {
+        return false;
+    }
+    memset(index->cell_starts, 0, (cell_count + 1U) * sizeof(size_t));
+
+    // Counting sort into a compressed cell -> entries layout. First count how
+    // many entries land in each cell, then turn counts into end offsets.
+    size_t total = 0U;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (elements[i] == NULL)
+        {
+            continue;
+        }
+
+        const SDL_FRect rect = ui_element_screen_rect(elements[i]);
+        int col0 = 0;
+        int row0 = 0;
+        int col1 = 0;
+        int row1 = 0;
+        get_cell_span(index, &rect, &col0, &row0, &col1, &row1);
+        for (int row = row0; row <= row1; ++row)
+        {
+            for (int col = col0; col <= col1; ++col)
+            {
+                index->cell_starts[((size_t)row * (size_t)index->columns) + (size_t)col]++;
+            }
+        }
+        total += (size_t)(row1 - row0 + 1) * (size_t)(col1 - col0 + 1);
+    }
+
+    if (!reserve_sizes(&index->cell_entries, &index->cell_entries_capacity, total))
+    {
+        return false;
+    }
+
+    size_t running = 0U;
+    for (size_t cell = 0; cell < cell_count; ++cell)
+    {
+        running += index->cell_starts[cell];
+        index->cell_starts[cell] = running;
+    }
+    index->cell_starts[cell_count] = total;
+
+    // Fill back to front, decrementing each cell's end offset; afterwards every
+    // offset points at its cell's start and entries are in ascending z order.
+    for (size_t i = count; i > 0U; --i)
+    {
+        const ui_element *element = elements[i - 1U];
+        if (element == NULL)
+        {
+            continue;
+        }
+
+        const SDL_FRect rect = ui_element_screen_rect(element);
+        int col0 = 0;
+        int row0 = 0;
+        int col1 = 0;
+        int row1 = 0;
+        get_cell_span(index, &rect, &col0, &row0, &col1, &row1);
+        for (int row = row0; row <= row1; ++row)
+        {
+            for (int col = col0; col <= col1; ++col)
+            {
+                const size_t cell = ((size_t)row * (size_t)index->columns) + (size_t)col;
+                index->cell_entries[--index->cell_starts[cell]] = i - 1U;
+            }
+        }
+    }
+
+    return true;
+}
+
+void ui_spatial_index_init(ui_spatial_index *index)
+{
+    if (index == NULL)
+    {
+        return;
+    }
+
+    memset(index, 0, sizeof(*index));
+}
+
+void ui_spatial_index_destroy(ui_spatial_index *index)
+{
+    if (index == NULL)
+    {
+        return;
+    }
+
+    free(index->cell_starts);
+    free(index->cell_entries);
+    memset(index, 0, sizeof(*index));
+}
+
+void ui_spatial_index_invalidate(ui_spatial_index *index)
+{
+    if (index == NULL)
+    {
+        return;
+    }
+
+    index->built_generation = 0U;
+}
+
+void ui_spatial_index_query(ui_spatial_index *index, ui_element *const *elements, size_t count,
+                            const SDL_FPoint *point, ui_spatial_cursor *cursor)
+{
+    if (cursor == NULL)
+    {
+        return;
+    }
+
+    // Linear fallback: every index, topmost first.
+    cursor->entries = NULL;
+    cursor->remaining = elements != NULL ? count : 0U;
+    if (index == NULL || elements == NULL || point == NULL ||
+        count < UI_SPATIAL_INDEX_MIN_ELEMENTS)
+    {
+        return;
+    }
+
+    const Uint64 generation = ui_element_screen_rect_generation();
+    if (index->built_generation != generation || index->indexed_count != count)
+    {
+        index->has_grid = build_grid(index, elements, count);
+        index->indexed_count = count;
+        index->built_generation = generation;
+    }
+    if (!index->has_grid)
+    {
+        return;
+    }
+
+    // Every indexed rect lies inside bounds, so points outside cannot hit.
+    const SDL_FRect *bounds = &index->bounds;
+    if (point->x < bounds->x || point->y < bounds->y || point->x > bounds->x + bounds->w ||
+        point->y > bounds->y + bounds->h)
+    {
+        cursor->remaining = 0U;
+        return;
+    }
+
+    const int col = cell_coordinate(point->x - index->bounds.x, index->cell_w, index->columns);
+    const int row = cell_coordinate(point->y - index->bounds.y, index->cell_h, index->rows);
+    const size_t cell = ((size_t)row * (size_t)index->columns) + (size_t)col;
+    cursor->entries = index->cell_entries + index->cell_starts[cell];
+    cursor->remaining = index->cell_starts[cell + 1U] - index->cell_starts[cell];
+}
+
+bool ui_spatial_cursor_next(ui_spatial_cursor *cursor, size_t *out_index)
+{
+    if (cursor == NULL || out_index == NULL || cursor->remaining == 0U)
+    {
+        return false;
+    }
+
+    cursor->remaining--;
+    *out_index = cursor->entries != NULL ? cursor->entries[cursor->remaining] : cursor->remaining;
+    return true;
+}
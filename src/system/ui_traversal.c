@@ -0,0 +1,265 @@
+#include "system/ui_traversal.h"
+
+#include "system/ui_handle.h"
+#include "system/ui_ops_profiler.h"
+
+#include <stdlib.h>
+
+// Depth covered without touching the heap; real pages stay well below this.
+#define INLINE_STACK_DEPTH 32U
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH_ELEMENT(element) __builtin_prefetch(element)
+#else
+#define PREFETCH_ELEMENT(element) ((void)(element))
+#endif
+
+typedef struct traversal_frame
+{
+    ui_element *element;
+    size_t next_child;
+} traversal_frame;
+
+typedef struct traversal_stack
+{
+    traversal_frame inline_frames[INLINE_STACK_DEPTH];
+    traversal_frame *frames;
+    size_t depth;
+    size_t capacity;
+} traversal_stack;
+
+/*
+ * Visitor hooks for one pass. enter returns false to skip the element's
+ * subtree (and its leave); leave may be NULL.
+ */
+typedef struct traversal_visitor
+{
+    bool (*enter)(ui_element *element, void *state);
+    void (*leave)(ui_element *element, void *state);
+    void *state;
+} traversal_visitor;
+
+static bool is_valid_element(const ui_element *element)
+{
+    return element != NULL && element->ops != NULL;
+}
+
+static bool push_frame(traversal_stack *stack, ui_element *element)
+{
+    if (stack->depth == stack->capacity)
+    {
+        const size_t new_capacity = stack->capacity * 2U;
+        traversal_frame *resized = NULL;
+        if (stack->frames == stack->inline_frames)
+        {
+            resized = malloc(new_capacity * sizeof(*resized));
+            if (resized != NULL)
+            {
+                for (size_t i = 0U; i < stack->depth; ++i)
+                {
+                    resized[i] = stack->frames[i];
+                }
+            }
+        }
+        else
+        {
+            resized = realloc(stack->frames, new_capacity * sizeof(*resized));
+        }
+
+        if (resized == NULL)
+        {
+            return false;
+        }
+        stack->frames = resized;
+        stack->capacity = new_capacity;
+    }
+
+    stack->frames[stack->depth++] = (traversal_frame){element, 0U};
+    return true;
+}
+
+static void leave_element(const traversal_visitor *visitor, ui_element *element)
+{
+    if (visitor->leave != NULL)
+    {
+        visitor->leave(element, visitor->state);
+    }
+}
+
+static void walk(ui_element *root, const traversal_visitor *visitor)
+{
+    if (!is_valid_element(root) || !visitor->enter(root, visitor->state))
+    {
+        return;
+    }
+
+    traversal_stack stack;
+    stack.frames = stack.inline_frames;
+    stack.depth = 0U;
+    stack.capacity = INLINE_STACK_DEPTH;
+
+    // Leaves never reach the stack; an element whose frame cannot be pushed is
+    // treated as a leaf rather than aborting the whole pass.
+    if (root->ops->child_span == NULL || !push_frame(&stack, root))
+    {
+        leave_element(visitor, root);
+        return;
+    }
+
+    while (stack.depth > 0U)
+    {
+        traversal_frame *top = &stack.frames[stack.depth - 1U];
+        ui_element *const *children = NULL;
+        const size_t child_count = top->element->ops->child_span(top->element, &children);
+        if (top->next_child >= child_count)
+        {
+            ui_element *finished = top->element;
+            stack.depth--;
+            leave_element(visitor, finished);
+            continue;
+        }
+
+        ui_element *child = children[top->next_child++];
+        if (top->next_child < child_count)
+        {
+            PREFETCH_ELEMENT(children[top->next_child]);
+        }
+        if (!is_valid_element(child) || !visitor->enter(child, visitor->state))
+        {
+            continue;
+        }
+        if (child->ops->child_span == NULL || !push_frame(&stack, child))
+        {
+            leave_element(visitor, child);
+        }
+    }
+
+    if (stack.frames != stack.inline_frames)
+    {
+        free(stack.frames);
+    }
+}
+
+typedef struct update_state
+{
+    float delta_seconds;
+} update_state;
+
+static bool enter_update(ui_element *element, void *state)
+{
+    if (element->enabled && element->ops->update != NULL)
+    {
+        UI_OPS_PROFILE_ENTER(scope, element->ops, UI_OPS_CALL_UPDATE);
+        element->ops->update(element, ((const update_state *)state)->delta_seconds);
+        UI_OPS_PROFILE_LEAVE(scope);
+    }
+
+    // After update, so rects the op itself moved are picked up as well.
+    ui_element_sync_screen_rect(element);
+    return element->enabled;
+}
+
+void ui_traversal_update(ui_element *root, float delta_seconds)
+{
+    update_state state = {delta_seconds};
+    const traversal_visitor visitor = {enter_update, NULL, &state};
+    walk(root, &visitor);
+}
+
+static bool enter_render(ui_element *element, void *state)
+{
+    if (!element->visible)
+    {
+        return false;
+    }
+
+    if (element->ops->render != NULL)
+    {
+        UI_OPS_PROFILE_ENTER(scope, element->ops, UI_OPS_CALL_RENDER);
+        element->ops->render(element, (SDL_Renderer *)state);
+        UI_OPS_PROFILE_LEAVE(scope);
+    }
+    return true;
+}
+
+static void leave_render(ui_element *element, void *state)
+{
+    if (element->ops->finish_render != NULL)
+    {
+        // Charged to render: finish_render is the tail of the same draw.
+        UI_OPS_PROFILE_ENTER(scope, element->ops, UI_OPS_CALL_RENDER);
+        element->ops->finish_render(element, (SDL_Renderer *)state);
+        UI_OPS_PROFILE_LEAVE(scope);
+    }
+}
+
+void ui_traversal_render(const ui_element *root, SDL_Renderer *renderer)
+{
+    // The walk hands out mutable children either way; render ops only ever
+    // see the element through a const pointer.
+    const traversal_visitor visitor = {enter_render, leave_render, renderer};
+    walk((ui_element *)root, &visitor);
+}
+
+static bool enter_frame_delay(ui_element *element, void *state)
+{
+    if (!element->visible || !element->enabled)
+    {
+        return false;
+    }
+
+    float *delay = state;
+    *delay = ui_element_earliest_frame_delay(*delay, ui_element_next_frame_delay(element));
+    return true;
+}
+
+float ui_traversal_next_frame_delay(const ui_element *root)
+{
+    float delay = UI_NO_FRAME_REQUEST;
+    const traversal_visitor visitor = {enter_frame_delay, NULL, &delay};
+    walk((ui_element *)root, &visitor);
+    return delay;
+}
+
+static bool enter_destroy(ui_element *element, void *state)
+{
+    (void)element;
+    (void)state;
+    return true;
+}
+
+static void leave_destroy(ui_element *element, void *state)
+{
+    (void)state;
+    ui_handle_release(element);
+    if (element->ops->destroy != NULL)
+    {
+        element->ops->destroy(element);
+    }
+}
+
+void ui_traversal_destroy(ui_element *root)
+{
+    const traversal_visitor visitor = {enter_destroy, leave_destroy, NULL};
+    walk(root, &visitor);
+}
+
+static bool enter_invalidate_screen_rect(ui_element *element, void *state)
+{
+    (void)state;
+    // A dropped cache implies dropped caches below it: descendants can only
+    // be resolved through this element, which would have refilled it.
+    if (element->screen_rect_generation == 0U)
+    {
+        return false;
+    }
+
+    element->screen_rect_generation = 0U;
+    return true;
+}
+
+void ui_traversal_invalidate_screen_rects(ui_element *root)
+{
+    const traversal_visitor visitor = {enter_invalidate_screen_rect, NULL, NULL};
+    walk(root, &visitor);
+}
@@ -1,11 +1,10 @@
 #include "ui/ui_button.h"
 
-#include <stdlib.h>
-#include <string.h>
+#include "system/ui_render.h"
 
-static const float DEBUG_GLYPH_WIDTH = 8.0F;
-static const float DEBUG_GLYPH_HEIGHT = 8.0F;
 static const SDL_Color BUTTON_TEXT_COLOR_WHITE = {255, 255, 255, 255};
+// How far the hovered fill moves from up_color toward down_color.
+static const float HOVER_COLOR_MIX = 0.35F;
 
 // Hit-testing uses SDL3's SDL_PointInRectFloat (from SDL_rect.h) instead of a
 // hand-rolled helper.  SDL handles the inclusive-bounds check for us and stays
@@ -21,6 +20,7 @@ static bool handle_button_event(ui_element *element, const SDL_Event *event)
         if (SDL_PointInRectFloat(&cursor, &sr))
         {
             button->is_pressed = true;
+            ui_element_invalidate_render(element);
             return true;
         }
         return false;
@@ -34,6 +34,10 @@ static bool handle_button_event(ui_element *element, const SDL_Event *event)
         const bool is_inside = SDL_PointInRectFloat(&cursor, &sr);
 
         button->is_pressed = false;
+        if (was_pressed)
+        {
+            ui_element_invalidate_render(element);
+        }
         if (was_pressed && is_inside && button->on_click != NULL)
         {
             button->on_click(button->on_click_context);
@@ -44,6 +48,17 @@ static bool handle_button_event(ui_element *element, const SDL_Event *event)
     return false;
 }
 
+static void update_button_hover(ui_element *element, const SDL_FPoint *point)
+{
+    ui_button *button = (ui_button *)element;
+    const bool hovered = point != NULL;
+    if (button->is_hovered != hovered)
+    {
+        button->is_hovered = hovered;
+        ui_element_invalidate_render(element);
+    }
+}
+
 static void update_button(ui_element *element, float delta_seconds)
 {
     (void)element;
@@ -60,12 +75,8 @@ static void measure_button(ui_element *element, const SDL_FRect *available_rect)
         return;
     }
 
-    const float intrinsic_height = DEBUG_GLYPH_HEIGHT + 12.0F;
-    float intrinsic_width = 24.0F;
-    if (button->label != NULL && button->label[0] != '\0')
-    {
-        intrinsic_width += (float)strlen(button->label) * DEBUG_GLYPH_WIDTH;
-    }
+    const float intrinsic_height = button->label_run.height + 12.0F;
+    const float intrinsic_width = 24.0F + button->label_run.width;
 
     if (button->base.rect.w < intrinsic_width)
     {
@@ -91,20 +102,25 @@ static void render_button(const ui_element *element, SDL_Renderer *renderer)
 {
     const ui_button *button = (const ui_button *)element;
     const SDL_FRect sr = ui_element_screen_rect(element);
-    const SDL_Color fill_color = button->is_pressed ? button->down_color : button->up_color;
+    SDL_Color fill_color = button->up_color;
+    if (button->is_pressed)
+    {
+        fill_color = button->down_color;
+    }
+    else if (button->is_hovered)
+    {
+        fill_color = ui_render_mix_color(button->up_color, button->down_color, HOVER_COLOR_MIX);
+    }
 
-    SDL_SetRenderDrawColor(renderer, fill_color.r, fill_color.g, fill_color.b, fill_color.a);
-    SDL_RenderFillRect(renderer, &sr);
+    ui_render_fill_rect(renderer, &sr, fill_color);
 
-    if (button->label != NULL && button->label[0] != '\0')
+    const ui_text_run *label = &button->label_run;
+    if (!ui_text_run_is_empty(label))
     {
-        const float label_width = (float)strlen(button->label) * DEBUG_GLYPH_WIDTH;
-        const float label_x = sr.x + ((sr.w - label_width) * 0.5F);
-        const float label_y = sr.y + ((sr.h - DEBUG_GLYPH_HEIGHT) * 0.5F);
+        const float label_x = sr.x + ((sr.w - label->width) * 0.5F);
+        const float label_y = sr.y + ((sr.h - label->height) * 0.5F);
 
-        SDL_SetRenderDrawColor(renderer, BUTTON_TEXT_COLOR_WHITE.r, BUTTON_TEXT_COLOR_WHITE.g,
-                               BUTTON_TEXT_COLOR_WHITE.b, BUTTON_TEXT_COLOR_WHITE.a);
-        SDL_RenderDebugText(renderer, label_x, label_y, button->label);
+        ui_render_debug_text(renderer, label_x, label_y, label->text, BUTTON_TEXT_COLOR_WHITE);
     }
 
     if (button->base.has_border)
@@ -114,28 +130,45 @@ static void render_button(const ui_element *element, SDL_Renderer *renderer)
     }
 }
 
-static void destroy_button(ui_element *element) { free(element); }
+// Drop the reference held on a pooled label, if any.
+static void release_label(ui_button *button)
+{
+    if (button->label_pool != NULL)
+    {
+        string_pool_release(button->label_pool, button->label);
+        button->label_pool = NULL;
+    }
+}
+
+static void destroy_button(ui_element *element)
+{
+    release_label((ui_button *)element);
+    cui_free(element->allocator, element, sizeof(ui_button));
+}
 
 static const ui_element_ops BUTTON_OPS = {
+    .type_name = "button",
     .measure = measure_button,
     .arrange = arrange_button,
     .handle_event = handle_button_event,
+    .update_hover = update_button_hover,
     .update = update_button,
     .render = render_button,
     .destroy = destroy_button,
 };
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-ui_button *ui_button_create(const SDL_FRect *rect, SDL_Color up_color, SDL_Color down_color,
-                            const char *label, const SDL_Color *border_color,
-                            button_click_handler on_click, void *on_click_context)
+ui_button *ui_button_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                            SDL_Color up_color, SDL_Color down_color, const char *label,
+                            const SDL_Color *border_color, button_click_handler on_click,
+                            void *on_click_context)
 {
     if (rect == NULL)
     {
         return NULL;
     }
 
-    ui_button *button = malloc(sizeof(*button));
+    ui_button *button = cui_alloc(allocator, sizeof(*button));
     if (button == NULL)
     {
         return NULL;
@@ -143,16 +176,21 @@ ui_button *ui_button_create(const SDL_FRect *rect, SDL_Color up_color, SDL_Color
 
     button->base.rect = *rect;
     button->base.ops = &BUTTON_OPS;
+    button->base.allocator = allocator;
     button->base.visible = true;
     button->base.enabled = true;
     button->base.parent = NULL;
     button->base.align_h = UI_ALIGN_LEFT;
     button->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&button->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&button->base);
     button->up_color = up_color;
     button->down_color = down_color;
     button->label = label;
+    button->label_pool = NULL;
+    ui_text_run_set(&button->label_run, label);
     button->is_pressed = false;
+    button->is_hovered = false;
     button->on_click = on_click;
     button->on_click_context = on_click_context;
 
@@ -168,6 +206,15 @@ bool ui_button_is_pressed(const ui_button *button)
     return button->is_pressed;
 }
 
+bool ui_button_is_hovered(const ui_button *button)
+{
+    if (button == NULL)
+    {
+        return false;
+    }
+    return button->is_hovered;
+}
+
 const char *ui_button_get_label(const ui_button *button)
 {
     if (button == NULL || button->label == NULL)
@@ -183,5 +230,25 @@ void ui_button_set_label(ui_button *button, const char *label)
     {
         return;
     }
+    release_label(button);
     button->label = label;
+    ui_text_run_set(&button->label_run, label);
+    ui_element_invalidate_measure(&button->base);
+}
+
+bool ui_button_set_interned_label(ui_button *button, string_pool *pool, const char *label)
+{
+    if (button == NULL || pool == NULL || label == NULL)
+    {
+        return false;
+    }
+    if (button->label == label && button->label_pool == pool)
+    {
+        return true;
+    }
+
+    (void)string_pool_retain(pool, label);
+    ui_button_set_label(button, label);
+    button->label_pool = pool;
+    return true;
 }
@@ -1,7 +1,6 @@
 #include "ui/ui_checkbox.h"
 
-#include <stdlib.h>
-#include <string.h>
+#include "system/ui_render.h"
 
 // The indicator box is always 16x16 pixels.
 static const float BOX_SIZE = 16.0F;
@@ -9,10 +8,6 @@ static const float BOX_SIZE = 16.0F;
 // Horizontal gap between the box and the label text.
 static const float LABEL_GAP = 6.0F;
 
-// SDL_RenderDebugText uses 8x8 pixel glyphs.
-static const float DEBUG_CHAR_W = 8.0F;
-static const float DEBUG_CHAR_H = 8.0F;
-
 // Inset in pixels from the box edges for the check-mark lines.
 static const float CHECK_INSET = 3.0F;
 
@@ -25,6 +20,10 @@ static void set_checked_internal(ui_checkbox *checkbox, bool checked, bool notif
 
     const bool changed = checkbox->is_checked != checked;
     checkbox->is_checked = checked;
+    if (changed)
+    {
+        ui_element_invalidate_render(&checkbox->base);
+    }
     if (changed && notify && checkbox->on_change != NULL)
     {
         checkbox->on_change(checkbox->is_checked, checkbox->on_change_context);
@@ -81,8 +80,7 @@ static void measure_checkbox(ui_element *element, const SDL_FRect *available_rec
         return;
     }
 
-    const float label_width = (float)strlen(checkbox->label) * DEBUG_CHAR_W;
-    const float intrinsic_width = BOX_SIZE + LABEL_GAP + label_width;
+    const float intrinsic_width = BOX_SIZE + LABEL_GAP + checkbox->label_run.width;
     if (checkbox->base.rect.w < intrinsic_width)
     {
         checkbox->base.rect.w = intrinsic_width;
@@ -109,27 +107,27 @@ static void render_checkbox(const ui_element *element, SDL_Renderer *renderer)
 
     // Draw the box outline.
     const SDL_FRect box_rect = {box_x, box_y, BOX_SIZE, BOX_SIZE};
-    SDL_SetRenderDrawColor(renderer, checkbox->box_color.r, checkbox->box_color.g,
-                           checkbox->box_color.b, checkbox->box_color.a);
-    SDL_RenderRect(renderer, &box_rect);
+    ui_render_rect(renderer, &box_rect, checkbox->box_color);
 
     // Draw an X inside the box when checked.
     if (checkbox->is_checked)
     {
-        SDL_SetRenderDrawColor(renderer, checkbox->check_color.r, checkbox->check_color.g,
-                               checkbox->check_color.b, checkbox->check_color.a);
-        SDL_RenderLine(renderer, box_x + CHECK_INSET, box_y + CHECK_INSET,
-                       box_x + BOX_SIZE - CHECK_INSET, box_y + BOX_SIZE - CHECK_INSET);
-        SDL_RenderLine(renderer, box_x + BOX_SIZE - CHECK_INSET, box_y + CHECK_INSET,
-                       box_x + CHECK_INSET, box_y + BOX_SIZE - CHECK_INSET);
+        ui_render_line(renderer, box_x + CHECK_INSET, box_y + CHECK_INSET,
+                       box_x + BOX_SIZE - CHECK_INSET, box_y + BOX_SIZE - CHECK_INSET,
+                       checkbox->check_color);
+        ui_render_line(renderer, box_x + BOX_SIZE - CHECK_INSET, box_y + CHECK_INSET,
+                       box_x + CHECK_INSET, box_y + BOX_SIZE - CHECK_INSET,
+                       checkbox->check_color);
     }
 
     // Draw the label to the right of the box, vertically centered.
     const float label_x = box_x + BOX_SIZE + LABEL_GAP;
-    const float label_y = box_y + ((BOX_SIZE - DEBUG_CHAR_H) / 2.0F);
-    SDL_SetRenderDrawColor(renderer, checkbox->label_color.r, checkbox->label_color.g,
-                           checkbox->label_color.b, checkbox->label_color.a);
-    SDL_RenderDebugText(renderer, label_x, label_y, checkbox->label);
+    const float label_y = box_y + ((BOX_SIZE - checkbox->label_run.height) / 2.0F);
+    if (!ui_text_run_is_empty(&checkbox->label_run))
+    {
+        ui_render_debug_text(renderer, label_x, label_y, checkbox->label_run.text,
+                             checkbox->label_color);
+    }
     if (checkbox->base.has_border)
     {
         ui_element_render_inner_border(renderer, &sr, checkbox->base.border_color,
@@ -137,9 +135,15 @@ static void render_checkbox(const ui_element *element, SDL_Renderer *renderer)
     }
 }
 
-static void destroy_checkbox(ui_element *element) { free(element); }
+static void destroy_checkbox(ui_element *element)
+{
+    ui_checkbox *checkbox = (ui_checkbox *)element;
+    string_pool_release(checkbox->label_pool, checkbox->label);
+    cui_free(element->allocator, element, sizeof(ui_checkbox));
+}
 
 static const ui_element_ops CHECKBOX_OPS = {
+    .type_name = "checkbox",
     .measure = measure_checkbox,
     .arrange = arrange_checkbox,
     .handle_event = handle_checkbox_event,
@@ -149,8 +153,8 @@ static const ui_element_ops CHECKBOX_OPS = {
 };
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-ui_checkbox *ui_checkbox_create(float x, float y, const char *label, SDL_Color box_color,
-                                SDL_Color check_color, SDL_Color label_color,
+ui_checkbox *ui_checkbox_create(const cui_allocator *allocator, float x, float y, const char *label,
+                                SDL_Color box_color, SDL_Color check_color, SDL_Color label_color,
                                 bool initially_checked, checkbox_change_handler on_change,
                                 void *on_change_context, const SDL_Color *border_color)
 {
@@ -159,29 +163,32 @@ ui_checkbox *ui_checkbox_create(float x, float y, const char *label, SDL_Color b
         return NULL;
     }
 
-    ui_checkbox *checkbox = malloc(sizeof(*checkbox));
+    ui_checkbox *checkbox = cui_alloc(allocator, sizeof(*checkbox));
     if (checkbox == NULL)
     {
         return NULL;
     }
 
-    const float label_width = (float)strlen(label) * DEBUG_CHAR_W;
-    const float total_width = BOX_SIZE + LABEL_GAP + label_width;
+    ui_text_run_set(&checkbox->label_run, label);
+    const float total_width = BOX_SIZE + LABEL_GAP + checkbox->label_run.width;
 
     checkbox->base.rect = (SDL_FRect){x, y, total_width, BOX_SIZE};
     checkbox->base.ops = &CHECKBOX_OPS;
+    checkbox->base.allocator = allocator;
     checkbox->base.visible = true;
     checkbox->base.enabled = true;
     checkbox->base.parent = NULL;
     checkbox->base.align_h = UI_ALIGN_LEFT;
     checkbox->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&checkbox->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&checkbox->base);
     checkbox->box_color = box_color;
     checkbox->check_color = check_color;
     checkbox->label_color = label_color;
     checkbox->is_checked = initially_checked;
     checkbox->is_pressed = false;
     checkbox->label = label;
+    checkbox->label_pool = NULL;
     checkbox->on_change = on_change;
     checkbox->on_change_context = on_change_context;
 
@@ -201,3 +208,23 @@ void ui_checkbox_set_checked(ui_checkbox *checkbox, bool checked, bool notify)
 {
     set_checked_internal(checkbox, checked, notify);
 }
+
+bool ui_checkbox_set_interned_label(ui_checkbox *checkbox, string_pool *pool, const char *label)
+{
+    if (checkbox == NULL || pool == NULL || label == NULL)
+    {
+        return false;
+    }
+    if (checkbox->label == label && checkbox->label_pool == pool)
+    {
+        return true;
+    }
+
+    (void)string_pool_retain(pool, label);
+    string_pool_release(checkbox->label_pool, checkbox->label);
+    checkbox->label = label;
+    checkbox->label_pool = pool;
+    ui_text_run_set(&checkbox->label_run, label);
+    ui_element_invalidate_measure(&checkbox->base);
+    return true;
+}
@@ -1,36 +1,295 @@
 #include "ui/ui_element.h"
 
+#include "system/ui_ops_profiler.h"
+#include "system/ui_render.h"
+#include "system/ui_traversal.h"
+
 #include <stddef.h>
 
+/*
+ * Both start at 1 so a freshly reset cache (generation 0) is always stale.
+ * screen_rect_epoch is what element caches are stamped with and only moves on
+ * a global invalidation; screen_rect_generation moves on every invalidation,
+ * global or per subtree, for caches derived from screen rects.
+ */
+static Uint64 screen_rect_epoch = 1U;
+static Uint64 screen_rect_generation = 1U;
+static Uint64 render_generation = 1U;
+
+void ui_element_reset_layout_cache(ui_element *element)
+{
+    if (element == NULL)
+    {
+        return;
+    }
+
+    element->screen_rect_cache = (SDL_FRect){0.0F, 0.0F, 0.0F, 0.0F};
+    element->screen_rect_source = (SDL_FRect){0.0F, 0.0F, 0.0F, 0.0F};
+    element->screen_rect_generation = 0U;
+    element->needs_measure = true;
+    element->needs_arrange = true;
+    element->measure_available_w = 0.0F;
+    element->measure_available_h = 0.0F;
+    element->measured_w = 0.0F;
+    element->measured_h = 0.0F;
+    element->arrange_final_rect = (SDL_FRect){0.0F, 0.0F, 0.0F, 0.0F};
+    element->arranged_rect = (SDL_FRect){0.0F, 0.0F, 0.0F, 0.0F};
+    element->sibling_index = 0U;
+    element->handle_index = 0U;
+}
+
+bool ui_element_find_sibling(ui_element *const *siblings, size_t count, const ui_element *element,
+                             size_t *out_index)
+{
+    if (siblings == NULL || element == NULL || element->sibling_index >= count ||
+        siblings[element->sibling_index] != element)
+    {
+        return false;
+    }
+
+    if (out_index != NULL)
+    {
+        *out_index = element->sibling_index;
+    }
+    return true;
+}
+
+bool ui_element_should_compact_siblings(size_t hole_count, size_t count)
+{
+    // Each compaction pass is paid for by at least count / 2 removals.
+    return hole_count > 0U && hole_count * 2U >= count;
+}
+
+size_t ui_element_compact_siblings(ui_element **siblings, size_t count)
+{
+    size_t kept = 0U;
+    for (size_t i = 0U; i < count; ++i)
+    {
+        ui_element *element = siblings[i];
+        if (element == NULL)
+        {
+            continue;
+        }
+        element->sibling_index = kept;
+        siblings[kept++] = element;
+    }
+
+    for (size_t i = kept; i < count; ++i)
+    {
+        siblings[i] = NULL;
+    }
+    return kept;
+}
+
+void ui_element_invalidate_measure(ui_element *element)
+{
+    // Walk the full chain instead of stopping at the first dirty ancestor:
+    // hidden or externally-owned children can stay dirty after their parent
+    // was cleaned, so a dirty node does not imply dirty ancestors.
+    for (ui_element *cursor = element; cursor != NULL; cursor = cursor->parent)
+    {
+        cursor->needs_measure = true;
+        cursor->needs_arrange = true;
+    }
+    ui_element_invalidate_render(element);
+}
+
+void ui_element_invalidate_arrange(ui_element *element)
+{
+    for (ui_element *cursor = element; cursor != NULL; cursor = cursor->parent)
+    {
+        cursor->needs_arrange = true;
+    }
+    ui_element_invalidate_render(element);
+}
+
+bool ui_element_needs_layout(const ui_element *element)
+{
+    return element != NULL && (element->needs_measure || element->needs_arrange);
+}
+
+float ui_element_next_frame_delay(const ui_element *element)
+{
+    if (element == NULL || element->ops == NULL || !element->visible || !element->enabled ||
+        element->ops->next_frame_delay == NULL)
+    {
+        return UI_NO_FRAME_REQUEST;
+    }
+
+    const float delay = element->ops->next_frame_delay(element);
+    return delay < 0.0F ? UI_NO_FRAME_REQUEST : delay;
+}
+
+float ui_element_earliest_frame_delay(float a, float b)
+{
+    if (a < 0.0F)
+    {
+        return b;
+    }
+    if (b < 0.0F)
+    {
+        return a;
+    }
+    return a < b ? a : b;
+}
+
+void ui_element_update_hover(ui_element *element, const SDL_FPoint *point)
+{
+    if (element == NULL || element->ops == NULL || element->ops->update_hover == NULL)
+    {
+        return;
+    }
+
+    element->ops->update_hover(element, point);
+}
+
+void ui_element_set_hovered_child(ui_element **hovered_child, ui_element *next,
+                                  const SDL_FPoint *point)
+{
+    if (hovered_child == NULL)
+    {
+        return;
+    }
+
+    if (*hovered_child != next)
+    {
+        ui_element *previous = *hovered_child;
+        *hovered_child = NULL;
+        ui_element_update_hover(previous, NULL);
+        *hovered_child = next;
+    }
+
+    ui_element_update_hover(next, point);
+}
+
+void ui_element_set_visible(ui_element *element, bool visible)
+{
+    if (element == NULL || element->visible == visible)
+    {
+        return;
+    }
+
+    element->visible = visible;
+    ui_element_invalidate_render(element);
+    if (visible)
+    {
+        ui_element_invalidate_measure(element);
+    }
+}
+
+static bool are_rects_equal(const SDL_FRect *a, const SDL_FRect *b)
+{
+    return a->x == b->x && a->y == b->y && a->w == b->w && a->h == b->h;
+}
+
+void ui_element_invalidate_screen_rects(void)
+{
+    ++screen_rect_epoch;
+    ++screen_rect_generation;
+    ++render_generation;
+}
+
+void ui_element_invalidate_subtree_screen_rects(ui_element *element)
+{
+    if (element == NULL)
+    {
+        return;
+    }
+
+    ui_traversal_invalidate_screen_rects(element);
+    ++screen_rect_generation;
+    ++render_generation;
+}
+
+/*
+ * True when the element holds a screen rect from the current epoch that was
+ * computed from a different rect, i.e. rect was written after the lookup.
+ */
+static bool has_moved_since_cached(const ui_element *element)
+{
+    return element->screen_rect_generation == screen_rect_epoch &&
+           !are_rects_equal(&element->rect, &element->screen_rect_source);
+}
+
+void ui_element_sync_screen_rect(ui_element *element)
+{
+    if (element != NULL && has_moved_since_cached(element))
+    {
+        ui_element_invalidate_subtree_screen_rects(element);
+    }
+}
+
+void ui_element_invalidate_render(const ui_element *element)
+{
+    (void)element;
+    ++render_generation;
+}
+
+Uint64 ui_element_screen_rect_generation(void) { return screen_rect_generation; }
+
+Uint64 ui_element_render_generation(void) { return render_generation; }
+
 void ui_element_measure(ui_element *element, const SDL_FRect *available_rect)
 {
-    (void)available_rect;
+    if (element == NULL || element->ops == NULL || !element->visible)
+    {
+        return;
+    }
 
-    if (element == NULL || element->ops == NULL)
+    // The rect may legitimately differ from the measured size when the last
+    // arrange pass stretched it; that still counts as untouched.
+    const bool rect_untouched =
+        (element->rect.w == element->measured_w && element->rect.h == element->measured_h) ||
+        are_rects_equal(&element->rect, &element->arranged_rect);
+    if (!element->needs_measure && available_rect != NULL &&
+        available_rect->w == element->measure_available_w &&
+        available_rect->h == element->measure_available_h && rect_untouched)
     {
         return;
     }
 
     if (element->ops->measure != NULL)
     {
+        UI_OPS_PROFILE_ENTER(scope, element->ops, UI_OPS_CALL_MEASURE);
         element->ops->measure(element, available_rect);
+        UI_OPS_PROFILE_LEAVE(scope);
     }
+
+    element->needs_measure = false;
+    element->measure_available_w = available_rect != NULL ? available_rect->w : -1.0F;
+    element->measure_available_h = available_rect != NULL ? available_rect->h : -1.0F;
+    element->measured_w = element->rect.w;
+    element->measured_h = element->rect.h;
 }
 
 void ui_element_arrange(ui_element *element, const SDL_FRect *final_rect)
 {
-    if (element == NULL || element->ops == NULL || final_rect == NULL)
+    if (element == NULL || element->ops == NULL || final_rect == NULL || !element->visible)
+    {
+        return;
+    }
+
+    if (!element->needs_arrange && are_rects_equal(final_rect, &element->arrange_final_rect) &&
+        are_rects_equal(&element->rect, &element->arranged_rect))
     {
         return;
     }
 
     if (element->ops->arrange != NULL)
     {
+        UI_OPS_PROFILE_ENTER(scope, element->ops, UI_OPS_CALL_ARRANGE);
         element->ops->arrange(element, final_rect);
-        return;
+        UI_OPS_PROFILE_LEAVE(scope);
+    }
+    else
+    {
+        element->rect = *final_rect;
     }
 
-    element->rect = *final_rect;
+    element->needs_arrange = false;
+    element->arrange_final_rect = *final_rect;
+    element->arranged_rect = element->rect;
+    ui_element_sync_screen_rect(element);
 }
 
 void ui_element_set_border(ui_element *element, const SDL_Color *border_color, float width)
@@ -49,6 +308,7 @@ void ui_element_set_border(ui_element *element, const SDL_Color *border_color, f
     element->has_border = true;
     element->border_color = *border_color;
     element->border_width = width >= 1.0F ? width : 1.0F;
+    ui_element_invalidate_render(element);
 }
 
 void ui_element_clear_border(ui_element *element)
@@ -61,6 +321,7 @@ void ui_element_clear_border(ui_element *element)
     element->has_border = false;
     element->border_color = (SDL_Color){0, 0, 0, 0};
     element->border_width = 0.0F;
+    ui_element_invalidate_render(element);
 }
 
 void ui_element_render_inner_border(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color,
@@ -78,8 +339,6 @@ void ui_element_render_inner_border(SDL_Renderer *renderer, const SDL_FRect *rec
         return;
     }
 
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-
     const SDL_FRect top = {rect->x, rect->y, rect->w, clamped_width};
     const SDL_FRect bottom = {rect->x, rect->y + rect->h - clamped_width, rect->w, clamped_width};
     const SDL_FRect left = {rect->x, rect->y + clamped_width, clamped_width,
@@ -87,15 +346,15 @@ void ui_element_render_inner_border(SDL_Renderer *renderer, const SDL_FRect *rec
     const SDL_FRect right = {rect->x + rect->w - clamped_width, rect->y + clamped_width,
                              clamped_width, rect->h - (2.0F * clamped_width)};
 
-    SDL_RenderFillRect(renderer, &top);
-    SDL_RenderFillRect(renderer, &bottom);
+    ui_render_fill_rect(renderer, &top, color);
+    ui_render_fill_rect(renderer, &bottom, color);
     if (left.h > 0.0F)
     {
-        SDL_RenderFillRect(renderer, &left);
+        ui_render_fill_rect(renderer, &left, color);
     }
     if (right.h > 0.0F)
     {
-        SDL_RenderFillRect(renderer, &right);
+        ui_render_fill_rect(renderer, &right, color);
     }
 }
 
@@ -106,15 +365,34 @@ static SDL_FRect compute_screen_rect(const ui_element *element, size_t depth)
         return (SDL_FRect){0.0F, 0.0F, 0.0F, 0.0F};
     }
 
-    static const size_t MAX_PARENT_CHAIN_DEPTH = 256U;
-    if (depth > MAX_PARENT_CHAIN_DEPTH)
+    /*
+     * Elements are always heap-allocated as mutable objects; the const in the
+     * public signature only promises that observable layout is not changed.
+     */
+    ui_element *cached = (ui_element *)element;
+    if (element->screen_rect_generation == screen_rect_epoch)
     {
-        return (SDL_FRect){0.0F, 0.0F, element->rect.w, element->rect.h};
+        if (are_rects_equal(&element->rect, &element->screen_rect_source))
+        {
+            return element->screen_rect_cache;
+        }
+        // Written directly since the lookup: descendants were resolved from
+        // the old rect too.
+        ui_element_invalidate_subtree_screen_rects(cached);
     }
 
     if (element->parent == NULL)
     {
-        return element->rect;
+        cached->screen_rect_cache = element->rect;
+        cached->screen_rect_source = element->rect;
+        cached->screen_rect_generation = screen_rect_epoch;
+        return cached->screen_rect_cache;
+    }
+
+    static const size_t MAX_PARENT_CHAIN_DEPTH = 256U;
+    if (depth > MAX_PARENT_CHAIN_DEPTH)
+    {
+        return (SDL_FRect){0.0F, 0.0F, element->rect.w, element->rect.h};
     }
 
     const SDL_FRect parent_sr = compute_screen_rect(element->parent, depth + 1U);
@@ -147,7 +425,10 @@ static SDL_FRect compute_screen_rect(const ui_element *element, size_t depth)
         break;
     }
 
-    return (SDL_FRect){abs_x, abs_y, element->rect.w, element->rect.h};
+    cached->screen_rect_cache = (SDL_FRect){abs_x, abs_y, element->rect.w, element->rect.h};
+    cached->screen_rect_source = element->rect;
+    cached->screen_rect_generation = screen_rect_epoch;
+    return cached->screen_rect_cache;
 }
 
 SDL_FRect ui_element_screen_rect(const ui_element *element)
@@ -1,15 +1,22 @@
 #include "ui/ui_fps_counter.h"
 
+#include "system/ui_render.h"
+
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
-static const float DEBUG_GLYPH_WIDTH = 8.0F;
-static const float DEBUG_GLYPH_HEIGHT = 8.0F;
-
-static void format_fps_label(ui_fps_counter *counter)
+static bool format_fps_label(ui_fps_counter *counter)
 {
-    snprintf(counter->label, sizeof(counter->label), "FPS: %.1f", counter->displayed_fps);
+    char label[sizeof(counter->label)];
+    snprintf(label, sizeof(label), "FPS: %.1f", counter->displayed_fps);
+    if (strcmp(label, counter->label) == 0)
+    {
+        return false;
+    }
+
+    memcpy(counter->label, label, sizeof(label));
+    ui_text_run_set(&counter->label_run, counter->label);
+    return true;
 }
 
 static void update_counter_layout(ui_fps_counter *counter)
@@ -21,10 +28,10 @@ static void update_counter_layout(ui_fps_counter *counter)
 
     if (counter->base.parent == NULL)
     {
-        const float label_width = (float)strlen(counter->label) * DEBUG_GLYPH_WIDTH;
-        counter->base.rect.x = (float)counter->viewport_width - counter->padding - label_width;
+        counter->base.rect.x =
+            (float)counter->viewport_width - counter->padding - counter->label_run.width;
         counter->base.rect.y =
-            (float)counter->viewport_height - counter->padding - DEBUG_GLYPH_HEIGHT;
+            (float)counter->viewport_height - counter->padding - counter->label_run.height;
     }
     else
     {
@@ -43,8 +50,8 @@ static void measure_fps_counter(ui_element *element, const SDL_FRect *available_
         return;
     }
 
-    counter->base.rect.w = (float)strlen(counter->label) * DEBUG_GLYPH_WIDTH;
-    counter->base.rect.h = DEBUG_GLYPH_HEIGHT;
+    counter->base.rect.w = counter->label_run.width;
+    counter->base.rect.h = counter->label_run.height;
     update_counter_layout(counter);
 }
 
@@ -76,16 +83,30 @@ static void update_fps_counter(ui_element *element, float delta_seconds)
     counter->elapsed_seconds += delta_seconds;
     counter->frame_count += 1;
 
-    if (counter->elapsed_seconds >= counter->update_interval_seconds &&
-        counter->elapsed_seconds > 0.0F)
+    if (counter->elapsed_seconds < counter->update_interval_seconds ||
+        counter->elapsed_seconds <= 0.0F)
     {
-        counter->displayed_fps = (float)counter->frame_count / counter->elapsed_seconds;
-        counter->elapsed_seconds = 0.0F;
-        counter->frame_count = 0;
+        return;
     }
 
-    format_fps_label(counter);
-    measure_fps_counter(element, &counter->base.rect);
+    counter->displayed_fps = (float)counter->frame_count / counter->elapsed_seconds;
+    counter->elapsed_seconds = 0.0F;
+    counter->frame_count = 0;
+
+    // The label only changes with displayed_fps, so it is formatted and
+    // measured once per interval rather than every frame.
+    if (format_fps_label(counter))
+    {
+        measure_fps_counter(element, &counter->base.rect);
+        ui_element_invalidate_subtree_screen_rects(element);
+    }
+}
+
+static float next_fps_counter_frame_delay(const ui_element *element)
+{
+    const ui_fps_counter *counter = (const ui_fps_counter *)element;
+    const float remaining = counter->update_interval_seconds - counter->elapsed_seconds;
+    return remaining > 0.0F ? remaining : 0.0F;
 }
 
 static void render_fps_counter(const ui_element *element, SDL_Renderer *renderer)
@@ -93,9 +114,7 @@ static void render_fps_counter(const ui_element *element, SDL_Renderer *renderer
     const ui_fps_counter *counter = (const ui_fps_counter *)element;
     const SDL_FRect sr = ui_element_screen_rect(element);
 
-    SDL_SetRenderDrawColor(renderer, counter->color.r, counter->color.g, counter->color.b,
-                           counter->color.a);
-    SDL_RenderDebugText(renderer, sr.x, sr.y, counter->label);
+    ui_render_debug_text(renderer, sr.x, sr.y, counter->label_run.text, counter->color);
     if (counter->base.has_border)
     {
         ui_element_render_inner_border(renderer, &sr, counter->base.border_color,
@@ -103,40 +122,48 @@ static void render_fps_counter(const ui_element *element, SDL_Renderer *renderer
     }
 }
 
-static void destroy_fps_counter(ui_element *element) { free(element); }
+static void destroy_fps_counter(ui_element *element)
+{
+    cui_free(element->allocator, element, sizeof(ui_fps_counter));
+}
 
 static const ui_element_ops FPS_COUNTER_OPS = {
+    .type_name = "fps_counter",
     .measure = measure_fps_counter,
     .arrange = arrange_fps_counter,
     .handle_event = handle_fps_counter_event,
     .update = update_fps_counter,
+    .next_frame_delay = next_fps_counter_frame_delay,
     .render = render_fps_counter,
     .destroy = destroy_fps_counter,
 };
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-ui_fps_counter *ui_fps_counter_create(int viewport_width, int viewport_height, float padding,
-                                      SDL_Color color, const SDL_Color *border_color)
+ui_fps_counter *ui_fps_counter_create(const cui_allocator *allocator, int viewport_width,
+                                      int viewport_height, float padding, SDL_Color color,
+                                      const SDL_Color *border_color)
 {
     if (viewport_width <= 0 || viewport_height <= 0)
     {
         return NULL;
     }
 
-    ui_fps_counter *counter = malloc(sizeof(*counter));
+    ui_fps_counter *counter = cui_alloc(allocator, sizeof(*counter));
     if (counter == NULL)
     {
         return NULL;
     }
 
-    counter->base.rect = (SDL_FRect){0.0F, 0.0F, 0.0F, DEBUG_GLYPH_HEIGHT};
+    counter->base.rect = (SDL_FRect){0.0F, 0.0F, 0.0F, UI_TEXT_GLYPH_HEIGHT};
     counter->base.ops = &FPS_COUNTER_OPS;
+    counter->base.allocator = allocator;
     counter->base.visible = true;
     counter->base.enabled = true;
     counter->base.parent = NULL;
     counter->base.align_h = UI_ALIGN_RIGHT;
     counter->base.align_v = UI_ALIGN_BOTTOM;
     ui_element_set_border(&counter->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&counter->base);
     counter->color = color;
     counter->viewport_width = viewport_width;
     counter->viewport_height = viewport_height;
@@ -145,7 +172,9 @@ ui_fps_counter *ui_fps_counter_create(int viewport_width, int viewport_height, f
     counter->frame_count = 0;
     counter->displayed_fps = 0.0F;
     counter->padding = padding;
-    format_fps_label(counter);
+    counter->label[0] = '\0';
+    ui_text_run_set(&counter->label_run, counter->label);
+    (void)format_fps_label(counter);
     measure_fps_counter(&counter->base, &counter->base.rect);
 
     return counter;
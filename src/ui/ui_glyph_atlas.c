@@ -0,0 +1,119 @@
+#include "ui/ui_glyph_atlas.h"
+
+#define ATLAS_COLUMNS 16
+// 256 Latin-1 cells plus one fallback cell for every other codepoint.
+#define ATLAS_CELL_COUNT 257
+#define ATLAS_ROWS ((ATLAS_CELL_COUNT + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS)
+#define ATLAS_WIDTH (ATLAS_COLUMNS * UI_GLYPH_ATLAS_CELL_SIZE)
+#define ATLAS_HEIGHT (ATLAS_ROWS * UI_GLYPH_ATLAS_CELL_SIZE)
+
+static const Uint32 FALLBACK_CELL = 256U;
+static const Uint32 FALLBACK_CODEPOINT = 0xFFFDU;
+static const char *const ATLAS_PROPERTY = "cui.glyph_atlas";
+static const char *const ATLAS_FAILED_PROPERTY = "cui.glyph_atlas.failed";
+
+static Uint32 cell_for_codepoint(Uint32 codepoint)
+{
+    return codepoint < FALLBACK_CELL ? codepoint : FALLBACK_CELL;
+}
+
+static void rasterize_cells(SDL_Renderer *renderer)
+{
+    for (Uint32 cell = 1U; cell < ATLAS_CELL_COUNT; ++cell)
+    {
+        // Cell 0 stays blank: NUL terminates strings and never reaches the atlas.
+        char utf8[5] = {0};
+        const Uint32 codepoint = cell == FALLBACK_CELL ? FALLBACK_CODEPOINT : cell;
+        (void)SDL_UCS4ToUTF8(codepoint, utf8);
+
+        const float x = (float)((cell % ATLAS_COLUMNS) * UI_GLYPH_ATLAS_CELL_SIZE);
+        const float y = (float)((cell / ATLAS_COLUMNS) * UI_GLYPH_ATLAS_CELL_SIZE);
+        SDL_RenderDebugText(renderer, x, y, utf8);
+    }
+}
+
+static SDL_Texture *build_atlas(SDL_Renderer *renderer)
+{
+    SDL_Texture *target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                            SDL_TEXTUREACCESS_TARGET, ATLAS_WIDTH, ATLAS_HEIGHT);
+    if (target == NULL)
+    {
+        return NULL;
+    }
+
+    // Every target keeps its own viewport and clip, so only the target, draw
+    // color and blend mode need restoring.
+    SDL_Texture *previous_target = SDL_GetRenderTarget(renderer);
+    Uint8 r = 0U;
+    Uint8 g = 0U;
+    Uint8 b = 0U;
+    Uint8 a = 0U;
+    SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blend_mode);
+
+    SDL_Surface *pixels = NULL;
+    if (SDL_SetRenderTarget(renderer, target))
+    {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 0);
+        SDL_RenderClear(renderer);
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        rasterize_cells(renderer);
+        pixels = SDL_RenderReadPixels(renderer, NULL);
+    }
+
+    SDL_SetRenderTarget(renderer, previous_target);
+    SDL_SetRenderDrawBlendMode(renderer, blend_mode);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_DestroyTexture(target);
+    if (pixels == NULL)
+    {
+        return NULL;
+    }
+
+    SDL_Texture *atlas = SDL_CreateTextureFromSurface(renderer, pixels);
+    SDL_DestroySurface(pixels);
+    if (atlas == NULL)
+    {
+        return NULL;
+    }
+
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(atlas, SDL_SCALEMODE_NEAREST);
+    return atlas;
+}
+
+SDL_Texture *ui_glyph_atlas_get(SDL_Renderer *renderer)
+{
+    if (renderer == NULL)
+    {
+        return NULL;
+    }
+
+    const SDL_PropertiesID properties = SDL_GetRendererProperties(renderer);
+    SDL_Texture *atlas = SDL_GetPointerProperty(properties, ATLAS_PROPERTY, NULL);
+    if (atlas != NULL || SDL_GetBooleanProperty(properties, ATLAS_FAILED_PROPERTY, false))
+    {
+        return atlas;
+    }
+
+    atlas = build_atlas(renderer);
+    if (atlas == NULL)
+    {
+        SDL_SetBooleanProperty(properties, ATLAS_FAILED_PROPERTY, true);
+        return NULL;
+    }
+
+    SDL_SetPointerProperty(properties, ATLAS_PROPERTY, atlas);
+    return atlas;
+}
+
+SDL_FRect ui_glyph_atlas_uv(Uint32 codepoint)
+{
+    const Uint32 cell = cell_for_codepoint(codepoint);
+    const float cell_w = (float)UI_GLYPH_ATLAS_CELL_SIZE / (float)ATLAS_WIDTH;
+    const float cell_h = (float)UI_GLYPH_ATLAS_CELL_SIZE / (float)ATLAS_HEIGHT;
+    return (SDL_FRect){(float)(cell % ATLAS_COLUMNS) * cell_w,
+                       (float)(cell / ATLAS_COLUMNS) * cell_h, cell_w, cell_h};
+}
@@ -1,6 +1,6 @@
 #include "ui/ui_hrule.h"
 
-#include <stdlib.h>
+#include "system/ui_render.h"
 
 static bool handle_hrule_event(ui_element *element, const SDL_Event *event)
 {
@@ -56,13 +56,16 @@ static void render_hrule(const ui_element *element, SDL_Renderer *renderer)
         1.0F,
     };
 
-    SDL_SetRenderDrawColor(renderer, rule->color.r, rule->color.g, rule->color.b, rule->color.a);
-    SDL_RenderFillRect(renderer, &line_rect);
+    ui_render_fill_rect(renderer, &line_rect, rule->color);
 }
 
-static void destroy_hrule(ui_element *element) { free(element); }
+static void destroy_hrule(ui_element *element)
+{
+    cui_free(element->allocator, element, sizeof(ui_hrule));
+}
 
 static const ui_element_ops HRULE_OPS = {
+    .type_name = "hrule",
     .measure = measure_hrule,
     .arrange = arrange_hrule,
     .handle_event = handle_hrule_event,
@@ -71,9 +74,10 @@ static const ui_element_ops HRULE_OPS = {
     .destroy = destroy_hrule,
 };
 
-ui_hrule *ui_hrule_create(float thickness, SDL_Color color, float inset_fraction)
+ui_hrule *ui_hrule_create(const cui_allocator *allocator, float thickness, SDL_Color color,
+                          float inset_fraction)
 {
-    ui_hrule *rule = malloc(sizeof(*rule));
+    ui_hrule *rule = cui_alloc(allocator, sizeof(*rule));
     if (rule == NULL)
     {
         return NULL;
@@ -81,12 +85,14 @@ ui_hrule *ui_hrule_create(float thickness, SDL_Color color, float inset_fraction
 
     rule->base.rect = (SDL_FRect){0.0F, 0.0F, 0.0F, thickness};
     rule->base.ops = &HRULE_OPS;
+    rule->base.allocator = allocator;
     rule->base.visible = true;
     rule->base.enabled = true;
     rule->base.parent = NULL;
     rule->base.align_h = UI_ALIGN_LEFT;
     rule->base.align_v = UI_ALIGN_TOP;
     ui_element_clear_border(&rule->base);
+    ui_element_reset_layout_cache(&rule->base);
     rule->color = color;
     rule->inset_fraction = inset_fraction;
 
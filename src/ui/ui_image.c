@@ -1,7 +1,8 @@
 #include "ui/ui_image.h"
 
+#include "system/ui_render.h"
+
 #include <SDL3_image/SDL_image.h>
-#include <stdlib.h>
 
 static const char *MISSING_IMAGE_ASSET_PATH = "assets/missing-image.png";
 
@@ -9,7 +10,7 @@ static void render_image(const ui_element *element, SDL_Renderer *renderer)
 {
     const ui_image *image = (const ui_image *)element;
     const SDL_FRect sr = ui_element_screen_rect(element);
-    SDL_RenderTexture(renderer, image->texture, NULL, &sr);
+    ui_render_texture(renderer, image->texture, &sr);
     if (image->base.has_border)
     {
         ui_element_render_inner_border(renderer, &sr, image->base.border_color,
@@ -24,18 +25,19 @@ static void destroy_image(ui_element *element)
     {
         SDL_DestroyTexture(image->texture);
     }
-    free(image);
+    cui_free(element->allocator, image, sizeof(*image));
 }
 
 static const ui_element_ops IMAGE_OPS = {
+    .type_name = "image",
     .handle_event = NULL,
     .update = NULL,
     .render = render_image,
     .destroy = destroy_image,
 };
 
-ui_image *ui_image_create(SDL_Renderer *renderer, float x, float y, float w, float h,
-                          const char *file_path, const SDL_Color *border_color)
+ui_image *ui_image_create(const cui_allocator *allocator, SDL_Renderer *renderer, float x, float y,
+                          float w, float h, const char *file_path, const SDL_Color *border_color)
 {
     if (renderer == NULL)
     {
@@ -68,7 +70,7 @@ ui_image *ui_image_create(SDL_Renderer *renderer, float x, float y, float w, flo
         return NULL;
     }
 
-    ui_image *image = malloc(sizeof(*image));
+    ui_image *image = cui_alloc(allocator, sizeof(*image));
     if (image == NULL)
     {
         SDL_DestroyTexture(texture);
@@ -77,12 +79,14 @@ ui_image *ui_image_create(SDL_Renderer *renderer, float x, float y, float w, flo
 
     image->base.rect = (SDL_FRect){x, y, w, h};
     image->base.ops = &IMAGE_OPS;
+    image->base.allocator = allocator;
     image->base.visible = true;
     image->base.enabled = false;
     image->base.parent = NULL;
     image->base.align_h = UI_ALIGN_LEFT;
     image->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&image->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&image->base);
     image->texture = texture;
 
     return image;
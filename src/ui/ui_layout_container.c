@@ -1,6 +1,7 @@
 #include "ui/ui_layout_container.h"
 
-#include <stdlib.h>
+#include "system/ui_ops_profiler.h"
+#include "system/ui_traversal.h"
 
 static const float DEFAULT_LAYOUT_PADDING = 8.0F;
 static const float DEFAULT_LAYOUT_SPACING = 8.0F;
@@ -94,7 +95,7 @@ static void set_focused_child(ui_layout_container *container, ui_element *child)
     }
 }
 
-static ui_element *find_top_focusable_child_at(const ui_layout_container *container,
+static ui_element *find_top_focusable_child_at(ui_layout_container *container,
                                                const SDL_FPoint *point)
 {
     if (container == NULL || point == NULL)
@@ -102,9 +103,13 @@ static ui_element *find_top_focusable_child_at(const ui_layout_container *contai
         return NULL;
     }
 
-    for (size_t i = container->child_count; i > 0U; --i)
+    ui_spatial_cursor cursor;
+    ui_spatial_index_query(&container->hit_index, container->children, container->child_count,
+                           point, &cursor);
+    size_t i = 0U;
+    while (ui_spatial_cursor_next(&cursor, &i))
     {
-        ui_element *child = container->children[i - 1U];
+        ui_element *child = container->children[i];
         if (!is_focusable_element(child))
         {
             continue;
@@ -119,6 +124,71 @@ static ui_element *find_top_focusable_child_at(const ui_layout_container *contai
     return NULL;
 }
 
+static ui_element *find_top_hoverable_child_at(ui_layout_container *container,
+                                               const SDL_FPoint *point)
+{
+    ui_spatial_cursor cursor;
+    ui_spatial_index_query(&container->hit_index, container->children, container->child_count,
+                           point, &cursor);
+    size_t i = 0U;
+    while (ui_spatial_cursor_next(&cursor, &i))
+    {
+        ui_element *child = container->children[i];
+        if (is_valid_element(child) && child->enabled && hit_test_element(child, point))
+        {
+            return child;
+        }
+    }
+
+    return NULL;
+}
+
+static bool dispatch_to_child(ui_element *child, const SDL_Event *event)
+{
+    if (!is_valid_element(child) || !child->enabled || child->ops->handle_event == NULL)
+    {
+        return false;
+    }
+
+    UI_OPS_PROFILE_ENTER(scope, child->ops, UI_OPS_CALL_HANDLE_EVENT);
+    const bool handled = child->ops->handle_event(child, event);
+    UI_OPS_PROFILE_LEAVE(scope);
+    return handled;
+}
+
+/*
+ * Offer a pointer event to the topmost children under point until one handles
+ * it, reporting the handler through a handle taken before dispatch.
+ */
+static bool dispatch_pointer_to_top_child(ui_layout_container *container, const SDL_Event *event,
+                                          const SDL_FPoint *point, ui_handle *out_handled)
+{
+    ui_spatial_cursor cursor;
+    ui_spatial_index_query(&container->hit_index, container->children, container->child_count,
+                           point, &cursor);
+    size_t i = 0U;
+    while (ui_spatial_cursor_next(&cursor, &i))
+    {
+        ui_element *child = container->children[i];
+        if (!hit_test_element(child, point))
+        {
+            continue;
+        }
+
+        const ui_handle handle = ui_handle_acquire(child);
+        if (dispatch_to_child(child, event))
+        {
+            if (out_handled != NULL)
+            {
+                *out_handled = handle;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
 static bool would_create_parent_cycle(const ui_element *child, const ui_element *new_parent)
 {
     if (child == NULL || new_parent == NULL)
@@ -301,23 +371,46 @@ static bool handle_layout_container_event(ui_element *element, const SDL_Event *
         return false;
     }
 
-    if (is_pointer_press_event(event))
+    SDL_FPoint point = {0.0F, 0.0F};
+    if (get_pointer_position(event, &point))
     {
-        SDL_FPoint point = {0.0F, 0.0F};
-        if (get_pointer_position(event, &point))
+        if (is_pointer_press_event(event))
         {
             set_focused_child(container, find_top_focusable_child_at(container, &point));
+            const ui_handle self = ui_handle_acquire(element);
+            ui_handle handled = UI_HANDLE_NULL;
+            const bool consumed =
+                dispatch_pointer_to_top_child(container, event, &point, &handled);
+            // A row's own callback may have destroyed this container already.
+            if (ui_handle_resolve(self) == element)
+            {
+                container->captured_child = handled;
+            }
+            return consumed;
+        }
+
+        if (event->type == SDL_EVENT_MOUSE_MOTION &&
+            dispatch_to_child(ui_handle_resolve(container->captured_child), event))
+        {
+            return true;
+        }
+
+        if (event->type == SDL_EVENT_MOUSE_BUTTON_UP && event->button.button == SDL_BUTTON_LEFT)
+        {
+            ui_element *captured = ui_handle_resolve(container->captured_child);
+            container->captured_child = UI_HANDLE_NULL;
+            if (dispatch_to_child(captured, event))
+            {
+                return true;
+            }
         }
+
+        return dispatch_pointer_to_top_child(container, event, &point, NULL);
     }
 
     for (size_t i = container->child_count; i > 0U; --i)
     {
-        ui_element *child = container->children[i - 1U];
-        if (!is_valid_element(child) || !child->enabled || child->ops->handle_event == NULL)
-        {
-            continue;
-        }
-        if (child->ops->handle_event(child, event))
+        if (dispatch_to_child(container->children[i - 1U], event))
         {
             return true;
         }
@@ -356,7 +449,7 @@ static void set_layout_container_focus(ui_element *element, bool focused)
     set_focused_child(container, NULL);
 }
 
-static void update_layout_container(ui_element *element, float delta_seconds)
+static void update_layout_container_hover(ui_element *element, const SDL_FPoint *point)
 {
     ui_layout_container *container = (ui_layout_container *)element;
     if (container == NULL)
@@ -364,31 +457,21 @@ static void update_layout_container(ui_element *element, float delta_seconds)
         return;
     }
 
-    for (size_t i = 0; i < container->child_count; ++i)
-    {
-        ui_element *child = container->children[i];
-        if (!is_valid_element(child) || !child->enabled || child->ops->update == NULL)
-        {
-            continue;
-        }
-        child->ops->update(child, delta_seconds);
-    }
+    ui_element *next = point != NULL ? find_top_hoverable_child_at(container, point) : NULL;
+    ui_element_set_hovered_child(&container->hovered_child, next, point);
 }
 
-static void render_layout_container(const ui_element *element, SDL_Renderer *renderer)
+static size_t get_layout_container_children(const ui_element *element,
+                                            ui_element *const **out_children)
 {
     const ui_layout_container *container = (const ui_layout_container *)element;
+    *out_children = container->children;
+    return container->child_count;
+}
 
-    for (size_t i = 0; i < container->child_count; ++i)
-    {
-        const ui_element *child = container->children[i];
-        if (!is_valid_element(child) || !child->visible || child->ops->render == NULL)
-        {
-            continue;
-        }
-        child->ops->render(child, renderer);
-    }
-
+static void finish_layout_container_render(const ui_element *element, SDL_Renderer *renderer)
+{
+    const ui_layout_container *container = (const ui_layout_container *)element;
     if (container->base.has_border)
     {
         const SDL_FRect sr = ui_element_screen_rect(element);
@@ -401,31 +484,27 @@ static void destroy_layout_container(ui_element *element)
 {
     ui_layout_container *container = (ui_layout_container *)element;
 
-    for (size_t i = 0; i < container->child_count; ++i)
-    {
-        ui_element *child = container->children[i];
-        if (is_valid_element(child) && child->ops->destroy != NULL)
-        {
-            child->ops->destroy(child);
-        }
-    }
-
-    free((void *)container->children);
-    free(container);
+    cui_free(element->allocator, (void *)container->children,
+             container->child_capacity * sizeof(ui_element *));
+    ui_spatial_index_destroy(&container->hit_index);
+    cui_free(element->allocator, container, sizeof(*container));
 }
 
 static const ui_element_ops LAYOUT_CONTAINER_OPS = {
+    .type_name = "layout_container",
     .measure = measure_layout_container,
     .arrange = arrange_layout_container,
     .handle_event = handle_layout_container_event,
     .can_focus = can_focus_layout_container,
     .set_focus = set_layout_container_focus,
-    .update = update_layout_container,
-    .render = render_layout_container,
+    .update_hover = update_layout_container_hover,
+    .child_span = get_layout_container_children,
+    .finish_render = finish_layout_container_render,
     .destroy = destroy_layout_container,
 };
 
-ui_layout_container *ui_layout_container_create(const SDL_FRect *rect, ui_layout_axis axis,
+ui_layout_container *ui_layout_container_create(const cui_allocator *allocator,
+                                                const SDL_FRect *rect, ui_layout_axis axis,
                                                 const SDL_Color *border_color)
 {
     if (rect == NULL)
@@ -433,7 +512,7 @@ ui_layout_container *ui_layout_container_create(const SDL_FRect *rect, ui_layout
         return NULL;
     }
 
-    ui_layout_container *container = malloc(sizeof(*container));
+    ui_layout_container *container = cui_alloc(allocator, sizeof(*container));
     if (container == NULL)
     {
         return NULL;
@@ -441,17 +520,23 @@ ui_layout_container *ui_layout_container_create(const SDL_FRect *rect, ui_layout
 
     container->base.rect = *rect;
     container->base.ops = &LAYOUT_CONTAINER_OPS;
+    container->base.allocator = allocator;
     container->base.visible = true;
     container->base.enabled = true;
     container->base.parent = NULL;
     container->base.align_h = UI_ALIGN_LEFT;
     container->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&container->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&container->base);
     container->axis = axis;
     container->children = NULL;
     container->child_count = 0;
     container->child_capacity = 0;
+    container->hole_count = 0;
     container->focused_child = NULL;
+    container->captured_child = UI_HANDLE_NULL;
+    container->hovered_child = NULL;
+    ui_spatial_index_init(&container->hit_index);
 
     return container;
 }
@@ -476,8 +561,9 @@ bool ui_layout_container_add_child(ui_layout_container *container, ui_element *c
     if (container->child_count == container->child_capacity)
     {
         size_t new_capacity = container->child_capacity == 0 ? 8U : container->child_capacity * 2U;
-        ui_element **new_children = (ui_element **)realloc((void *)container->children,
-                                                           new_capacity * sizeof(ui_element *));
+        ui_element **new_children = (ui_element **)cui_realloc(
+            container->base.allocator, (void *)container->children,
+            container->child_capacity * sizeof(ui_element *), new_capacity * sizeof(ui_element *));
         if (new_children == NULL)
         {
             return false;
@@ -487,48 +573,113 @@ bool ui_layout_container_add_child(ui_layout_container *container, ui_element *c
     }
 
     child->parent = &container->base;
+    ui_element_invalidate_subtree_screen_rects(child);
+    child->sibling_index = container->child_count;
     container->children[container->child_count++] = child;
+    ui_spatial_index_invalidate(&container->hit_index);
+    ui_element_invalidate_measure(&container->base);
     return true;
 }
 
+/*
+ * Detach the child in slot index, leaving a NULL hole behind.
+ */
+static void detach_child(ui_layout_container *container, size_t index, bool destroy_child)
+{
+    ui_element *child = container->children[index];
+    if (container->hovered_child == child)
+    {
+        ui_element_set_hovered_child(&container->hovered_child, NULL, NULL);
+    }
+    if (destroy_child)
+    {
+        ui_traversal_destroy(child);
+    }
+    else
+    {
+        child->parent = NULL;
+        ui_element_invalidate_subtree_screen_rects(child);
+    }
+
+    if (container->focused_child == child)
+    {
+        container->focused_child = NULL;
+    }
+    if (ui_handle_resolve(container->captured_child) == child)
+    {
+        container->captured_child = UI_HANDLE_NULL;
+    }
+
+    container->children[index] = NULL;
+    container->hole_count++;
+}
+
+/*
+ * Trim trailing holes and compact once holes dominate the array.
+ */
+static void finish_removal(ui_layout_container *container)
+{
+    while (container->child_count > 0U &&
+           container->children[container->child_count - 1U] == NULL)
+    {
+        container->child_count--;
+        container->hole_count--;
+    }
+
+    if (ui_element_should_compact_siblings(container->hole_count, container->child_count))
+    {
+        container->child_count =
+            ui_element_compact_siblings(container->children, container->child_count);
+        container->hole_count = 0;
+    }
+
+    ui_spatial_index_invalidate(&container->hit_index);
+    ui_element_invalidate_measure(&container->base);
+}
+
 bool ui_layout_container_remove_child(ui_layout_container *container, ui_element *child,
                                       bool destroy_child)
 {
-    if (container == NULL || !is_valid_element(child))
+    size_t index = 0U;
+    if (container == NULL || !is_valid_element(child) ||
+        !ui_element_find_sibling(container->children, container->child_count, child, &index))
     {
         return false;
     }
 
-    for (size_t i = 0; i < container->child_count; ++i)
-    {
-        if (container->children[i] != child)
-        {
-            continue;
-        }
-
-        if (destroy_child && child->ops->destroy != NULL)
-        {
-            child->ops->destroy(child);
-        }
-        else
-        {
-            child->parent = NULL;
-        }
+    detach_child(container, index, destroy_child);
+    finish_removal(container);
+    return true;
+}
 
-        if (container->focused_child == child)
-        {
-            container->focused_child = NULL;
-        }
+size_t ui_layout_container_remove_children(ui_layout_container *container,
+                                           ui_element *const *children, size_t count,
+                                           bool destroy_children)
+{
+    if (container == NULL || children == NULL)
+    {
+        return 0U;
+    }
 
-        for (size_t j = i; j + 1U < container->child_count; ++j)
+    size_t removed = 0U;
+    for (size_t i = 0U; i < count; ++i)
+    {
+        size_t index = 0U;
+        if (!is_valid_element(children[i]) ||
+            !ui_element_find_sibling(container->children, container->child_count, children[i],
+                                     &index))
         {
-            container->children[j] = container->children[j + 1U];
+            continue;
         }
-        container->child_count--;
-        return true;
+        detach_child(container, index, destroy_children);
+        removed++;
     }
 
-    return false;
+    if (removed > 0U)
+    {
+        finish_removal(container);
+    }
+    return removed;
 }
 
 void ui_layout_container_clear_children(ui_layout_container *container, bool destroy_children)
@@ -538,6 +689,7 @@ void ui_layout_container_clear_children(ui_layout_container *container, bool des
         return;
     }
 
+    ui_element_set_hovered_child(&container->hovered_child, NULL, NULL);
     for (size_t i = 0; i < container->child_count; ++i)
     {
         ui_element *child = container->children[i];
@@ -545,15 +697,21 @@ void ui_layout_container_clear_children(ui_layout_container *container, bool des
         {
             continue;
         }
-        if (destroy_children && child->ops->destroy != NULL)
+        if (destroy_children)
         {
-            child->ops->destroy(child);
+            ui_traversal_destroy(child);
         }
         else
         {
             child->parent = NULL;
+            ui_element_invalidate_subtree_screen_rects(child);
         }
     }
 
     container->child_count = 0;
+    container->hole_count = 0;
+    container->focused_child = NULL;
+    container->captured_child = UI_HANDLE_NULL;
+    ui_spatial_index_invalidate(&container->hit_index);
+    ui_element_invalidate_measure(&container->base);
 }
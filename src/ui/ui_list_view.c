@@ -0,0 +1,857 @@
+#include "ui/ui_list_view.h"
+
+#include "system/ui_ops_profiler.h"
+#include "system/ui_render.h"
+#include "system/ui_traversal.h"
+
+#include <stdint.h>
+#include <string.h>
+
+static const float DEFAULT_SCROLL_STEP = 24.0F;
+static const size_t INITIAL_ROW_CAPACITY = 16U;
+// Re-measure passes allowed when estimated heights change the visible range.
+static const int MAX_ESTIMATE_PASSES = 8;
+
+static bool is_mouse_event(const SDL_Event *event)
+{
+    return event->type == SDL_EVENT_MOUSE_BUTTON_DOWN || event->type == SDL_EVENT_MOUSE_BUTTON_UP ||
+           event->type == SDL_EVENT_MOUSE_MOTION || event->type == SDL_EVENT_MOUSE_WHEEL;
+}
+
+static bool get_mouse_position(const SDL_Event *event, SDL_FPoint *out)
+{
+    if (event->type == SDL_EVENT_MOUSE_BUTTON_DOWN || event->type == SDL_EVENT_MOUSE_BUTTON_UP)
+    {
+        out->x = event->button.x;
+        out->y = event->button.y;
+        return true;
+    }
+    if (event->type == SDL_EVENT_MOUSE_MOTION)
+    {
+        out->x = event->motion.x;
+        out->y = event->motion.y;
+        return true;
+    }
+    if (event->type == SDL_EVENT_MOUSE_WHEEL)
+    {
+        out->x = event->wheel.mouse_x;
+        out->y = event->wheel.mouse_y;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Fenwick (binary indexed) tree over row pitches, 1-based: tree[i] holds the
+ * sum of the lowest_bit(i) pitches ending at row i - 1. Prefix sums, point
+ * updates and offset-to-row searches are O(log n).
+ */
+static size_t lowest_bit(size_t i)
+{
+    return i & (~i + 1U);
+}
+
+/*
+ * Grow a tree of old_count rows to new_count rows, the new rows at pitch. Old
+ * nodes are untouched except through their new parents, which are exactly the
+ * parents of the nodes summed by the old prefix, so this is
+ * O(new_count - old_count + log old_count). Shrinking needs no work: nodes up
+ * to the new count only cover rows below it.
+ */
+static void pitch_tree_extend(double *tree, size_t old_count, size_t new_count, double pitch)
+{
+    tree[0] = 0.0;
+    for (size_t i = old_count + 1U; i <= new_count; ++i)
+    {
+        tree[i] = pitch;
+    }
+    for (size_t i = old_count; i > 0U; i -= lowest_bit(i))
+    {
+        const size_t parent = i + lowest_bit(i);
+        if (parent <= new_count)
+        {
+            tree[parent] += tree[i];
+        }
+    }
+    for (size_t i = old_count + 1U; i <= new_count; ++i)
+    {
+        const size_t parent = i + lowest_bit(i);
+        if (parent <= new_count)
+        {
+            tree[parent] += tree[i];
+        }
+    }
+}
+
+static void pitch_tree_add_to_all(double *tree, size_t count, double delta)
+{
+    for (size_t i = 1U; i <= count; ++i)
+    {
+        tree[i] += delta * (double)lowest_bit(i);
+    }
+}
+
+static double pitch_tree_prefix(const double *tree, size_t count)
+{
+    double sum = 0.0;
+    for (size_t i = count; i > 0U; i -= lowest_bit(i))
+    {
+        sum += tree[i];
+    }
+    return sum;
+}
+
+static void pitch_tree_add(double *tree, size_t count, size_t index, double delta)
+{
+    for (size_t i = index + 1U; i <= count; i += lowest_bit(i))
+    {
+        tree[i] += delta;
+    }
+}
+
+// Return how many leading rows have pitches summing to at most offset.
+static size_t pitch_tree_search(const double *tree, size_t count, double offset)
+{
+    size_t step = 1U;
+    while (step <= count / 2U)
+    {
+        step *= 2U;
+    }
+
+    size_t position = 0U;
+    for (; step > 0U; step /= 2U)
+    {
+        if (position + step <= count && tree[position + step] <= offset)
+        {
+            position += step;
+            offset -= tree[position];
+        }
+    }
+    return position;
+}
+
+static size_t pitch_tree_bytes(size_t row_count)
+{
+    return (row_count + 1U) * sizeof(double);
+}
+
+static double fixed_pitch(const ui_list_view *list)
+{
+    return (double)list->row_height + (double)list->spacing;
+}
+
+// Content-space y of the top of row index (index == row_count is the end).
+static double row_top(const ui_list_view *list, size_t index)
+{
+    if (list->height_mode == UI_LIST_VIEW_FIXED_HEIGHT)
+    {
+        return (double)list->padding + ((double)index * fixed_pitch(list));
+    }
+    return (double)list->padding + pitch_tree_prefix(list->pitch_tree, index);
+}
+
+static double row_extent(const ui_list_view *list, size_t index)
+{
+    if (list->height_mode == UI_LIST_VIEW_FIXED_HEIGHT)
+    {
+        return (double)list->row_height;
+    }
+    return row_top(list, index + 1U) - row_top(list, index) - (double)list->spacing;
+}
+
+// Return the row under content-space y, clamped to the last row.
+static size_t row_at(const ui_list_view *list, double y)
+{
+    const double offset = y - (double)list->padding;
+    size_t index = 0U;
+    if (offset > 0.0)
+    {
+        index = list->height_mode == UI_LIST_VIEW_FIXED_HEIGHT
+                    ? (size_t)(offset / fixed_pitch(list))
+                    : pitch_tree_search(list->pitch_tree, list->row_count, offset);
+    }
+    return index < list->row_count ? index : list->row_count - 1U;
+}
+
+static double compute_max_scroll(const ui_list_view *list)
+{
+    const double max_offset = ui_list_view_content_height(list) - (double)list->base.rect.h;
+    return max_offset > 0.0 ? max_offset : 0.0;
+}
+
+static void clamp_scroll(ui_list_view *list)
+{
+    const double max_offset = compute_max_scroll(list);
+    if (list->scroll_offset > max_offset)
+    {
+        list->scroll_offset = max_offset;
+    }
+    if (list->scroll_offset < 0.0)
+    {
+        list->scroll_offset = 0.0;
+    }
+}
+
+/*
+ * Compute the rows to keep bound: those intersecting the viewport plus
+ * overscan on each side, as the half-open range [first, end).
+ */
+static void compute_bound_range(const ui_list_view *list, size_t *out_first, size_t *out_end)
+{
+    *out_first = 0U;
+    *out_end = 0U;
+    if (list->row_count == 0U || list->base.rect.h <= 0.0F)
+    {
+        return;
+    }
+
+    const size_t top = row_at(list, list->scroll_offset);
+    const size_t bottom = row_at(list, list->scroll_offset + (double)list->base.rect.h);
+    const size_t below = list->row_count - bottom - 1U;
+    *out_first = top > list->overscan ? top - list->overscan : 0U;
+    *out_end = bottom + 1U + (list->overscan < below ? list->overscan : below);
+}
+
+static bool reserve_row_array(const cui_allocator *allocator, ui_element ***rows,
+                              size_t *capacity, size_t needed)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+
+    size_t new_capacity = *capacity == 0U ? INITIAL_ROW_CAPACITY : *capacity * 2U;
+    while (new_capacity < needed)
+    {
+        new_capacity *= 2U;
+    }
+
+    ui_element **resized =
+        (ui_element **)cui_realloc(allocator, (void *)*rows, *capacity * sizeof(ui_element *),
+                                   new_capacity * sizeof(ui_element *));
+    if (resized == NULL)
+    {
+        return false;
+    }
+    *rows = resized;
+    *capacity = new_capacity;
+    return true;
+}
+
+/*
+ * Create count rows into the spare pool. Both row arrays are grown to hold
+ * every row the list owns, so binding and recycling never allocate and a
+ * failure here leaves the bound rows untouched.
+ */
+static bool create_spare_rows(ui_list_view *list, size_t count)
+{
+    const size_t total = list->bound_count + list->spare_count + count;
+    if (!reserve_row_array(list->base.allocator, &list->rows, &list->row_capacity, total) ||
+        !reserve_row_array(list->base.allocator, &list->spare_rows, &list->spare_capacity, total))
+    {
+        return false;
+    }
+
+    for (size_t i = 0U; i < count; ++i)
+    {
+        ui_element *row = list->adapter.create_row(list->adapter.context);
+        if (row == NULL || row->ops == NULL || row->parent != NULL)
+        {
+            return false;
+        }
+        row->parent = &list->base;
+        ui_element_invalidate_subtree_screen_rects(row);
+        list->spare_rows[list->spare_count++] = row;
+    }
+
+    return true;
+}
+
+static void unbind_row(ui_list_view *list, ui_element *row, size_t index)
+{
+    if (list->adapter.unbind_row != NULL)
+    {
+        list->adapter.unbind_row(list->adapter.context, row, index);
+    }
+}
+
+static void recycle_row(ui_list_view *list, ui_element *row)
+{
+    if (list->hovered_row == row)
+    {
+        ui_element_set_hovered_child(&list->hovered_row, NULL, NULL);
+    }
+    if (ui_handle_resolve(list->captured_row) == row)
+    {
+        list->captured_row = UI_HANDLE_NULL;
+    }
+    list->spare_rows[list->spare_count++] = row;
+}
+
+static void unbind_all_rows(ui_list_view *list)
+{
+    for (size_t i = 0U; i < list->bound_count; ++i)
+    {
+        unbind_row(list, list->rows[i], list->first_index + i);
+        recycle_row(list, list->rows[i]);
+    }
+    list->first_index = 0U;
+    list->bound_count = 0U;
+}
+
+/*
+ * Bind the rows of the current bound range after a data change: every row is
+ * unbound, then rows are reused in place (so the one under the pointer stays
+ * the same element) and bound to their new items.
+ */
+static void rebind_rows(ui_list_view *list, size_t first, size_t end)
+{
+    const size_t wanted = end - first;
+    for (size_t i = 0U; i < list->bound_count; ++i)
+    {
+        unbind_row(list, list->rows[i], list->first_index + i);
+    }
+    for (size_t i = wanted; i < list->bound_count; ++i)
+    {
+        recycle_row(list, list->rows[i]);
+    }
+    for (size_t i = list->bound_count; i < wanted; ++i)
+    {
+        list->rows[i] = list->spare_rows[--list->spare_count];
+    }
+
+    list->first_index = first;
+    list->bound_count = wanted;
+    for (size_t i = 0U; i < wanted; ++i)
+    {
+        list->adapter.bind_row(list->adapter.context, list->rows[i], first + i);
+    }
+}
+
+/*
+ * Bind rows for the range after a scroll: rows still showing an item of the
+ * new range keep it, rows that left are unbound and recycled, and recycled
+ * rows are bound to the items that entered.
+ */
+static void shift_rows(ui_list_view *list, size_t first, size_t end)
+{
+    const size_t old_first = list->first_index;
+    const size_t old_end = old_first + list->bound_count;
+    size_t keep_first = first;
+    size_t keep_end = first;
+    if (old_first < end && first < old_end)
+    {
+        keep_first = old_first > first ? old_first : first;
+        keep_end = old_end < end ? old_end : end;
+    }
+
+    for (size_t i = 0U; i < list->bound_count; ++i)
+    {
+        const size_t index = old_first + i;
+        if (index < keep_first || index >= keep_end)
+        {
+            unbind_row(list, list->rows[i], index);
+            recycle_row(list, list->rows[i]);
+        }
+    }
+    // Without overlap keep_first may lie before old_first; nothing moves then.
+    if (keep_end > keep_first)
+    {
+        memmove((void *)(list->rows + (keep_first - first)),
+                (const void *)(list->rows + (keep_first - old_first)),
+                (keep_end - keep_first) * sizeof(ui_element *));
+    }
+
+    list->first_index = first;
+    list->bound_count = end - first;
+    for (size_t index = first; index < end; ++index)
+    {
+        if (index >= keep_first && index < keep_end)
+        {
+            continue;
+        }
+        ui_element *row = list->spare_rows[--list->spare_count];
+        list->rows[index - first] = row;
+        list->adapter.bind_row(list->adapter.context, row, index);
+    }
+}
+
+/*
+ * Bring the bound rows in line with the scroll offset and row count. With
+ * rebind, every row is bound again because items may have moved.
+ *
+ * Returns false when a row could not be created; nothing is changed then.
+ */
+static bool sync_rows(ui_list_view *list, bool rebind)
+{
+    clamp_scroll(list);
+    size_t first = 0U;
+    size_t end = 0U;
+    compute_bound_range(list, &first, &end);
+    if (!rebind && first == list->first_index && end - first == list->bound_count)
+    {
+        return true;
+    }
+
+    const size_t available = list->bound_count + list->spare_count;
+    if (end - first > available && !create_spare_rows(list, (end - first) - available))
+    {
+        return false;
+    }
+
+    if (rebind)
+    {
+        rebind_rows(list, first, end);
+    }
+    else
+    {
+        shift_rows(list, first, end);
+    }
+    return true;
+}
+
+/*
+ * Record a bound row's measured height in ESTIMATED mode. Growth above the
+ * viewport top moves the scroll offset with it, so visible rows stay put.
+ * Returns true when the height changed.
+ */
+static bool record_row_height(ui_list_view *list, size_t index, float height)
+{
+    const double delta = (double)height - row_extent(list, index);
+    if (height <= 0.0F || delta == 0.0)
+    {
+        return false;
+    }
+
+    const bool above_viewport = row_top(list, index) < list->scroll_offset;
+    pitch_tree_add(list->pitch_tree, list->row_count, index, delta);
+    if (above_viewport)
+    {
+        list->scroll_offset += delta;
+    }
+    return true;
+}
+
+static float inner_width(const ui_list_view *list)
+{
+    const float width = list->base.rect.w - (2.0F * list->padding);
+    return width > 0.0F ? width : 0.0F;
+}
+
+/*
+ * Measure and place the bound rows relative to the viewport.
+ */
+static void layout_rows(ui_list_view *list)
+{
+    const float width = inner_width(list);
+    for (int pass = 0; pass < MAX_ESTIMATE_PASSES; ++pass)
+    {
+        bool heights_changed = false;
+        for (size_t i = 0U; i < list->bound_count; ++i)
+        {
+            ui_element *row = list->rows[i];
+            const size_t index = list->first_index + i;
+            const SDL_FRect available = {0.0F, 0.0F, width, (float)row_extent(list, index)};
+            ui_element_measure(row, &available);
+            if (list->height_mode == UI_LIST_VIEW_ESTIMATED_HEIGHT &&
+                record_row_height(list, index, row->rect.h))
+            {
+                heights_changed = true;
+            }
+        }
+
+        // Measured heights can pull more rows into the viewport. The last
+        // pass does not sync, so every bound row has been measured.
+        if (!heights_changed || pass + 1 == MAX_ESTIMATE_PASSES || !sync_rows(list, false))
+        {
+            break;
+        }
+    }
+
+    for (size_t i = 0U; i < list->bound_count; ++i)
+    {
+        const size_t index = list->first_index + i;
+        const SDL_FRect final_rect = {list->padding,
+                                      (float)(row_top(list, index) - list->scroll_offset), width,
+                                      (float)row_extent(list, index)};
+        ui_element_arrange(list->rows[i], &final_rect);
+    }
+}
+
+static bool scroll_to(ui_list_view *list, double offset)
+{
+    const double previous = list->scroll_offset;
+    list->scroll_offset = offset;
+    clamp_scroll(list);
+    if (list->scroll_offset == previous)
+    {
+        return false;
+    }
+
+    (void)sync_rows(list, false);
+    layout_rows(list);
+    return true;
+}
+
+static bool hit_test_row(const ui_element *row, const SDL_FPoint *point)
+{
+    if (!row->visible || !row->enabled)
+    {
+        return false;
+    }
+    if (row->ops->hit_test != NULL)
+    {
+        return row->ops->hit_test(row, point);
+    }
+    return ui_element_hit_test(row, point);
+}
+
+static ui_element *find_row_at(const ui_list_view *list, const SDL_FPoint *point)
+{
+    for (size_t i = list->bound_count; i > 0U; --i)
+    {
+        ui_element *row = list->rows[i - 1U];
+        if (hit_test_row(row, point))
+        {
+            return row;
+        }
+    }
+    return NULL;
+}
+
+static bool dispatch_to_row(ui_element *row, const SDL_Event *event)
+{
+    if (row == NULL || !row->enabled || row->ops->handle_event == NULL)
+    {
+        return false;
+    }
+
+    UI_OPS_PROFILE_ENTER(scope, row->ops, UI_OPS_CALL_HANDLE_EVENT);
+    const bool handled = row->ops->handle_event(row, event);
+    UI_OPS_PROFILE_LEAVE(scope);
+    return handled;
+}
+
+static void measure_list_view(ui_element *element, const SDL_FRect *available_rect)
+{
+    ui_list_view *list = (ui_list_view *)element;
+    if (available_rect == NULL)
+    {
+        return;
+    }
+
+    // Rows are measured in arrange, once the bound range is known.
+    if (available_rect->w > 0.0F)
+    {
+        list->base.rect.w = available_rect->w;
+    }
+    if (available_rect->h > 0.0F)
+    {
+        list->base.rect.h = available_rect->h;
+    }
+}
+
+static void arrange_list_view(ui_element *element, const SDL_FRect *final_rect)
+{
+    ui_list_view *list = (ui_list_view *)element;
+    if (final_rect == NULL)
+    {
+        return;
+    }
+
+    list->base.rect = *final_rect;
+    (void)sync_rows(list, false);
+    layout_rows(list);
+}
+
+static bool handle_pointer_event(ui_list_view *list, const SDL_Event *event,
+                                 const SDL_FPoint *point)
+{
+    if (event->type == SDL_EVENT_MOUSE_WHEEL)
+    {
+        if (compute_max_scroll(list) <= 0.0)
+        {
+            return false;
+        }
+        (void)scroll_to(list, list->scroll_offset - ((double)event->wheel.y * list->scroll_step));
+        return true;
+    }
+
+    if (event->type == SDL_EVENT_MOUSE_BUTTON_DOWN && event->button.button == SDL_BUTTON_LEFT)
+    {
+        ui_element *row = find_row_at(list, point);
+        const ui_handle self = ui_handle_acquire(&list->base);
+        const ui_handle row_handle = ui_handle_acquire(row);
+        const bool handled = dispatch_to_row(row, event);
+        // A row callback may have destroyed the list itself.
+        if (ui_handle_resolve(self) == &list->base)
+        {
+            list->captured_row = handled ? row_handle : UI_HANDLE_NULL;
+        }
+        return handled;
+    }
+
+    if (event->type == SDL_EVENT_MOUSE_MOTION &&
+        dispatch_to_row(ui_handle_resolve(list->captured_row), event))
+    {
+        return true;
+    }
+
+    if (event->type == SDL_EVENT_MOUSE_BUTTON_UP && event->button.button == SDL_BUTTON_LEFT)
+    {
+        ui_element *captured = ui_handle_resolve(list->captured_row);
+        list->captured_row = UI_HANDLE_NULL;
+        if (dispatch_to_row(captured, event))
+        {
+            return true;
+        }
+    }
+
+    return dispatch_to_row(find_row_at(list, point), event);
+}
+
+static bool handle_list_view_event(ui_element *element, const SDL_Event *event)
+{
+    ui_list_view *list = (ui_list_view *)element;
+
+    if (is_mouse_event(event))
+    {
+        // Gate pointer input to the viewport; rows in the overscan are clipped.
+        const SDL_FRect sr = ui_element_screen_rect(element);
+        SDL_FPoint point = {0.0F, 0.0F};
+        if (!get_mouse_position(event, &point) || !SDL_PointInRectFloat(&point, &sr))
+        {
+            return false;
+        }
+        return handle_pointer_event(list, event, &point);
+    }
+
+    for (size_t i = list->bound_count; i > 0U; --i)
+    {
+        if (dispatch_to_row(list->rows[i - 1U], event))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void update_list_view_hover(ui_element *element, const SDL_FPoint *point)
+{
+    ui_list_view *list = (ui_list_view *)element;
+
+    const SDL_FRect sr = ui_element_screen_rect(element);
+    const bool inside = point != NULL && SDL_PointInRectFloat(point, &sr);
+    ui_element *next = inside ? find_row_at(list, point) : NULL;
+    ui_element_set_hovered_child(&list->hovered_row, next, next != NULL ? point : NULL);
+}
+
+static size_t get_list_view_children(const ui_element *element, ui_element *const **out_children)
+{
+    const ui_list_view *list = (const ui_list_view *)element;
+    *out_children = list->rows;
+    return list->bound_count;
+}
+
+static void render_list_view(const ui_element *element, SDL_Renderer *renderer)
+{
+    // Clip rows (overscan included) to the viewport; finish_render pops it.
+    const SDL_FRect sr = ui_element_screen_rect(element);
+    ui_render_push_clip(renderer, &sr);
+}
+
+static void finish_list_view_render(const ui_element *element, SDL_Renderer *renderer)
+{
+    const ui_list_view *list = (const ui_list_view *)element;
+    ui_render_pop_clip(renderer);
+
+    if (list->base.has_border)
+    {
+        const SDL_FRect sr = ui_element_screen_rect(element);
+        ui_element_render_inner_border(renderer, &sr, list->base.border_color,
+                                       list->base.border_width);
+    }
+}
+
+static void destroy_list_view(ui_element *element)
+{
+    ui_list_view *list = (ui_list_view *)element;
+
+    // Bound rows were destroyed as children; recycled rows are not children.
+    for (size_t i = 0U; i < list->spare_count; ++i)
+    {
+        ui_traversal_destroy(list->spare_rows[i]);
+    }
+
+    cui_free(element->allocator, (void *)list->rows, list->row_capacity * sizeof(ui_element *));
+    cui_free(element->allocator, (void *)list->spare_rows,
+             list->spare_capacity * sizeof(ui_element *));
+    if (list->pitch_tree != NULL)
+    {
+        cui_free(element->allocator, list->pitch_tree, pitch_tree_bytes(list->row_count));
+    }
+    cui_free(element->allocator, list, sizeof(*list));
+}
+
+static const ui_element_ops LIST_VIEW_OPS = {
+    .type_name = "list_view",
+    .measure = measure_list_view,
+    .arrange = arrange_list_view,
+    .handle_event = handle_list_view_event,
+    .update_hover = update_list_view_hover,
+    .child_span = get_list_view_children,
+    .render = render_list_view,
+    .finish_render = finish_list_view_render,
+    .destroy = destroy_list_view,
+};
+
+/*
+ * Size the ESTIMATED-mode pitch tree for row_count rows. Rows below both the
+ * old and new count keep their measured pitch; added rows start at the
+ * estimate.
+ */
+static bool resize_pitch_tree(ui_list_view *list, size_t row_count)
+{
+    if (list->height_mode != UI_LIST_VIEW_ESTIMATED_HEIGHT)
+    {
+        return true;
+    }
+    if (row_count >= SIZE_MAX / sizeof(double))
+    {
+        return false;
+    }
+
+    const size_t old_count = list->pitch_tree != NULL ? list->row_count : 0U;
+    const size_t old_bytes = list->pitch_tree != NULL ? pitch_tree_bytes(old_count) : 0U;
+    double *tree = cui_realloc(list->base.allocator, list->pitch_tree, old_bytes,
+                               pitch_tree_bytes(row_count));
+    if (tree == NULL)
+    {
+        return false;
+    }
+
+    pitch_tree_extend(tree, old_count, row_count, fixed_pitch(list));
+    list->pitch_tree = tree;
+    return true;
+}
+
+ui_list_view *ui_list_view_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                                  size_t row_count, ui_list_view_height_mode height_mode,
+                                  float row_height, size_t overscan,
+                                  const ui_list_view_adapter *adapter,
+                                  const SDL_Color *border_color)
+{
+    if (rect == NULL || adapter == NULL || adapter->create_row == NULL ||
+        adapter->bind_row == NULL || !(row_height > 0.0F))
+    {
+        return NULL;
+    }
+
+    ui_list_view *list = cui_alloc(allocator, sizeof(*list));
+    if (list == NULL)
+    {
+        return NULL;
+    }
+
+    memset(list, 0, sizeof(*list));
+    list->base.rect = *rect;
+    list->base.ops = &LIST_VIEW_OPS;
+    list->base.allocator = allocator;
+    list->base.visible = true;
+    list->base.enabled = true;
+    list->base.parent = NULL;
+    list->base.align_h = UI_ALIGN_LEFT;
+    list->base.align_v = UI_ALIGN_TOP;
+    ui_element_set_border(&list->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&list->base);
+    list->adapter = *adapter;
+    list->height_mode = height_mode;
+    list->row_height = row_height;
+    list->overscan = overscan;
+    list->scroll_step = DEFAULT_SCROLL_STEP;
+    list->captured_row = UI_HANDLE_NULL;
+
+    if (!resize_pitch_tree(list, row_count))
+    {
+        cui_free(allocator, list, sizeof(*list));
+        return NULL;
+    }
+    list->row_count = row_count;
+
+    // Rows are created and bound by the first arrange, once the size is known.
+    return list;
+}
+
+void ui_list_view_set_spacing(ui_list_view *list, float padding, float spacing)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+
+    const float old_spacing = list->spacing;
+    list->padding = padding > 0.0F ? padding : 0.0F;
+    list->spacing = spacing > 0.0F ? spacing : 0.0F;
+    if (list->height_mode == UI_LIST_VIEW_ESTIMATED_HEIGHT)
+    {
+        pitch_tree_add_to_all(list->pitch_tree, list->row_count,
+                              (double)list->spacing - (double)old_spacing);
+    }
+    ui_element_invalidate_arrange(&list->base);
+}
+
+bool ui_list_view_set_row_count(ui_list_view *list, size_t row_count)
+{
+    if (list == NULL || !resize_pitch_tree(list, row_count))
+    {
+        return false;
+    }
+
+    list->row_count = row_count;
+    if (!sync_rows(list, true))
+    {
+        // Bound rows may name items past the new count; drop them all.
+        unbind_all_rows(list);
+        return false;
+    }
+    layout_rows(list);
+    return true;
+}
+
+void ui_list_view_refresh(ui_list_view *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+
+    (void)sync_rows(list, true);
+    layout_rows(list);
+}
+
+void ui_list_view_scroll_to_row(ui_list_view *list, size_t index)
+{
+    if (list == NULL || list->row_count == 0U)
+    {
+        return;
+    }
+
+    if (index >= list->row_count)
+    {
+        index = list->row_count - 1U;
+    }
+    (void)scroll_to(list, row_top(list, index) - (double)list->padding);
+}
+
+double ui_list_view_content_height(const ui_list_view *list)
+{
+    if (list == NULL)
+    {
+        return 0.0;
+    }
+    if (list->row_count == 0U)
+    {
+        return 2.0 * (double)list->padding;
+    }
+    return row_top(list, list->row_count) - (double)list->spacing + (double)list->padding;
+}
@@ -1,6 +1,6 @@
 #include "ui/ui_pane.h"
 
-#include <stdlib.h>
+#include "system/ui_render.h"
 
 static bool handle_pane_event(ui_element *element, const SDL_Event *event)
 {
@@ -20,9 +20,7 @@ static void render_pane(const ui_element *element, SDL_Renderer *renderer)
     const ui_pane *pane = (const ui_pane *)element;
     const SDL_FRect sr = ui_element_screen_rect(element);
 
-    SDL_SetRenderDrawColor(renderer, pane->fill_color.r, pane->fill_color.g, pane->fill_color.b,
-                           pane->fill_color.a);
-    SDL_RenderFillRect(renderer, &sr);
+    ui_render_fill_rect(renderer, &sr, pane->fill_color);
     if (pane->base.has_border)
     {
         ui_element_render_inner_border(renderer, &sr, pane->base.border_color,
@@ -30,9 +28,13 @@ static void render_pane(const ui_element *element, SDL_Renderer *renderer)
     }
 }
 
-static void destroy_pane(ui_element *element) { free(element); }
+static void destroy_pane(ui_element *element)
+{
+    cui_free(element->allocator, element, sizeof(ui_pane));
+}
 
 static const ui_element_ops PANE_OPS = {
+    .type_name = "pane",
     .handle_event = handle_pane_event,
     .update = update_pane,
     .render = render_pane,
@@ -40,14 +42,15 @@ static const ui_element_ops PANE_OPS = {
 };
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-ui_pane *ui_pane_create(const SDL_FRect *rect, SDL_Color fill_color, const SDL_Color *border_color)
+ui_pane *ui_pane_create(const cui_allocator *allocator, const SDL_FRect *rect, SDL_Color fill_color,
+                        const SDL_Color *border_color)
 {
     if (rect == NULL)
     {
         return NULL;
     }
 
-    ui_pane *pane = malloc(sizeof(*pane));
+    ui_pane *pane = cui_alloc(allocator, sizeof(*pane));
     if (pane == NULL)
     {
         return NULL;
@@ -55,12 +58,14 @@ ui_pane *ui_pane_create(const SDL_FRect *rect, SDL_Color fill_color, const SDL_C
 
     pane->base.rect = *rect;
     pane->base.ops = &PANE_OPS;
+    pane->base.allocator = allocator;
     pane->base.visible = true;
     pane->base.enabled = true;
     pane->base.parent = NULL;
     pane->base.align_h = UI_ALIGN_LEFT;
     pane->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&pane->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&pane->base);
     pane->fill_color = fill_color;
 
     return pane;
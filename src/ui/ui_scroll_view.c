@@ -1,6 +1,7 @@
 #include "ui/ui_scroll_view.h"
 
-#include <stdlib.h>
+#include "system/ui_ops_profiler.h"
+#include "system/ui_render.h"
 
 static bool is_mouse_event(const SDL_Event *event)
 {
@@ -57,9 +58,17 @@ static float clamp_scroll(float offset, float max_offset)
 
 static void position_child(ui_scroll_view *scroll)
 {
-    scroll->child->rect.x = 0.0F;
-    scroll->child->rect.y = -scroll->scroll_offset_y;
-    scroll->child->rect.w = scroll->base.rect.w;
+    ui_element *child = scroll->child;
+    const float child_y = -scroll->scroll_offset_y;
+    if (child->rect.x == 0.0F && child->rect.y == child_y && child->rect.w == scroll->base.rect.w)
+    {
+        return;
+    }
+
+    child->rect.x = 0.0F;
+    child->rect.y = child_y;
+    child->rect.w = scroll->base.rect.w;
+    ui_element_invalidate_subtree_screen_rects(child);
 }
 
 static void measure_scroll_view(ui_element *element, const SDL_FRect *available_rect)
@@ -126,6 +135,34 @@ static void set_scroll_view_focus(ui_element *element, bool focused)
     scroll->child->ops->set_focus(scroll->child, focused);
 }
 
+static void update_scroll_view_hover(ui_element *element, const SDL_FPoint *point)
+{
+    ui_scroll_view *scroll = (ui_scroll_view *)element;
+    if (scroll->child == NULL)
+    {
+        return;
+    }
+
+    // Content scrolled outside the viewport is clipped, so it cannot be hovered.
+    const SDL_FRect sr = ui_element_screen_rect(element);
+    const bool inside = point != NULL && scroll->child->visible && scroll->child->enabled &&
+                        SDL_PointInRectFloat(point, &sr);
+    ui_element_update_hover(scroll->child, inside ? point : NULL);
+}
+
+static bool forward_to_child(ui_scroll_view *scroll, const SDL_Event *event)
+{
+    if (!scroll->child->enabled || scroll->child->ops->handle_event == NULL)
+    {
+        return false;
+    }
+
+    UI_OPS_PROFILE_ENTER(scope, scroll->child->ops, UI_OPS_CALL_HANDLE_EVENT);
+    const bool handled = scroll->child->ops->handle_event(scroll->child, event);
+    UI_OPS_PROFILE_LEAVE(scope);
+    return handled;
+}
+
 static bool handle_scroll_view_event(ui_element *element, const SDL_Event *event)
 {
     ui_scroll_view *scroll = (ui_scroll_view *)element;
@@ -160,36 +197,33 @@ static bool handle_scroll_view_event(ui_element *element, const SDL_Event *event
         }
 
         // Forward other mouse events to the child.
-        if (scroll->child->enabled && scroll->child->ops->handle_event != NULL)
-        {
-            return scroll->child->ops->handle_event(scroll->child, event);
-        }
-        return false;
+        return forward_to_child(scroll, event);
     }
 
     // Non-mouse events (keyboard, text input) are always forwarded.
-    if (scroll->child->enabled && scroll->child->ops->handle_event != NULL)
-    {
-        return scroll->child->ops->handle_event(scroll->child, event);
-    }
-    return false;
+    return forward_to_child(scroll, event);
+}
+
+static size_t get_scroll_view_children(const ui_element *element,
+                                       ui_element *const **out_children)
+{
+    const ui_scroll_view *scroll = (const ui_scroll_view *)element;
+    *out_children = &scroll->child;
+    return scroll->child != NULL ? 1U : 0U;
 }
 
 static void update_scroll_view(ui_element *element, float delta_seconds)
 {
     ui_scroll_view *scroll = (ui_scroll_view *)element;
+    (void)delta_seconds;
 
     if (scroll->child == NULL || scroll->child->ops == NULL)
     {
         return;
     }
 
-    if (scroll->child->enabled && scroll->child->ops->update != NULL)
-    {
-        scroll->child->ops->update(scroll->child, delta_seconds);
-    }
-
-    // Re-clamp after child update in case content height changed.
+    // Re-clamp before the child updates in case content height changed since
+    // the last frame.
     const float max_offset = compute_max_scroll(scroll);
     scroll->scroll_offset_y = clamp_scroll(scroll->scroll_offset_y, max_offset);
     position_child(scroll);
@@ -197,37 +231,20 @@ static void update_scroll_view(ui_element *element, float delta_seconds)
 
 static void render_scroll_view(const ui_element *element, SDL_Renderer *renderer)
 {
-    const ui_scroll_view *scroll = (const ui_scroll_view *)element;
-
-    if (scroll->child == NULL || scroll->child->ops == NULL)
-    {
-        return;
-    }
-
-    // Save the current clip rect, apply viewport clipping, render child, restore.
+    // Clip the child to the viewport; finish_render pops back to the
+    // enclosing clip.
     const SDL_FRect sr = ui_element_screen_rect(element);
-    SDL_Rect saved_clip;
-    const bool had_clip = SDL_GetRenderClipRect(renderer, &saved_clip);
-    const SDL_Rect viewport_clip = {(int)sr.x, (int)sr.y, (int)sr.w, (int)sr.h};
-    SDL_SetRenderClipRect(renderer, &viewport_clip);
-
-    if (scroll->child->visible && scroll->child->ops->render != NULL)
-    {
-        scroll->child->ops->render(scroll->child, renderer);
-    }
+    ui_render_push_clip(renderer, &sr);
+}
 
-    // Restore previous clip state.
-    if (had_clip && (saved_clip.w > 0 || saved_clip.h > 0))
-    {
-        SDL_SetRenderClipRect(renderer, &saved_clip);
-    }
-    else
-    {
-        SDL_SetRenderClipRect(renderer, NULL);
-    }
+static void finish_scroll_view_render(const ui_element *element, SDL_Renderer *renderer)
+{
+    const ui_scroll_view *scroll = (const ui_scroll_view *)element;
+    ui_render_pop_clip(renderer);
 
     if (scroll->base.has_border)
     {
+        const SDL_FRect sr = ui_element_screen_rect(element);
         ui_element_render_inner_border(renderer, &sr, scroll->base.border_color,
                                        scroll->base.border_width);
     }
@@ -235,27 +252,26 @@ static void render_scroll_view(const ui_element *element, SDL_Renderer *renderer
 
 static void destroy_scroll_view(ui_element *element)
 {
-    ui_scroll_view *scroll = (ui_scroll_view *)element;
-
-    if (scroll->child != NULL && scroll->child->ops != NULL && scroll->child->ops->destroy != NULL)
-    {
-        scroll->child->ops->destroy(scroll->child);
-    }
-    free(element);
+    cui_free(element->allocator, element, sizeof(ui_scroll_view));
 }
 
 static const ui_element_ops SCROLL_VIEW_OPS = {
+    .type_name = "scroll_view",
     .measure = measure_scroll_view,
     .arrange = arrange_scroll_view,
     .handle_event = handle_scroll_view_event,
     .can_focus = can_focus_scroll_view,
     .set_focus = set_scroll_view_focus,
+    .update_hover = update_scroll_view_hover,
+    .child_span = get_scroll_view_children,
     .update = update_scroll_view,
     .render = render_scroll_view,
+    .finish_render = finish_scroll_view_render,
     .destroy = destroy_scroll_view,
 };
 
-ui_scroll_view *ui_scroll_view_create(const SDL_FRect *rect, ui_element *child, float scroll_step,
+ui_scroll_view *ui_scroll_view_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                                      ui_element *child, float scroll_step,
                                       const SDL_Color *border_color)
 {
     if (rect == NULL || child == NULL || child->ops == NULL || rect->w <= 0.0F || rect->h <= 0.0F)
@@ -268,7 +284,7 @@ ui_scroll_view *ui_scroll_view_create(const SDL_FRect *rect, ui_element *child,
         return NULL;
     }
 
-    ui_scroll_view *scroll = malloc(sizeof(*scroll));
+    ui_scroll_view *scroll = cui_alloc(allocator, sizeof(*scroll));
     if (scroll == NULL)
     {
         return NULL;
@@ -276,12 +292,14 @@ ui_scroll_view *ui_scroll_view_create(const SDL_FRect *rect, ui_element *child,
 
     scroll->base.rect = *rect;
     scroll->base.ops = &SCROLL_VIEW_OPS;
+    scroll->base.allocator = allocator;
     scroll->base.visible = true;
     scroll->base.enabled = true;
     scroll->base.parent = NULL;
     scroll->base.align_h = UI_ALIGN_LEFT;
     scroll->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&scroll->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&scroll->base);
     scroll->child = child;
     scroll->scroll_offset_y = 0.0F;
     static const float DEFAULT_SCROLL_STEP = 20.0F;
@@ -289,6 +307,7 @@ ui_scroll_view *ui_scroll_view_create(const SDL_FRect *rect, ui_element *child,
 
     // Set parent and position the child relative to the scroll view.
     child->parent = &scroll->base;
+    ui_element_invalidate_subtree_screen_rects(child);
     child->rect.x = 0.0F;
     child->rect.y = 0.0F;
     child->rect.w = rect->w;
@@ -1,10 +1,8 @@
 #include "ui/ui_segment_group.h"
 
-#include <stdlib.h>
-#include <string.h>
+#include "system/ui_render.h"
 
-static const float DEBUG_GLYPH_WIDTH = 8.0F;
-static const float DEBUG_GLYPH_HEIGHT = 8.0F;
+static const float HOVER_COLOR_MIX = 0.5F;
 
 static size_t clamp_segment_index(const ui_segment_group *group, size_t index)
 {
@@ -37,6 +35,10 @@ static void set_selected_index_internal(ui_segment_group *group, size_t selected
     const size_t clamped = clamp_segment_index(group, selected_index);
     const bool changed = group->selected_index != clamped;
     group->selected_index = clamped;
+    if (changed)
+    {
+        ui_element_invalidate_render(&group->base);
+    }
 
     if (changed && notify && group->on_change != NULL)
     {
@@ -60,6 +62,7 @@ static bool handle_segment_group_event(ui_element *element, const SDL_Event *eve
 
         group->pressed_index = segment_index_from_x(group, event->button.x, &sr);
         group->has_pressed_segment = true;
+        ui_element_invalidate_render(element);
         return true;
     }
 
@@ -80,6 +83,7 @@ static bool handle_segment_group_event(ui_element *element, const SDL_Event *eve
         }
 
         group->has_pressed_segment = false;
+        ui_element_invalidate_render(element);
         return true;
     }
 
@@ -88,7 +92,12 @@ static bool handle_segment_group_event(ui_element *element, const SDL_Event *eve
         const SDL_FPoint cursor = {event->motion.x, event->motion.y};
         if (SDL_PointInRectFloat(&cursor, &sr))
         {
-            group->pressed_index = segment_index_from_x(group, event->motion.x, &sr);
+            const size_t pressed_index = segment_index_from_x(group, event->motion.x, &sr);
+            if (pressed_index != group->pressed_index)
+            {
+                group->pressed_index = pressed_index;
+                ui_element_invalidate_render(element);
+            }
         }
         return true;
     }
@@ -96,6 +105,25 @@ static bool handle_segment_group_event(ui_element *element, const SDL_Event *eve
     return false;
 }
 
+static void update_segment_group_hover(ui_element *element, const SDL_FPoint *point)
+{
+    ui_segment_group *group = (ui_segment_group *)element;
+    const bool hovered = point != NULL;
+    size_t hovered_index = group->hovered_index;
+    if (hovered)
+    {
+        const SDL_FRect sr = ui_element_screen_rect(element);
+        hovered_index = segment_index_from_x(group, point->x, &sr);
+    }
+
+    if (group->has_hovered_segment != hovered || group->hovered_index != hovered_index)
+    {
+        group->has_hovered_segment = hovered;
+        group->hovered_index = hovered_index;
+        ui_element_invalidate_render(element);
+    }
+}
+
 static void update_segment_group(ui_element *element, float delta_seconds)
 {
     (void)element;
@@ -107,30 +135,14 @@ static void measure_segment_group(ui_element *element, const SDL_FRect *availabl
     (void)available_rect;
 
     ui_segment_group *group = (ui_segment_group *)element;
-    if (group == NULL || group->labels == NULL || group->segment_count == 0U)
+    if (group == NULL || group->label_runs == NULL || group->segment_count == 0U)
     {
         return;
     }
 
-    float max_label_width = 0.0F;
-    for (size_t i = 0; i < group->segment_count; ++i)
-    {
-        const char *label = group->labels[i];
-        if (label == NULL)
-        {
-            continue;
-        }
-
-        const float width = (float)strlen(label) * DEBUG_GLYPH_WIDTH;
-        if (width > max_label_width)
-        {
-            max_label_width = width;
-        }
-    }
-
-    const float min_segment_width = max_label_width + 24.0F;
+    const float min_segment_width = group->max_label_width + 24.0F;
     const float intrinsic_width = min_segment_width * (float)group->segment_count;
-    const float intrinsic_height = DEBUG_GLYPH_HEIGHT + 20.0F;
+    const float intrinsic_height = UI_TEXT_GLYPH_HEIGHT + 20.0F;
     if (group->base.rect.w < intrinsic_width)
     {
         group->base.rect.w = intrinsic_width;
@@ -169,35 +181,37 @@ static void render_segment_group(const ui_element *element, SDL_Renderer *render
         const SDL_FRect segment_rect = {segment_x, sr.y, width, sr.h};
         const bool is_selected = i == group->selected_index;
         const bool is_pressed = group->has_pressed_segment && i == group->pressed_index;
-        const SDL_Color fill_color =
-            is_pressed ? group->pressed_color
-                       : (is_selected ? group->selected_color : group->base_color);
+        const bool is_hovered = group->has_hovered_segment && i == group->hovered_index;
+        SDL_Color fill_color = is_selected ? group->selected_color : group->base_color;
+        if (is_pressed)
+        {
+            fill_color = group->pressed_color;
+        }
+        else if (is_hovered && !is_selected)
+        {
+            fill_color =
+                ui_render_mix_color(group->base_color, group->pressed_color, HOVER_COLOR_MIX);
+        }
         const SDL_Color label_color = is_selected ? group->selected_text_color : group->text_color;
 
-        SDL_SetRenderDrawColor(renderer, fill_color.r, fill_color.g, fill_color.b, fill_color.a);
-        SDL_RenderFillRect(renderer, &segment_rect);
+        ui_render_fill_rect(renderer, &segment_rect, fill_color);
 
-        const char *label = group->labels[i];
-        if (label != NULL && label[0] != '\0')
+        const ui_text_run *label = &group->label_runs[i];
+        if (!ui_text_run_is_empty(label))
         {
-            const float label_width = (float)strlen(label) * DEBUG_GLYPH_WIDTH;
-            const float label_x = segment_rect.x + ((segment_rect.w - label_width) * 0.5F);
-            const float label_y = segment_rect.y + ((segment_rect.h - DEBUG_GLYPH_HEIGHT) * 0.5F);
+            const float label_x = segment_rect.x + ((segment_rect.w - label->width) * 0.5F);
+            const float label_y = segment_rect.y + ((segment_rect.h - label->height) * 0.5F);
 
-            SDL_SetRenderDrawColor(renderer, label_color.r, label_color.g, label_color.b,
-                                   label_color.a);
-            SDL_RenderDebugText(renderer, label_x, label_y, label);
+            ui_render_debug_text(renderer, label_x, label_y, label->text, label_color);
         }
     }
 
     const SDL_Color separator_color =
         group->base.has_border ? group->base.border_color : group->text_color;
-    SDL_SetRenderDrawColor(renderer, separator_color.r, separator_color.g, separator_color.b,
-                           separator_color.a);
     for (size_t i = 1; i < group->segment_count; ++i)
     {
         const float separator_x = sr.x + (segment_width * (float)i);
-        SDL_RenderLine(renderer, separator_x, sr.y, separator_x, sr.y + sr.h);
+        ui_render_line(renderer, separator_x, sr.y, separator_x, sr.y + sr.h, separator_color);
     }
 
     if (group->base.has_border)
@@ -207,24 +221,34 @@ static void render_segment_group(const ui_element *element, SDL_Renderer *render
     }
 }
 
-static void destroy_segment_group(ui_element *element) { free(element); }
+static void destroy_segment_group(ui_element *element)
+{
+    ui_segment_group *group = (ui_segment_group *)element;
+    cui_free(element->allocator, group->label_runs,
+             sizeof(*group->label_runs) * group->segment_count);
+    cui_free(element->allocator, element, sizeof(ui_segment_group));
+}
 
 static const ui_element_ops SEGMENT_GROUP_OPS = {
+    .type_name = "segment_group",
     .measure = measure_segment_group,
     .arrange = arrange_segment_group,
     .handle_event = handle_segment_group_event,
+    .update_hover = update_segment_group_hover,
     .update = update_segment_group,
     .render = render_segment_group,
     .destroy = destroy_segment_group,
 };
 
 // NOLINTBEGIN(bugprone-easily-swappable-parameters)
-ui_segment_group *
-ui_segment_group_create(const SDL_FRect *rect, const char **labels, size_t segment_count,
-                        size_t initial_selected_index, SDL_Color base_color,
-                        SDL_Color selected_color, SDL_Color pressed_color, SDL_Color text_color,
-                        SDL_Color selected_text_color, const SDL_Color *border_color,
-                        segment_group_change_handler on_change, void *on_change_context)
+ui_segment_group *ui_segment_group_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                                          const char **labels, size_t segment_count,
+                                          size_t initial_selected_index, SDL_Color base_color,
+                                          SDL_Color selected_color, SDL_Color pressed_color,
+                                          SDL_Color text_color, SDL_Color selected_text_color,
+                                          const SDL_Color *border_color,
+                                          segment_group_change_handler on_change,
+                                          void *on_change_context)
 // NOLINTEND(bugprone-easily-swappable-parameters)
 {
     if (rect == NULL || rect->w <= 0.0F || rect->h <= 0.0F || labels == NULL ||
@@ -241,25 +265,46 @@ ui_segment_group_create(const SDL_FRect *rect, const char **labels, size_t segme
         }
     }
 
-    ui_segment_group *group = malloc(sizeof(*group));
+    ui_segment_group *group = cui_alloc(allocator, sizeof(*group));
     if (group == NULL)
     {
         return NULL;
     }
 
+    group->label_runs = cui_alloc(allocator, sizeof(*group->label_runs) * segment_count);
+    if (group->label_runs == NULL)
+    {
+        cui_free(allocator, group, sizeof(*group));
+        return NULL;
+    }
+
+    group->max_label_width = 0.0F;
+    for (size_t i = 0; i < segment_count; ++i)
+    {
+        ui_text_run_set(&group->label_runs[i], labels[i]);
+        if (group->label_runs[i].width > group->max_label_width)
+        {
+            group->max_label_width = group->label_runs[i].width;
+        }
+    }
+
     group->base.rect = *rect;
     group->base.ops = &SEGMENT_GROUP_OPS;
+    group->base.allocator = allocator;
     group->base.visible = true;
     group->base.enabled = true;
     group->base.parent = NULL;
     group->base.align_h = UI_ALIGN_LEFT;
     group->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&group->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&group->base);
     group->labels = labels;
     group->segment_count = segment_count;
     group->selected_index = initial_selected_index;
     group->has_pressed_segment = false;
     group->pressed_index = initial_selected_index;
+    group->has_hovered_segment = false;
+    group->hovered_index = initial_selected_index;
     group->base_color = base_color;
     group->selected_color = selected_color;
     group->pressed_color = pressed_color;
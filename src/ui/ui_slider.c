@@ -1,9 +1,10 @@
 #include "ui/ui_slider.h"
 
-#include <stdlib.h>
+#include "system/ui_render.h"
 
 static const float TRACK_HEIGHT = 4.0F;
 static const float DEFAULT_THUMB_WIDTH = 12.0F;
+static const float HOVER_COLOR_MIX = 0.5F;
 
 static float clamp_slider_value(const ui_slider *slider, float value)
 {
@@ -52,6 +53,10 @@ static void set_slider_value_from_cursor(ui_slider *slider, float cursor_x)
 
     const float old_value = slider->value;
     slider->value = clamp_slider_value(slider, new_value);
+    if (slider->value != old_value)
+    {
+        ui_element_invalidate_render(&slider->base);
+    }
     if (slider->on_change != NULL && slider->value != old_value)
     {
         slider->on_change(slider->value, slider->on_change_context);
@@ -69,6 +74,7 @@ static bool handle_slider_event(ui_element *element, const SDL_Event *event)
         if (SDL_PointInRectFloat(&cursor, &sr))
         {
             slider->is_dragging = true;
+            ui_element_invalidate_render(element);
             set_slider_value_from_cursor(slider, event->button.x);
             return true;
         }
@@ -87,6 +93,7 @@ static bool handle_slider_event(ui_element *element, const SDL_Event *event)
         {
             set_slider_value_from_cursor(slider, event->button.x);
             slider->is_dragging = false;
+            ui_element_invalidate_render(element);
             return true;
         }
     }
@@ -94,6 +101,24 @@ static bool handle_slider_event(ui_element *element, const SDL_Event *event)
     return false;
 }
 
+static void update_slider_hover(ui_element *element, const SDL_FPoint *point)
+{
+    ui_slider *slider = (ui_slider *)element;
+    bool thumb_hovered = false;
+    if (point != NULL)
+    {
+        const SDL_FRect sr = ui_element_screen_rect(element);
+        const SDL_FRect thumb_rect = get_thumb_rect(slider, &sr);
+        thumb_hovered = SDL_PointInRectFloat(point, &thumb_rect);
+    }
+
+    if (slider->is_thumb_hovered != thumb_hovered)
+    {
+        slider->is_thumb_hovered = thumb_hovered;
+        ui_element_invalidate_render(element);
+    }
+}
+
 static void update_slider(ui_element *element, float delta_seconds)
 {
     (void)element;
@@ -107,16 +132,20 @@ static void render_slider(const ui_element *element, SDL_Renderer *renderer)
     const float track_y = sr.y + ((sr.h - TRACK_HEIGHT) * 0.5F);
     const SDL_FRect track_rect = {sr.x, track_y, sr.w, TRACK_HEIGHT};
     const SDL_FRect thumb_rect = get_thumb_rect(slider, &sr);
-    const SDL_Color current_thumb_color =
-        slider->is_dragging ? slider->active_thumb_color : slider->thumb_color;
+    SDL_Color current_thumb_color = slider->thumb_color;
+    if (slider->is_dragging)
+    {
+        current_thumb_color = slider->active_thumb_color;
+    }
+    else if (slider->is_thumb_hovered)
+    {
+        current_thumb_color =
+            ui_render_mix_color(slider->thumb_color, slider->active_thumb_color, HOVER_COLOR_MIX);
+    }
 
-    SDL_SetRenderDrawColor(renderer, slider->track_color.r, slider->track_color.g,
-                           slider->track_color.b, slider->track_color.a);
-    SDL_RenderFillRect(renderer, &track_rect);
+    ui_render_fill_rect(renderer, &track_rect, slider->track_color);
 
-    SDL_SetRenderDrawColor(renderer, current_thumb_color.r, current_thumb_color.g,
-                           current_thumb_color.b, current_thumb_color.a);
-    SDL_RenderFillRect(renderer, &thumb_rect);
+    ui_render_fill_rect(renderer, &thumb_rect, current_thumb_color);
 
     if (slider->base.has_border)
     {
@@ -125,20 +154,26 @@ static void render_slider(const ui_element *element, SDL_Renderer *renderer)
     }
 }
 
-static void destroy_slider(ui_element *element) { free(element); }
+static void destroy_slider(ui_element *element)
+{
+    cui_free(element->allocator, element, sizeof(ui_slider));
+}
 
 static const ui_element_ops SLIDER_OPS = {
+    .type_name = "slider",
     .handle_event = handle_slider_event,
+    .update_hover = update_slider_hover,
     .update = update_slider,
     .render = render_slider,
     .destroy = destroy_slider,
 };
 
 // NOLINTBEGIN(bugprone-easily-swappable-parameters)
-ui_slider *ui_slider_create(const SDL_FRect *rect, float min_value, float max_value,
-                            float initial_value, SDL_Color track_color, SDL_Color thumb_color,
-                            SDL_Color active_thumb_color, const SDL_Color *border_color,
-                            slider_change_handler on_change, void *on_change_context)
+ui_slider *ui_slider_create(const cui_allocator *allocator, const SDL_FRect *rect, float min_value,
+                            float max_value, float initial_value, SDL_Color track_color,
+                            SDL_Color thumb_color, SDL_Color active_thumb_color,
+                            const SDL_Color *border_color, slider_change_handler on_change,
+                            void *on_change_context)
 // NOLINTEND(bugprone-easily-swappable-parameters)
 {
     if (rect == NULL || rect->w <= 0.0F || rect->h <= 0.0F || min_value >= max_value)
@@ -146,7 +181,7 @@ ui_slider *ui_slider_create(const SDL_FRect *rect, float min_value, float max_va
         return NULL;
     }
 
-    ui_slider *slider = malloc(sizeof(*slider));
+    ui_slider *slider = cui_alloc(allocator, sizeof(*slider));
     if (slider == NULL)
     {
         return NULL;
@@ -154,12 +189,14 @@ ui_slider *ui_slider_create(const SDL_FRect *rect, float min_value, float max_va
 
     slider->base.rect = *rect;
     slider->base.ops = &SLIDER_OPS;
+    slider->base.allocator = allocator;
     slider->base.visible = true;
     slider->base.enabled = true;
     slider->base.parent = NULL;
     slider->base.align_h = UI_ALIGN_LEFT;
     slider->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&slider->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&slider->base);
     slider->min_value = min_value;
     slider->max_value = max_value;
     slider->value = initial_value;
@@ -172,6 +209,7 @@ ui_slider *ui_slider_create(const SDL_FRect *rect, float min_value, float max_va
     slider->thumb_color = thumb_color;
     slider->active_thumb_color = active_thumb_color;
     slider->is_dragging = false;
+    slider->is_thumb_hovered = false;
     slider->on_change = on_change;
     slider->on_change_context = on_change_context;
     slider->value = clamp_slider_value(slider, slider->value);
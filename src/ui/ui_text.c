@@ -1,30 +1,11 @@
 #include "ui/ui_text.h"
 
+#include "system/ui_render.h"
+
+#include <stdarg.h>
 #include <stdbool.h>
-#include <stdlib.h>
 #include <string.h>
 
-static const float DEBUG_GLYPH_WIDTH = 8.0F;
-static const float DEBUG_GLYPH_HEIGHT = 8.0F;
-
-static char *duplicate_text_content(const char *content)
-{
-    if (content == NULL)
-    {
-        return NULL;
-    }
-
-    const size_t length = strlen(content);
-    char *copy = malloc(length + 1U);
-    if (copy == NULL)
-    {
-        return NULL;
-    }
-
-    memcpy(copy, content, length + 1U);
-    return copy;
-}
-
 static bool handle_text_event(ui_element *element, const SDL_Event *event)
 {
     (void)element;
@@ -48,12 +29,11 @@ static void measure_text(ui_element *element, const SDL_FRect *available_rect)
         return;
     }
 
-    const float intrinsic_width = (float)strlen(text->content) * DEBUG_GLYPH_WIDTH;
-    if (text->base.rect.w < intrinsic_width)
+    if (text->base.rect.w < text->run.width)
     {
-        text->base.rect.w = intrinsic_width;
+        text->base.rect.w = text->run.width;
     }
-    text->base.rect.h = DEBUG_GLYPH_HEIGHT;
+    text->base.rect.h = text->run.height;
 }
 
 static void arrange_text(ui_element *element, const SDL_FRect *final_rect)
@@ -81,13 +61,12 @@ static void render_text(const ui_element *element, SDL_Renderer *renderer)
     // Centering here keeps text aligned with sibling controls (checkboxes/buttons)
     // in compact rows without changing legacy top-aligned behavior for fixed text.
     float draw_y = sr.y;
-    if (sr.h > DEBUG_GLYPH_HEIGHT)
+    if (sr.h > text->run.height)
     {
-        draw_y += (sr.h - DEBUG_GLYPH_HEIGHT) * 0.5F;
+        draw_y += (sr.h - text->run.height) * 0.5F;
     }
 
-    SDL_SetRenderDrawColor(renderer, text->color.r, text->color.g, text->color.b, text->color.a);
-    SDL_RenderDebugText(renderer, sr.x, draw_y, text->content);
+    ui_render_debug_text(renderer, sr.x, draw_y, text->content, text->color);
     if (text->base.has_border)
     {
         ui_element_render_inner_border(renderer, &sr, text->base.border_color,
@@ -95,14 +74,107 @@ static void render_text(const ui_element *element, SDL_Renderer *renderer)
     }
 }
 
+static bool has_inline_storage(const ui_text *text)
+{
+    return text->storage == text->inline_storage;
+}
+
+// Drop the reference to a pooled string and point content back at storage.
+static void release_shared(ui_text *text)
+{
+    if (text->shared_pool != NULL)
+    {
+        string_pool_release(text->shared_pool, text->content);
+        text->shared_pool = NULL;
+    }
+    text->content = text->storage;
+}
+
+static void release_storage(ui_text *text)
+{
+    if (!has_inline_storage(text))
+    {
+        cui_free(text->base.allocator, text->storage, text->capacity);
+    }
+    text->storage = text->inline_storage;
+    text->capacity = UI_TEXT_INLINE_CAPACITY;
+}
+
+/*
+ * Allocate a buffer for at least size bytes, doubling the current capacity so
+ * steadily growing content reallocates O(log n) times. The caller fills it
+ * and installs it with install_storage, so the source may still alias the
+ * old buffer while copying.
+ */
+static char *allocate_storage(const ui_text *text, size_t size, size_t *out_capacity)
+{
+    size_t capacity = text->capacity * 2U;
+    if (capacity < size)
+    {
+        capacity = size;
+    }
+
+    char *storage = cui_alloc(text->base.allocator, capacity);
+    if (storage != NULL)
+    {
+        *out_capacity = capacity;
+    }
+    return storage;
+}
+
+static void install_storage(ui_text *text, char *storage, size_t capacity)
+{
+    release_storage(text);
+    text->storage = storage;
+    text->capacity = capacity;
+}
+
+/*
+ * Copy length bytes of content (plus terminator) into the element's buffer
+ * and make it the current content, dropping any pooled string afterwards
+ * (content may be that string).
+ */
+static bool store_content(ui_text *text, const char *content, size_t length)
+{
+    if (length < text->capacity)
+    {
+        // memmove: content may be a suffix of the current buffer.
+        memmove(text->storage, content, length + 1U);
+    }
+    else
+    {
+        size_t capacity = 0U;
+        char *storage = allocate_storage(text, length + 1U, &capacity);
+        if (storage == NULL)
+        {
+            return false;
+        }
+        memcpy(storage, content, length + 1U);
+        install_storage(text, storage, capacity);
+    }
+
+    release_shared(text);
+    return true;
+}
+
+static void apply_content(ui_text *text, size_t length)
+{
+    ui_text_run_set_length(&text->run, text->content, length);
+    text->base.rect.w = text->run.width;
+    text->base.rect.h = text->run.height;
+    ui_element_invalidate_measure(&text->base);
+}
+
 static void destroy_text(ui_element *element)
 {
     ui_text *text = (ui_text *)element;
-    free(text->content);
-    free(text);
+    release_shared(text);
+    release_storage(text);
+    cui_free(element->allocator, text, sizeof(*text));
 }
 
 static const ui_element_ops TEXT_OPS = {
+    .type_name = "text",
     .measure = measure_text,
     .arrange = arrange_text,
     .handle_event = handle_text_event,
@@ -111,29 +183,34 @@ static const ui_element_ops TEXT_OPS = {
     .destroy = destroy_text,
 };
 
-ui_text *ui_text_create(float x, float y, const char *content, SDL_Color color,
-                        const SDL_Color *border_color)
+ui_text *ui_text_create(const cui_allocator *allocator, float x, float y, const char *content,
+                        SDL_Color color, const SDL_Color *border_color)
 {
     if (content == NULL)
     {
         return NULL;
     }
 
-    ui_text *text = malloc(sizeof(*text));
+    ui_text *text = cui_alloc(allocator, sizeof(*text));
     if (text == NULL)
     {
         return NULL;
     }
 
-    char *content_copy = duplicate_text_content(content);
-    if (content_copy == NULL)
+    text->base.allocator = allocator;
+    text->storage = text->inline_storage;
+    text->content = text->storage;
+    text->capacity = UI_TEXT_INLINE_CAPACITY;
+    text->shared_pool = NULL;
+    const size_t length = strlen(content);
+    if (!store_content(text, content, length))
     {
-        free(text);
+        cui_free(allocator, text, sizeof(*text));
         return NULL;
     }
 
-    const float text_width = (float)strlen(content_copy) * DEBUG_GLYPH_WIDTH;
-    text->base.rect = (SDL_FRect){x, y, text_width, DEBUG_GLYPH_HEIGHT};
+    ui_text_run_set_length(&text->run, text->content, length);
+    text->base.rect = (SDL_FRect){x, y, text->run.width, text->run.height};
     text->base.ops = &TEXT_OPS;
     text->base.visible = true;
     text->base.enabled = false;
@@ -141,8 +218,8 @@ ui_text *ui_text_create(float x, float y, const char *content, SDL_Color color,
     text->base.align_h = UI_ALIGN_LEFT;
     text->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&text->base, border_color, 1.0F);
+    ui_element_reset_layout_cache(&text->base);
     text->color = color;
-    text->content = content_copy;
 
     return text;
 }
@@ -154,16 +231,91 @@ bool ui_text_set_content(ui_text *text, const char *content)
         return false;
     }
 
-    char *content_copy = duplicate_text_content(content);
-    if (content_copy == NULL)
+    const size_t length = strlen(content);
+    if (length == text->run.byte_length && memcmp(text->content, content, length) == 0)
+    {
+        return true;
+    }
+
+    if (!store_content(text, content, length))
+    {
+        return false;
+    }
+    apply_content(text, length);
+    return true;
+}
+
+bool ui_text_set_format(ui_text *text, const char *format, ...)
+{
+    if (text == NULL || format == NULL)
     {
         return false;
     }
 
-    free(text->content);
-    text->content = content_copy;
-    text->base.rect.w = (float)strlen(text->content) * DEBUG_GLYPH_WIDTH;
-    text->base.rect.h = DEBUG_GLYPH_HEIGHT;
+    va_list args;
+    va_list retry_args;
+    va_start(args, format);
+    va_copy(retry_args, args);
+    const int written = SDL_vsnprintf(text->storage, text->capacity, format, args);
+    va_end(args);
+
+    bool ok = written >= 0;
+    size_t length = ok ? (size_t)written : 0U;
+    if (ok && length >= text->capacity)
+    {
+        // The first pass stored a truncated prefix; format again into a buffer
+        // sized from its return value.
+        size_t capacity = 0U;
+        char *storage = allocate_storage(text, length + 1U, &capacity);
+        ok = storage != NULL;
+        if (ok)
+        {
+            (void)SDL_vsnprintf(storage, capacity, format, retry_args);
+            install_storage(text, storage, capacity);
+        }
+    }
+    va_end(retry_args);
+
+    if (!ok)
+    {
+        // The buffer may hold partial output; leave the element empty instead.
+        text->storage[0] = '\0';
+        length = 0U;
+    }
+    // Released only now: the arguments may point into a pooled content string.
+    release_shared(text);
+    apply_content(text, length);
+    return ok;
+}
+
+bool ui_text_set_interned(ui_text *text, string_pool *pool, const char *interned)
+{
+    if (text == NULL || pool == NULL || interned == NULL)
+    {
+        return false;
+    }
+
+    if (text->content == interned)
+    {
+        return true;
+    }
+
+    const size_t length = string_pool_length(interned);
+    const bool unchanged =
+        length == text->run.byte_length && memcmp(text->content, interned, length) == 0;
+
+    (void)string_pool_retain(pool, interned);
+    release_shared(text);
+    text->content = interned;
+    text->shared_pool = pool;
+
+    if (unchanged)
+    {
+        // Same glyphs, new address: keep the metrics and the layout.
+        text->run.text = interned;
+        return true;
+    }
+    apply_content(text, length);
     return true;
 }
 
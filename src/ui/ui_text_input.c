@@ -1,12 +1,10 @@
 #include "ui/ui_text_input.h"
 
+#include "system/ui_render.h"
 #include "util/string_util.h"
 
-#include <stdlib.h>
 #include <string.h>
 
-static const float DEBUG_GLYPH_WIDTH = 8.0F;
-static const float DEBUG_GLYPH_HEIGHT = 8.0F;
 static const float TEXT_PADDING = 4.0F;
 static const float CARET_BLINK_PERIOD = 1.0F;
 static const float CARET_BLINK_HALF = 0.5F;
@@ -27,7 +25,7 @@ static size_t compute_max_visible_chars(float width)
         return 0U;
     }
 
-    size_t max_visible = (size_t)(usable_width / DEBUG_GLYPH_WIDTH);
+    size_t max_visible = ui_text_run_glyphs_in_width(usable_width);
     if (max_visible > UI_TEXT_INPUT_BUFFER_SIZE - 1U)
     {
         max_visible = UI_TEXT_INPUT_BUFFER_SIZE - 1U;
@@ -35,6 +33,15 @@ static size_t compute_max_visible_chars(float width)
     return max_visible;
 }
 
+// Every edit goes through here so text_run always matches the buffer.
+// length must be a codepoint boundary.
+static void set_text_length(ui_text_input *input, size_t length)
+{
+    input->length = length;
+    input->buffer[length] = '\0';
+    ui_text_run_set_length(&input->text_run, input->buffer, length);
+}
+
 static void update_visible_capacity(ui_text_input *input)
 {
     if (input == NULL)
@@ -43,13 +50,32 @@ static void update_visible_capacity(ui_text_input *input)
     }
 
     input->max_length = compute_max_visible_chars(input->base.rect.w);
-    if (input->length > input->max_length)
+    if (input->text_run.glyph_count > input->max_length)
     {
-        input->length = input->max_length;
-        input->buffer[input->length] = '\0';
+        set_text_length(input, utf8_prefix_bytes(input->buffer, input->length, input->max_length));
+        ui_element_invalidate_render(&input->base);
     }
 }
 
+/*
+ * Return how many leading bytes of text (text_length bytes) fit in the input
+ * after length bytes holding glyph_count glyphs: at most max_length glyphs in
+ * total and the buffer size, cut on a codepoint boundary.
+ */
+static size_t fitting_prefix(const ui_text_input *input, const char *text, size_t text_length,
+                             size_t length, size_t glyph_count)
+{
+    const size_t glyph_room =
+        input->max_length > glyph_count ? input->max_length - glyph_count : 0U;
+    const size_t byte_room = (UI_TEXT_INPUT_BUFFER_SIZE - 1U) - length;
+    size_t fit = utf8_prefix_bytes(text, text_length, glyph_room);
+    if (fit > byte_room)
+    {
+        fit = utf8_floor_boundary(text, text_length, byte_room);
+    }
+    return fit;
+}
+
 static void set_focus(ui_text_input *input, bool focused)
 {
     if (input == NULL || input->is_focused == focused)
@@ -61,6 +87,7 @@ static void set_focus(ui_text_input *input, bool focused)
     input->caret_blink_timer = 0.0F;
     input->base.border_color =
         focused ? input->focused_border_color : input->unfocused_border_color;
+    ui_element_invalidate_render(&input->base);
 
     if (focused)
     {
@@ -91,18 +118,14 @@ static bool handle_text_input_event(ui_element *element, const SDL_Event *event)
     if (event->type == SDL_EVENT_TEXT_INPUT)
     {
         const char *text = event->text.text;
-        size_t text_len = strlen(text);
-        const size_t available = input->max_length - input->length;
-        if (text_len > available)
-        {
-            text_len = available;
-        }
+        const size_t text_len = fitting_prefix(input, text, strlen(text), input->length,
+                                               input->text_run.glyph_count);
         if (text_len > 0)
         {
             memcpy(input->buffer + input->length, text, text_len);
-            input->length += text_len;
-            input->buffer[input->length] = '\0';
+            set_text_length(input, input->length + text_len);
             input->caret_blink_timer = 0.0F;
+            ui_element_invalidate_render(element);
         }
         return true;
     }
@@ -113,9 +136,11 @@ static bool handle_text_input_event(ui_element *element, const SDL_Event *event)
         {
             if (input->length > 0)
             {
-                input->length--;
-                input->buffer[input->length] = '\0';
+                // Remove the whole last codepoint, not just its final byte.
+                const size_t last = input->length - 1U;
+                set_text_length(input, utf8_floor_boundary(input->buffer, input->length, last));
                 input->caret_blink_timer = 0.0F;
+                ui_element_invalidate_render(element);
             }
             return true;
         }
@@ -139,14 +164,35 @@ static void update_text_input(ui_element *element, float delta_seconds)
 
     if (input->is_focused)
     {
+        const bool was_caret_visible = input->caret_blink_timer < CARET_BLINK_HALF;
         input->caret_blink_timer += delta_seconds;
-        if (input->caret_blink_timer >= CARET_BLINK_PERIOD)
+        while (input->caret_blink_timer >= CARET_BLINK_PERIOD)
         {
             input->caret_blink_timer -= CARET_BLINK_PERIOD;
         }
+        if (was_caret_visible != (input->caret_blink_timer < CARET_BLINK_HALF))
+        {
+            ui_element_invalidate_render(element);
+        }
     }
 }
 
+static float next_text_input_frame_delay(const ui_element *element)
+{
+    const ui_text_input *input = (const ui_text_input *)element;
+    if (!input->is_focused)
+    {
+        return UI_NO_FRAME_REQUEST;
+    }
+
+    // Wake up exactly when the caret toggles between its visible and hidden halves.
+    if (input->caret_blink_timer < CARET_BLINK_HALF)
+    {
+        return CARET_BLINK_HALF - input->caret_blink_timer;
+    }
+    return CARET_BLINK_PERIOD - input->caret_blink_timer;
+}
+
 static void measure_text_input(ui_element *element, const SDL_FRect *available_rect)
 {
     (void)available_rect;
@@ -157,9 +203,9 @@ static void measure_text_input(ui_element *element, const SDL_FRect *available_r
         return;
     }
 
-    if (input->base.rect.h < DEBUG_GLYPH_HEIGHT + (PADDING_SIDES * TEXT_PADDING))
+    if (input->base.rect.h < UI_TEXT_GLYPH_HEIGHT + (PADDING_SIDES * TEXT_PADDING))
     {
-        input->base.rect.h = DEBUG_GLYPH_HEIGHT + (PADDING_SIDES * TEXT_PADDING);
+        input->base.rect.h = UI_TEXT_GLYPH_HEIGHT + (PADDING_SIDES * TEXT_PADDING);
     }
 
     update_visible_capacity(input);
@@ -183,36 +229,29 @@ static void render_text_input(const ui_element *element, SDL_Renderer *renderer)
     const SDL_FRect sr = ui_element_screen_rect(element);
 
     // Background fill.
-    SDL_SetRenderDrawColor(renderer, input->background_color.r, input->background_color.g,
-                           input->background_color.b, input->background_color.a);
-    SDL_RenderFillRect(renderer, &sr);
+    ui_render_fill_rect(renderer, &sr, input->background_color);
 
     const float text_x = sr.x + TEXT_PADDING;
-    const float text_y = sr.y + ((sr.h - DEBUG_GLYPH_HEIGHT) * HALF);
+    const float text_y = sr.y + ((sr.h - UI_TEXT_GLYPH_HEIGHT) * HALF);
 
     // Text content.
-    if (input->length > 0)
+    if (!ui_text_run_is_empty(&input->text_run))
     {
-        SDL_SetRenderDrawColor(renderer, input->text_color.r, input->text_color.g,
-                               input->text_color.b, input->text_color.a);
-        SDL_RenderDebugText(renderer, text_x, text_y, input->buffer);
+        ui_render_debug_text(renderer, text_x, text_y, input->text_run.text, input->text_color);
     }
-    else if (!input->is_focused && input->placeholder != NULL && input->placeholder[0] != '\0')
+    else if (!input->is_focused && !ui_text_run_is_empty(&input->placeholder_run))
     {
-        SDL_SetRenderDrawColor(renderer, input->placeholder_color.r, input->placeholder_color.g,
-                               input->placeholder_color.b, input->placeholder_color.a);
-        SDL_RenderDebugText(renderer, text_x, text_y, input->placeholder);
+        ui_render_debug_text(renderer, text_x, text_y, input->placeholder_run.text,
+                             input->placeholder_color);
     }
 
     // Blinking caret when focused (visible during the first half of the blink cycle).
     if (input->is_focused && input->caret_blink_timer < CARET_BLINK_HALF)
     {
-        const float caret_x = text_x + ((float)input->length * DEBUG_GLYPH_WIDTH);
-        const SDL_FRect caret_rect = {caret_x, text_y, CARET_WIDTH, DEBUG_GLYPH_HEIGHT};
+        const float caret_x = text_x + input->text_run.width;
+        const SDL_FRect caret_rect = {caret_x, text_y, CARET_WIDTH, UI_TEXT_GLYPH_HEIGHT};
 
-        SDL_SetRenderDrawColor(renderer, input->text_color.r, input->text_color.g,
-                               input->text_color.b, input->text_color.a);
-        SDL_RenderFillRect(renderer, &caret_rect);
+        ui_render_fill_rect(renderer, &caret_rect, input->text_color);
     }
 
     // Border (always enabled for text inputs).
@@ -231,27 +270,30 @@ static void destroy_text_input(ui_element *element)
     {
         SDL_StopTextInput(input->window);
     }
-    free(input->placeholder);
-    free(element);
+    cui_free_string(element->allocator, input->placeholder);
+    cui_free(element->allocator, input, sizeof(*input));
 }
 
 static const ui_element_ops TEXT_INPUT_OPS = {
+    .type_name = "text_input",
     .measure = measure_text_input,
     .arrange = arrange_text_input,
     .handle_event = handle_text_input_event,
     .can_focus = can_focus_text_input,
     .set_focus = set_text_input_focus,
     .update = update_text_input,
+    .next_frame_delay = next_text_input_frame_delay,
     .render = render_text_input,
     .destroy = destroy_text_input,
 };
 
 // NOLINTBEGIN(bugprone-easily-swappable-parameters)
-ui_text_input *ui_text_input_create(const SDL_FRect *rect, SDL_Color text_color,
-                                    SDL_Color background_color, SDL_Color border_color,
-                                    SDL_Color focused_border_color, const char *placeholder,
-                                    SDL_Color placeholder_color, SDL_Window *window,
-                                    text_input_submit_handler on_submit, void *on_submit_context)
+ui_text_input *ui_text_input_create(const cui_allocator *allocator, const SDL_FRect *rect,
+                                    SDL_Color text_color, SDL_Color background_color,
+                                    SDL_Color border_color, SDL_Color focused_border_color,
+                                    const char *placeholder, SDL_Color placeholder_color,
+                                    SDL_Window *window, text_input_submit_handler on_submit,
+                                    void *on_submit_context)
 // NOLINTEND(bugprone-easily-swappable-parameters)
 {
     if (rect == NULL || rect->w <= 0.0F || rect->h <= 0.0F || window == NULL)
@@ -259,7 +301,7 @@ ui_text_input *ui_text_input_create(const SDL_FRect *rect, SDL_Color text_color,
         return NULL;
     }
 
-    ui_text_input *input = malloc(sizeof(*input));
+    ui_text_input *input = cui_alloc(allocator, sizeof(*input));
     if (input == NULL)
     {
         return NULL;
@@ -267,16 +309,18 @@ ui_text_input *ui_text_input_create(const SDL_FRect *rect, SDL_Color text_color,
 
     input->base.rect = *rect;
     input->base.ops = &TEXT_INPUT_OPS;
+    input->base.allocator = allocator;
     input->base.visible = true;
     input->base.enabled = true;
     input->base.parent = NULL;
     input->base.align_h = UI_ALIGN_LEFT;
     input->base.align_v = UI_ALIGN_TOP;
     ui_element_set_border(&input->base, &border_color, 1.0F);
+    ui_element_reset_layout_cache(&input->base);
 
-    input->buffer[0] = '\0';
     input->placeholder = NULL;
-    input->length = 0;
+    ui_text_run_set(&input->placeholder_run, NULL);
+    set_text_length(input, 0U);
 
     update_visible_capacity(input);
 
@@ -293,7 +337,7 @@ ui_text_input *ui_text_input_create(const SDL_FRect *rect, SDL_Color text_color,
 
     if (!ui_text_input_set_placeholder(input, placeholder))
     {
-        free(input);
+        cui_free(allocator, input, sizeof(*input));
         return NULL;
     }
 
@@ -316,16 +360,11 @@ bool ui_text_input_set_value(ui_text_input *input, const char *value)
         return false;
     }
 
-    size_t value_length = strlen(value);
-    if (value_length > input->max_length)
-    {
-        value_length = input->max_length;
-    }
-
+    const size_t value_length = fitting_prefix(input, value, strlen(value), 0U, 0U);
     memcpy(input->buffer, value, value_length);
-    input->buffer[value_length] = '\0';
-    input->length = value_length;
+    set_text_length(input, value_length);
     input->caret_blink_timer = 0.0F;
+    ui_element_invalidate_render(&input->base);
     return true;
 }
 
@@ -338,19 +377,23 @@ bool ui_text_input_set_placeholder(ui_text_input *input, const char *placeholder
 
     if (placeholder == NULL)
     {
-        free(input->placeholder);
+        cui_free_string(input->base.allocator, input->placeholder);
         input->placeholder = NULL;
+        ui_text_run_set(&input->placeholder_run, NULL);
+        ui_element_invalidate_render(&input->base);
         return true;
     }
 
-    char *placeholder_copy = duplicate_string(placeholder);
+    char *placeholder_copy = cui_strdup(input->base.allocator, placeholder);
     if (placeholder_copy == NULL)
     {
         return false;
     }
 
-    free(input->placeholder);
+    cui_free_string(input->base.allocator, input->placeholder);
     input->placeholder = placeholder_copy;
+    ui_text_run_set(&input->placeholder_run, placeholder_copy);
+    ui_element_invalidate_render(&input->base);
     return true;
 }
 
@@ -360,9 +403,9 @@ void ui_text_input_clear(ui_text_input *input)
     {
         return;
     }
-    input->buffer[0] = '\0';
-    input->length = 0;
+    set_text_length(input, 0U);
     input->caret_blink_timer = 0.0F;
+    ui_element_invalidate_render(&input->base);
 }
 
 bool ui_text_input_is_focused(const ui_text_input *input)
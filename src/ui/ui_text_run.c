@@ -0,0 +1,70 @@
+#include "ui/ui_text_run.h"
+
+#include "util/string_util.h"
+
+#include <string.h>
+
+/*
+ * Count glyphs the way SDL_RenderDebugText and the glyph atlas draw them:
+ * one per SDL_StepUTF8 step, malformed sequences included (drawn as U+FFFD).
+ */
+static size_t count_glyphs(const char *text, size_t byte_length)
+{
+    if (utf8_is_valid(text, byte_length))
+    {
+        return utf8_count_codepoints(text, byte_length);
+    }
+
+    size_t count = 0U;
+    size_t remaining = byte_length;
+    while (remaining > 0U && SDL_StepUTF8(&text, &remaining) != 0U)
+    {
+        count++;
+    }
+    return count;
+}
+
+void ui_text_run_set(ui_text_run *run, const char *text)
+{
+    if (run == NULL)
+    {
+        return;
+    }
+
+    const char *content = text != NULL ? text : "";
+    ui_text_run_set_length(run, content, strlen(content));
+}
+
+void ui_text_run_set_length(ui_text_run *run, const char *text, size_t byte_length)
+{
+    if (run == NULL)
+    {
+        return;
+    }
+
+    if (text == NULL)
+    {
+        text = "";
+        byte_length = 0U;
+    }
+
+    run->text = text;
+    run->byte_length = byte_length;
+    run->glyph_count = count_glyphs(text, byte_length);
+    run->width = (float)run->glyph_count * UI_TEXT_GLYPH_WIDTH;
+    run->height = UI_TEXT_GLYPH_HEIGHT;
+}
+
+bool ui_text_run_is_empty(const ui_text_run *run)
+{
+    return run == NULL || run->glyph_count == 0U;
+}
+
+size_t ui_text_run_glyphs_in_width(float width)
+{
+    if (width <= 0.0F)
+    {
+        return 0U;
+    }
+    return (size_t)(width / UI_TEXT_GLYPH_WIDTH);
+}
@@ -1,6 +1,7 @@
 #include "ui/ui_window.h"
 
-#include <stdlib.h>
+#include "system/ui_ops_profiler.h"
+#include "system/ui_traversal.h"
 
 static bool is_valid_element(const ui_element *element)
 {
@@ -78,7 +79,10 @@ static bool dispatch_to_child(ui_element *child, const SDL_Event *event)
         return false;
     }
 
-    return child->ops->handle_event(child, event);
+    UI_OPS_PROFILE_ENTER(scope, child->ops, UI_OPS_CALL_HANDLE_EVENT);
+    const bool handled = child->ops->handle_event(child, event);
+    UI_OPS_PROFILE_LEAVE(scope);
+    return handled;
 }
 
 static void set_focused_child(ui_window *window, ui_element *next_focus)
@@ -106,16 +110,20 @@ static void set_focused_child(ui_window *window, ui_element *next_focus)
     }
 }
 
-static ui_element *find_top_focusable_child_at(const ui_window *window, const SDL_FPoint *point)
+static ui_element *find_top_focusable_child_at(ui_window *window, const SDL_FPoint *point)
 {
     if (window == NULL || point == NULL)
     {
         return NULL;
     }
 
-    for (size_t i = window->child_count; i > 0U; --i)
+    ui_spatial_cursor cursor;
+    ui_spatial_index_query(&window->hit_index, window->children, window->child_count, point,
+                           &cursor);
+    size_t i = 0U;
+    while (ui_spatial_cursor_next(&cursor, &i))
     {
-        ui_element *child = window->children[i - 1U];
+        ui_element *child = window->children[i];
         if (!is_focusable_element(child) || !hit_test_child(child, point))
         {
             continue;
@@ -126,17 +134,43 @@ static ui_element *find_top_focusable_child_at(const ui_window *window, const SD
     return NULL;
 }
 
-static ui_element *dispatch_pointer_to_top_child(ui_window *window, const SDL_Event *event,
-                                                 const SDL_FPoint *point)
+static ui_element *find_top_hoverable_child_at(ui_window *window, const SDL_FPoint *point)
+{
+    ui_spatial_cursor cursor;
+    ui_spatial_index_query(&window->hit_index, window->children, window->child_count, point,
+                           &cursor);
+    size_t i = 0U;
+    while (ui_spatial_cursor_next(&cursor, &i))
+    {
+        ui_element *child = window->children[i];
+        if (is_valid_element(child) && child->enabled && hit_test_child(child, point))
+        {
+            return child;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Offer a pointer event to the topmost children under point until one handles
+ * it, reporting the handler through a handle taken before dispatch.
+ */
+static bool dispatch_pointer_to_top_child(ui_window *window, const SDL_Event *event,
+                                          const SDL_FPoint *point, ui_handle *out_handled)
 {
     if (window == NULL || event == NULL || point == NULL)
     {
-        return NULL;
+        return false;
     }
 
-    for (size_t i = window->child_count; i > 0U; --i)
+    ui_spatial_cursor cursor;
+    ui_spatial_index_query(&window->hit_index, window->children, window->child_count, point,
+                           &cursor);
+    size_t i = 0U;
+    while (ui_spatial_cursor_next(&cursor, &i))
     {
-        ui_element *child = window->children[i - 1U];
+        ui_element *child = window->children[i];
         if (!is_valid_element(child) || !child->enabled || child->ops->handle_event == NULL)
         {
             continue;
@@ -147,13 +181,21 @@ static ui_element *dispatch_pointer_to_top_child(ui_window *window, const SDL_Ev
             continue;
         }
 
-        if (child->ops->handle_event(child, event))
+        const ui_handle handle = ui_handle_acquire(child);
+        UI_OPS_PROFILE_ENTER(scope, child->ops, UI_OPS_CALL_HANDLE_EVENT);
+        const bool handled = child->ops->handle_event(child, event);
+        UI_OPS_PROFILE_LEAVE(scope);
+        if (handled)
         {
-            return child;
+            if (out_handled != NULL)
+            {
+                *out_handled = handle;
+            }
+            return true;
         }
     }
 
-    return NULL;
+    return false;
 }
 
 static void run_window_layout_pass(ui_window *window)
@@ -244,32 +286,38 @@ static bool handle_window_event(ui_element *element, const SDL_Event *event)
         if (event->type == SDL_EVENT_MOUSE_BUTTON_DOWN && event->button.button == SDL_BUTTON_LEFT)
         {
             set_focused_child(window, find_top_focusable_child_at(window, &point));
-            ui_element *handled = dispatch_pointer_to_top_child(window, event, &point);
-            window->captured_child = handled;
-            return handled != NULL;
+            const ui_handle self = ui_handle_acquire(element);
+            ui_handle handled = UI_HANDLE_NULL;
+            const bool consumed = dispatch_pointer_to_top_child(window, event, &point, &handled);
+            // The child's handler may have destroyed this window as well.
+            if (ui_handle_resolve(self) == element)
+            {
+                window->captured_child = handled;
+            }
+            return consumed;
         }
 
         if (event->type == SDL_EVENT_MOUSE_MOTION)
         {
-            if (dispatch_to_child(window->captured_child, event))
+            if (dispatch_to_child(ui_handle_resolve(window->captured_child), event))
             {
                 return true;
             }
-            return dispatch_pointer_to_top_child(window, event, &point) != NULL;
+            return dispatch_pointer_to_top_child(window, event, &point, NULL);
         }
 
         if (event->type == SDL_EVENT_MOUSE_BUTTON_UP && event->button.button == SDL_BUTTON_LEFT)
         {
-            if (dispatch_to_child(window->captured_child, event))
+            ui_element *captured = ui_handle_resolve(window->captured_child);
+            window->captured_child = UI_HANDLE_NULL;
+            if (dispatch_to_child(captured, event))
             {
-                window->captured_child = NULL;
                 return true;
             }
-            window->captured_child = NULL;
-            return dispatch_pointer_to_top_child(window, event, &point) != NULL;
+            return dispatch_pointer_to_top_child(window, event, &point, NULL);
         }
 
-        return dispatch_pointer_to_top_child(window, event, &point) != NULL;
+        return dispatch_pointer_to_top_child(window, event, &point, NULL);
     }
 
     for (size_t i = window->child_count; i > 0U; --i)
@@ -314,7 +362,7 @@ static void set_window_focus(ui_element *element, bool focused)
     set_focused_child(window, NULL);
 }
 
-static void update_window(ui_element *element, float delta_seconds)
+static void update_window_hover(ui_element *element, const SDL_FPoint *point)
 {
     ui_window *window = (ui_window *)element;
     if (window == NULL)
@@ -322,34 +370,15 @@ static void update_window(ui_element *element, float delta_seconds)
         return;
     }
 
-    for (size_t i = 0; i < window->child_count; ++i)
-    {
-        ui_element *child = window->children[i];
-        if (!is_valid_element(child) || !child->enabled || child->ops->update == NULL)
-        {
-            continue;
-        }
-        child->ops->update(child, delta_seconds);
-    }
+    ui_element *next = point != NULL ? find_top_hoverable_child_at(window, point) : NULL;
+    ui_element_set_hovered_child(&window->hovered_child, next, point);
 }
 
-static void render_window(const ui_element *element, SDL_Renderer *renderer)
+static size_t get_window_children(const ui_element *element, ui_element *const **out_children)
 {
     const ui_window *window = (const ui_window *)element;
-    if (window == NULL)
-    {
-        return;
-    }
-
-    for (size_t i = 0; i < window->child_count; ++i)
-    {
-        const ui_element *child = window->children[i];
-        if (!is_valid_element(child) || !child->visible || child->ops->render == NULL)
-        {
-            continue;
-        }
-        child->ops->render(child, renderer);
-    }
+    *out_children = window->children;
+    return window->child_count;
 }
 
 static void destroy_window(ui_element *element)
@@ -360,38 +389,32 @@ static void destroy_window(ui_element *element)
         return;
     }
 
-    for (size_t i = 0; i < window->child_count; ++i)
-    {
-        ui_element *child = window->children[i];
-        if (is_valid_element(child) && child->ops->destroy != NULL)
-        {
-            child->ops->destroy(child);
-        }
-    }
-
-    free((void *)window->children);
-    free(window);
+    cui_free(element->allocator, (void *)window->children,
+             window->child_capacity * sizeof(ui_element *));
+    ui_spatial_index_destroy(&window->hit_index);
+    cui_free(element->allocator, window, sizeof(*window));
 }
 
 static const ui_element_ops WINDOW_OPS = {
+    .type_name = "window",
     .measure = measure_window,
     .arrange = arrange_window,
     .handle_event = handle_window_event,
     .can_focus = can_focus_window,
     .set_focus = set_window_focus,
-    .update = update_window,
-    .render = render_window,
+    .update_hover = update_window_hover,
+    .child_span = get_window_children,
     .destroy = destroy_window,
 };
 
-ui_window *ui_window_create(const SDL_FRect *rect)
+ui_window *ui_window_create(const cui_allocator *allocator, const SDL_FRect *rect)
 {
     if (rect == NULL || rect->w <= 0.0F || rect->h <= 0.0F)
     {
         return NULL;
     }
 
-    ui_window *window = malloc(sizeof(*window));
+    ui_window *window = cui_alloc(allocator, sizeof(*window));
     if (window == NULL)
     {
         return NULL;
@@ -402,14 +425,19 @@ ui_window *ui_window_create(const SDL_FRect *rect)
     window->base.align_h = UI_ALIGN_LEFT;
     window->base.align_v = UI_ALIGN_TOP;
     window->base.ops = &WINDOW_OPS;
+    window->base.allocator = allocator;
     window->base.visible = true;
     window->base.enabled = true;
     ui_element_clear_border(&window->base);
+    ui_element_reset_layout_cache(&window->base);
     window->children = NULL;
     window->child_count = 0U;
     window->child_capacity = 0U;
+    window->hole_count = 0U;
     window->focused_child = NULL;
-    window->captured_child = NULL;
+    window->captured_child = UI_HANDLE_NULL;
+    window->hovered_child = NULL;
+    ui_spatial_index_init(&window->hit_index);
     return window;
 }
 
@@ -422,6 +450,8 @@ bool ui_window_set_size(ui_window *window, float width, float height)
 
     window->base.rect.w = width;
     window->base.rect.h = height;
+    ui_element_invalidate_measure(&window->base);
+    ui_element_invalidate_subtree_screen_rects(&window->base);
     return true;
 }
 
@@ -435,8 +465,9 @@ bool ui_window_add_child(ui_window *window, ui_element *child)
     if (window->child_count == window->child_capacity)
     {
         size_t new_capacity = window->child_capacity == 0U ? 8U : window->child_capacity * 2U;
-        ui_element **new_children =
-            (ui_element **)realloc((void *)window->children, new_capacity * sizeof(ui_element *));
+        ui_element **new_children = (ui_element **)cui_realloc(
+            window->base.allocator, (void *)window->children,
+            window->child_capacity * sizeof(ui_element *), new_capacity * sizeof(ui_element *));
         if (new_children == NULL)
         {
             return false;
@@ -447,48 +478,105 @@ bool ui_window_add_child(ui_window *window, ui_element *child)
     }
 
     child->parent = &window->base;
+    ui_element_invalidate_subtree_screen_rects(child);
+    child->sibling_index = window->child_count;
     window->children[window->child_count++] = child;
+    ui_spatial_index_invalidate(&window->hit_index);
+    ui_element_invalidate_measure(&window->base);
     return true;
 }
 
-bool ui_window_remove_child(ui_window *window, ui_element *child, bool destroy_child)
+/*
+ * Detach the child in slot index, leaving a NULL hole behind.
+ */
+static void detach_child(ui_window *window, size_t index, bool destroy_child)
 {
-    if (window == NULL || !is_valid_element(child))
+    ui_element *child = window->children[index];
+    if (window->focused_child == child)
     {
-        return false;
+        set_focused_child(window, NULL);
+    }
+    if (ui_handle_resolve(window->captured_child) == child)
+    {
+        window->captured_child = UI_HANDLE_NULL;
+    }
+    if (window->hovered_child == child)
+    {
+        ui_element_set_hovered_child(&window->hovered_child, NULL, NULL);
     }
 
-    for (size_t i = 0; i < window->child_count; ++i)
+    child->parent = NULL;
+    ui_element_invalidate_subtree_screen_rects(child);
+    if (destroy_child)
     {
-        if (window->children[i] != child)
-        {
-            continue;
-        }
+        ui_traversal_destroy(child);
+    }
 
-        if (window->focused_child == child)
-        {
-            set_focused_child(window, NULL);
-        }
-        if (window->captured_child == child)
-        {
-            window->captured_child = NULL;
-        }
+    window->children[index] = NULL;
+    window->hole_count++;
+}
 
-        child->parent = NULL;
-        if (destroy_child && child->ops->destroy != NULL)
-        {
-            child->ops->destroy(child);
-        }
+/*
+ * Trim trailing holes and compact once holes dominate the array.
+ */
+static void finish_removal(ui_window *window)
+{
+    while (window->child_count > 0U && window->children[window->child_count - 1U] == NULL)
+    {
+        window->child_count--;
+        window->hole_count--;
+    }
 
-        for (size_t j = i; j + 1U < window->child_count; ++j)
+    if (ui_element_should_compact_siblings(window->hole_count, window->child_count))
+    {
+        window->child_count = ui_element_compact_siblings(window->children, window->child_count);
+        window->hole_count = 0U;
+    }
+
+    ui_spatial_index_invalidate(&window->hit_index);
+    ui_element_invalidate_measure(&window->base);
+}
+
+bool ui_window_remove_child(ui_window *window, ui_element *child, bool destroy_child)
+{
+    size_t index = 0U;
+    if (window == NULL || !is_valid_element(child) ||
+        !ui_element_find_sibling(window->children, window->child_count, child, &index))
+    {
+        return false;
+    }
+
+    detach_child(window, index, destroy_child);
+    finish_removal(window);
+    return true;
+}
+
+size_t ui_window_remove_children(ui_window *window, ui_element *const *children, size_t count,
+                                 bool destroy_children)
+{
+    if (window == NULL || children == NULL)
+    {
+        return 0U;
+    }
+
+    size_t removed = 0U;
+    for (size_t i = 0U; i < count; ++i)
+    {
+        size_t index = 0U;
+        if (!is_valid_element(children[i]) ||
+            !ui_element_find_sibling(window->children, window->child_count, children[i], &index))
         {
-            window->children[j] = window->children[j + 1U];
+            continue;
         }
-        window->child_count--;
-        return true;
+        detach_child(window, index, destroy_children);
+        removed++;
     }
 
-    return false;
+    if (removed > 0U)
+    {
+        finish_removal(window);
+    }
+    return removed;
 }
 
 void ui_window_clear_children(ui_window *window, bool destroy_children)
@@ -0,0 +1,248 @@
+#include "util/cui_allocator.h"
+
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const size_t DEFAULT_ARENA_BLOCK_SIZE = 64U * 1024U;
+static const size_t ARENA_ALIGNMENT = alignof(max_align_t);
+
+struct cui_arena_block
+{
+    cui_arena_block *next;
+    size_t capacity;
+    size_t used;
+    // Most recent allocation, so release/reallocate of the tail can be undone.
+    unsigned char *last;
+    alignas(max_align_t) unsigned char data[];
+};
+
+void *cui_alloc(const cui_allocator *allocator, size_t size)
+{
+    if (size == 0U)
+    {
+        return NULL;
+    }
+    if (allocator == NULL)
+    {
+        return malloc(size);
+    }
+    return allocator->allocate(allocator->user_data, size);
+}
+
+void *cui_realloc(const cui_allocator *allocator, void *ptr, size_t old_size, size_t new_size)
+{
+    if (ptr == NULL)
+    {
+        return cui_alloc(allocator, new_size);
+    }
+    if (allocator == NULL)
+    {
+        return realloc(ptr, new_size);
+    }
+    return allocator->reallocate(allocator->user_data, ptr, old_size, new_size);
+}
+
+void cui_free(const cui_allocator *allocator, void *ptr, size_t size)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+    if (allocator == NULL)
+    {
+        free(ptr);
+        return;
+    }
+    allocator->release(allocator->user_data, ptr, size);
+}
+
+char *cui_strdup(const cui_allocator *allocator, const char *source)
+{
+    if (source == NULL)
+    {
+        return NULL;
+    }
+
+    const size_t length = strlen(source);
+    char *copy = cui_alloc(allocator, length + 1U);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+
+    memcpy(copy, source, length + 1U);
+    return copy;
+}
+
+void cui_free_string(const cui_allocator *allocator, char *string)
+{
+    if (string == NULL)
+    {
+        return;
+    }
+    cui_free(allocator, string, strlen(string) + 1U);
+}
+
+static size_t align_size(size_t size)
+{
+    return (size + ARENA_ALIGNMENT - 1U) & ~(ARENA_ALIGNMENT - 1U);
+}
+
+static cui_arena_block *create_block(cui_arena *arena, size_t capacity)
+{
+    cui_arena_block *block = malloc(sizeof(*block) + capacity);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    block->capacity = capacity;
+    block->used = 0U;
+    block->last = NULL;
+    block->next = NULL;
+    arena->bytes_reserved += capacity;
+    return block;
+}
+
+static void *arena_allocate(void *user_data, size_t size)
+{
+    cui_arena *arena = user_data;
+    const size_t aligned = align_size(size);
+    cui_arena_block *block = arena->blocks;
+
+    if (aligned > arena->block_size && block != NULL)
+    {
+        // Oversized requests get a dedicated block linked behind the head, so
+        // the head keeps serving small requests from its remainder.
+        cui_arena_block *dedicated = create_block(arena, aligned);
+        if (dedicated == NULL)
+        {
+            return NULL;
+        }
+
+        dedicated->used = aligned;
+        dedicated->next = block->next;
+        block->next = dedicated;
+        arena->bytes_used += aligned;
+        return dedicated->data;
+    }
+
+    if (block == NULL || block->capacity - block->used < aligned)
+    {
+        const size_t capacity = aligned > arena->block_size ? aligned : arena->block_size;
+        cui_arena_block *fresh = create_block(arena, capacity);
+        if (fresh == NULL)
+        {
+            return NULL;
+        }
+
+        fresh->next = arena->blocks;
+        arena->blocks = fresh;
+        block = fresh;
+    }
+
+    unsigned char *ptr = block->data + block->used;
+    block->used += aligned;
+    block->last = ptr;
+    arena->bytes_used += aligned;
+    return ptr;
+}
+
+static bool is_last_allocation(const cui_arena *arena, const void *ptr)
+{
+    return arena->blocks != NULL && arena->blocks->last == ptr;
+}
+
+static void *arena_reallocate(void *user_data, void *ptr, size_t old_size, size_t new_size)
+{
+    cui_arena *arena = user_data;
+    cui_arena_block *block = arena->blocks;
+
+    if (is_last_allocation(arena, ptr))
+    {
+        const size_t offset = (size_t)((unsigned char *)ptr - block->data);
+        const size_t new_aligned = align_size(new_size);
+        if (offset + new_aligned <= block->capacity)
+        {
+            arena->bytes_used = arena->bytes_used - (block->used - offset) + new_aligned;
+            block->used = offset + new_aligned;
+            return ptr;
+        }
+    }
+
+    void *moved = arena_allocate(arena, new_size);
+    if (moved == NULL)
+    {
+        return NULL;
+    }
+
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    return moved;
+}
+
+static void arena_release(void *user_data, void *ptr, size_t size)
+{
+    cui_arena *arena = user_data;
+    (void)size;
+
+    if (!is_last_allocation(arena, ptr))
+    {
+        return;
+    }
+
+    cui_arena_block *block = arena->blocks;
+    const size_t offset = (size_t)((unsigned char *)ptr - block->data);
+    arena->bytes_used -= block->used - offset;
+    block->used = offset;
+    block->last = NULL;
+}
+
+void cui_arena_init(cui_arena *arena, size_t block_size)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    arena->blocks = NULL;
+    arena->block_size = block_size > 0U ? align_size(block_size) : DEFAULT_ARENA_BLOCK_SIZE;
+    arena->bytes_reserved = 0U;
+    arena->bytes_used = 0U;
+    arena->allocator = (cui_allocator){
+        .allocate = arena_allocate,
+        .reallocate = arena_reallocate,
+        .release = arena_release,
+        .user_data = arena,
+    };
+}
+
+const cui_allocator *cui_arena_allocator(cui_arena *arena)
+{
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+    return &arena->allocator;
+}
+
+void cui_arena_destroy(cui_arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    cui_arena_block *block = arena->blocks;
+    while (block != NULL)
+    {
+        cui_arena_block *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->blocks = NULL;
+    arena->bytes_reserved = 0U;
+    arena->bytes_used = 0U;
+}
@@ -0,0 +1,273 @@
+#include "util/string_pool.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const size_t INITIAL_BUCKET_COUNT = 64U;
+// Smallest entry size class is 1 << MIN_CLASS_SHIFT bytes.
+static const size_t MIN_CLASS_SHIFT = 5U;
+
+struct string_pool_entry
+{
+    // Next entry in the same bucket while live, in the same free list after.
+    string_pool_entry *next;
+    uint32_t hash;
+    uint32_t size_class;
+    uint32_t refcount;
+    // Entries top out at the largest size class, well below 4 GiB.
+    uint32_t length;
+    char text[];
+};
+
+static string_pool_entry *entry_from_text(const char *interned)
+{
+    return (string_pool_entry *)(void *)(interned - offsetof(string_pool_entry, text));
+}
+
+static size_t class_size(uint32_t size_class)
+{
+    return (size_t)1U << (size_class + MIN_CLASS_SHIFT);
+}
+
+/*
+ * Return the smallest size class holding size bytes, or
+ * STRING_POOL_SIZE_CLASSES when size exceeds the largest class.
+ */
+static uint32_t size_class_for(size_t size)
+{
+    uint32_t size_class = 0U;
+    while (size_class < STRING_POOL_SIZE_CLASSES && class_size(size_class) < size)
+    {
+        size_class++;
+    }
+    return size_class;
+}
+
+// FNV-1a over the string, measuring its length in the same pass.
+static uint32_t hash_string(const char *text, size_t *out_length)
+{
+    uint32_t hash = 2166136261U;
+    size_t length = 0U;
+    while (text[length] != '\0')
+    {
+        hash ^= (unsigned char)text[length];
+        hash *= 16777619U;
+        length++;
+    }
+    *out_length = length;
+    return hash;
+}
+
+static string_pool_entry **bucket_for(const string_pool *pool, uint32_t hash)
+{
+    return &pool->buckets[hash & (pool->bucket_count - 1U)];
+}
+
+/*
+ * Rehash every live entry into a bucket array of new_count buckets (a power
+ * of two). Returns false and keeps the old table on allocation failure.
+ */
+static bool resize_table(string_pool *pool, size_t new_count)
+{
+    string_pool_entry **buckets = calloc(new_count, sizeof(*buckets));
+    if (buckets == NULL)
+    {
+        return false;
+    }
+
+    for (size_t i = 0U; i < pool->bucket_count; ++i)
+    {
+        string_pool_entry *entry = pool->buckets[i];
+        while (entry != NULL)
+        {
+            string_pool_entry *next = entry->next;
+            string_pool_entry **bucket = &buckets[entry->hash & (new_count - 1U)];
+            entry->next = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+
+    free((void *)pool->buckets);
+    pool->buckets = buckets;
+    pool->bucket_count = new_count;
+    pool->stats.table_bytes = new_count * sizeof(*buckets);
+    return true;
+}
+
+static string_pool_entry *allocate_entry(string_pool *pool, uint32_t size_class)
+{
+    string_pool_entry *entry = pool->free_lists[size_class];
+    if (entry != NULL)
+    {
+        pool->free_lists[size_class] = entry->next;
+        pool->stats.free_bytes -= class_size(size_class);
+        return entry;
+    }
+    return cui_alloc(cui_arena_allocator(&pool->arena), class_size(size_class));
+}
+
+void string_pool_init(string_pool *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    cui_arena_init(&pool->arena, 0U);
+}
+
+void string_pool_destroy(string_pool *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    free((void *)pool->buckets);
+    cui_arena_destroy(&pool->arena);
+    memset(pool, 0, sizeof(*pool));
+}
+
+const char *string_pool_intern(string_pool *pool, const char *text)
+{
+    if (pool == NULL || text == NULL)
+    {
+        return NULL;
+    }
+
+    pool->stats.intern_calls++;
+    size_t length = 0U;
+    const uint32_t hash = hash_string(text, &length);
+
+    if (pool->bucket_count > 0U)
+    {
+        for (string_pool_entry *entry = *bucket_for(pool, hash); entry != NULL;
+             entry = entry->next)
+        {
+            if (entry->hash == hash && entry->length == length &&
+                memcmp(entry->text, text, length) == 0)
+            {
+                entry->refcount++;
+                pool->stats.references++;
+                pool->stats.intern_hits++;
+                return entry->text;
+            }
+        }
+    }
+
+    // Grow before inserting so the new entry lands in its final bucket.
+    if (pool->bucket_count == 0U)
+    {
+        if (!resize_table(pool, INITIAL_BUCKET_COUNT))
+        {
+            return NULL;
+        }
+    }
+    else if (pool->stats.live_strings + 1U > pool->bucket_count - pool->bucket_count / 4U)
+    {
+        // A failed grow only lengthens chains; keep using the current table.
+        (void)resize_table(pool, pool->bucket_count * 2U);
+    }
+
+    const size_t size = offsetof(string_pool_entry, text) + length + 1U;
+    const uint32_t size_class = size_class_for(size);
+    if (size < length || size_class >= STRING_POOL_SIZE_CLASSES)
+    {
+        return NULL;
+    }
+
+    string_pool_entry *entry = allocate_entry(pool, size_class);
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+
+    entry->hash = hash;
+    entry->size_class = size_class;
+    entry->refcount = 1U;
+    entry->length = (uint32_t)length;
+    memcpy(entry->text, text, length + 1U);
+
+    string_pool_entry **bucket = bucket_for(pool, hash);
+    entry->next = *bucket;
+    *bucket = entry;
+
+    pool->stats.live_strings++;
+    pool->stats.references++;
+    pool->stats.string_bytes += length + 1U;
+    pool->stats.entry_bytes += class_size(size_class);
+    return entry->text;
+}
+
+const char *string_pool_retain(string_pool *pool, const char *interned)
+{
+    if (pool == NULL || interned == NULL)
+    {
+        return interned;
+    }
+
+    entry_from_text(interned)->refcount++;
+    pool->stats.references++;
+    return interned;
+}
+
+void string_pool_release(string_pool *pool, const char *interned)
+{
+    if (pool == NULL || interned == NULL)
+    {
+        return;
+    }
+
+    string_pool_entry *entry = entry_from_text(interned);
+    pool->stats.references--;
+    if (--entry->refcount > 0U)
+    {
+        return;
+    }
+
+    string_pool_entry **link = bucket_for(pool, entry->hash);
+    while (*link != entry)
+    {
+        link = &(*link)->next;
+    }
+    *link = entry->next;
+
+    // The arena cannot free, so the entry waits for a string of its class.
+    entry->next = pool->free_lists[entry->size_class];
+    pool->free_lists[entry->size_class] = entry;
+
+    const size_t bytes = class_size(entry->size_class);
+    pool->stats.live_strings--;
+    pool->stats.string_bytes -= entry->length + 1U;
+    pool->stats.entry_bytes -= bytes;
+    pool->stats.free_bytes += bytes;
+}
+
+size_t string_pool_length(const char *interned)
+{
+    if (interned == NULL)
+    {
+        return 0U;
+    }
+    return entry_from_text(interned)->length;
+}
+
+void string_pool_get_stats(const string_pool *pool, string_pool_stats *out_stats)
+{
+    if (out_stats == NULL)
+    {
+        return;
+    }
+    if (pool == NULL)
+    {
+        memset(out_stats, 0, sizeof(*out_stats));
+        return;
+    }
+
+    *out_stats = pool->stats;
+    out_stats->arena_bytes = pool->arena.bytes_reserved;
+}
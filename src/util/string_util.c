@@ -20,3 +20,253 @@ char *duplicate_string(const char *source)
     memcpy(copy, source, source_length + 1U);
     return copy;
 }
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define STRING_UTIL_AVX2 1
+#define UTF8_BLOCK 32U
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STRING_UTIL_SSE2 1
+#define UTF8_BLOCK 16U
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define STRING_UTIL_NEON 1
+#define UTF8_BLOCK 16U
+#else
+#define UTF8_BLOCK 16U
+#endif
+
+static bool is_continuation(unsigned char byte) { return (byte & 0xC0U) == 0x80U; }
+
+#if defined(STRING_UTIL_AVX2) || defined(STRING_UTIL_SSE2)
+static size_t count_bits(unsigned int mask)
+{
+    size_t count = 0U;
+    while (mask != 0U)
+    {
+        mask &= mask - 1U;
+        count++;
+    }
+    return count;
+}
+#endif
+
+/*
+ * Return true when the UTF8_BLOCK bytes at block are all below 0x80.
+ */
+static bool block_is_ascii(const unsigned char *block)
+{
+#if defined(STRING_UTIL_AVX2)
+    return _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)(const void *)block)) == 0;
+#elif defined(STRING_UTIL_SSE2)
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(const void *)block)) == 0;
+#elif defined(STRING_UTIL_NEON)
+    return vmaxvq_u8(vld1q_u8(block)) < 0x80U;
+#else
+    unsigned char high = 0U;
+    for (size_t i = 0U; i < UTF8_BLOCK; ++i)
+    {
+        high |= block[i];
+    }
+    return high < 0x80U;
+#endif
+}
+
+/*
+ * Return how many of the UTF8_BLOCK bytes at block start a codepoint.
+ */
+static size_t block_count_leads(const unsigned char *block)
+{
+    // As signed bytes, continuation bytes 0x80-0xBF are exactly -128..-65.
+#if defined(STRING_UTIL_AVX2)
+    const __m256i bytes = _mm256_loadu_si256((const __m256i *)(const void *)block);
+    const __m256i leads = _mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(-65));
+    return count_bits((unsigned int)_mm256_movemask_epi8(leads));
+#elif defined(STRING_UTIL_SSE2)
+    const __m128i bytes = _mm_loadu_si128((const __m128i *)(const void *)block);
+    const __m128i leads = _mm_cmpgt_epi8(bytes, _mm_set1_epi8(-65));
+    return count_bits((unsigned int)_mm_movemask_epi8(leads));
+#elif defined(STRING_UTIL_NEON)
+    const int8x16_t bytes = vreinterpretq_s8_u8(vld1q_u8(block));
+    const uint8x16_t leads = vcgtq_s8(bytes, vdupq_n_s8(-65));
+    return (size_t)vaddvq_u8(vshrq_n_u8(leads, 7));
+#else
+    size_t count = 0U;
+    for (size_t i = 0U; i < UTF8_BLOCK; ++i)
+    {
+        count += is_continuation(block[i]) ? 0U : 1U;
+    }
+    return count;
+#endif
+}
+
+/*
+ * Return the length of the well-formed sequence at bytes, or 0 when it is
+ * malformed or runs past remaining (Unicode table 3-7).
+ */
+static size_t sequence_length(const unsigned char *bytes, size_t remaining)
+{
+    const unsigned char lead = bytes[0];
+    if (lead < 0x80U)
+    {
+        return 1U;
+    }
+
+    size_t length = 0U;
+    unsigned char second_min = 0x80U;
+    unsigned char second_max = 0xBFU;
+    if (lead >= 0xC2U && lead <= 0xDFU)
+    {
+        length = 2U;
+    }
+    else if (lead >= 0xE0U && lead <= 0xEFU)
+    {
+        length = 3U;
+        second_min = lead == 0xE0U ? 0xA0U : 0x80U;
+        second_max = lead == 0xEDU ? 0x9FU : 0xBFU;
+    }
+    else if (lead >= 0xF0U && lead <= 0xF4U)
+    {
+        length = 4U;
+        second_min = lead == 0xF0U ? 0x90U : 0x80U;
+        second_max = lead == 0xF4U ? 0x8FU : 0xBFU;
+    }
+    else
+    {
+        return 0U;
+    }
+
+    if (length > remaining || bytes[1] < second_min || bytes[1] > second_max)
+    {
+        return 0U;
+    }
+    for (size_t i = 2U; i < length; ++i)
+    {
+        if (!is_continuation(bytes[i]))
+        {
+            return 0U;
+        }
+    }
+    return length;
+}
+
+bool utf8_is_valid(const char *text, size_t length)
+{
+    if (text == NULL)
+    {
+        return length == 0U;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)text;
+    size_t i = 0U;
+    while (i < length)
+    {
+        if (length - i >= UTF8_BLOCK && block_is_ascii(bytes + i))
+        {
+            i += UTF8_BLOCK;
+            continue;
+        }
+
+        // Decode sequences across the mixed block before trying the fast path again.
+        const size_t block_end = length - i > UTF8_BLOCK ? i + UTF8_BLOCK : length;
+        while (i < block_end)
+        {
+            const size_t step = sequence_length(bytes + i, length - i);
+            if (step == 0U)
+            {
+                return false;
+            }
+            i += step;
+        }
+    }
+    return true;
+}
+
+size_t utf8_count_codepoints(const char *text, size_t length)
+{
+    if (text == NULL)
+    {
+        return 0U;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)text;
+    size_t count = 0U;
+    size_t i = 0U;
+    for (; length - i >= UTF8_BLOCK; i += UTF8_BLOCK)
+    {
+        count += block_count_leads(bytes + i);
+    }
+    for (; i < length; ++i)
+    {
+        count += is_continuation(bytes[i]) ? 0U : 1U;
+    }
+    return count;
+}
+
+size_t utf8_prefix_bytes(const char *text, size_t length, size_t codepoints)
+{
+    if (text == NULL)
+    {
+        return 0U;
+    }
+
+    // Find where codepoint number `codepoints` (0-based) starts; whole blocks
+    // that cannot contain it are skipped by their lead count alone.
+    const unsigned char *bytes = (const unsigned char *)text;
+    size_t remaining = codepoints;
+    size_t i = 0U;
+    while (length - i >= UTF8_BLOCK)
+    {
+        const size_t leads = block_count_leads(bytes + i);
+        if (leads > remaining)
+        {
+            break;
+        }
+        remaining -= leads;
+        i += UTF8_BLOCK;
+    }
+
+    for (; i < length; ++i)
+    {
+        if (is_continuation(bytes[i]))
+        {
+            continue;
+        }
+        if (remaining == 0U)
+        {
+            return i;
+        }
+        remaining--;
+    }
+    return length;
+}
+
+size_t utf8_floor_boundary(const char *text, size_t length, size_t offset)
+{
+    if (text == NULL || offset >= length)
+    {
+        return text == NULL ? 0U : length;
+    }
+
+    // At most three steps back on valid UTF-8.
+    const unsigned char *bytes = (const unsigned char *)text;
+    while (offset > 0U && is_continuation(bytes[offset]))
+    {
+        offset--;
+    }
+    return offset;
+}
+
+const char *utf8_simd_backend(void)
+{
+#if defined(STRING_UTIL_AVX2)
+    return "avx2";
+#elif defined(STRING_UTIL_SSE2)
+    return "sse2";
+#elif defined(STRING_UTIL_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
@@ -1,9 +1,27 @@
+#include "pages/todo_page.h"
+#include "system/ui_clock.h"
+#include "system/ui_event_log.h"
+#include "system/ui_frame_profiler.h"
+#include "system/ui_input_coalescer.h"
+#include "system/ui_ops_profiler.h"
+#include "system/ui_render.h"
+#include "system/ui_runtime.h"
+#include "system/ui_traversal.h"
+#include "ui/ui_glyph_atlas.h"
 #include "ui/ui_layout_container.h"
+#include "ui/ui_list_view.h"
 #include "ui/ui_pane.h"
 #include "ui/ui_scroll_view.h"
+#include "ui/ui_text.h"
+#include "ui/ui_window.h"
+#include "util/cui_allocator.h"
+#include "util/string_pool.h"
+#include "util/string_util.h"
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 static bool are_close(float a, float b)
 {
@@ -12,10 +30,117 @@ static bool are_close(float a, float b)
     return diff <= epsilon;
 }
 
+typedef struct counting_element
+{
+    ui_element base;
+    int measure_calls;
+    int pointer_events;
+    size_t motion_samples;
+    float wheel_y;
+    bool is_hovered;
+    int hover_enters;
+    int hover_leaves;
+    float frame_delay;
+    // Runs after the element has counted an event; may destroy the element.
+    void (*on_event)(void *context);
+    void *on_event_context;
+} counting_element;
+
+static void measure_counting_element(ui_element *element, const SDL_FRect *available_rect)
+{
+    (void)available_rect;
+    ((counting_element *)element)->measure_calls++;
+}
+
+static bool handle_counting_element_event(ui_element *element, const SDL_Event *event)
+{
+    counting_element *counting = (counting_element *)element;
+    counting->pointer_events++;
+    if (event->type == SDL_EVENT_MOUSE_MOTION)
+    {
+        size_t sample_count = 0U;
+        (void)ui_input_coalesced_motion_samples(&sample_count);
+        counting->motion_samples += sample_count;
+    }
+    else if (event->type == SDL_EVENT_MOUSE_WHEEL)
+    {
+        counting->wheel_y += event->wheel.y;
+    }
+    if (counting->on_event != NULL)
+    {
+        counting->on_event(counting->on_event_context);
+    }
+    return true;
+}
+
+static void update_counting_element_hover(ui_element *element, const SDL_FPoint *point)
+{
+    counting_element *counting = (counting_element *)element;
+    if (counting->is_hovered == (point != NULL))
+    {
+        return;
+    }
+
+    counting->is_hovered = point != NULL;
+    if (counting->is_hovered)
+    {
+        counting->hover_enters++;
+    }
+    else
+    {
+        counting->hover_leaves++;
+    }
+}
+
+static float next_counting_element_frame_delay(const ui_element *element)
+{
+    return ((const counting_element *)element)->frame_delay;
+}
+
+static void destroy_counting_element(ui_element *element) { free(element); }
+
+static const ui_element_ops COUNTING_ELEMENT_OPS = {
+    .measure = measure_counting_element,
+    .handle_event = handle_counting_element_event,
+    .update_hover = update_counting_element_hover,
+    .next_frame_delay = next_counting_element_frame_delay,
+    .destroy = destroy_counting_element,
+};
+
+static counting_element *create_counting_element(void)
+{
+    counting_element *element = malloc(sizeof(*element));
+    if (element == NULL)
+    {
+        return NULL;
+    }
+
+    element->base.rect = (SDL_FRect){0.0F, 0.0F, 20.0F, 20.0F};
+    element->base.ops = &COUNTING_ELEMENT_OPS;
+    element->base.visible = true;
+    element->base.enabled = true;
+    element->base.parent = NULL;
+    element->base.align_h = UI_ALIGN_LEFT;
+    element->base.align_v = UI_ALIGN_TOP;
+    ui_element_clear_border(&element->base);
+    ui_element_reset_layout_cache(&element->base);
+    element->measure_calls = 0;
+    element->pointer_events = 0;
+    element->motion_samples = 0U;
+    element->wheel_y = 0.0F;
+    element->is_hovered = false;
+    element->hover_enters = 0;
+    element->hover_leaves = 0;
+    element->frame_delay = UI_NO_FRAME_REQUEST;
+    element->on_event = NULL;
+    element->on_event_context = NULL;
+    return element;
+}
+
 static bool test_add_child_rejects_self_cycle(void)
 {
     ui_layout_container *container = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+        NULL, &(SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
     if (container == NULL)
     {
         return false;
@@ -28,16 +153,16 @@ static bool test_add_child_rejects_self_cycle(void)
     }
 
     const bool ok = container->child_count == 0U;
-    container->base.ops->destroy((ui_element *)container);
+    ui_traversal_destroy(&container->base);
     return ok;
 }
 
 static bool test_add_child_rejects_ancestor_cycle(void)
 {
     ui_layout_container *parent = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+        NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
     ui_layout_container *child = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+        NULL, &(SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
 
     if (parent == NULL || child == NULL)
     {
@@ -56,18 +181,18 @@ static bool test_add_child_rejects_ancestor_cycle(void)
     }
 
     const bool ok = child->base.parent == &parent->base;
-    parent->base.ops->destroy((ui_element *)parent);
+    ui_traversal_destroy(&parent->base);
     return ok;
 }
 
 static bool test_add_child_rejects_reparenting(void)
 {
     ui_layout_container *container_a = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+        NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
     ui_layout_container *container_b = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
-    ui_pane *child =
-        ui_pane_create(&(SDL_FRect){0.0F, 0.0F, 40.0F, 40.0F}, (SDL_Color){20, 20, 20, 255}, NULL);
+        NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    ui_pane *child = ui_pane_create(NULL, &(SDL_FRect){0.0F, 0.0F, 40.0F, 40.0F},
+                                    (SDL_Color){20, 20, 20, 255}, NULL);
 
     if (container_a == NULL || container_b == NULL || child == NULL)
     {
@@ -86,17 +211,17 @@ static bool test_add_child_rejects_reparenting(void)
     }
 
     const bool ok = child->base.parent == &container_a->base;
-    container_b->base.ops->destroy((ui_element *)container_b);
-    container_a->base.ops->destroy((ui_element *)container_a);
+    ui_traversal_destroy(&container_b->base);
+    ui_traversal_destroy(&container_a->base);
     return ok;
 }
 
 static bool test_scroll_view_create_rejects_parented_child(void)
 {
     ui_layout_container *container = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 120.0F, 120.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
-    ui_pane *child =
-        ui_pane_create(&(SDL_FRect){0.0F, 0.0F, 40.0F, 20.0F}, (SDL_Color){20, 20, 20, 255}, NULL);
+        NULL, &(SDL_FRect){0.0F, 0.0F, 120.0F, 120.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    ui_pane *child = ui_pane_create(NULL, &(SDL_FRect){0.0F, 0.0F, 40.0F, 20.0F},
+                                    (SDL_Color){20, 20, 20, 255}, NULL);
 
     if (container == NULL || child == NULL)
     {
@@ -108,25 +233,25 @@ static bool test_scroll_view_create_rejects_parented_child(void)
         return false;
     }
 
-    ui_scroll_view *scroll =
-        ui_scroll_view_create(&(SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F}, &child->base, 20.0F, NULL);
+    ui_scroll_view *scroll = ui_scroll_view_create(NULL, &(SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F},
+                                                   &child->base, 20.0F, NULL);
     if (scroll != NULL)
     {
         return false;
     }
 
-    container->base.ops->destroy((ui_element *)container);
+    ui_traversal_destroy(&container->base);
     return true;
 }
 
 static bool test_horizontal_layout_preserves_right_anchor_inset(void)
 {
     ui_layout_container *container = ui_layout_container_create(
-        &(SDL_FRect){0.0F, 0.0F, 200.0F, 40.0F}, UI_LAYOUT_AXIS_HORIZONTAL, NULL);
-    ui_pane *left =
-        ui_pane_create(&(SDL_FRect){0.0F, 0.0F, 50.0F, 20.0F}, (SDL_Color){20, 20, 20, 255}, NULL);
-    ui_pane *right =
-        ui_pane_create(&(SDL_FRect){12.0F, 0.0F, 30.0F, 20.0F}, (SDL_Color){40, 40, 40, 255}, NULL);
+        NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 40.0F}, UI_LAYOUT_AXIS_HORIZONTAL, NULL);
+    ui_pane *left = ui_pane_create(NULL, &(SDL_FRect){0.0F, 0.0F, 50.0F, 20.0F},
+                                   (SDL_Color){20, 20, 20, 255}, NULL);
+    ui_pane *right = ui_pane_create(NULL, &(SDL_FRect){12.0F, 0.0F, 30.0F, 20.0F},
+                                    (SDL_Color){40, 40, 40, 255}, NULL);
 
     if (container == NULL || left == NULL || right == NULL)
     {
@@ -144,17 +269,1589 @@ static bool test_horizontal_layout_preserves_right_anchor_inset(void)
         return false;
     }
 
-    container->base.ops->update((ui_element *)container, 0.0F);
+    ui_traversal_update(&container->base, 0.0F);
     const SDL_FRect right_before = ui_element_screen_rect(&right->base);
 
     container->base.rect.w = 260.0F;
-    container->base.ops->update((ui_element *)container, 0.0F);
+    ui_traversal_update(&container->base, 0.0F);
     const SDL_FRect right_after = ui_element_screen_rect(&right->base);
 
     const bool ok = are_close(right_before.x, 158.0F) && are_close(right_after.x, 218.0F) &&
                     are_close(right->base.rect.x, 12.0F);
 
-    container->base.ops->destroy((ui_element *)container);
+    ui_traversal_destroy(&container->base);
+    return ok;
+}
+
+static bool test_screen_rect_cache_follows_ancestor_arrange(void)
+{
+    ui_layout_container *outer = ui_layout_container_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    ui_layout_container *inner = ui_layout_container_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    ui_pane *leaf = ui_pane_create(NULL, &(SDL_FRect){0.0F, 0.0F, 20.0F, 20.0F},
+                                   (SDL_Color){20, 20, 20, 255}, NULL);
+
+    if (outer == NULL || inner == NULL || leaf == NULL)
+    {
+        return false;
+    }
+
+    if (!ui_layout_container_add_child(inner, &leaf->base) ||
+        !ui_layout_container_add_child(outer, &inner->base))
+    {
+        return false;
+    }
+
+    ui_element_arrange(&outer->base, &outer->base.rect);
+    const SDL_FRect leaf_before = ui_element_screen_rect(&leaf->base);
+    const SDL_FRect leaf_cached = ui_element_screen_rect(&leaf->base);
+
+    const SDL_FRect moved = {30.0F, 40.0F, 200.0F, 200.0F};
+    ui_element_arrange(&outer->base, &moved);
+    const SDL_FRect leaf_after = ui_element_screen_rect(&leaf->base);
+
+    // Moving the leaf alone only drops the leaf's cache, not its ancestors'.
+    const SDL_FRect nudged = {5.0F, 0.0F, 20.0F, 20.0F};
+    ui_element_arrange(&leaf->base, &nudged);
+    const bool ancestors_cached =
+        inner->base.screen_rect_generation != 0U && leaf->base.screen_rect_generation == 0U;
+    const SDL_FRect leaf_nudged = ui_element_screen_rect(&leaf->base);
+
+    const bool ok = are_close(leaf_before.x, 16.0F) && are_close(leaf_before.y, 16.0F) &&
+                    are_close(leaf_cached.x, leaf_before.x) && are_close(leaf_after.x, 46.0F) &&
+                    are_close(leaf_after.y, 56.0F) && ancestors_cached &&
+                    are_close(leaf_nudged.x, 43.0F);
+
+    ui_traversal_destroy(&outer->base);
+    return ok;
+}
+
+static void measure_and_arrange(ui_element *element)
+{
+    const SDL_FRect available = element->rect;
+    ui_element_measure(element, &available);
+    ui_element_arrange(element, &element->rect);
+}
+
+static bool test_layout_skips_clean_and_hidden_children(void)
+{
+    ui_layout_container *container = ui_layout_container_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    counting_element *first = create_counting_element();
+    counting_element *second = create_counting_element();
+
+    if (container == NULL || first == NULL || second == NULL)
+    {
+        return false;
+    }
+
+    if (!ui_layout_container_add_child(container, &first->base) ||
+        !ui_layout_container_add_child(container, &second->base))
+    {
+        return false;
+    }
+
+    measure_and_arrange(&container->base);
+    const bool first_pass = first->measure_calls == 1 && second->measure_calls == 1;
+
+    measure_and_arrange(&container->base);
+    const bool clean_pass = first->measure_calls == 1 && second->measure_calls == 1 &&
+                            !ui_element_needs_layout(&container->base);
+
+    ui_element_invalidate_measure(&first->base);
+    const bool propagated = ui_element_needs_layout(&container->base);
+    measure_and_arrange(&container->base);
+    const bool dirty_pass = first->measure_calls == 2 && second->measure_calls == 1;
+
+    ui_element_set_visible(&second->base, false);
+    ui_element_invalidate_measure(&second->base);
+    measure_and_arrange(&container->base);
+    const bool hidden_pass = second->measure_calls == 1;
+
+    const bool ok = first_pass && clean_pass && propagated && dirty_pass && hidden_pass;
+    ui_traversal_destroy(&container->base);
+    return ok;
+}
+
+static bool test_container_reports_earliest_visible_frame_request(void)
+{
+    ui_layout_container *container = ui_layout_container_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    counting_element *slow = create_counting_element();
+    counting_element *fast = create_counting_element();
+
+    if (container == NULL || slow == NULL || fast == NULL)
+    {
+        return false;
+    }
+
+    if (!ui_layout_container_add_child(container, &slow->base) ||
+        !ui_layout_container_add_child(container, &fast->base))
+    {
+        return false;
+    }
+
+    const bool idle = ui_traversal_next_frame_delay(&container->base) < 0.0F;
+
+    slow->frame_delay = 1.0F;
+    fast->frame_delay = 0.25F;
+    const bool earliest = are_close(ui_traversal_next_frame_delay(&container->base), 0.25F);
+
+    ui_element_set_visible(&fast->base, false);
+    const bool skips_hidden = are_close(ui_traversal_next_frame_delay(&container->base), 1.0F);
+
+    const bool ok = idle && earliest && skips_hidden;
+    ui_traversal_destroy(&container->base);
+    return ok;
+}
+
+static bool test_traversal_walks_deep_trees_iteratively(void)
+{
+    // Deep enough that the old per-level recursion would lean on the C stack.
+    enum
+    {
+        TREE_DEPTH = 10000
+    };
+    counting_element *leaf = create_counting_element();
+    if (leaf == NULL)
+    {
+        return false;
+    }
+
+    // Built bottom-up so each add only walks the (still unparented) new parent.
+    ui_element *top = &leaf->base;
+    ui_layout_container *middle = NULL;
+    for (int depth = 0; depth < TREE_DEPTH; ++depth)
+    {
+        ui_layout_container *container = ui_layout_container_create(
+            NULL, &(SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+        if (container == NULL || !ui_layout_container_add_child(container, top))
+        {
+            return false;
+        }
+        if (depth == TREE_DEPTH / 2)
+        {
+            middle = container;
+        }
+        top = &container->base;
+    }
+
+    const bool idle = ui_traversal_next_frame_delay(top) < 0.0F;
+    leaf->frame_delay = 0.5F;
+    const bool reaches_leaf = are_close(ui_traversal_next_frame_delay(top), 0.5F);
+    middle->base.enabled = false;
+    const bool prunes_disabled = ui_traversal_next_frame_delay(top) < 0.0F;
+
+    ui_traversal_destroy(top);
+    return idle && reaches_leaf && prunes_disabled;
+}
+
+static bool test_window_pointer_routing_uses_topmost_hit_after_moves(void)
+{
+    enum
+    {
+        CHILD_COUNT = 40
+    };
+
+    ui_window *window = ui_window_create(NULL, &(SDL_FRect){0.0F, 0.0F, 400.0F, 400.0F});
+    counting_element *children[CHILD_COUNT];
+    if (window == NULL)
+    {
+        return false;
+    }
+
+    // Enough siblings to use the grid rather than the linear fallback; a
+    // 20px-wide column of 10px-tall elements, each index i at y = i * 10.
+    for (size_t i = 0U; i < CHILD_COUNT; ++i)
+    {
+        children[i] = create_counting_element();
+        if (children[i] == NULL || !ui_window_add_child(window, &children[i]->base))
+        {
+            return false;
+        }
+        children[i]->base.rect = (SDL_FRect){0.0F, (float)i * 10.0F, 20.0F, 10.0F};
+    }
+    ui_element_invalidate_screen_rects();
+
+    SDL_Event motion;
+    SDL_zero(motion);
+    motion.type = SDL_EVENT_MOUSE_MOTION;
+    motion.motion.x = 5.0F;
+    motion.motion.y = 125.0F;
+    const bool routed = window->base.ops->handle_event(&window->base, &motion) &&
+                        children[12]->pointer_events == 1 && children[11]->pointer_events == 0;
+
+    // Stack a later (topmost) sibling over the same spot through arrange; the
+    // grid must pick up the move and prefer it.
+    const SDL_FRect moved = {0.0F, 120.0F, 20.0F, 10.0F};
+    ui_element_arrange(&children[CHILD_COUNT - 1]->base, &moved);
+    const bool topmost = window->base.ops->handle_event(&window->base, &motion) &&
+                         children[CHILD_COUNT - 1]->pointer_events == 1 &&
+                         children[12]->pointer_events == 1;
+
+    motion.motion.x = 300.0F;
+    const bool miss = !window->base.ops->handle_event(&window->base, &motion);
+
+    ui_traversal_destroy(&window->base);
+    return routed && topmost && miss;
+}
+
+static bool test_window_removal_preserves_order_and_stales_handles(void)
+{
+    enum
+    {
+        CHILD_COUNT = 12
+    };
+
+    ui_window *window = ui_window_create(NULL, &(SDL_FRect){0.0F, 0.0F, 400.0F, 400.0F});
+    counting_element *children[CHILD_COUNT];
+    ui_handle handles[CHILD_COUNT];
+    if (window == NULL)
+    {
+        return false;
+    }
+    for (size_t i = 0U; i < CHILD_COUNT; ++i)
+    {
+        children[i] = create_counting_element();
+        if (children[i] == NULL || !ui_window_add_child(window, &children[i]->base))
+        {
+            return false;
+        }
+        handles[i] = ui_handle_acquire(&children[i]->base);
+    }
+
+    // Front removals leave holes until they make up half of the array.
+    bool ok = ui_window_remove_child(window, &children[0]->base, true) &&
+              ui_window_remove_child(window, &children[1]->base, true) &&
+              window->child_count == CHILD_COUNT && window->hole_count == 2U &&
+              ui_handle_resolve(handles[0]) == NULL && ui_handle_resolve(handles[1]) == NULL &&
+              ui_handle_resolve(handles[2]) == &children[2]->base;
+
+    // One batch call pushes the holes over half and compacts once, in order.
+    ui_element *const batch[] = {&children[3]->base, &children[5]->base, &children[7]->base,
+                                 &children[9]->base, NULL};
+    ok = ok && ui_window_remove_children(window, batch, 5U, true) == 4U &&
+         window->child_count == 6U && window->hole_count == 0U;
+    const size_t kept[] = {2U, 4U, 6U, 8U, 10U, 11U};
+    for (size_t i = 0U; ok && i < 6U; ++i)
+    {
+        ui_element *child = &children[kept[i]]->base;
+        ok = window->children[i] == child && child->sibling_index == i &&
+             ui_handle_resolve(handles[kept[i]]) == child;
+    }
+
+    // Trailing removals shrink the array without leaving holes behind.
+    ok = ok && ui_window_remove_child(window, &children[11]->base, false) &&
+         window->child_count == 5U && window->hole_count == 0U &&
+         children[11]->base.parent == NULL &&
+         ui_handle_resolve(handles[11]) == &children[11]->base;
+
+    ui_traversal_destroy(&children[11]->base);
+    ui_traversal_destroy(&window->base);
+    return ok && ui_handle_resolve(handles[11]) == NULL && ui_handle_resolve(handles[2]) == NULL;
+}
+
+typedef struct removal_request
+{
+    ui_window *window;
+    ui_element *target;
+} removal_request;
+
+static void remove_target(void *context)
+{
+    removal_request *request = context;
+    (void)ui_window_remove_child(request->window, request->target, true);
+}
+
+static bool test_press_survives_container_destroyed_by_child(void)
+{
+    ui_runtime context;
+    ui_window *window = ui_window_create(NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F});
+    ui_layout_container *row = ui_layout_container_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, 100.0F, 40.0F}, UI_LAYOUT_AXIS_HORIZONTAL, NULL);
+    counting_element *button = create_counting_element();
+    if (window == NULL || row == NULL || button == NULL || !ui_runtime_init(&context))
+    {
+        return false;
+    }
+    if (!ui_layout_container_add_child(row, &button->base) ||
+        !ui_window_add_child(window, &row->base) || !ui_runtime_add(&context, &window->base))
+    {
+        return false;
+    }
+    ui_runtime_layout(&context);
+
+    // Like a todo row rebuilt from its own checkbox callback: the press lands
+    // on the button, which destroys the row that is still dispatching to it.
+    removal_request request = {window, &row->base};
+    button->on_event = remove_target;
+    button->on_event_context = &request;
+
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+    event.button.button = SDL_BUTTON_LEFT;
+    event.button.x = 10.0F;
+    event.button.y = 10.0F;
+    ui_runtime_handle_event(&context, &event);
+    const bool removed = window->child_count == 0U;
+
+    // Motion and release must find the captured row gone rather than touch it.
+    SDL_Event motion;
+    SDL_zero(motion);
+    motion.type = SDL_EVENT_MOUSE_MOTION;
+    motion.motion.x = 12.0F;
+    motion.motion.y = 10.0F;
+    ui_runtime_handle_event(&context, &motion);
+    const bool moved = ui_handle_resolve(context.captured_element) == &window->base &&
+                       ui_handle_resolve(window->captured_child) == NULL;
+    event.type = SDL_EVENT_MOUSE_BUTTON_UP;
+    ui_runtime_handle_event(&context, &event);
+    const bool released = ui_handle_resolve(context.captured_element) == NULL;
+
+    ui_runtime_destroy(&context);
+    return removed && moved && released;
+}
+
+static void record_two_fills(ui_render_list *list, SDL_Renderer *renderer, float second_x)
+{
+    const SDL_Color color = {10, 20, 30, 255};
+    (void)ui_render_begin_recording(list);
+    ui_render_fill_rect(renderer, &(SDL_FRect){0.0F, 0.0F, 10.0F, 10.0F}, color);
+    ui_render_fill_rect(renderer, &(SDL_FRect){second_x, 40.0F, 10.0F, 10.0F}, color);
+    (void)ui_render_end_recording();
+}
+
+static bool test_input_coalescer_merges_motion_and_keeps_button_order(void)
+{
+    ui_runtime context;
+    ui_input_coalescer input;
+    counting_element *target = create_counting_element();
+    if (target == NULL || !ui_runtime_init(&context))
+    {
+        free(target);
+        return false;
+    }
+    (void)ui_input_coalescer_init(&input);
+    target->base.rect = (SDL_FRect){0.0F, 0.0F, 100.0F, 100.0F};
+    if (!ui_runtime_add(&context, &target->base))
+    {
+        free(target);
+        ui_runtime_destroy(&context);
+        return false;
+    }
+
+    SDL_Event event;
+    SDL_zero(event);
+
+    // 10 motion samples, a press, 5 more samples and 3 wheel ticks should reach
+    // the runtime as motion, press, motion, wheel.
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    for (int i = 0; i < 10; ++i)
+    {
+        event.motion.x = (float)i;
+        event.motion.y = 10.0F;
+        ui_input_coalescer_push(&input, &context, &event);
+    }
+    const bool held = target->pointer_events == 0;
+
+    SDL_Event press;
+    SDL_zero(press);
+    press.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+    press.button.button = SDL_BUTTON_RIGHT;
+    press.button.x = 9.0F;
+    press.button.y = 10.0F;
+    ui_input_coalescer_push(&input, &context, &press);
+    const bool flushed_before_press = target->pointer_events == 2 && target->motion_samples == 10U;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        event.motion.x = 20.0F + (float)i;
+        ui_input_coalescer_push(&input, &context, &event);
+    }
+    SDL_Event wheel;
+    SDL_zero(wheel);
+    wheel.type = SDL_EVENT_MOUSE_WHEEL;
+    wheel.wheel.y = 1.0F;
+    wheel.wheel.mouse_x = 24.0F;
+    wheel.wheel.mouse_y = 10.0F;
+    for (int i = 0; i < 3; ++i)
+    {
+        ui_input_coalescer_push(&input, &context, &wheel);
+    }
+    ui_input_coalescer_flush(&input, &context);
+
+    size_t outside_count = 1U;
+    const ui_input_coalescer_stats stats = ui_input_coalescer_get_stats(&input);
+    const bool ok = held && flushed_before_press && target->pointer_events == 4 &&
+                    target->motion_samples == 15U && are_close(target->wheel_y, 3.0F) &&
+                    stats.received_events == 19U && stats.dispatched_events == 4U &&
+                    stats.merged_motion_events == 13U && stats.merged_wheel_events == 2U &&
+                    ui_input_coalesced_motion_samples(&outside_count) == NULL &&
+                    outside_count == 0U;
+
+    ui_input_coalescer_destroy(&input);
+    ui_runtime_destroy(&context);
+    return ok;
+}
+
+static bool test_runtime_hover_follows_pointer_and_layout(void)
+{
+    ui_runtime context;
+    ui_window *window = ui_window_create(NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 100.0F});
+    counting_element *left = create_counting_element();
+    counting_element *right = create_counting_element();
+    if (window == NULL || left == NULL || right == NULL || !ui_runtime_init(&context))
+    {
+        return false;
+    }
+    left->base.rect = (SDL_FRect){0.0F, 0.0F, 50.0F, 50.0F};
+    right->base.rect = (SDL_FRect){100.0F, 0.0F, 50.0F, 50.0F};
+    if (!ui_window_add_child(window, &left->base) || !ui_window_add_child(window, &right->base) ||
+        !ui_runtime_add(&context, &window->base))
+    {
+        return false;
+    }
+
+    SDL_Event motion;
+    SDL_zero(motion);
+    motion.type = SDL_EVENT_MOUSE_MOTION;
+    motion.motion.x = 10.0F;
+    motion.motion.y = 10.0F;
+    ui_runtime_handle_event(&context, &motion);
+    motion.motion.x = 20.0F;
+    ui_runtime_handle_event(&context, &motion);
+    const bool entered_once = left->is_hovered && left->hover_enters == 1 &&
+                              left->hover_leaves == 0 && window->hovered_child == &left->base;
+
+    motion.motion.x = 110.0F;
+    ui_runtime_handle_event(&context, &motion);
+    const bool moved = !left->is_hovered && left->hover_leaves == 1 && right->is_hovered &&
+                       right->hover_enters == 1;
+
+    // Move the hovered element out from under a still pointer; the next layout
+    // pass re-resolves hover without any motion event.
+    const SDL_FRect away = {100.0F, 60.0F, 50.0F, 30.0F};
+    ui_element_arrange(&right->base, &away);
+    ui_runtime_layout(&context);
+    const bool followed_layout = !right->is_hovered && right->hover_leaves == 1 &&
+                                 window->hovered_child == NULL &&
+                                 context.hovered_element == &window->base;
+
+    motion.motion.x = 10.0F;
+    ui_runtime_handle_event(&context, &motion);
+    SDL_Event leave;
+    SDL_zero(leave);
+    leave.type = SDL_EVENT_WINDOW_MOUSE_LEAVE;
+    ui_runtime_handle_event(&context, &leave);
+    const bool cleared = !left->is_hovered && left->hover_leaves == 2 &&
+                         context.hovered_element == NULL && window->hovered_child == NULL;
+
+    ui_runtime_destroy(&context);
+    return entered_once && moved && followed_layout && cleared;
+}
+
+static void send_wheel_at(ui_runtime *context, float x, float y)
+{
+    SDL_Event wheel;
+    SDL_zero(wheel);
+    wheel.type = SDL_EVENT_MOUSE_WHEEL;
+    wheel.wheel.mouse_x = x;
+    wheel.wheel.mouse_y = y;
+    wheel.wheel.y = 1.0F;
+    ui_runtime_handle_event(context, &wheel);
+}
+
+static bool test_element_table_tracks_runtime_state(void)
+{
+    // Six stacked elements span two four-row kernel blocks.
+    enum
+    {
+        ELEMENT_COUNT = 6
+    };
+    ui_runtime context;
+    counting_element *elements[ELEMENT_COUNT];
+    if (!ui_runtime_init(&context))
+    {
+        return false;
+    }
+    ui_runtime_set_element_table(&context, true);
+    for (size_t i = 0U; i < ELEMENT_COUNT; ++i)
+    {
+        elements[i] = create_counting_element();
+        if (elements[i] == NULL || !ui_runtime_add(&context, &elements[i]->base))
+        {
+            return false;
+        }
+    }
+    ui_element_arrange(&elements[5]->base, &(SDL_FRect){100.0F, 0.0F, 20.0F, 20.0F});
+
+    send_wheel_at(&context, 10.0F, 10.0F);
+    const bool topmost_overlap = elements[4]->wheel_y == 1.0F && elements[5]->wheel_y == 0.0F;
+
+    // Hidden through the setter, disabled by a direct write plus invalidation.
+    ui_element_set_visible(&elements[4]->base, false);
+    send_wheel_at(&context, 10.0F, 10.0F);
+    const bool skipped_hidden = elements[4]->wheel_y == 1.0F && elements[3]->wheel_y == 1.0F;
+    elements[3]->base.enabled = false;
+    ui_element_invalidate_render(&elements[3]->base);
+    send_wheel_at(&context, 10.0F, 10.0F);
+    const bool skipped_disabled = elements[3]->wheel_y == 1.0F && elements[2]->wheel_y == 1.0F;
+
+    ui_element_arrange(&elements[5]->base, &(SDL_FRect){0.0F, 0.0F, 20.0F, 20.0F});
+    send_wheel_at(&context, 10.0F, 10.0F);
+    const bool followed_arrange = elements[5]->wheel_y == 1.0F;
+
+    const bool removed = ui_runtime_remove(&context, &elements[5]->base, true);
+    send_wheel_at(&context, 10.0F, 10.0F);
+    const ui_element_table *table = &context.element_table;
+    const bool rows_follow = removed && table->count == context.element_count &&
+                             elements[2]->wheel_y == 2.0F &&
+                             (ui_element_table_flags(table, 3U) & UI_ELEMENT_TABLE_ENABLED) == 0U &&
+                             (ui_element_table_flags(table, 4U) & UI_ELEMENT_TABLE_VISIBLE) == 0U &&
+                             ui_element_table_flags(table, 5U) == 0U;
+
+    ui_runtime_destroy(&context);
+    return topmost_overlap && skipped_hidden && skipped_disabled && followed_arrange && rows_follow;
+}
+
+static bool test_render_diff_damages_only_changed_commands(void)
+{
+    SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = surface != NULL ? SDL_CreateSoftwareRenderer(surface) : NULL;
+    if (renderer == NULL)
+    {
+        SDL_DestroySurface(surface);
+        return false;
+    }
+
+    ui_render_list previous;
+    ui_render_list current;
+    ui_render_list_init(&previous);
+    ui_render_list_init(&current);
+    record_two_fills(&previous, renderer, 40.0F);
+    record_two_fills(&current, renderer, 45.0F);
+
+    ui_render_damage damage;
+    ui_render_damage_clear(&damage);
+    ui_render_list_diff(&previous, &current, &damage);
+
+    // The moved fill damages its old and new (overlapping) rects; the unchanged
+    // fill at the origin stays clean.
+    const SDL_FRect unchanged = {0.0F, 0.0F, 10.0F, 10.0F};
+    bool ok = damage.count == 1U && are_close(damage.rects[0].x, 40.0F) &&
+              are_close(damage.rects[0].y, 40.0F) && are_close(damage.rects[0].w, 15.0F) &&
+              are_close(damage.rects[0].h, 10.0F) &&
+              !SDL_HasRectIntersectionFloat(&damage.rects[0], &unchanged);
+
+    ui_render_damage_clear(&damage);
+    ui_render_list_diff(&current, &current, &damage);
+    ok = ok && damage.count == 0U;
+
+    ui_render_list_destroy(&previous);
+    ui_render_list_destroy(&current);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    return ok;
+}
+
+static bool test_render_call_stats_count_sdl_calls(void)
+{
+    SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = surface != NULL ? SDL_CreateSoftwareRenderer(surface) : NULL;
+    if (renderer == NULL)
+    {
+        SDL_DestroySurface(surface);
+        return false;
+    }
+
+    const SDL_Color ink = {0, 0, 0, 255};
+    (void)ui_render_end_frame();
+
+    // Recording issues nothing; only the replay below reaches SDL.
+    ui_render_list list;
+    ui_render_list_init(&list);
+    (void)ui_render_begin_recording(&list);
+    ui_render_push_clip(renderer, &(SDL_FRect){0.0F, 0.0F, 32.0F, 32.0F});
+    ui_render_fill_rect(renderer, &(SDL_FRect){0.0F, 0.0F, 10.0F, 10.0F}, ink);
+    ui_render_debug_text(renderer, 0.0F, 12.0F, "abc", ink);
+    ui_render_debug_text(renderer, 0.0F, 22.0F, "de", ink);
+    ui_render_pop_clip(renderer);
+    (void)ui_render_end_recording();
+    const ui_render_call_stats recorded = ui_render_get_call_stats();
+
+    ui_render_list_replay(&list, renderer);
+    ui_render_clear(renderer, ink);
+    const ui_render_call_stats frame = ui_render_end_frame();
+    const ui_render_call_stats next = ui_render_get_call_stats();
+
+    // Both texts share one glyph atlas batch, bound once; batched geometry
+    // carries vertex colors, so only the clear sets a draw color.
+    const bool ok = recorded.draw_calls == 0U && frame.draw_calls == 3U &&
+                    frame.primitives == 7U && frame.color_changes == 1U &&
+                    frame.clip_changes == 2U && frame.texture_binds == 1U &&
+                    next.draw_calls == 0U && next.color_changes == 0U;
+
+    ui_render_list_destroy(&list);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    return ok;
+}
+
+static bool test_render_replay_batches_fills_around_text(void)
+{
+    SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = surface != NULL ? SDL_CreateSoftwareRenderer(surface) : NULL;
+    if (renderer == NULL)
+    {
+        SDL_DestroySurface(surface);
+        return false;
+    }
+
+    const SDL_Color red = {255, 0, 0, 255};
+    const SDL_Color green = {0, 255, 0, 255};
+    const SDL_Color blue = {0, 0, 255, 255};
+    const SDL_Color black = {0, 0, 0, 255};
+
+    // Green covers the text and must stay above it; blue is clear of it and
+    // can join green's batch.
+    ui_render_list list;
+    ui_render_list_init(&list);
+    (void)ui_render_begin_recording(&list);
+    ui_render_fill_rect(renderer, &(SDL_FRect){0.0F, 0.0F, 8.0F, 8.0F}, red);
+    ui_render_debug_text(renderer, 0.0F, 0.0F, "X", black);
+    ui_render_fill_rect(renderer, &(SDL_FRect){0.0F, 0.0F, 8.0F, 8.0F}, green);
+    ui_render_rect(renderer, &(SDL_FRect){40.0F, 40.0F, 8.0F, 8.0F}, blue);
+    (void)ui_render_end_recording();
+
+    (void)ui_render_end_frame();
+    ui_render_list_replay(&list, renderer);
+    const ui_render_call_stats frame = ui_render_end_frame();
+    SDL_FlushRenderer(renderer);
+
+    Uint8 r = 0U;
+    Uint8 g = 0U;
+    Uint8 b = 0U;
+    Uint8 a = 0U;
+    const bool covered = SDL_ReadSurfacePixel(surface, 4, 4, &r, &g, &b, &a) && r == 0U &&
+                         g == 255U && b == 0U;
+    const bool outlined = SDL_ReadSurfacePixel(surface, 40, 44, &r, &g, &b, &a) && b == 255U &&
+                          SDL_ReadSurfacePixel(surface, 44, 44, &r, &g, &b, &a) && b == 0U;
+
+    // red | text | green + four outline edges.
+    const bool batched = frame.draw_calls == 3U && frame.primitives == 7U &&
+                         frame.color_changes == 0U;
+
+    ui_render_list_destroy(&list);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    return covered && outlined && batched;
+}
+
+static bool test_render_replay_clipped_skips_undamaged_commands(void)
+{
+    SDL_Surface *full_surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Surface *damaged_surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *full_renderer =
+        full_surface != NULL ? SDL_CreateSoftwareRenderer(full_surface) : NULL;
+    SDL_Renderer *damaged_renderer =
+        damaged_surface != NULL ? SDL_CreateSoftwareRenderer(damaged_surface) : NULL;
+    if (full_renderer == NULL || damaged_renderer == NULL)
+    {
+        SDL_DestroyRenderer(full_renderer);
+        SDL_DestroyRenderer(damaged_renderer);
+        SDL_DestroySurface(full_surface);
+        SDL_DestroySurface(damaged_surface);
+        return false;
+    }
+
+    const SDL_Color black = {0, 0, 0, 255};
+    const SDL_Color white = {255, 255, 255, 255};
+    const SDL_Color green = {0, 255, 0, 255};
+
+    // Eight 8px rows; the mark over each row's text keeps fills and text
+    // from sharing a batch, so every row costs its own draws.
+    ui_render_list list;
+    ui_render_list_init(&list);
+    (void)ui_render_begin_recording(&list);
+    for (int row = 0; row < 8; ++row)
+    {
+        const float y = (float)row * 8.0F;
+        ui_render_fill_rect(full_renderer, &(SDL_FRect){0.0F, y, 64.0F, 8.0F}, black);
+        ui_render_debug_text(full_renderer, 0.0F, y, "ab", white);
+        ui_render_fill_rect(full_renderer, &(SDL_FRect){4.0F, y + 2.0F, 4.0F, 4.0F}, green);
+    }
+    ui_render_push_clip(full_renderer, &(SDL_FRect){0.0F, 0.0F, 64.0F, 16.0F});
+    ui_render_fill_rect(full_renderer, &(SDL_FRect){32.0F, 0.0F, 8.0F, 8.0F}, green);
+    ui_render_pop_clip(full_renderer);
+    (void)ui_render_end_recording();
+
+    const SDL_FRect full_rect = {0.0F, 0.0F, 64.0F, 64.0F};
+    const SDL_FRect damaged_row = {0.0F, 24.0F, 64.0F, 8.0F};
+    (void)ui_render_end_frame();
+    ui_render_list_replay_clipped(&list, full_renderer, &full_rect);
+    const ui_render_call_stats full = ui_render_end_frame();
+    ui_render_list_replay_clipped(&list, damaged_renderer, &damaged_row);
+    const ui_render_call_stats damaged = ui_render_end_frame();
+    SDL_FlushRenderer(full_renderer);
+    SDL_FlushRenderer(damaged_renderer);
+
+    // Only the damaged row's fill, text and mark are issued; the clip group
+    // above it is skipped without touching the clip rect.
+    bool ok = damaged.draw_calls == 3U && damaged.draw_calls < full.draw_calls &&
+              damaged.clip_changes == 2U;
+    for (int x = 0; ok && x < 64; x += 3)
+    {
+        Uint8 full_r = 0U;
+        Uint8 full_g = 0U;
+        Uint8 full_b = 0U;
+        Uint8 damaged_r = 0U;
+        Uint8 damaged_g = 0U;
+        Uint8 damaged_b = 0U;
+        Uint8 a = 0U;
+        ok = SDL_ReadSurfacePixel(full_surface, x, 27, &full_r, &full_g, &full_b, &a) &&
+             SDL_ReadSurfacePixel(damaged_surface, x, 27, &damaged_r, &damaged_g, &damaged_b,
+                                  &a) &&
+             full_r == damaged_r && full_g == damaged_g && full_b == damaged_b;
+    }
+
+    ui_render_list_destroy(&list);
+    SDL_DestroyRenderer(full_renderer);
+    SDL_DestroyRenderer(damaged_renderer);
+    SDL_DestroySurface(full_surface);
+    SDL_DestroySurface(damaged_surface);
+    return ok;
+}
+
+static bool test_glyph_atlas_text_matches_debug_text(void)
+{
+    SDL_Surface *atlas_surface = SDL_CreateSurface(64, 16, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Surface *debug_surface = SDL_CreateSurface(64, 16, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *atlas_renderer =
+        atlas_surface != NULL ? SDL_CreateSoftwareRenderer(atlas_surface) : NULL;
+    SDL_Renderer *debug_renderer =
+        debug_surface != NULL ? SDL_CreateSoftwareRenderer(debug_surface) : NULL;
+    bool ok = atlas_renderer != NULL && debug_renderer != NULL &&
+              ui_glyph_atlas_get(atlas_renderer) != NULL;
+
+    // Same text through the atlas and through SDL's debug font must match
+    // pixel for pixel, including spaces, punctuation and Latin-1.
+    const char *text = "Hi! \xC3\xA9";
+    const SDL_Color ink = {200, 40, 10, 255};
+    if (ok)
+    {
+        SDL_SetRenderDrawColor(atlas_renderer, 255, 255, 255, 255);
+        SDL_RenderClear(atlas_renderer);
+        ui_render_debug_text(atlas_renderer, 3.0F, 4.0F, text, ink);
+        SDL_FlushRenderer(atlas_renderer);
+
+        SDL_SetRenderDrawColor(debug_renderer, 255, 255, 255, 255);
+        SDL_RenderClear(debug_renderer);
+        SDL_SetRenderDrawColor(debug_renderer, ink.r, ink.g, ink.b, ink.a);
+        SDL_RenderDebugText(debug_renderer, 3.0F, 4.0F, text);
+        SDL_FlushRenderer(debug_renderer);
+    }
+
+    int inked = 0;
+    for (int y = 0; ok && y < 16; ++y)
+    {
+        for (int x = 0; ok && x < 64; ++x)
+        {
+            Uint8 r1 = 0U;
+            Uint8 g1 = 0U;
+            Uint8 b1 = 0U;
+            Uint8 a1 = 0U;
+            Uint8 r2 = 0U;
+            Uint8 g2 = 0U;
+            Uint8 b2 = 0U;
+            Uint8 a2 = 0U;
+            ok = SDL_ReadSurfacePixel(atlas_surface, x, y, &r1, &g1, &b1, &a1) &&
+                 SDL_ReadSurfacePixel(debug_surface, x, y, &r2, &g2, &b2, &a2) && r1 == r2 &&
+                 g1 == g2 && b1 == b2;
+            inked += r1 == ink.r && g1 == ink.g && b1 == ink.b ? 1 : 0;
+        }
+    }
+
+    SDL_DestroyRenderer(atlas_renderer);
+    SDL_DestroyRenderer(debug_renderer);
+    SDL_DestroySurface(atlas_surface);
+    SDL_DestroySurface(debug_surface);
+    return ok && inked > 0;
+}
+
+static bool test_text_run_follows_content(void)
+{
+    const SDL_Color black = {0, 0, 0, 255};
+    ui_text *label = ui_text_create(NULL, 0.0F, 0.0F, "READY", black, NULL);
+    if (label == NULL)
+    {
+        return false;
+    }
+
+    bool ok = label->run.text == label->content && label->run.byte_length == 5U &&
+              label->run.glyph_count == 5U && label->run.width == 40.0F &&
+              label->run.height == UI_TEXT_GLYPH_HEIGHT && label->base.rect.w == 40.0F;
+
+    // New content is measured once, on the set, and the run follows the copy.
+    ok = ok && ui_text_set_content(label, "UPDATED") && label->run.text == label->content &&
+         label->run.width == 56.0F && label->base.rect.w == 56.0F;
+
+    ui_text_run empty;
+    ui_text_run_set(&empty, NULL);
+    ok = ok && ui_text_run_is_empty(&empty) && strcmp(empty.text, "") == 0 &&
+         empty.width == 0.0F && empty.height == UI_TEXT_GLYPH_HEIGHT;
+    ok = ok && ui_text_run_glyphs_in_width(20.0F) == 2U && ui_text_run_glyphs_in_width(-1.0F) == 0U;
+
+    ui_traversal_destroy(&label->base);
+    return ok;
+}
+
+static bool test_utf8_scans_follow_codepoints(void)
+{
+    // 1-, 2-, 3- and 4-byte codepoints, repeated past several vector blocks
+    // and ending mid-block so the scalar tail runs too.
+    const char *unit = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    char text[10U * 41U + 1U];
+    for (size_t i = 0U; i < 41U; ++i)
+    {
+        memcpy(text + (i * 10U), unit, 10U);
+    }
+    text[sizeof(text) - 1U] = '\0';
+    const size_t length = sizeof(text) - 1U;
+
+    bool ok = utf8_is_valid(text, length) && utf8_count_codepoints(text, length) == 164U;
+
+    // Every prefix ends where SDL's decoder has consumed that many codepoints.
+    const char *cursor = text;
+    size_t remaining = length;
+    for (size_t n = 0U; ok && n <= 164U; ++n)
+    {
+        ok = utf8_prefix_bytes(text, length, n) == (size_t)(cursor - text);
+        if (n < 164U)
+        {
+            (void)SDL_StepUTF8(&cursor, &remaining);
+        }
+    }
+    ok = ok && utf8_prefix_bytes(text, length, 1000U) == length;
+
+    // Backspace from the end removes the whole 4-byte emoji.
+    ok = ok && utf8_floor_boundary(text, length, length - 1U) == length - 4U &&
+         utf8_floor_boundary(text, length, 2U) == 1U && utf8_floor_boundary(text, 5U, 9U) == 5U;
+
+    // Overlong, surrogate, truncated, above U+10FFFF, stray continuation.
+    const char *invalid[] = {"\xC0\x80", "\xED\xA0\x80", "abc\xE2\x82", "\xF4\x90\x80\x80",
+                             "0123456789abcdef0123456789abcdef\x80"};
+    for (size_t i = 0U; i < SDL_arraysize(invalid); ++i)
+    {
+        ok = ok && !utf8_is_valid(invalid[i], strlen(invalid[i]));
+    }
+
+    // Text runs measure codepoints, not bytes.
+    ui_text_run run;
+    ui_text_run_set(&run, "caf\xC3\xA9");
+    ok = ok && run.byte_length == 5U && run.glyph_count == 4U && run.width == 32.0F;
+    return ok;
+}
+
+typedef struct counting_heap
+{
+    size_t allocations;
+    size_t releases;
+    size_t bytes_live;
+} counting_heap;
+
+static void *counting_allocate(void *user_data, size_t size)
+{
+    counting_heap *heap = user_data;
+    heap->allocations++;
+    heap->bytes_live += size;
+    return malloc(size);
+}
+
+static void *counting_reallocate(void *user_data, void *ptr, size_t old_size, size_t new_size)
+{
+    counting_heap *heap = user_data;
+    heap->allocations++;
+    heap->bytes_live += new_size - old_size;
+    return realloc(ptr, new_size);
+}
+
+static void counting_release(void *user_data, void *ptr, size_t size)
+{
+    counting_heap *heap = user_data;
+    heap->releases++;
+    heap->bytes_live -= size;
+    free(ptr);
+}
+
+static bool test_text_updates_reuse_storage(void)
+{
+    counting_heap heap = {0U, 0U, 0U};
+    const cui_allocator allocator = {counting_allocate, counting_reallocate, counting_release,
+                                     &heap};
+    const SDL_Color black = {0, 0, 0, 255};
+
+    // Short content lives inside the element: only the element is allocated.
+    ui_text *label = ui_text_create(&allocator, 0.0F, 0.0F, "00:00:00", black, NULL);
+    if (label == NULL)
+    {
+        return false;
+    }
+    bool ok = heap.allocations == 1U && label->content == label->inline_storage;
+    for (int i = 0; ok && i < 1000; ++i)
+    {
+        ok = ui_text_set_format(label, "%02d:%02d:%02d", i / 3600, (i / 60) % 60, i % 60);
+    }
+    ok = ok && heap.allocations == 1U && strcmp(label->content, "00:16:39") == 0 &&
+         label->run.byte_length == 8U && label->base.rect.w == 64.0F;
+
+    // Outgrowing the inline buffer allocates once, then updates reuse it.
+    const char *long_text = "A LABEL LONGER THAN THE INLINE STORAGE OF A TEXT ELEMENT";
+    ok = ok && ui_text_set_content(label, long_text) && heap.allocations == 2U &&
+         label->content != label->inline_storage && strcmp(label->content, long_text) == 0;
+    ok = ok && ui_text_set_format(label, "%s #%d", "SHORTER AGAIN", 7) &&
+         ui_text_set_content(label, long_text) && heap.allocations == 2U;
+
+    // Formatted output past the capacity grows in one step and keeps the text.
+    ok = ok && ui_text_set_format(label, "%s / %s", long_text, long_text) &&
+         heap.allocations == 3U && heap.releases == 1U &&
+         label->run.byte_length == (2U * strlen(long_text)) + 3U;
+
+    // Self-assignment from a suffix of the buffer is safe.
+    ok = ok && ui_text_set_content(label, label->content + 4U) &&
+         strncmp(label->content, "BEL LONGER", 10U) == 0;
+
+    ui_traversal_destroy(&label->base);
+    return ok && heap.releases == heap.allocations && heap.bytes_live == 0U;
+}
+
+static bool test_string_pool_shares_text_content(void)
+{
+    string_pool pool;
+    string_pool_init(&pool);
+    const SDL_Color black = {0, 0, 0, 255};
+
+    // Equal strings intern to one refcounted copy.
+    const char *title = string_pool_intern(&pool, "WRITE TESTS");
+    char buffer[16];
+    SDL_snprintf(buffer, sizeof(buffer), "WRITE %s", "TESTS");
+    bool ok = title != NULL && string_pool_intern(&pool, buffer) == title &&
+              string_pool_length(title) == 11U;
+    string_pool_stats stats;
+    string_pool_get_stats(&pool, &stats);
+    ok = ok && stats.live_strings == 1U && stats.references == 2U && stats.string_bytes == 12U &&
+         stats.intern_calls == 2U && stats.intern_hits == 1U && stats.arena_bytes > 0U;
+
+    // Texts display the pooled copy itself and hold their own reference.
+    ui_text *first = ui_text_create(NULL, 0.0F, 0.0F, "", black, NULL);
+    ui_text *second = ui_text_create(NULL, 0.0F, 0.0F, "WRITE TESTS", black, NULL);
+    if (first == NULL || second == NULL)
+    {
+        return false;
+    }
+    ok = ok && ui_text_set_interned(first, &pool, title) &&
+         ui_text_set_interned(second, &pool, title) && first->content == title &&
+         second->content == title && first->run.byte_length == 11U &&
+         first->base.rect.w == 88.0F;
+    string_pool_release(&pool, title);
+    string_pool_release(&pool, title);
+    string_pool_get_stats(&pool, &stats);
+    ok = ok && stats.live_strings == 1U && stats.references == 2U;
+
+    // Replacing or destroying the text drops its reference; the last one
+    // recycles the entry for the next string of its size.
+    ok = ok && ui_text_set_content(first, "LOCAL") && first->content == first->inline_storage;
+    ui_traversal_destroy(&second->base);
+    string_pool_get_stats(&pool, &stats);
+    ok = ok && stats.live_strings == 0U && stats.references == 0U && stats.string_bytes == 0U &&
+         stats.free_bytes > 0U;
+    const size_t arena_bytes = stats.arena_bytes;
+    const char *reused = string_pool_intern(&pool, "READ DOCS");
+    string_pool_get_stats(&pool, &stats);
+    ok = ok && reused == title && stats.free_bytes == 0U && stats.arena_bytes == arena_bytes;
+
+    string_pool_release(&pool, reused);
+    ui_traversal_destroy(&first->base);
+    string_pool_destroy(&pool);
+    return ok;
+}
+
+typedef struct list_view_rows
+{
+    size_t created;
+    size_t bound;
+} list_view_rows;
+
+static ui_element *create_list_view_row(void *context)
+{
+    list_view_rows *rows = (list_view_rows *)context;
+    rows->created++;
+    const SDL_Color black = {0, 0, 0, 255};
+    return (ui_element *)ui_text_create(NULL, 0.0F, 0.0F, "", black, NULL);
+}
+
+static void bind_list_view_row(void *context, ui_element *row, size_t index)
+{
+    list_view_rows *rows = (list_view_rows *)context;
+    rows->bound++;
+    (void)ui_text_set_format((ui_text *)row, "ROW %zu", index);
+}
+
+static bool list_view_rows_match(const ui_list_view *list)
+{
+    for (size_t i = 0U; i < list->bound_count; ++i)
+    {
+        char expected[32];
+        SDL_snprintf(expected, sizeof(expected), "ROW %zu", list->first_index + i);
+        if (strcmp(ui_text_get_content((const ui_text *)list->rows[i]), expected) != 0 ||
+            list->rows[i]->parent != &list->base)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool test_list_view_recycles_rows(void)
+{
+    list_view_rows rows = {0U, 0U};
+    const ui_list_view_adapter adapter = {
+        .create_row = create_list_view_row,
+        .bind_row = bind_list_view_row,
+        .context = &rows,
+    };
+    const SDL_FRect viewport = {0.0F, 0.0F, 300.0F, 200.0F};
+    ui_list_view *list = ui_list_view_create(NULL, &viewport, 1000000U, UI_LIST_VIEW_FIXED_HEIGHT,
+                                             20.0F, 2U, &adapter, NULL);
+    if (list == NULL)
+    {
+        return false;
+    }
+    ui_list_view_set_spacing(list, 8.0F, 8.0F);
+    ui_element_arrange(&list->base, &viewport);
+
+    // A million rows bind only what covers the viewport plus overscan below.
+    bool ok = list->first_index == 0U && list->bound_count == 9U && rows.created == 9U &&
+              list_view_rows_match(list) && list->rows[0]->rect.y == 8.0F &&
+              list->rows[1]->rect.y == 36.0F && ui_list_view_content_height(list) == 28000008.0;
+
+    // Wheel scrolling recycles rows instead of creating them.
+    SDL_Event wheel;
+    SDL_zero(wheel);
+    wheel.type = SDL_EVENT_MOUSE_WHEEL;
+    wheel.wheel.y = -1.0F;
+    wheel.wheel.mouse_x = 10.0F;
+    wheel.wheel.mouse_y = 10.0F;
+    list->scroll_step = 30.0F;
+    for (int i = 0; i < 1000; ++i)
+    {
+        ok = ok && list->base.ops->handle_event(&list->base, &wheel);
+    }
+    ok = ok && list->scroll_offset == 30000.0 && list->first_index == 1069U &&
+         list_view_rows_match(list) && rows.created <= 13U;
+
+    // Rows stay exactly placed at the far end of the list.
+    ui_list_view_scroll_to_row(list, 999999U);
+    const ui_element *last = list->rows[list->bound_count - 1U];
+    ok = ok && list->first_index + list->bound_count == 1000000U && list_view_rows_match(list) &&
+         last->rect.y + last->rect.h + 8.0F == 200.0F && rows.created <= 13U;
+
+    // Shrinking the count clamps the scroll offset and rebinds every row.
+    const size_t bound_before = rows.bound;
+    ok = ok && ui_list_view_set_row_count(list, 3U) && list->scroll_offset == 0.0 &&
+         list->bound_count == 3U && list_view_rows_match(list) && rows.bound == bound_before + 3U;
+    ok = ok && ui_list_view_set_row_count(list, 0U) && list->bound_count == 0U;
+    ok = ok && ui_list_view_set_row_count(list, 100U) && list_view_rows_match(list);
+
+    ui_traversal_destroy(&list->base);
+    return ok;
+}
+
+static bool test_list_view_estimates_row_heights(void)
+{
+    list_view_rows rows = {0U, 0U};
+    const ui_list_view_adapter adapter = {
+        .create_row = create_list_view_row,
+        .bind_row = bind_list_view_row,
+        .context = &rows,
+    };
+    const SDL_FRect viewport = {0.0F, 0.0F, 300.0F, 200.0F};
+    ui_list_view *list = ui_list_view_create(NULL, &viewport, 100000U,
+                                             UI_LIST_VIEW_ESTIMATED_HEIGHT, 20.0F, 1U, &adapter,
+                                             NULL);
+    if (list == NULL)
+    {
+        return false;
+    }
+    ui_element_arrange(&list->base, &viewport);
+
+    // Bound rows replace the 20 px estimate with their measured 8 px height,
+    // which pulls more rows into the viewport.
+    const size_t measured = list->bound_count;
+    bool ok = list->first_index == 0U && measured * 8U >= 200U && list_view_rows_match(list);
+    for (size_t i = 0U; ok && i < list->bound_count; ++i)
+    {
+        ok = list->rows[i]->rect.y == (float)(8U * i) && list->rows[i]->rect.h == 8.0F;
+    }
+    const double content = (8.0 * (double)measured) + (20.0 * (double)(100000U - measured));
+    ok = ok && ui_list_view_content_height(list) == content;
+
+    // Rows measured above the viewport move the offset with them, so the
+    // target row stays at the top.
+    ui_list_view_scroll_to_row(list, 50000U);
+    ok = ok && list->first_index <= 50000U && list_view_rows_match(list) &&
+         list->rows[50000U - list->first_index]->rect.y == 0.0F;
+
+    // Adding a row keeps measured heights and the visible rows in place.
+    const double before = ui_list_view_content_height(list);
+    ok = ok && ui_list_view_set_row_count(list, 100001U) &&
+         ui_list_view_content_height(list) == before + 20.0 && list_view_rows_match(list) &&
+         list->rows[50000U - list->first_index]->rect.y == 0.0F;
+
+    // Negative spacing clamps to 0 and leaves row pitches alone.
+    ui_list_view_set_spacing(list, 0.0F, -5.0F);
+    ok = ok && list->spacing == 0.0F && ui_list_view_content_height(list) == before + 20.0;
+
+    // Jumping back past the bound range rebinds every row.
+    ui_list_view_scroll_to_row(list, 0U);
+    ok = ok && list->first_index == 0U && list_view_rows_match(list) &&
+         list->rows[0]->rect.y == 0.0F;
+
+    // Shrinking keeps the heights of the rows that remain.
+    ok = ok && ui_list_view_set_row_count(list, 10U) && list->bound_count == 10U &&
+         ui_list_view_content_height(list) == 80.0;
+
+    ui_traversal_destroy(&list->base);
+    return ok;
+}
+
+static bool test_arena_backs_widget_tree_and_strings(void)
+{
+    cui_arena arena;
+    cui_arena_init(&arena, 1024U);
+    const cui_allocator *allocator = cui_arena_allocator(&arena);
+
+    // The newest allocation can be grown in place and handed back.
+    char *tail = cui_alloc(allocator, 8U);
+    char *grown = cui_realloc(allocator, tail, 8U, 32U);
+    bool ok = tail != NULL && grown == tail && arena.bytes_used >= 32U;
+    cui_free(allocator, grown, 32U);
+    ok = ok && arena.bytes_used == 0U;
+
+    // An oversized request does not retire the current block: the next small
+    // allocation still bumps from it instead of reserving a third block.
+    const void *small = cui_alloc(allocator, 16U);
+    const void *oversized = cui_alloc(allocator, 4096U);
+    const void *next_small = cui_alloc(allocator, 16U);
+    ok = ok && small != NULL && oversized != NULL && next_small != NULL &&
+         arena.bytes_reserved == 1024U + 4096U;
+
+    const SDL_Color black = {0, 0, 0, 255};
+    ui_window *window = ui_window_create(allocator, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F});
+    ui_layout_container *column = ui_layout_container_create(
+        allocator, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    ui_text *label = ui_text_create(allocator, 0.0F, 0.0F, "READY", black, NULL);
+    if (window == NULL || column == NULL || label == NULL ||
+        !ui_window_add_child(window, &column->base) ||
+        !ui_layout_container_add_child(column, &label->base))
+    {
+        cui_arena_destroy(&arena);
+        return false;
+    }
+
+    // Enough children to grow the container's child array past its first
+    // capacity, so the array is reallocated through the arena.
+    for (int i = 0; i < 20; ++i)
+    {
+        ui_pane *pane =
+            ui_pane_create(allocator, &(SDL_FRect){0.0F, 0.0F, 10.0F, 10.0F}, black, NULL);
+        ok = ok && pane != NULL && pane->base.allocator == allocator &&
+             ui_layout_container_add_child(column, &pane->base);
+    }
+
+    ok = ok && ui_text_set_content(label, "UPDATED") &&
+         strcmp(ui_text_get_content(label), "UPDATED") == 0;
+    ok = ok && window->base.allocator == allocator && column->child_count == 21U &&
+         arena.bytes_used > 0U && arena.bytes_reserved >= arena.bytes_used;
+
+    // Destroy ops still run for the whole tree; their releases are no-ops for
+    // all but the newest allocation, and the arena reclaims the rest at once.
+    ui_traversal_destroy(&window->base);
+    ok = ok && arena.bytes_used > 0U;
+
+    cui_arena_destroy(&arena);
+    return ok && arena.bytes_used == 0U && arena.bytes_reserved == 0U;
+}
+
+static bool test_frame_profiler_reports_tail_percentiles(void)
+{
+    // Heap-allocated: the ring buffers are too large to keep on a test frame.
+    ui_frame_profiler *profiler = malloc(sizeof(*profiler));
+    if (profiler == NULL || !ui_frame_profiler_init(profiler))
+    {
+        free(profiler);
+        return false;
+    }
+
+    const double ms = (double)profiler->ticks_per_second / 1000.0;
+    const bool empty = ui_frame_profiler_get_frame_stats(profiler).sample_count == 0U;
+
+    // Frames 1..100 ms of render time plus a constant 1 ms of events.
+    for (Uint64 i = 1U; i <= 100U; ++i)
+    {
+        Uint64 ticks[UI_FRAME_PHASE_COUNT] = {0};
+        ticks[UI_FRAME_PHASE_EVENTS] = (Uint64)ms;
+        ticks[UI_FRAME_PHASE_RENDER] = (Uint64)((double)i * ms);
+        ui_frame_profiler_record_frame(profiler, ticks);
+    }
+
+    const ui_frame_timing_stats render =
+        ui_frame_profiler_get_phase_stats(profiler, UI_FRAME_PHASE_RENDER);
+    const ui_frame_timing_stats events =
+        ui_frame_profiler_get_phase_stats(profiler, UI_FRAME_PHASE_EVENTS);
+    const ui_frame_timing_stats frame = ui_frame_profiler_get_frame_stats(profiler);
+    const bool ranked = render.sample_count == 100U && are_close((float)render.p50_ms, 50.0F) &&
+                        are_close((float)render.p95_ms, 95.0F) &&
+                        are_close((float)render.p99_ms, 99.0F) &&
+                        are_close((float)render.max_ms, 100.0F) &&
+                        are_close((float)events.max_ms, 1.0F) &&
+                        are_close((float)frame.max_ms, 101.0F);
+
+    // Wrapping the ring drops the old slow frames from every series.
+    for (size_t i = 0U; i < UI_FRAME_PROFILER_CAPACITY; ++i)
+    {
+        Uint64 ticks[UI_FRAME_PHASE_COUNT] = {0};
+        ticks[UI_FRAME_PHASE_LAYOUT] = (Uint64)(2.0 * ms);
+        ui_frame_profiler_record_frame(profiler, ticks);
+    }
+    const ui_frame_timing_stats wrapped = ui_frame_profiler_get_frame_stats(profiler);
+    const bool rolled = wrapped.sample_count == UI_FRAME_PROFILER_CAPACITY &&
+                        are_close((float)wrapped.max_ms, 2.0F) &&
+                        ui_frame_profiler_get_phase_stats(profiler, UI_FRAME_PHASE_RENDER)
+                                .max_ms == 0.0 &&
+                        profiler->frame_count == 100U + UI_FRAME_PROFILER_CAPACITY;
+
+    // Marks outside begin/end are ignored; a real frame sums its phases.
+    ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_EVENTS);
+    ui_frame_profiler_begin_frame(profiler);
+    ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_EVENTS);
+    ui_frame_profiler_mark(profiler, UI_FRAME_PHASE_RENDER);
+    ui_frame_profiler_end_frame(profiler);
+    ui_frame_profiler_end_frame(profiler);
+    const bool counted = profiler->frame_count == 101U + UI_FRAME_PROFILER_CAPACITY;
+
+    free(profiler);
+    return empty && ranked && rolled && counted;
+}
+
+static const ui_ops_profile_entry *find_ops_profile(const ui_element_ops *ops)
+{
+    const ui_ops_profile_entry *entries = NULL;
+    const size_t count = ui_ops_profiler_entries(&entries);
+    for (size_t i = 0U; i < count; ++i)
+    {
+        if (entries[i].ops == ops)
+        {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+static bool test_ops_profiler_splits_self_time_per_type(void)
+{
+    ui_layout_container *container = ui_layout_container_create(
+        NULL, &(SDL_FRect){0.0F, 0.0F, 200.0F, 200.0F}, UI_LAYOUT_AXIS_VERTICAL, NULL);
+    counting_element *first = create_counting_element();
+    counting_element *second = create_counting_element();
+    if (container == NULL || first == NULL || second == NULL ||
+        !ui_layout_container_add_child(container, &first->base) ||
+        !ui_layout_container_add_child(container, &second->base))
+    {
+        return false;
+    }
+
+    ui_ops_profiler_reset();
+    measure_and_arrange(&container->base);
+    ui_ops_profiler_end_frame();
+
+    const ui_ops_profile_entry *leaf = find_ops_profile(&COUNTING_ELEMENT_OPS);
+    const ui_ops_profile_entry *column = find_ops_profile(container->base.ops);
+    bool ok = leaf != NULL && column != NULL;
+    if (ok)
+    {
+        const ui_ops_call_stats *leaf_measure = &leaf->last_frame[UI_OPS_CALL_MEASURE];
+        const ui_ops_call_stats *column_measure = &column->last_frame[UI_OPS_CALL_MEASURE];
+        // Children measured inside the container are subtracted from its self time.
+        ok = leaf_measure->calls == 2U && column_measure->calls == 1U &&
+             column->last_frame[UI_OPS_CALL_ARRANGE].calls == 1U &&
+             leaf->current[UI_OPS_CALL_MEASURE].calls == 0U &&
+             leaf->total[UI_OPS_CALL_MEASURE].calls == 2U &&
+             column_measure->self_ticks + leaf_measure->inclusive_ticks ==
+                 column_measure->inclusive_ticks;
+    }
+
+    // A clean second pass dispatches nothing, so the last frame reads zero.
+    measure_and_arrange(&container->base);
+    ui_ops_profiler_end_frame();
+    ok = ok && leaf->last_frame[UI_OPS_CALL_MEASURE].calls == 0U &&
+         leaf->total[UI_OPS_CALL_MEASURE].calls == 2U;
+
+    ui_traversal_destroy(&container->base);
+    ui_ops_profiler_reset();
+    return ok && ui_ops_profiler_entries(NULL) == 0U;
+}
+
+static bool test_event_log_round_trips_frames_and_text(void)
+{
+    static const char *LOG_PATH = "ui_hierarchy_tests_event_log.bin";
+    const ui_event_log_header header = {
+        .wall_start_ns = 1700000000LL * SDL_NS_PER_SECOND,
+        .ticks_start_ns = 5000U,
+        .width = 800,
+        .height = 600,
+    };
+
+    ui_event_log_writer writer;
+    if (!ui_event_log_writer_open(&writer, LOG_PATH, &header))
+    {
+        return false;
+    }
+
+    SDL_Event motion;
+    SDL_zero(motion);
+    motion.type = SDL_EVENT_MOUSE_MOTION;
+    motion.motion.x = 12.5F;
+    motion.motion.yrel = -3.0F;
+    SDL_Event text;
+    SDL_zero(text);
+    text.type = SDL_EVENT_TEXT_INPUT;
+    text.text.text = "h\xc3\xa9";
+    SDL_Event drop;
+    SDL_zero(drop);
+    drop.type = SDL_EVENT_DROP_FILE;
+    SDL_Event quit;
+    SDL_zero(quit);
+    quit.type = SDL_EVENT_QUIT;
+
+    // Pointer-carrying types are skipped rather than written as dangling bytes.
+    const bool written = ui_event_log_write(&writer, 0U, 6000U, &motion) &&
+                         ui_event_log_write_frame(&writer, 2U, 1500000000U) &&
+                         ui_event_log_write(&writer, 2U, 7000U, &text) &&
+                         ui_event_log_write(&writer, 2U, 7500U, &drop) &&
+                         ui_event_log_write(&writer, 3U, 9000U, &quit) &&
+                         writer.written_events == 3U && writer.skipped_events == 1U &&
+                         ui_event_log_writer_close(&writer);
+
+    ui_event_log_reader reader;
+    if (!written || !ui_event_log_reader_open(&reader, LOG_PATH))
+    {
+        (void)SDL_RemovePath(LOG_PATH);
+        return false;
+    }
+
+    SDL_Event event;
+    Uint64 timestamp_ns = 0U;
+    const bool restored_header = reader.header.wall_start_ns == header.wall_start_ns &&
+                                 reader.header.ticks_start_ns == header.ticks_start_ns &&
+                                 reader.header.width == 800 && reader.header.height == 600;
+    const bool frame0 = ui_event_log_read(&reader, 0U, &event, &timestamp_ns) &&
+                        event.type == SDL_EVENT_MOUSE_MOTION && event.motion.x == 12.5F &&
+                        event.motion.yrel == -3.0F && timestamp_ns == 1000U &&
+                        !ui_event_log_read(&reader, 0U, &event, NULL);
+    // Frame 1 recorded nothing; frame 2's records wait for frame 2, and its
+    // events only after its frame record.
+    Uint64 frame_ns = 0U;
+    const bool frame1 = !ui_event_log_read(&reader, 1U, &event, NULL) &&
+                        !ui_event_log_read_frame(&reader, 1U, &frame_ns);
+    const bool frame2 = !ui_event_log_read(&reader, 2U, &event, NULL) &&
+                        ui_event_log_read_frame(&reader, 2U, &frame_ns) &&
+                        frame_ns == 1500000000U &&
+                        !ui_event_log_read_frame(&reader, 2U, &frame_ns) &&
+                        ui_event_log_read(&reader, 2U, &event, &timestamp_ns) &&
+                        event.type == SDL_EVENT_TEXT_INPUT &&
+                        strcmp(event.text.text, "h\xc3\xa9") == 0 && timestamp_ns == 2000U;
+    const bool frame3 = !ui_event_log_reader_at_end(&reader) &&
+                        ui_event_log_read(&reader, 3U, &event, NULL) &&
+                        event.type == SDL_EVENT_QUIT && ui_event_log_reader_at_end(&reader) &&
+                        !reader.failed && reader.read_events == 3U;
+
+    ui_event_log_reader_close(&reader);
+    (void)SDL_RemovePath(LOG_PATH);
+    return restored_header && frame0 && frame1 && frame2 && frame3;
+}
+
+enum
+{
+    SESSION_FRAME_COUNT = 6,
+    SESSION_MAX_TASKS = 16,
+    SESSION_TEXT_CAPACITY = 64
+};
+
+// What a todo session leaves behind, copied out before the page is destroyed.
+typedef struct todo_session_result
+{
+    size_t task_count;
+    char titles[SESSION_MAX_TASKS][SESSION_TEXT_CAPACITY];
+    char due_times[SESSION_MAX_TASKS][SESSION_TEXT_CAPACITY];
+    bool done[SESSION_MAX_TASKS];
+    char header[SESSION_TEXT_CAPACITY];
+} todo_session_result;
+
+/*
+ * Run the todo page through main.c's frame order. With a writer the scripted
+ * deltas and events are played live and logged; with a reader both come from
+ * the log instead, exactly as --replay feeds them.
+ */
+static bool run_todo_session(SDL_Window *window, ui_event_log_writer *writer,
+                             ui_event_log_reader *reader, todo_session_result *out)
+{
+    // Idle gaps of seconds and a minute, as SDL_WaitEventTimeout produces them.
+    static const Uint64 FRAME_NS[SESSION_FRAME_COUNT] = {
+        16000000U, 2500000000U, 16000000U, 61000000000U, 16000000U, 3300000000U,
+    };
+
+    SDL_Event click_down;
+    SDL_zero(click_down);
+    click_down.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+    click_down.button.button = SDL_BUTTON_LEFT;
+    click_down.button.x = 400.0F;
+    click_down.button.y = 170.0F;
+    SDL_Event click_up = click_down;
+    click_up.type = SDL_EVENT_MOUSE_BUTTON_UP;
+    SDL_Event text;
+    SDL_zero(text);
+    text.type = SDL_EVENT_TEXT_INPUT;
+    text.text.text = "milk";
+    SDL_Event submit;
+    SDL_zero(submit);
+    submit.type = SDL_EVENT_KEY_DOWN;
+    submit.key.key = SDLK_RETURN;
+    const SDL_Event *script[SESSION_FRAME_COUNT][2] = {
+        {NULL, NULL}, {&click_down, &click_up}, {NULL, NULL},
+        {&text, NULL}, {NULL, NULL},           {&submit, NULL},
+    };
+
+    ui_runtime context;
+    if (!ui_runtime_init(&context))
+    {
+        return false;
+    }
+    todo_page *page = todo_page_create(window, &context, 1024, 768);
+    bool ok = page != NULL;
+
+    for (Uint32 frame = 0U; ok && frame < SESSION_FRAME_COUNT; ++frame)
+    {
+        Uint64 frame_ns = FRAME_NS[frame];
+        if (reader != NULL)
+        {
+            frame_ns = 0U;
+            ok = ui_event_log_read_frame(reader, frame, &frame_ns);
+        }
+        ui_clock_advance(frame_ns);
+        if (writer != NULL)
+        {
+            ok = ok && ui_event_log_write_frame(writer, frame, frame_ns);
+        }
+
+        SDL_Event event;
+        for (size_t i = 0U; ok && reader == NULL && i < 2U && script[frame][i] != NULL; ++i)
+        {
+            ok = ui_event_log_write(writer, frame, ui_clock_ticks_ns(), script[frame][i]);
+            ui_runtime_handle_event(&context, script[frame][i]);
+        }
+        while (ok && reader != NULL && ui_event_log_read(reader, frame, &event, NULL))
+        {
+            ui_runtime_handle_event(&context, &event);
+        }
+
+        ok = ok && todo_page_update(page);
+        ui_runtime_update(&context, (float)frame_ns / (float)SDL_NS_PER_SECOND);
+        ui_runtime_layout(&context);
+    }
+
+    out->task_count = ok ? todo_page_task_count(page) : 0U;
+    ok = ok && out->task_count <= SESSION_MAX_TASKS;
+    for (size_t i = 0U; ok && i < out->task_count; ++i)
+    {
+        const char *title = NULL;
+        const char *due_time = NULL;
+        ok = todo_page_get_task(page, i, &title, &due_time, &out->done[i]);
+        (void)SDL_snprintf(out->titles[i], SESSION_TEXT_CAPACITY, "%s", ok ? title : "");
+        (void)SDL_snprintf(out->due_times[i], SESSION_TEXT_CAPACITY, "%s", ok ? due_time : "");
+    }
+    (void)SDL_snprintf(out->header, SESSION_TEXT_CAPACITY, "%s",
+                       ok ? todo_page_header_text(page) : "");
+
+    if (page != NULL)
+    {
+        todo_page_destroy(page);
+    }
+    ui_runtime_destroy(&context);
+    return ok;
+}
+
+static bool test_replay_reproduces_todo_session(void)
+{
+    static const char *LOG_PATH = "ui_hierarchy_tests_todo_session.bin";
+    const ui_event_log_header header = {
+        .wall_start_ns = 1700000000LL * SDL_NS_PER_SECOND + 500000000LL,
+        .ticks_start_ns = 5000U,
+        .width = 1024,
+        .height = 768,
+    };
+
+    (void)SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        return false;
+    }
+    SDL_Window *window = SDL_CreateWindow("replay", header.width, header.height,
+                                          SDL_WINDOW_HIDDEN);
+    ui_event_log_writer writer;
+    if (window == NULL || !ui_event_log_writer_open(&writer, LOG_PATH, &header))
+    {
+        SDL_DestroyWindow(window);
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        return false;
+    }
+
+    // Both runs start from the header's clock, as --record and --replay do.
+    static todo_session_result recorded;
+    static todo_session_result replayed;
+    ui_clock_use_virtual(header.wall_start_ns, header.ticks_start_ns);
+    bool ok = run_todo_session(window, &writer, NULL, &recorded);
+    ok = ui_event_log_writer_close(&writer) && ok;
+
+    ui_event_log_reader reader;
+    if (ok && ui_event_log_reader_open(&reader, LOG_PATH))
+    {
+        ui_clock_use_virtual(reader.header.wall_start_ns, reader.header.ticks_start_ns);
+        ok = run_todo_session(window, NULL, &reader, &replayed) &&
+             ui_event_log_reader_at_end(&reader) && !reader.failed;
+        ui_event_log_reader_close(&reader);
+    }
+    else
+    {
+        ok = false;
+    }
+
+    // Ten seeded tasks plus the submitted one, with every clock-derived string equal.
+    ok = ok && recorded.task_count == 11U && replayed.task_count == recorded.task_count &&
+         strcmp(recorded.titles[10], "milk") == 0 && recorded.header[0] != '\0' &&
+         strcmp(replayed.header, recorded.header) == 0;
+    for (size_t i = 0U; ok && i < recorded.task_count; ++i)
+    {
+        ok = strcmp(replayed.titles[i], recorded.titles[i]) == 0 &&
+             strcmp(replayed.due_times[i], recorded.due_times[i]) == 0 &&
+             replayed.done[i] == recorded.done[i];
+    }
+
+    ui_clock_use_real();
+    (void)SDL_RemovePath(LOG_PATH);
+    SDL_DestroyWindow(window);
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
     return ok;
 }
 
@@ -174,6 +1871,41 @@ int main(void)
          test_scroll_view_create_rejects_parented_child},
         {"horizontal layout preserves right anchor inset",
          test_horizontal_layout_preserves_right_anchor_inset},
+        {"screen rect cache follows ancestor arrange",
+         test_screen_rect_cache_follows_ancestor_arrange},
+        {"layout skips clean and hidden children", test_layout_skips_clean_and_hidden_children},
+        {"render diff damages only changed commands",
+         test_render_diff_damages_only_changed_commands},
+        {"render call stats count sdl calls", test_render_call_stats_count_sdl_calls},
+        {"render replay batches fills around text",
+         test_render_replay_batches_fills_around_text},
+        {"render replay clipped skips undamaged commands",
+         test_render_replay_clipped_skips_undamaged_commands},
+        {"glyph atlas text matches debug text", test_glyph_atlas_text_matches_debug_text},
+        {"text run follows content", test_text_run_follows_content},
+        {"utf8 scans follow codepoints", test_utf8_scans_follow_codepoints},
+        {"text updates reuse storage", test_text_updates_reuse_storage},
+        {"string pool shares text content", test_string_pool_shares_text_content},
+        {"list view recycles rows", test_list_view_recycles_rows},
+        {"list view estimates row heights", test_list_view_estimates_row_heights},
+        {"container reports earliest visible frame request",
+         test_container_reports_earliest_visible_frame_request},
+        {"traversal walks deep trees iteratively", test_traversal_walks_deep_trees_iteratively},
+        {"window pointer routing uses topmost hit after moves",
+         test_window_pointer_routing_uses_topmost_hit_after_moves},
+        {"window removal preserves order and stales handles",
+         test_window_removal_preserves_order_and_stales_handles},
+        {"press survives container destroyed by child",
+         test_press_survives_container_destroyed_by_child},
+        {"input coalescer merges motion and keeps button order",
+         test_input_coalescer_merges_motion_and_keeps_button_order},
+        {"runtime hover follows pointer and layout", test_runtime_hover_follows_pointer_and_layout},
+        {"arena backs widget tree and strings", test_arena_backs_widget_tree_and_strings},
+        {"element table tracks runtime state", test_element_table_tracks_runtime_state},
+        {"frame profiler reports tail percentiles", test_frame_profiler_reports_tail_percentiles},
+        {"ops profiler splits self time per type", test_ops_profiler_splits_self_time_per_type},
+        {"event log round trips frames and text", test_event_log_round_trips_frames_and_text},
+        {"replay reproduces todo session", test_replay_reproduces_todo_session},
     };
 
     size_t passed = 0U;